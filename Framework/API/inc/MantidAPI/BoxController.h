@@ -387,6 +387,10 @@ public:
   /// the compartibility function -- the write buffer is always used for file
   /// based workspaces
   bool useWriteBuffer() const;
+  /// the fraction of the file of a file-backed workspace taken by data
+  double getFileUtilisation() const;
+  /// the number of blocks of free space in the file of a file-backed workspace
+  size_t getNumFreeFileBlocks() const;
 
 private:
   /// When you split a MDBox, it becomes this many sub-boxes
@@ -225,8 +225,14 @@ protected:
       const std::string &parentLocalAttributesStr = "") const override;
 
   size_t paramOffset(size_t i) const { return m_paramOffsets[i]; }
+  /// Whether function() is the sum of the members on the same domain.
+  /// Derived classes combining their members otherwise must return false.
+  virtual bool membersAreSummed() const { return true; }
 
 private:
+  /// Numerical derivatives recalculating only the members that change
+  void calNumericalDerivOfMembers(const FunctionDomain &domain,
+                                  Jacobian &jacobian);
   /// Extract function index and parameter name from a variable name
   static void parseName(const std::string &varName, size_t &index,
                         std::string &name);
@@ -0,0 +1,178 @@
+#ifndef MANTID_API_DUALNUMBER_H_
+#define MANTID_API_DUALNUMBER_H_
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace Mantid {
+namespace API {
+/** DualNumber : A number together with its first derivatives with respect to
+  N variables, for forward-mode automatic differentiation.
+
+  Evaluating an expression with DualNumber instead of double gives its value
+  and all N derivatives in a single pass, exactly up to rounding. Variables
+  are created with DualNumber::variable(); plain doubles act as constants.
+  IFunction1D::functionDerivAutoDiff uses this to compute the Jacobian of
+  functions whose function1D is written as a template over the number type.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+template <size_t N> class DualNumber {
+public:
+  /// A constant
+  DualNumber(const double value = 0.) : m_value(value) {
+    m_derivatives.fill(0.);
+  }
+  /// @return the i-th variable, having the given value
+  static DualNumber variable(const double value, const size_t i) {
+    DualNumber x(value);
+    x.m_derivatives[i] = 1.;
+    return x;
+  }
+
+  /// @return the value
+  double value() const { return m_value; }
+  /// @return the derivative with respect to the i-th variable
+  double derivative(const size_t i) const { return m_derivatives[i]; }
+
+  DualNumber &operator+=(const DualNumber &rhs) {
+    m_value += rhs.m_value;
+    for (size_t i = 0; i < N; ++i)
+      m_derivatives[i] += rhs.m_derivatives[i];
+    return *this;
+  }
+  DualNumber &operator-=(const DualNumber &rhs) {
+    m_value -= rhs.m_value;
+    for (size_t i = 0; i < N; ++i)
+      m_derivatives[i] -= rhs.m_derivatives[i];
+    return *this;
+  }
+  DualNumber &operator*=(const DualNumber &rhs) {
+    for (size_t i = 0; i < N; ++i)
+      m_derivatives[i] =
+          m_derivatives[i] * rhs.m_value + m_value * rhs.m_derivatives[i];
+    m_value *= rhs.m_value;
+    return *this;
+  }
+  DualNumber &operator/=(const DualNumber &rhs) {
+    const double inverse = 1. / rhs.m_value;
+    m_value *= inverse;
+    for (size_t i = 0; i < N; ++i)
+      m_derivatives[i] =
+          (m_derivatives[i] - m_value * rhs.m_derivatives[i]) * inverse;
+    return *this;
+  }
+
+  /// @return a number with the given value whose derivatives are those of
+  /// this number times factor, i.e. f(this) for f' = factor
+  DualNumber chain(const double value, const double factor) const {
+    DualNumber result(value);
+    for (size_t i = 0; i < N; ++i)
+      result.m_derivatives[i] = factor * m_derivatives[i];
+    return result;
+  }
+
+  // The operators and functions below are only found by argument dependent
+  // lookup, so that they do not hide those of <cmath> for doubles.
+  friend DualNumber operator+(DualNumber lhs, const DualNumber &rhs) {
+    return lhs += rhs;
+  }
+  friend DualNumber operator-(DualNumber lhs, const DualNumber &rhs) {
+    return lhs -= rhs;
+  }
+  friend DualNumber operator*(DualNumber lhs, const DualNumber &rhs) {
+    return lhs *= rhs;
+  }
+  friend DualNumber operator/(DualNumber lhs, const DualNumber &rhs) {
+    return lhs /= rhs;
+  }
+  friend DualNumber operator-(const DualNumber &x) {
+    return x.chain(-x.value(), -1.);
+  }
+  friend DualNumber operator*(const DualNumber &lhs, const double rhs) {
+    return lhs.chain(lhs.value() * rhs, rhs);
+  }
+  friend DualNumber operator*(const double lhs, const DualNumber &rhs) {
+    return rhs.chain(lhs * rhs.value(), lhs);
+  }
+  friend DualNumber operator/(const DualNumber &lhs, const double rhs) {
+    return lhs.chain(lhs.value() / rhs, 1. / rhs);
+  }
+
+  friend DualNumber exp(const DualNumber &x) {
+    const double value = std::exp(x.value());
+    return x.chain(value, value);
+  }
+  friend DualNumber log(const DualNumber &x) {
+    return x.chain(std::log(x.value()), 1. / x.value());
+  }
+  friend DualNumber sqrt(const DualNumber &x) {
+    const double value = std::sqrt(x.value());
+    return x.chain(value, 0.5 / value);
+  }
+  friend DualNumber sin(const DualNumber &x) {
+    return x.chain(std::sin(x.value()), std::cos(x.value()));
+  }
+  friend DualNumber cos(const DualNumber &x) {
+    return x.chain(std::cos(x.value()), -std::sin(x.value()));
+  }
+  friend DualNumber atan(const DualNumber &x) {
+    return x.chain(std::atan(x.value()), 1. / (1. + x.value() * x.value()));
+  }
+  friend DualNumber tanh(const DualNumber &x) {
+    const double value = std::tanh(x.value());
+    return x.chain(value, 1. - value * value);
+  }
+  friend DualNumber abs(const DualNumber &x) {
+    return x.chain(std::abs(x.value()), x.value() < 0. ? -1. : 1.);
+  }
+  friend DualNumber pow(const DualNumber &x, const double exponent) {
+    const double value = std::pow(x.value(), exponent);
+    // Avoid 0 * inf for a constant base of zero
+    const double factor =
+        x.value() == 0. ? (exponent == 1. ? 1. : 0.)
+                        : exponent * std::pow(x.value(), exponent - 1.);
+    return x.chain(value, factor);
+  }
+  /// x^y for a positive or zero x. The derivatives at x = 0 are taken as the
+  /// limit for x going to zero along the direction of the derivatives of x,
+  /// which is 0 for y > 1.
+  friend DualNumber pow(const DualNumber &x, const DualNumber &exponent) {
+    if (x.value() == 0.) {
+      return pow(x, exponent.value());
+    }
+    const double value = std::pow(x.value(), exponent.value());
+    DualNumber result = x.chain(value, exponent.value() * value / x.value());
+    result += exponent.chain(0., value * std::log(x.value()));
+    return result;
+  }
+
+private:
+  double m_value;
+  std::array<double, N> m_derivatives;
+};
+
+} // namespace API
+} // namespace Mantid
+
+#endif /* MANTID_API_DUALNUMBER_H_ */
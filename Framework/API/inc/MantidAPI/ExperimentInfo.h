@@ -10,6 +10,7 @@
 #include "MantidKernel/V3D.h"
 #include "MantidKernel/cow_ptr.h"
 
+#include <atomic>
 #include <list>
 #include <mutex>
 
@@ -36,6 +37,7 @@ class ChopperModel;
 class ModeratorModel;
 class Run;
 class Sample;
+class SpectrumGeometry;
 class SpectrumInfo;
 
 /** This class is shared by a few Workspace types
@@ -171,6 +173,9 @@ public:
   const Geometry::ComponentInfo &componentInfo() const;
   Geometry::ComponentInfo &mutableComponentInfo();
 
+  boost::shared_ptr<const SpectrumGeometry> spectrumGeometry() const;
+  size_t spectrumGeometryVersion() const;
+
   void invalidateSpectrumDefinition(const size_t index);
   void updateSpectrumDefinitionIfNecessary(const size_t index) const;
 
@@ -226,6 +231,7 @@ private:
   mutable std::unordered_map<detid_t, size_t> m_det2group;
   void cacheDefaultDetectorGrouping() const; // Not thread-safe
   void invalidateAllSpectrumDefinitions();
+  void invalidateSpectrumGeometry() const;
   mutable std::once_flag m_defaultDetectorGroupingCached;
 
   mutable std::unique_ptr<Beamline::SpectrumInfo> m_spectrumInfo;
@@ -234,6 +240,14 @@ private:
   // This vector stores boolean flags but uses char to do so since
   // std::vector<bool> is not thread-safe.
   mutable std::vector<char> m_spectrumDefinitionNeedsUpdate;
+
+  /// Flat copy of the spectrum geometry, built on demand
+  mutable boost::shared_ptr<const SpectrumGeometry> m_spectrumGeometry;
+  /// The version of the geometry m_spectrumGeometry was built for
+  mutable size_t m_spectrumGeometryBuiltVersion{0};
+  /// Incremented whenever the geometry of the spectra may change
+  mutable std::atomic<size_t> m_spectrumGeometryVersion{1};
+  mutable std::mutex m_spectrumGeometryMutex;
 };
 
 /// Shared pointer to ExperimentInfo
@@ -69,6 +69,11 @@ public:
 
   virtual void clearMRU() const = 0;
 
+  /// Choose whether histogramming sorts the events by TOF first
+  virtual void setSortBeforeHistogram(const bool sort) = 0;
+  /// Whether histogramming sorts the events by TOF first
+  virtual bool getSortBeforeHistogram() const = 0;
+
 protected:
   /// Protected copy constructor. May be used by childs for cloning.
   IEventWorkspace(const IEventWorkspace &) = default;
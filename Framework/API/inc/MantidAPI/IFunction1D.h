@@ -5,10 +5,14 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidAPI/DllConfig.h"
+#include "MantidAPI/DualNumber.h"
 #include "MantidAPI/IFunction.h"
 #include "MantidAPI/FunctionDomain1D.h"
 #include "MantidKernel/Logger.h"
 
+#include <array>
+#include <stdexcept>
+
 namespace Mantid {
 
 namespace CurveFitting {
@@ -87,6 +91,11 @@ protected:
   virtual void histogramDerivative1D(Jacobian *jacobian, double left,
                                      const double *right,
                                      const size_t nBins) const;
+  /// Derivatives obtained by evaluating the function with dual numbers.
+  template <size_t N, typename Evaluate>
+  void functionDerivAutoDiff(Jacobian *jacobian, const double *xValues,
+                             const size_t nData,
+                             const Evaluate &evaluate) const;
 
   /// Logger instance
   static Kernel::Logger g_log;
@@ -95,6 +104,39 @@ protected:
   friend class CurveFitting::Algorithms::Fit;
 };
 
+/** Fill in the derivatives with respect to all parameters of a function
+ * whose value at a point can be evaluated for any number type. The function
+ * is evaluated once per point with DualNumbers, giving the exact derivatives
+ * instead of the N + 1 evaluations of a numerical derivative.
+ * @param jacobian :: the Jacobian to fill in
+ * @param xValues :: the x values
+ * @param nData :: the number of x values
+ * @param evaluate :: a callable taking a double x and a std::array<T, N> of
+ * parameters, in declaration order, and returning the value as a T. It is
+ * instantiated with T = DualNumber<N>.
+ */
+template <size_t N, typename Evaluate>
+void IFunction1D::functionDerivAutoDiff(Jacobian *jacobian,
+                                        const double *xValues,
+                                        const size_t nData,
+                                        const Evaluate &evaluate) const {
+  if (nParams() != N) {
+    throw std::logic_error("Function " + name() + " has " +
+                           std::to_string(nParams()) + " parameters, not " +
+                           std::to_string(N));
+  }
+  std::array<DualNumber<N>, N> parameters;
+  for (size_t ip = 0; ip < N; ++ip) {
+    parameters[ip] = DualNumber<N>::variable(getParameter(ip), ip);
+  }
+  for (size_t i = 0; i < nData; ++i) {
+    const DualNumber<N> value = evaluate(xValues[i], parameters);
+    for (size_t ip = 0; ip < N; ++ip) {
+      jacobian->set(i, ip, value.derivative(ip));
+    }
+  }
+}
+
 typedef boost::shared_ptr<IFunction1D> IFunction1D_sptr;
 
 } // namespace API
@@ -99,6 +99,8 @@ public:
   }
 
 protected:
+  /// Each member is evaluated on its own domains
+  bool membersAreSummed() const override { return false; }
   /// Counts number of the domains
   void countNumberOfDomains();
   void countValueOffsets(const CompositeDomain &domain) const;
@@ -0,0 +1,112 @@
+#ifndef MANTID_API_SPECTRUMGEOMETRY_H_
+#define MANTID_API_SPECTRUMGEOMETRY_H_
+
+#include "MantidAPI/DllConfig.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+
+class ExperimentInfo;
+
+/** SpectrumGeometry : An immutable snapshot of the geometry of all spectra of
+  an ExperimentInfo, held in contiguous arrays: L2, 2-theta, signed 2-theta,
+  DIFC and the Efixed instrument parameter, along with L1.
+
+  Computing these through SpectrumInfo walks the instrument and the
+  ParameterMap for every spectrum, which dominates unit conversions on large
+  instruments. ExperimentInfo::spectrumGeometry() builds the table once and
+  hands it out until the instrument, its parameters or the detector grouping
+  change, so repeated conversions of the same workspace only read arrays.
+  ExperimentInfo::spectrumGeometryVersion() tells whether a table held on to
+  is still current.
+
+  The values follow the conventions of SpectrumInfo: spectra without detectors
+  have none of them, and monitors only have L2. DIFC is that of the nominal
+  geometry, i.e. without calibration offsets.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_API_DLL SpectrumGeometry {
+public:
+  explicit SpectrumGeometry(const ExperimentInfo &experimentInfo);
+
+  /// @return the number of spectra
+  size_t size() const { return m_kind.size(); }
+  /// @return the source-sample distance; 0 if no spectrum has detectors
+  double l1() const { return m_l1; }
+
+  /// @return true if the spectrum at index has detectors
+  bool hasDetectors(const size_t index) const {
+    return m_kind[index] != Kind::NoDetectors;
+  }
+  /// @return true if the spectrum at index is a monitor
+  bool isMonitor(const size_t index) const {
+    return m_kind[index] == Kind::Monitor;
+  }
+  /// @return the sample-detector distance of the spectrum at index
+  double l2(const size_t index) const { return m_l2[index]; }
+  /// @return the scattering angle of the spectrum at index; 0 for monitors
+  double twoTheta(const size_t index) const { return m_twoTheta[index]; }
+  /// @return the signed scattering angle of the spectrum at index
+  double signedTwoTheta(const size_t index) const {
+    return m_signedTwoTheta[index];
+  }
+  /// @return DIFC of the spectrum at index; 0 for monitors
+  double difc(const size_t index) const { return m_difc[index]; }
+  /// @return true if the spectrum at index has an Efixed parameter
+  bool hasEFixed(const size_t index) const;
+  /// @return the Efixed parameter of the spectrum at index, EMPTY_DBL() if it
+  /// has none or its detectors are grouped
+  double eFixed(const size_t index) const { return m_eFixed[index]; }
+
+  /// @return the L2 of all spectra
+  const std::vector<double> &l2s() const { return m_l2; }
+  /// @return the 2-theta of all spectra
+  const std::vector<double> &twoThetas() const { return m_twoTheta; }
+  /// @return the DIFC of all spectra
+  const std::vector<double> &difcs() const { return m_difc; }
+  /// @return the Efixed of all spectra
+  const std::vector<double> &eFixeds() const { return m_eFixed; }
+
+private:
+  enum class Kind : uint8_t { NoDetectors, Monitor, Detector };
+
+  double m_l1;
+  std::vector<Kind> m_kind;
+  std::vector<double> m_l2;
+  std::vector<double> m_twoTheta;
+  std::vector<double> m_signedTwoTheta;
+  std::vector<double> m_difc;
+  std::vector<double> m_eFixed;
+};
+
+using SpectrumGeometry_const_sptr = boost::shared_ptr<const SpectrumGeometry>;
+
+} // namespace API
+} // namespace Mantid
+
+#endif /* MANTID_API_SPECTRUMGEOMETRY_H_ */
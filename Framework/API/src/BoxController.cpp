@@ -214,6 +214,26 @@ bool BoxController::useWriteBuffer() const {
   return static_cast<bool>(m_fileIO);
 }
 
+/** Report how well the file of a file-backed workspace is filled: the free
+space left by boxes that moved or shrank is not used until other boxes are
+written there.
+@return the fraction of the file length that holds data, or 1 if the
+workspace is not file based or its file is empty */
+double BoxController::getFileUtilisation() const {
+  if (!m_fileIO || m_fileIO->getFileLength() == 0)
+    return 1.;
+  const auto fileLength = static_cast<double>(m_fileIO->getFileLength());
+  return 1. - static_cast<double>(m_fileIO->getFreeSpaceSize()) / fileLength;
+}
+/** @return the number of blocks of free space in the file of a file-backed
+workspace, which measures its fragmentation; 0 if it is not file based */
+size_t BoxController::getNumFreeFileBlocks() const {
+  if (m_fileIO)
+    return m_fileIO->getNumFreeBlocks();
+  else
+    return 0;
+}
+
 //------------------------------------------------------------------------------------------------------
 /** Static method that sets the data inside this BoxController from an XML
  *string
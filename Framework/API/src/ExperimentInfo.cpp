@@ -5,6 +5,7 @@
 #include "MantidAPI/ResizeRectangularDetectorHelper.h"
 #include "MantidAPI/Run.h"
 #include "MantidAPI/Sample.h"
+#include "MantidAPI/SpectrumGeometry.h"
 #include "MantidAPI/SpectrumInfo.h"
 
 #include "MantidGeometry/Crystal/OrientedLattice.h"
@@ -79,6 +80,14 @@ ExperimentInfo::ExperimentInfo()
 ExperimentInfo::ExperimentInfo(const ExperimentInfo &source) {
   this->copyExperimentInfoFrom(&source);
   setSpectrumDefinitions(source.spectrumInfo().sharedSpectrumDefinitions());
+  // The copy has the geometry of the source, so it can share its table
+  std::lock_guard<std::mutex> lock{source.m_spectrumGeometryMutex};
+  if (source.m_spectrumGeometry &&
+      source.m_spectrumGeometryBuiltVersion ==
+          source.m_spectrumGeometryVersion) {
+    m_spectrumGeometry = source.m_spectrumGeometry;
+    m_spectrumGeometryBuiltVersion = m_spectrumGeometryVersion;
+  }
 }
 
 // Defined as default in source for forward declaration with std::unique_ptr.
@@ -188,6 +197,7 @@ void checkDetectorInfoSize(const Instrument &instr,
 */
 void ExperimentInfo::setInstrument(const Instrument_const_sptr &instr) {
   m_spectrumInfoWrapper = nullptr;
+  invalidateSpectrumGeometry();
 
   // Detector IDs that were previously dropped because they were not part of the
   // instrument may now suddenly be valid, so we have to reinitialize the
@@ -226,6 +236,7 @@ Instrument_const_sptr ExperimentInfo::getInstrument() const {
 */
 Geometry::ParameterMap &ExperimentInfo::instrumentParameters() {
   populateIfNotLoaded();
+  invalidateSpectrumGeometry();
   return *m_parmap;
 }
 
@@ -483,6 +494,7 @@ void ExperimentInfo::setNumberOfDetectorGroups(const size_t count) const {
   m_spectrumDefinitionNeedsUpdate.resize(count, 1);
   m_spectrumInfo = Kernel::make_unique<Beamline::SpectrumInfo>(count);
   m_spectrumInfoWrapper = nullptr;
+  invalidateSpectrumGeometry();
 }
 
 /** Returns the number of detector groups.
@@ -1045,6 +1057,7 @@ const Geometry::DetectorInfo &ExperimentInfo::detectorInfo() const {
 /** Return a non-const reference to the DetectorInfo object. */
 Geometry::DetectorInfo &ExperimentInfo::mutableDetectorInfo() {
   populateIfNotLoaded();
+  invalidateSpectrumGeometry();
   return m_parmap->mutableDetectorInfo();
 }
 
@@ -1111,6 +1124,7 @@ const Geometry::ComponentInfo &ExperimentInfo::componentInfo() const {
 }
 
 ComponentInfo &ExperimentInfo::mutableComponentInfo() {
+  invalidateSpectrumGeometry();
   return m_parmap->mutableComponentInfo();
 }
 
@@ -1128,6 +1142,41 @@ void ExperimentInfo::setSpectrumDefinitions(
     invalidateAllSpectrumDefinitions();
   }
   m_spectrumInfoWrapper = nullptr;
+  invalidateSpectrumGeometry();
+}
+
+/** Return the geometry of all spectra as flat arrays.
+ *
+ * The table is built on first use and shared until the instrument, the
+ * instrument parameters or the detector grouping change. Obtaining a mutable
+ * DetectorInfo, ComponentInfo or ParameterMap counts as a change, so the table
+ * must not be requested while holding on to such a reference that will still
+ * be written through. Thread safe.
+ */
+boost::shared_ptr<const SpectrumGeometry>
+ExperimentInfo::spectrumGeometry() const {
+  // Resolve lazy detector groupings first, they would change the version
+  const auto &info = spectrumInfo();
+  std::lock_guard<std::mutex> lock{m_spectrumGeometryMutex};
+  const size_t version = m_spectrumGeometryVersion;
+  if (!m_spectrumGeometry || m_spectrumGeometryBuiltVersion != version ||
+      m_spectrumGeometry->size() != info.size()) {
+    m_spectrumGeometry = boost::make_shared<const SpectrumGeometry>(*this);
+    m_spectrumGeometryBuiltVersion = version;
+  }
+  return m_spectrumGeometry;
+}
+
+/** Return the version of the geometry of the spectra. It changes whenever the
+ * table returned by spectrumGeometry() may be out of date.
+ */
+size_t ExperimentInfo::spectrumGeometryVersion() const {
+  return m_spectrumGeometryVersion;
+}
+
+/// Marks the table returned by spectrumGeometry() as out of date.
+void ExperimentInfo::invalidateSpectrumGeometry() const {
+  ++m_spectrumGeometryVersion;
 }
 
 /** Notifies the ExperimentInfo that a spectrum definition has changed.
@@ -1139,6 +1188,7 @@ void ExperimentInfo::invalidateSpectrumDefinition(const size_t index) {
   // This uses a vector of char, such that flags for different indices can be
   // set from different threads (std::vector<bool> is not thread-safe).
   m_spectrumDefinitionNeedsUpdate.at(index) = 1;
+  invalidateSpectrumGeometry();
 }
 
 void ExperimentInfo::updateSpectrumDefinitionIfNecessary(
@@ -1192,6 +1242,7 @@ size_t ExperimentInfo::groupOfDetectorID(const detid_t detID) const {
 void ExperimentInfo::invalidateAllSpectrumDefinitions() {
   std::fill(m_spectrumDefinitionNeedsUpdate.begin(),
             m_spectrumDefinitionNeedsUpdate.end(), 1);
+  invalidateSpectrumGeometry();
 }
 
 /** Save the object to an open NeXus file.
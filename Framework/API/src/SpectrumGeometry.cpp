@@ -0,0 +1,82 @@
+#include "MantidAPI/SpectrumGeometry.h"
+#include "MantidAPI/ExperimentInfo.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidGeometry/IDetector.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
+#include "MantidKernel/EmptyValues.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <algorithm>
+
+namespace Mantid {
+namespace API {
+
+namespace {
+/// @return true if any component has an Efixed parameter
+bool hasEFixedParameters(const Geometry::ParameterMap &pmap) {
+  return std::any_of(pmap.begin(), pmap.end(),
+                     [](const Geometry::ParameterMap::pmap::value_type &item) {
+                       return boost::iequals(item.second->name(), "Efixed");
+                     });
+}
+} // namespace
+
+/** Compute the geometry of all spectra
+ * @param experimentInfo :: the ExperimentInfo whose spectra are described
+ */
+SpectrumGeometry::SpectrumGeometry(const ExperimentInfo &experimentInfo)
+    : m_l1(0.) {
+  const auto &spectrumInfo = experimentInfo.spectrumInfo();
+  const size_t numberOfSpectra = spectrumInfo.size();
+  m_kind.resize(numberOfSpectra, Kind::NoDetectors);
+  m_l2.resize(numberOfSpectra, 0.);
+  m_twoTheta.resize(numberOfSpectra, 0.);
+  m_signedTwoTheta.resize(numberOfSpectra, 0.);
+  m_difc.resize(numberOfSpectra, 0.);
+  m_eFixed.resize(numberOfSpectra, EMPTY_DBL());
+
+  for (size_t i = 0; i < numberOfSpectra; ++i) {
+    if (spectrumInfo.hasDetectors(i))
+      m_kind[i] = spectrumInfo.isMonitor(i) ? Kind::Monitor : Kind::Detector;
+  }
+  // An instrument without detectors need not have a source
+  if (std::none_of(m_kind.cbegin(), m_kind.cend(),
+                   [](const Kind kind) { return kind != Kind::NoDetectors; }))
+    return;
+  m_l1 = spectrumInfo.l1();
+
+  const auto &pmap = experimentInfo.constInstrumentParameters();
+  const bool lookupEFixed = hasEFixedParameters(pmap);
+  const auto numberOfSpectra_i = static_cast<int64_t>(numberOfSpectra);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numberOfSpectra_i; ++i) {
+    if (m_kind[i] == Kind::NoDetectors)
+      continue;
+    m_l2[i] = spectrumInfo.l2(i);
+    if (m_kind[i] == Kind::Monitor)
+      continue;
+    m_twoTheta[i] = spectrumInfo.twoTheta(i);
+    m_signedTwoTheta[i] = spectrumInfo.signedTwoTheta(i);
+    m_difc[i] = 1. / Geometry::Conversion::tofToDSpacingFactor(
+                         m_l1, m_l2[i], m_twoTheta[i], 0.);
+    if (lookupEFixed && spectrumInfo.hasUniqueDetector(i)) {
+      const auto par =
+          pmap.getRecursive(&spectrumInfo.detector(i), "Efixed");
+      if (par)
+        m_eFixed[i] = par->value<double>();
+    }
+  }
+}
+
+/** @param index :: index of a spectrum
+ * @return true if the spectrum has an Efixed parameter
+ */
+bool SpectrumGeometry::hasEFixed(const size_t index) const {
+  return m_eFixed[index] != EMPTY_DBL();
+}
+
+} // namespace API
+} // namespace Mantid
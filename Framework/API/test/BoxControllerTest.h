@@ -357,6 +357,28 @@ public:
     TS_ASSERT_EQUALS(dbuf->getWriteBufferSize(), 123);
   }
 
+  void test_file_utilisation() {
+    auto a = boost::make_shared<BoxController>(2);
+    TS_ASSERT_EQUALS(a->getFileUtilisation(), 1.);
+    TS_ASSERT_EQUALS(a->getNumFreeFileBlocks(), 0);
+
+    boost::shared_ptr<IBoxControllerIO> pS(
+        new MantidTestHelpers::BoxControllerDummyIO(a.get()));
+    a->setFileBacked(pS, "existingFakeFile");
+    DiskBuffer *dbuf = a->getFileIO();
+    TS_ASSERT_EQUALS(dbuf->getFileLength(), 1000);
+    TS_ASSERT_EQUALS(a->getFileUtilisation(), 1.);
+
+    dbuf->freeBlock(100, 100);
+    dbuf->freeBlock(500, 150);
+    TS_ASSERT_DELTA(a->getFileUtilisation(), 0.75, 1e-12);
+    TS_ASSERT_EQUALS(a->getNumFreeFileBlocks(), 2);
+    // A block that fits is reused
+    TS_ASSERT_EQUALS(dbuf->allocate(150), 500);
+    TS_ASSERT_DELTA(a->getFileUtilisation(), 0.9, 1e-12);
+    TS_ASSERT_EQUALS(a->getNumFreeFileBlocks(), 1);
+  }
+
   void test_construction_defaults() {
     // Check the constructor defaults.
     BoxController box_controller(2);
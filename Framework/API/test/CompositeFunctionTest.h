@@ -13,6 +13,8 @@
 #include "MantidAPI/FunctionFactory.h"
 #include "MantidTestHelpers/FakeObjects.h"
 
+#include <boost/make_shared.hpp>
+
 using namespace Mantid;
 using namespace Mantid::API;
 
@@ -192,6 +194,50 @@ public:
   }
 };
 
+/// Counts the evaluations of a Linear function
+class CompositeFunctionTest_CountingLinear : public Linear {
+public:
+  void function1D(double *out, const double *xValues,
+                  const size_t nData) const override {
+    ++nCalls;
+    Linear::function1D(out, xValues, nData);
+  }
+  mutable size_t nCalls = 0;
+};
+
+/// Multiplies its members instead of adding them
+class CompositeFunctionTest_Product : public CompositeFunction {
+public:
+  void function(const FunctionDomain &domain,
+                FunctionValues &values) const override {
+    FunctionValues tmp(domain);
+    values.setCalculated(1.0);
+    for (size_t iFun = 0; iFun < nFunctions(); ++iFun) {
+      getFunction(iFun)->function(domain, tmp);
+      values *= tmp;
+    }
+  }
+
+protected:
+  bool membersAreSummed() const override { return false; }
+};
+
+class CompositeFunctionTest_Jacobian : public Jacobian {
+public:
+  CompositeFunctionTest_Jacobian(size_t ny, size_t np) : m_np(np) {
+    m_data.resize(ny * np);
+  }
+  void set(size_t iY, size_t iP, double value) override {
+    m_data[iY * m_np + iP] = value;
+  }
+  double get(size_t iY, size_t iP) override { return m_data[iY * m_np + iP]; }
+  void zero() override { m_data.assign(m_data.size(), 0.0); }
+
+private:
+  size_t m_np;
+  std::vector<double> m_data;
+};
+
 class CompositeFunctionTest : public CxxTest::TestSuite {
 public:
   static CompositeFunctionTest *createSuite() {
@@ -1193,6 +1239,68 @@ public:
     TS_ASSERT(!b);
   }
 
+  void test_numerical_derivatives_only_recalculate_changed_members() {
+    auto l1 = boost::make_shared<CompositeFunctionTest_CountingLinear>();
+    auto g = boost::make_shared<Gauss>();
+    auto cub = boost::make_shared<Cubic>();
+    auto l2 = boost::make_shared<CompositeFunctionTest_CountingLinear>();
+    CompositeFunction fun;
+    fun.setAttributeValue("NumDeriv", true);
+    fun.addFunction(l1);
+    fun.addFunction(g);
+    fun.addFunction(cub);
+    fun.addFunction(l2);
+    const double values[] = {0.8, 0.1, 1.1, 1.2, 1.3, 0.0,
+                             2.2, 2.3, 2.4, 0.5, -0.3};
+    for (size_t i = 0; i < fun.nParams(); ++i) {
+      fun.setParameter(i, values[i]);
+    }
+    fun.tie("f2.c0", "2*f0.a");
+    fun.fix(4);
+
+    FunctionDomain1DVector domain(0.0, 3.0, 20);
+    CompositeFunctionTest_Jacobian jacobian(domain.size(), fun.nParams());
+    CompositeFunctionTest_Jacobian expected(domain.size(), fun.nParams());
+    fun.functionDeriv(domain, jacobian);
+    // 1 evaluation at the current parameters and 1 per own parameter
+    TS_ASSERT_EQUALS(l1->nCalls, 3);
+    TS_ASSERT_EQUALS(l2->nCalls, 3);
+
+    fun.calNumericalDeriv(domain, expected);
+    for (size_t i = 0; i < domain.size(); ++i) {
+      for (size_t ip = 0; ip < fun.nParams(); ++ip) {
+        TS_ASSERT_EQUALS(jacobian.get(i, ip), expected.get(i, ip));
+      }
+    }
+    TS_ASSERT_EQUALS(fun.getParameter("f0.a"), 0.8);
+    TS_ASSERT_DELTA(fun.getParameter("f2.c0"), 1.6, 1e-15);
+  }
+
+  void test_numerical_derivatives_of_members_not_summed() {
+    auto l1 = boost::make_shared<CompositeFunctionTest_CountingLinear>();
+    auto l2 = boost::make_shared<CompositeFunctionTest_CountingLinear>();
+    CompositeFunctionTest_Product fun;
+    fun.setAttributeValue("NumDeriv", true);
+    fun.addFunction(l1);
+    fun.addFunction(l2);
+    const double values[] = {0.8, 0.1, 1.1, 1.2};
+    for (size_t i = 0; i < fun.nParams(); ++i) {
+      fun.setParameter(i, values[i]);
+    }
+
+    FunctionDomain1DVector domain(0.0, 3.0, 20);
+    CompositeFunctionTest_Jacobian jacobian(domain.size(), fun.nParams());
+    fun.functionDeriv(domain, jacobian);
+    // Every member is evaluated for every step
+    TS_ASSERT_EQUALS(l1->nCalls, 5);
+    TS_ASSERT_EQUALS(l2->nCalls, 5);
+    // d(l1 * l2)/d(l1.b) = x * l2
+    for (size_t i = 0; i < domain.size(); ++i) {
+      const double x = domain[i];
+      TS_ASSERT_DELTA(jacobian.get(i, 1), x * (1.1 + 1.2 * x), 1e-5);
+    }
+  }
+
   void test_local_name() {
     std::string funStr = "name=Linear;(name=Linear;(name=Linear;name=Linear))";
     auto fun = boost::dynamic_pointer_cast<CompositeFunction>(
@@ -0,0 +1,77 @@
+#ifndef MANTID_API_DUALNUMBERTEST_H_
+#define MANTID_API_DUALNUMBERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/DualNumber.h"
+
+#include <cmath>
+
+using Mantid::API::DualNumber;
+
+class DualNumberTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static DualNumberTest *createSuite() { return new DualNumberTest(); }
+  static void destroySuite(DualNumberTest *suite) { delete suite; }
+
+  void test_constant_has_no_derivatives() {
+    const DualNumber<2> c(3.5);
+    TS_ASSERT_EQUALS(c.value(), 3.5);
+    TS_ASSERT_EQUALS(c.derivative(0), 0.0);
+    TS_ASSERT_EQUALS(c.derivative(1), 0.0);
+  }
+
+  void test_arithmetic() {
+    const auto x = DualNumber<2>::variable(3.0, 0);
+    const auto y = DualNumber<2>::variable(2.0, 1);
+    // f = (x * y + 1) / (x - y) - 2 / y
+    const auto f = (x * y + 1.) / (x - y) - 2. / y;
+    TS_ASSERT_DELTA(f.value(), 6.0, 1e-15);
+    // df/dx = (y (x - y) - (x y + 1)) / (x - y)^2 = -5
+    TS_ASSERT_DELTA(f.derivative(0), -5.0, 1e-14);
+    // df/dy = (x (x - y) + (x y + 1)) / (x - y)^2 + 2 / y^2 = 10.5
+    TS_ASSERT_DELTA(f.derivative(1), 10.5, 1e-14);
+  }
+
+  void test_functions_match_numerical_derivatives() {
+    const double x0 = 0.7;
+    const double h = 1e-6;
+    const auto x = DualNumber<1>::variable(x0, 0);
+    checkDerivative(exp(x), [](double v) { return std::exp(v); }, x0, h);
+    checkDerivative(log(x), [](double v) { return std::log(v); }, x0, h);
+    checkDerivative(sqrt(x), [](double v) { return std::sqrt(v); }, x0, h);
+    checkDerivative(sin(x), [](double v) { return std::sin(v); }, x0, h);
+    checkDerivative(cos(x), [](double v) { return std::cos(v); }, x0, h);
+    checkDerivative(atan(x), [](double v) { return std::atan(v); }, x0, h);
+    checkDerivative(tanh(x), [](double v) { return std::tanh(v); }, x0, h);
+    checkDerivative(abs(-x), [](double v) { return std::abs(-v); }, x0, h);
+    checkDerivative(pow(x, 2.5), [](double v) { return std::pow(v, 2.5); },
+                    x0, h);
+    checkDerivative(pow(2. * x, x),
+                    [](double v) { return std::pow(2. * v, v); }, x0, h);
+  }
+
+  void test_pow_of_zero_has_finite_derivatives() {
+    const auto x = DualNumber<2>::variable(0.0, 0);
+    const auto b = DualNumber<2>::variable(0.5, 1);
+    const auto f = pow(x, b);
+    TS_ASSERT_EQUALS(f.value(), 0.0);
+    TS_ASSERT(std::isfinite(f.derivative(0)));
+    TS_ASSERT_EQUALS(f.derivative(1), 0.0);
+    const auto g = pow(x, 2.0);
+    TS_ASSERT_EQUALS(g.derivative(0), 0.0);
+  }
+
+private:
+  template <typename F>
+  void checkDerivative(const DualNumber<1> &f, const F &function,
+                       const double x, const double h) {
+    TS_ASSERT_DELTA(f.value(), function(x), 1e-15);
+    const double numerical = (function(x + h) - function(x - h)) / (2. * h);
+    TS_ASSERT_DELTA(f.derivative(0), numerical, 1e-8);
+  }
+};
+
+#endif /* MANTID_API_DUALNUMBERTEST_H_ */
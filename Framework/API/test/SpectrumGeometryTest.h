@@ -0,0 +1,135 @@
+#ifndef MANTID_API_SPECTRUMGEOMETRYTEST_H_
+#define MANTID_API_SPECTRUMGEOMETRYTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/SpectrumGeometry.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidKernel/EmptyValues.h"
+#include "MantidTestHelpers/FakeObjects.h"
+#include "MantidTestHelpers/InstrumentCreationHelper.h"
+
+using namespace Mantid;
+using namespace Mantid::API;
+using namespace Mantid::Kernel;
+
+class SpectrumGeometryTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static SpectrumGeometryTest *createSuite() {
+    return new SpectrumGeometryTest();
+  }
+  static void destroySuite(SpectrumGeometryTest *suite) { delete suite; }
+
+  void test_values_match_SpectrumInfo() {
+    auto ws = makeWorkspace();
+    const auto &spectrumInfo = ws.spectrumInfo();
+    const auto geometry = ws.spectrumGeometry();
+    TS_ASSERT_EQUALS(geometry->size(), 5);
+    TS_ASSERT_EQUALS(geometry->l1(), spectrumInfo.l1());
+    for (size_t i = 0; i < 3; ++i) {
+      TS_ASSERT(geometry->hasDetectors(i));
+      TS_ASSERT(!geometry->isMonitor(i));
+      TS_ASSERT_EQUALS(geometry->l2(i), spectrumInfo.l2(i));
+      TS_ASSERT_EQUALS(geometry->twoTheta(i), spectrumInfo.twoTheta(i));
+      TS_ASSERT_EQUALS(geometry->signedTwoTheta(i),
+                       spectrumInfo.signedTwoTheta(i));
+      TS_ASSERT(!geometry->hasEFixed(i));
+    }
+    // Monitors have an L2 but no angle
+    for (size_t i = 3; i < 5; ++i) {
+      TS_ASSERT(geometry->isMonitor(i));
+      TS_ASSERT_EQUALS(geometry->l2(i), spectrumInfo.l2(i));
+      TS_ASSERT_EQUALS(geometry->twoTheta(i), 0.0);
+      TS_ASSERT_EQUALS(geometry->difc(i), 0.0);
+    }
+  }
+
+  void test_difc() {
+    auto ws = makeWorkspace();
+    const auto &spectrumInfo = ws.spectrumInfo();
+    const auto geometry = ws.spectrumGeometry();
+    const double expected =
+        1. / Geometry::Conversion::tofToDSpacingFactor(
+                 spectrumInfo.l1(), spectrumInfo.l2(0),
+                 spectrumInfo.twoTheta(0), 0.);
+    TS_ASSERT_DELTA(geometry->difc(0), expected, 1e-9);
+    TS_ASSERT_EQUALS(geometry->difcs().size(), 5);
+  }
+
+  void test_table_is_cached() {
+    auto ws = makeWorkspace();
+    const auto geometry = ws.spectrumGeometry();
+    const auto version = ws.spectrumGeometryVersion();
+    TS_ASSERT_EQUALS(ws.spectrumGeometry(), geometry);
+    TS_ASSERT_EQUALS(ws.spectrumGeometryVersion(), version);
+  }
+
+  void test_moving_a_detector_invalidates_the_table() {
+    auto ws = makeWorkspace();
+    const auto geometry = ws.spectrumGeometry();
+    const auto version = ws.spectrumGeometryVersion();
+    ws.mutableDetectorInfo().setPosition(0, V3D(0.0, -0.2, 10.0));
+    TS_ASSERT_DIFFERS(ws.spectrumGeometryVersion(), version);
+    const auto updated = ws.spectrumGeometry();
+    TS_ASSERT_DIFFERS(updated, geometry);
+    TS_ASSERT_EQUALS(updated->l2(0), ws.spectrumInfo().l2(0));
+    TS_ASSERT_DIFFERS(updated->l2(0), geometry->l2(0));
+  }
+
+  void test_changing_detector_ids_invalidates_the_table() {
+    auto ws = makeWorkspace();
+    TS_ASSERT(ws.spectrumGeometry()->hasDetectors(1));
+    ws.getSpectrum(1).clearDetectorIDs();
+    TS_ASSERT(!ws.spectrumGeometry()->hasDetectors(1));
+  }
+
+  void test_efixed_of_single_detectors() {
+    auto ws = makeWorkspace();
+    ws.setEFixed(2, 3.5);
+    const auto geometry = ws.spectrumGeometry();
+    TS_ASSERT(geometry->hasEFixed(1));
+    TS_ASSERT_EQUALS(geometry->eFixed(1), 3.5);
+    TS_ASSERT(!geometry->hasEFixed(0));
+    TS_ASSERT_EQUALS(geometry->eFixed(0), EMPTY_DBL());
+
+    // Groups use the value given by the user
+    ws.getSpectrum(1).setDetectorIDs({1, 2});
+    TS_ASSERT(!ws.spectrumGeometry()->hasEFixed(1));
+  }
+
+  void test_copy_shares_the_table() {
+    auto ws = makeWorkspace();
+    const auto geometry = ws.spectrumGeometry();
+    auto copy = ws.clone();
+    TS_ASSERT_EQUALS(copy->spectrumGeometry(), geometry);
+    // Changing the copy leaves the original alone
+    copy->mutableDetectorInfo().setPosition(0, V3D(0.0, -0.2, 10.0));
+    TS_ASSERT_DIFFERS(copy->spectrumGeometry(), geometry);
+    TS_ASSERT_EQUALS(ws.spectrumGeometry(), geometry);
+  }
+
+  void test_workspace_without_detectors() {
+    WorkspaceTester ws;
+    ws.initialize(3, 2, 1);
+    const auto geometry = ws.spectrumGeometry();
+    TS_ASSERT_EQUALS(geometry->size(), 3);
+    TS_ASSERT(!geometry->hasDetectors(0));
+    TS_ASSERT_EQUALS(geometry->l1(), 0.0);
+  }
+
+private:
+  /// 3 detectors followed by 2 monitors
+  WorkspaceTester makeWorkspace() {
+    WorkspaceTester ws;
+    ws.initialize(5, 2, 1);
+    InstrumentCreationHelper::addFullInstrumentToWorkspace(ws, true, true,
+                                                           "TestInstrument");
+    return ws;
+  }
+};
+
+#endif /* MANTID_API_SPECTRUMGEOMETRYTEST_H_ */
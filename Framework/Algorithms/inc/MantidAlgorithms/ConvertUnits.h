@@ -115,11 +115,10 @@ protected:
                  const double &power);
 
   /// Internal function to gather detector specific L2, theta and efixed values
-  bool getDetectorValues(const API::SpectrumInfo &spectrumInfo,
+  bool getDetectorValues(const API::SpectrumGeometry &geometry,
                          const Kernel::Unit &outputUnit, int emode,
-                         const API::MatrixWorkspace &ws, const bool signedTheta,
-                         int64_t wsIndex, double &efixed, double &l2,
-                         double &twoTheta);
+                         const bool signedTheta, int64_t wsIndex,
+                         double &efixed, double &l2, double &twoTheta);
 
   /// Convert the workspace units using TOF as an intermediate step in the
   /// conversion
@@ -10,6 +10,7 @@
 
 namespace Mantid {
 namespace API {
+class Progress;
 class Sample;
 }
 namespace Geometry {
@@ -18,6 +19,7 @@ class Instrument;
 
 namespace Algorithms {
 class DetectorGridDefinition;
+class MCAbsorptionStrategy;
 /**
   Calculates attenuation due to absorption and scattering in a sample +
   its environment using a Monte Carlo algorithm.
@@ -67,7 +69,20 @@ private:
   API::MatrixWorkspace_uptr doSimulation(
       const API::MatrixWorkspace &inputWS, const size_t nevents, int nlambda,
       const int seed, const InterpolationOption &interpolateOpt,
-      const bool useSparseInstrument, const size_t maxScatterPtAttempts);
+      const bool useSparseInstrument, const size_t maxScatterPtAttempts,
+      const bool resimulateTracks);
+  void simulate(API::MatrixWorkspace &simulationWS,
+                const MCAbsorptionStrategy &strategy,
+                const std::vector<size_t> &indices, const int nlambda,
+                const int seed, const InterpolationOption &interpolateOpt,
+                const bool interpolateWavelengths, const bool resimulateTracks,
+                API::Progress &prog);
+  void refineSparseInstrument(
+      const API::MatrixWorkspace &inputWS,
+      std::unique_ptr<const DetectorGridDefinition> &detGrid,
+      API::MatrixWorkspace_uptr &sparseWS, const MCAbsorptionStrategy &strategy,
+      const int nlambda, const int seed, const bool resimulateTracks,
+      const double tolerance);
   API::MatrixWorkspace_uptr
   createOutputWorkspace(const API::MatrixWorkspace &inputWS) const;
   std::unique_ptr<IBeamProfile>
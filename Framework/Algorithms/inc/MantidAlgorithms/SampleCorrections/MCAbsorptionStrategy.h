@@ -4,6 +4,7 @@
 #include "MantidAlgorithms/DllConfig.h"
 #include "MantidAlgorithms/SampleCorrections/MCInteractionVolume.h"
 #include <tuple>
+#include <vector>
 
 namespace Mantid {
 namespace API {
@@ -55,8 +56,17 @@ public:
                                        const Kernel::V3D &finalPos,
                                        double lambdaBefore,
                                        double lambdaAfter) const;
+  void calculate(Kernel::PseudoRandomNumberGenerator &rng,
+                 const Kernel::V3D &finalPos,
+                 const std::vector<double> &lambdasBefore,
+                 const std::vector<double> &lambdasAfter,
+                 std::vector<double> &attenuationFactors) const;
+  /// @return The error on every correction factor
+  double error() const { return m_error; }
 
 private:
+  [[noreturn]] void throwTooManyScatterAttempts() const;
+
   const IBeamProfile &m_beamProfile;
   const MCInteractionVolume m_scatterVol;
   const size_t m_nevents;
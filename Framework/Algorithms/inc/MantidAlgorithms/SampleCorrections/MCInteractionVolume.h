@@ -4,6 +4,8 @@
 #include "MantidAlgorithms/DllConfig.h"
 #include "MantidGeometry/Objects/BoundingBox.h"
 
+#include <vector>
+
 namespace Mantid {
 namespace API {
 class Sample;
@@ -11,6 +13,7 @@ class Sample;
 namespace Geometry {
 class IObject;
 class SampleEnvironment;
+class Track;
 }
 
 namespace Kernel {
@@ -48,6 +51,26 @@ class IBeamProfile;
 */
 class MANTID_ALGORITHMS_DLL MCInteractionVolume {
 public:
+  /**
+   * The distances travelled through each object of the volume by a batch of
+   * scattered neutrons, before and after scattering. There is one array per
+   * object met, holding the distance for every event, so that the attenuation
+   * at many wavelengths can be computed from contiguous arrays.
+   */
+  struct MANTID_ALGORITHMS_DLL PathLengths {
+    explicit PathLengths(const size_t nevents) : nevents(nevents) {}
+    size_t objectIndex(const Geometry::IObject *object);
+
+    /// The number of events in the batch
+    const size_t nevents;
+    /// The objects met by any of the events
+    std::vector<const Geometry::IObject *> objects;
+    /// The distances in each object before scattering, in metres
+    std::vector<std::vector<double>> before;
+    /// The distances in each object after scattering, in metres
+    std::vector<std::vector<double>> after;
+  };
+
   MCInteractionVolume(const API::Sample &sample,
                       const Geometry::BoundingBox &activeRegion,
                       const size_t maxScatterAttempts = 5000);
@@ -61,8 +84,17 @@ public:
                              const Kernel::V3D &startPos,
                              const Kernel::V3D &endPos, double lambdaBefore,
                              double lambdaAfter) const;
+  bool calculatePathLengths(Kernel::PseudoRandomNumberGenerator &rng,
+                            const Kernel::V3D &startPos,
+                            const Kernel::V3D &endPos, const size_t event,
+                            PathLengths &paths) const;
 
 private:
+  bool generateTracks(Kernel::PseudoRandomNumberGenerator &rng,
+                      const Kernel::V3D &startPos, const Kernel::V3D &endPos,
+                      Geometry::Track &beforeScatter,
+                      Geometry::Track &afterScatter) const;
+
   const boost::shared_ptr<Geometry::IObject> m_sample;
   const Geometry::SampleEnvironment *m_env;
   const Geometry::BoundingBox m_activeRegion;
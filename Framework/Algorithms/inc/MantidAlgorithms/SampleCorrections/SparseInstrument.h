@@ -72,6 +72,11 @@ interpolateFromDetectorGrid(const double lat, const double lon,
 DLLExport std::unique_ptr<const Algorithms::DetectorGridDefinition>
 createDetectorGridDefinition(const API::MatrixWorkspace &modelWS,
                              const size_t rows, const size_t columns);
+DLLExport std::pair<double, double>
+interpolationErrors(const API::MatrixWorkspace &coarseWS,
+                    const Algorithms::DetectorGridDefinition &coarseGrid,
+                    const API::MatrixWorkspace &fineWS,
+                    const Algorithms::DetectorGridDefinition &fineGrid);
 }
 }
 }
@@ -7,6 +7,10 @@
 // Two small routines used by all SofQW algorithms intended to provide united
 // user interface to all SofQ algorihtms.
 namespace Mantid {
+namespace API {
+class SpectrumGeometry;
+class SpectrumInfo;
+}
 namespace Algorithms {
 
 struct SofQCommon {
@@ -26,6 +30,10 @@ struct SofQCommon {
 
   /// Get the efixed value for the given detector
   double getEFixed(const Geometry::IDetector &det) const;
+  /// Get the efixed value for the spectrum at the given index
+  double getEFixed(const API::SpectrumGeometry &geometry,
+                   const API::SpectrumInfo &spectrumInfo,
+                   const size_t index) const;
 };
 }
 }
@@ -1,6 +1,6 @@
 #include "MantidAlgorithms/ConvertDiffCal.h"
 #include "MantidAPI/IAlgorithm.h"
-#include "MantidAPI/SpectrumInfo.h"
+#include "MantidAPI/SpectrumGeometry.h"
 #include "MantidAPI/TableRow.h"
 #include "MantidDataObjects/OffsetsWorkspace.h"
 #include "MantidDataObjects/TableWorkspace.h"
@@ -95,19 +95,19 @@ double getOffset(OffsetsWorkspace_const_sptr offsetsWS, const detid_t detid) {
 /**
  * @param offsetsWS
  * @param index
- * @param spectrumInfo
+ * @param geometry
  * @return The offset adjusted value of DIFC
  */
 double calculateDIFC(OffsetsWorkspace_const_sptr offsetsWS, const size_t index,
-                     const Mantid::API::SpectrumInfo &spectrumInfo) {
+                     const Mantid::API::SpectrumGeometry &geometry) {
   const detid_t detid = getDetID(offsetsWS, index);
   const double offset = getOffset(offsetsWS, detid);
-  // the factor returned is what is needed to convert TOF->d-spacing
-  // the table is supposed to be filled with DIFC which goes the other way
-  const double factor = Mantid::Geometry::Conversion::tofToDSpacingFactor(
-      spectrumInfo.l1(), spectrumInfo.l2(index), spectrumInfo.twoTheta(index),
-      offset);
-  return 1. / factor;
+  if (geometry.isMonitor(index))
+    throw std::logic_error(
+        "Two theta (scattering angle) is not defined for monitors.");
+  // the offset scales the TOF->d-spacing factor by (1 + offset) and thus
+  // divides DIFC, which goes the other way
+  return geometry.difc(index) / (1. + offset);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -127,11 +127,11 @@ void ConvertDiffCal::exec() {
   const size_t numberOfSpectra = offsetsWS->getNumberHistograms();
   Progress progress(this, 0.0, 1.0, numberOfSpectra);
 
-  const Mantid::API::SpectrumInfo &spectrumInfo = offsetsWS->spectrumInfo();
+  const auto geometry = offsetsWS->spectrumGeometry();
   for (size_t i = 0; i < numberOfSpectra; ++i) {
     API::TableRow newrow = configWksp->appendRow();
     newrow << static_cast<int>(getDetID(offsetsWS, i));
-    newrow << calculateDIFC(offsetsWS, i, spectrumInfo);
+    newrow << calculateDIFC(offsetsWS, i, *geometry);
     newrow << 0.; // difa
     newrow << 0.; // tzero
 
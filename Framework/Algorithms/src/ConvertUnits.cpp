@@ -3,6 +3,7 @@
 #include "MantidAPI/Axis.h"
 #include "MantidAPI/CommonBinsValidator.h"
 #include "MantidAPI/Run.h"
+#include "MantidAPI/SpectrumGeometry.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidAPI/WorkspaceUnitValidator.h"
@@ -388,10 +389,9 @@ ConvertUnits::convertQuickly(API::MatrixWorkspace_const_sptr inputWS,
 }
 
 /** Get the L2, theta and efixed values for a workspace index
-* @param spectrumInfo :: SpectrumInfo of the workspace
+* @param geometry :: SpectrumGeometry of the workspace
 * @param outputUnit :: The output unit
 * @param emode :: The energy mode
-* @param ws :: The workspace
 * @param signedTheta :: Return twotheta with sign or without
 * @param wsIndex :: The workspace index
 * @param efixed :: the returned fixed energy
@@ -399,37 +399,26 @@ ConvertUnits::convertQuickly(API::MatrixWorkspace_const_sptr inputWS,
 * @param twoTheta :: the returned two theta angle
 * @returns true if lookup successful, false on error
 */
-bool ConvertUnits::getDetectorValues(const API::SpectrumInfo &spectrumInfo,
+bool ConvertUnits::getDetectorValues(const API::SpectrumGeometry &geometry,
                                      const Kernel::Unit &outputUnit, int emode,
-                                     const MatrixWorkspace &ws,
                                      const bool signedTheta, int64_t wsIndex,
                                      double &efixed, double &l2,
                                      double &twoTheta) {
-  if (!spectrumInfo.hasDetectors(wsIndex))
+  if (!geometry.hasDetectors(wsIndex))
     return false;
 
-  l2 = spectrumInfo.l2(wsIndex);
+  l2 = geometry.l2(wsIndex);
 
-  if (!spectrumInfo.isMonitor(wsIndex)) {
+  if (!geometry.isMonitor(wsIndex)) {
     // The scattering angle for this detector (in radians).
     if (signedTheta)
-      twoTheta = spectrumInfo.signedTwoTheta(wsIndex);
+      twoTheta = geometry.signedTwoTheta(wsIndex);
     else
-      twoTheta = spectrumInfo.twoTheta(wsIndex);
-    // If an indirect instrument, try getting Efixed from the geometry
-    if (emode == 2 && efixed == EMPTY_DBL()) // indirect
-    {
-      if (spectrumInfo.hasUniqueDetector(wsIndex)) {
-        const auto &det = spectrumInfo.detector(wsIndex);
-        auto par = ws.constInstrumentParameters().getRecursive(&det, "Efixed");
-        if (par) {
-          efixed = par->value<double>();
-          g_log.debug() << "Detector: " << det.getID() << " EFixed: " << efixed
-                        << "\n";
-        }
-      }
-      // Non-unique detector (i.e., DetectorGroup): use single provided value
-    }
+      twoTheta = geometry.twoTheta(wsIndex);
+    // If an indirect instrument, try getting Efixed from the geometry. For
+    // a non-unique detector (i.e., DetectorGroup) use the single provided value
+    if (emode == 2 && efixed == EMPTY_DBL() && geometry.hasEFixed(wsIndex))
+      efixed = geometry.eFixed(wsIndex);
   } else {
     twoTheta = 0.0;
     efixed = DBL_MIN;
@@ -458,8 +447,9 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
 
   Kernel::Unit_const_sptr outputUnit = m_outputUnit;
 
-  const auto &spectrumInfo = inputWS->spectrumInfo();
-  double l1 = spectrumInfo.l1();
+  // The flat geometry is cached on the workspace and shared with its copies
+  const auto geometry = inputWS->spectrumGeometry();
+  double l1 = geometry->l1();
   g_log.debug() << "Source-sample distance: " << l1 << '\n';
 
   int failedDetectorCount = 0;
@@ -518,8 +508,8 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
   double checkl2;
   double checktwoTheta;
   size_t checkIndex = 0;
-  if (getDetectorValues(spectrumInfo, *outputUnit, emode, *inputWS, signedTheta,
-                        checkIndex, checkefixed, checkl2, checktwoTheta)) {
+  if (getDetectorValues(*geometry, *outputUnit, emode, signedTheta, checkIndex,
+                        checkefixed, checkl2, checktwoTheta)) {
     const double checkdelta = 0.0;
     // copy the X values for the check
     auto checkXValues = inputWS->readX(checkIndex);
@@ -545,8 +535,8 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
     // Now get the detector object for this histogram
     double l2;
     double twoTheta;
-    if (getDetectorValues(outSpectrumInfo, *outputUnit, emode, *outputWS,
-                          signedTheta, i, efixed, l2, twoTheta)) {
+    if (getDetectorValues(*geometry, *outputUnit, emode, signedTheta, i,
+                          efixed, l2, twoTheta)) {
 
       /// @todo Don't yet consider hold-off (delta)
       const double delta = 0.0;
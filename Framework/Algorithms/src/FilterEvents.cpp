@@ -46,6 +46,38 @@ const uint32_t UNDEFINED_SPLITTING_TARGET(0);
 namespace Mantid {
 namespace Algorithms {
 
+namespace {
+/** Splitting works on row storage. Get a spectrum of the input in row
+ * storage without converting the input itself, so that a workspace held in
+ * compact, column or mapped storage is only expanded one spectrum at a time
+ * and is left as it was.
+ * @param input :: the event list to split
+ * @param copy :: holds a row storage copy of input, if one is needed
+ * @return input, or copy if input is not in row storage
+ */
+const EventList &inRowStorage(const EventList &input, EventList &copy) {
+  if (input.getStorageMode() == ROW_STORAGE)
+    return input;
+  copy = input;
+  copy.setStorageMode(ROW_STORAGE);
+  return copy;
+}
+
+/** Put the lists a spectrum was split into in the storage of the input, so
+ * that compact or column input gives compact or column output. Only loading
+ * can map events, so the output of mapped input stays in row storage.
+ * @param outputs :: the lists the input was split into
+ * @param storageMode :: the storage of the input
+ */
+void setOutputStorageMode(const std::map<int, EventList *> &outputs,
+                          const EventStorageMode storageMode) {
+  if (storageMode == ROW_STORAGE || storageMode == MAPPED_STORAGE)
+    return;
+  for (const auto &output : outputs)
+    output.second->setStorageMode(storageMode);
+}
+} // namespace
+
 DECLARE_ALGORITHM(FilterEvents)
 
 /** Constructor
@@ -1595,7 +1627,9 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
         }
       }
       // Get a holder on input workspace's event list of this spectrum
-      const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
+      const DataObjects::EventList &input = m_eventWS->getSpectrum(iws);
+      DataObjects::EventList rowCopy;
+      const DataObjects::EventList &input_el = inRowStorage(input, rowCopy);
 
       // Perform the filtering (using the splitting function and just one
       // output)
@@ -1607,6 +1641,8 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
       } else {
         input_el.splitByFullTime(m_splitters, outputs, false, 1.0, 0.0);
       }
+
+      setOutputStorageMode(outputs, input.getStorageMode());
     }
 
     PARALLEL_END_INTERUPT_REGION
@@ -1666,7 +1702,9 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
       }
 
       // Get a holder on input workspace's event list of this spectrum
-      const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
+      const DataObjects::EventList &input = m_eventWS->getSpectrum(iws);
+      DataObjects::EventList rowCopy;
+      const DataObjects::EventList &input_el = inRowStorage(input, rowCopy);
 
       bool printdetail = false;
       if (m_useDBSpectrum)
@@ -1684,6 +1722,8 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
             m_vecSplitterTime, m_vecSplitterGroup, outputs, false, 1.0, 0.0);
       }
 
+      setOutputStorageMode(outputs, input.getStorageMode());
+
       if (printdetail)
         g_log.notice(logmessage);
     }
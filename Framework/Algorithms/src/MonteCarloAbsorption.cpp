@@ -25,6 +25,9 @@
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/VectorHelper.h"
 
+#include <algorithm>
+#include <numeric>
+
 using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::Kernel;
@@ -130,6 +133,21 @@ void MonteCarloAbsorption::init() {
       "NumberOfDetectorColumns",
       Kernel::make_unique<EnabledWhenProperty>(
           "SparseInstrument", ePropertyCriterion::IS_NOT_DEFAULT));
+  auto nonNegative = boost::make_shared<Kernel::BoundedValidator<double>>();
+  nonNegative->setLower(0.0);
+  declareProperty("InterpolationTolerance", EMPTY_DBL(), nonNegative,
+                  "If given, the detector grid of the sparse instrument is "
+                  "refined, starting from the given rows and columns, until "
+                  "the estimated relative error of the interpolation to the "
+                  "real instrument is below this value.");
+  setPropertySettings(
+      "InterpolationTolerance",
+      Kernel::make_unique<EnabledWhenProperty>(
+          "SparseInstrument", ePropertyCriterion::IS_NOT_DEFAULT));
+  declareProperty("InterpolationErrorEstimate", EMPTY_DBL(),
+                  "The estimated relative error of the interpolation from "
+                  "the refined sparse instrument.",
+                  Direction::Output);
 
   // Control the number of attempts made to generate a random point in the
   // object
@@ -141,6 +159,12 @@ void MonteCarloAbsorption::init() {
                   "If a scattering point cannot be generated by increasing "
                   "this value then there is most likely a problem with "
                   "the sample geometry.");
+  declareProperty("ResimulateTracksForDifferentWavelengths", true,
+                  "If true, new tracks are generated for every simulated "
+                  "wavelength point. If false, the tracks generated for a "
+                  "detector are reused for all of its wavelength points, "
+                  "which is much faster when many points are simulated but "
+                  "correlates the statistical errors of the points.");
 }
 
 /**
@@ -155,9 +179,12 @@ void MonteCarloAbsorption::exec() {
   interpolateOpt.set(getPropertyValue("Interpolation"));
   const bool useSparseInstrument = getProperty("SparseInstrument");
   const int maxScatterPtAttempts = getProperty("MaxScatterPtAttempts");
+  const bool resimulateTracks =
+      getProperty("ResimulateTracksForDifferentWavelengths");
   auto outputWS = doSimulation(*inputWS, static_cast<size_t>(nevents), nlambda,
                                seed, interpolateOpt, useSparseInstrument,
-                               static_cast<size_t>(maxScatterPtAttempts));
+                               static_cast<size_t>(maxScatterPtAttempts),
+                               resimulateTracks);
 
   setProperty("OutputWorkspace", std::move(outputWS));
 }
@@ -190,12 +217,15 @@ std::map<std::string, std::string> MonteCarloAbsorption::validateInputs() {
  * @param useSparseInstrument If true, use sparse instrument in simulation
  * @param maxScatterPtAttempts The maximum number of tries to generate a
  * scatter point within the object
+ * @param resimulateTracks If false, the tracks of a detector are generated
+ * once and reused for all of its wavelength points
  * @return A new workspace containing the correction factors & errors
  */
 MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
     const MatrixWorkspace &inputWS, const size_t nevents, int nlambda,
     const int seed, const InterpolationOption &interpolateOpt,
-    const bool useSparseInstrument, const size_t maxScatterPtAttempts) {
+    const bool useSparseInstrument, const size_t maxScatterPtAttempts,
+    const bool resimulateTracks) {
   auto outputWS = createOutputWorkspace(inputWS);
   const auto inputNbins = static_cast<int>(inputWS.blocksize());
   if (isEmpty(nlambda) || nlambda > inputNbins) {
@@ -224,24 +254,68 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
       static_cast<int64_t>(instrumentWS.getNumberHistograms());
   const int nbins = static_cast<int>(simulationWS.blocksize());
 
-  EFixedProvider efixed(instrumentWS);
   auto beamProfile = createBeamProfile(*instrument, inputWS.sample());
 
   // Configure progress
+  const double tolerance = getProperty("InterpolationTolerance");
+  const bool adaptive = useSparseInstrument && !isEmpty(tolerance);
   const int lambdaStepSize = nbins / nlambda;
-  Progress prog(this, 0.0, 1.0, nhists * nbins / lambdaStepSize);
+  Progress prog(this, 0.0, adaptive ? 0.5 : 1.0,
+                nhists * nbins / lambdaStepSize);
   prog.setNotifyStep(0.01);
-  const std::string reportMsg = "Computing corrections";
 
   // Configure strategy
   MCAbsorptionStrategy strategy(*beamProfile, inputWS.sample(), nevents,
                                 maxScatterPtAttempts);
 
+  std::vector<size_t> indices(static_cast<size_t>(nhists));
+  std::iota(indices.begin(), indices.end(), 0);
+  simulate(simulationWS, strategy, indices, nlambda, seed, interpolateOpt,
+           !useSparseInstrument, resimulateTracks, prog);
+
+  if (adaptive) {
+    refineSparseInstrument(inputWS, detGrid, sparseWS, strategy, nlambda, seed,
+                           resimulateTracks, tolerance);
+  }
+  if (useSparseInstrument) {
+    interpolateFromSparse(*outputWS, *sparseWS, interpolateOpt, *detGrid);
+  }
+
+  return outputWS;
+}
+
+/**
+ * Simulate the attenuation for some of the spectra of a workspace
+ * @param simulationWS The workspace to store the correction factors in
+ * @param strategy The strategy used to compute the factors
+ * @param indices Workspace indices of the spectra to simulate
+ * @param nlambda Number of wavelength points to simulate
+ * @param seed Seed value for the random number generator
+ * @param interpolateOpt Method of interpolation to compute unsimulated points
+ * @param interpolateWavelengths If true, fill in the wavelength points that
+ * were not simulated
+ * @param resimulateTracks If false, the tracks of a detector are generated
+ * once and reused for all of its wavelength points
+ * @param prog Progress reporter, reported once per simulated point
+ */
+void MonteCarloAbsorption::simulate(
+    MatrixWorkspace &simulationWS, const MCAbsorptionStrategy &strategy,
+    const std::vector<size_t> &indices, const int nlambda, const int seed,
+    const InterpolationOption &interpolateOpt,
+    const bool interpolateWavelengths, const bool resimulateTracks,
+    Progress &prog) {
+  const int nbins = static_cast<int>(simulationWS.blocksize());
+  const int lambdaStepSize = nbins / nlambda;
+  const std::string reportMsg = "Computing corrections";
+
+  EFixedProvider efixed(simulationWS);
   const auto &spectrumInfo = simulationWS.spectrumInfo();
 
+  const auto nindices = static_cast<int64_t>(indices.size());
   PARALLEL_FOR_IF(Kernel::threadSafe(simulationWS))
-  for (int64_t i = 0; i < nhists; ++i) {
+  for (int64_t n = 0; n < nindices; ++n) {
     PARALLEL_START_INTERUPT_REGION
+    const size_t i = indices[n];
 
     auto &outE = simulationWS.mutableE(i);
     // The input was cloned so clear the errors out
@@ -258,9 +332,10 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
 
     auto &outY = simulationWS.mutableY(i);
     const auto lambdas = simulationWS.points(i);
-    // Simulation for each requested wavelength point
+    // Wavelengths of each requested wavelength point
+    std::vector<int> simulatedBins;
+    std::vector<double> lambdasIn, lambdasOut;
     for (int j = 0; j < nbins; j += lambdaStepSize) {
-      prog.report(reportMsg);
       const double lambdaStep = lambdas[j];
       double lambdaIn(lambdaStep), lambdaOut(lambdaStep);
       if (efixed.emode() == DeltaEMode::Direct) {
@@ -270,17 +345,33 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
       } else {
         // elastic case already initialized
       }
-      std::tie(outY[j], std::ignore) =
-          strategy.calculate(rng, detPos, lambdaIn, lambdaOut);
+      simulatedBins.push_back(j);
+      lambdasIn.push_back(lambdaIn);
+      lambdasOut.push_back(lambdaOut);
 
       // Ensure we have the last point for the interpolation
       if (lambdaStepSize > 1 && j + lambdaStepSize >= nbins && j + 1 != nbins) {
         j = nbins - lambdaStepSize - 1;
       }
     }
+    // Simulation for each requested wavelength point
+    if (resimulateTracks) {
+      for (size_t k = 0; k < simulatedBins.size(); ++k) {
+        prog.report(reportMsg);
+        std::tie(outY[simulatedBins[k]], std::ignore) =
+            strategy.calculate(rng, detPos, lambdasIn[k], lambdasOut[k]);
+      }
+    } else {
+      std::vector<double> factors;
+      strategy.calculate(rng, detPos, lambdasIn, lambdasOut, factors);
+      for (size_t k = 0; k < simulatedBins.size(); ++k) {
+        outY[simulatedBins[k]] = factors[k];
+      }
+      prog.reportIncrement(simulatedBins.size(), reportMsg);
+    }
 
     // Interpolate through points not simulated
-    if (!useSparseInstrument && lambdaStepSize > 1) {
+    if (interpolateWavelengths && lambdaStepSize > 1) {
       auto histnew = simulationWS.histogram(i);
       if (lambdaStepSize < nbins) {
         interpolateOpt.applyInplace(histnew, lambdaStepSize);
@@ -289,18 +380,109 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
                   histnew.y()[0]);
       }
 
-      outputWS->setHistogram(i, histnew);
+      simulationWS.setHistogram(i, histnew);
     }
 
     PARALLEL_END_INTERUPT_REGION
   }
   PARALLEL_CHECK_INTERUPT_REGION
+}
 
-  if (useSparseInstrument) {
-    interpolateFromSparse(*outputWS, simulationWS, interpolateOpt, *detGrid);
+/**
+ * Refine the sparse instrument until the interpolation error is estimated to
+ * be within the given tolerance. Each pass inserts a new row between each
+ * pair of rows and/or a new column between each pair of columns and
+ * simulates only the new detectors. The values at the new detectors are
+ * compared to the values interpolated from the previous grid: rows
+ * (columns) are refined further only while the error between them exceeds
+ * the tolerance, so the refinement concentrates on the direction in which
+ * the correction varies fastest. Refinement stops early if the grid would
+ * have more detectors than the input workspace has spectra. The estimated
+ * error, that of the last but one grid and therefore an upper bound for the
+ * final one, is set as the InterpolationErrorEstimate property.
+ * @param inputWS The workspace the sparse instrument approximates
+ * @param detGrid The initial grid; replaced by the refined grid
+ * @param sparseWS The simulated sparse workspace of detGrid; replaced by the
+ * refined workspace
+ * @param strategy The strategy used to compute the factors
+ * @param nlambda Number of wavelength points to simulate
+ * @param seed Seed value for the random number generator
+ * @param resimulateTracks If false, the tracks of a detector are generated
+ * once and reused for all of its wavelength points
+ * @param tolerance The target relative interpolation error
+ */
+void MonteCarloAbsorption::refineSparseInstrument(
+    const MatrixWorkspace &inputWS,
+    std::unique_ptr<const DetectorGridDefinition> &detGrid,
+    MatrixWorkspace_uptr &sparseWS, const MCAbsorptionStrategy &strategy,
+    const int nlambda, const int seed, const bool resimulateTracks,
+    const double tolerance) {
+  double latitudeError{EMPTY_DBL()}, longitudeError{EMPTY_DBL()};
+  bool refineRows{true}, refineColumns{true};
+  double progressStart{0.5};
+  while (refineRows || refineColumns) {
+    const size_t rows = detGrid->numberRows();
+    const size_t columns = detGrid->numberColumns();
+    const size_t fineRows = refineRows ? 2 * rows - 1 : rows;
+    const size_t fineColumns = refineColumns ? 2 * columns - 1 : columns;
+    if (fineRows * fineColumns > inputWS.getNumberHistograms()) {
+      g_log.warning() << "The sparse instrument cannot be refined further "
+                         "without exceeding the size of the input workspace. "
+                         "The interpolation tolerance may not be met.\n";
+      break;
+    }
+    auto fineGrid = SparseInstrument::createDetectorGridDefinition(
+        inputWS, fineRows, fineColumns);
+    auto fineWS = SparseInstrument::createSparseWS(inputWS, *fineGrid, nlambda);
+    // Detectors shared with the coarse grid are copied, the rest simulated
+    std::vector<size_t> newIndices;
+    for (size_t col = 0; col < fineColumns; ++col) {
+      const bool newColumn = refineColumns && col % 2 == 1;
+      const size_t coarseCol = refineColumns ? col / 2 : col;
+      for (size_t row = 0; row < fineRows; ++row) {
+        const size_t fineIndex = col * fineRows + row;
+        if (newColumn || (refineRows && row % 2 == 1)) {
+          newIndices.push_back(fineIndex);
+          continue;
+        }
+        const size_t coarseRow = refineRows ? row / 2 : row;
+        const size_t coarseIndex = coarseCol * rows + coarseRow;
+        fineWS->mutableY(fineIndex) = sparseWS->y(coarseIndex);
+        fineWS->mutableE(fineIndex) = sparseWS->e(coarseIndex);
+      }
+    }
+    const double progressEnd = progressStart + 0.5 * (1.0 - progressStart);
+    Progress prog(this, progressStart, progressEnd,
+                  static_cast<int64_t>(newIndices.size() * nlambda));
+    prog.setNotifyStep(0.01);
+    simulate(*fineWS, strategy, newIndices, nlambda, seed,
+             InterpolationOption(), false, resimulateTracks, prog);
+
+    double fineLatitudeError, fineLongitudeError;
+    std::tie(fineLatitudeError, fineLongitudeError) =
+        SparseInstrument::interpolationErrors(*sparseWS, *detGrid, *fineWS,
+                                              *fineGrid);
+    if (refineRows) {
+      latitudeError = fineLatitudeError;
+    }
+    if (refineColumns) {
+      longitudeError = fineLongitudeError;
+    }
+    detGrid = std::move(fineGrid);
+    sparseWS = std::move(fineWS);
+    refineRows = refineRows && latitudeError > tolerance;
+    refineColumns = refineColumns && longitudeError > tolerance;
+    progressStart = progressEnd;
+  }
+  const double errorEstimate = std::max(latitudeError, longitudeError);
+  g_log.information() << "Sparse instrument refined to "
+                      << detGrid->numberRows() << " rows and "
+                      << detGrid->numberColumns() << " columns.\n";
+  if (!isEmpty(errorEstimate)) {
+    g_log.information() << "Estimated interpolation error: " << errorEstimate
+                        << '\n';
+    setProperty("InterpolationErrorEstimate", errorEstimate);
   }
-
-  return outputWS;
 }
 
 MatrixWorkspace_uptr MonteCarloAbsorption::createOutputWorkspace(
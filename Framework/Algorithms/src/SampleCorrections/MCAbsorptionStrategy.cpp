@@ -5,6 +5,10 @@
 
 #include "MantidAlgorithms/SampleCorrections/RectangularBeamProfile.h"
 #include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidKernel/Material.h"
+
+#include <algorithm>
+#include <cmath>
 
 namespace Mantid {
 using Kernel::PseudoRandomNumberGenerator;
@@ -59,12 +63,7 @@ MCAbsorptionStrategy::calculate(Kernel::PseudoRandomNumberGenerator &rng,
         break;
       }
       if (attempts == m_maxScatterAttempts) {
-        throw std::runtime_error("Unable to generate valid track through "
-                                 "sample interaction volume after " +
-                                 std::to_string(m_maxScatterAttempts) +
-                                 " attempts. Try increasing the maximum "
-                                 "threshold or if this does not help then "
-                                 "please check the defined shape.");
+        throwTooManyScatterAttempts();
       }
     } while (true);
   }
@@ -72,5 +71,89 @@ MCAbsorptionStrategy::calculate(Kernel::PseudoRandomNumberGenerator &rng,
   return make_tuple(factor / static_cast<double>(m_nevents), m_error);
 }
 
+/**
+ * Compute the corrections for a final position of the neutron and many pairs
+ * of wavelengths before and after scattering. The events are generated and
+ * traced through the volume once, then the attenuation of every event is
+ * evaluated at all wavelengths, so the cost of the ray tracing is shared
+ * between the wavelengths. The error on each factor is given by error().
+ * @param rng A reference to a PseudoRandomNumberGenerator
+ * @param finalPos Defines the final position of the neutron, assumed to be
+ * where it is detected
+ * @param lambdasBefore Wavelengths, in \f$\\A^-1\f$, before scattering
+ * @param lambdasAfter Wavelengths, in \f$\\A^-1\f$, after scattering. Must
+ * be the same size as lambdasBefore
+ * @param attenuationFactors Filled with the correction factor for each pair
+ * of wavelengths
+ */
+void MCAbsorptionStrategy::calculate(Kernel::PseudoRandomNumberGenerator &rng,
+                                     const Kernel::V3D &finalPos,
+                                     const std::vector<double> &lambdasBefore,
+                                     const std::vector<double> &lambdasAfter,
+                                     std::vector<double> &attenuationFactors)
+    const {
+  if (lambdasBefore.size() != lambdasAfter.size()) {
+    throw std::invalid_argument("MCAbsorptionStrategy::calculate() - The "
+                                "number of wavelengths before and after "
+                                "scattering must match.");
+  }
+  const auto scatterBounds = m_scatterVol.getBoundingBox();
+  MCInteractionVolume::PathLengths paths(m_nevents);
+  for (size_t i = 0; i < m_nevents; ++i) {
+    size_t attempts(0);
+    do {
+      const auto neutron = m_beamProfile.generatePoint(rng, scatterBounds);
+      if (m_scatterVol.calculatePathLengths(rng, neutron.startPos, finalPos,
+                                            i, paths)) {
+        break;
+      }
+      if (++attempts == m_maxScatterAttempts) {
+        throwTooManyScatterAttempts();
+      }
+    } while (true);
+  }
+
+  // The attenuation of an event is exp(-sum of mu * distance) over the
+  // objects, where mu = 100 * rho * sigma. Accumulate the exponents of all
+  // events object by object.
+  const size_t nlambda = lambdasBefore.size();
+  attenuationFactors.resize(nlambda);
+  std::vector<double> exponents(m_nevents);
+  auto addExponents = [&exponents](const double mu,
+                                   const std::vector<double> &lengths) {
+    for (size_t i = 0; i < exponents.size(); ++i) {
+      exponents[i] += mu * lengths[i];
+    }
+  };
+  for (size_t j = 0; j < nlambda; ++j) {
+    std::fill(exponents.begin(), exponents.end(), 0.0);
+    for (size_t k = 0; k < paths.objects.size(); ++k) {
+      const auto &material = paths.objects[k]->material();
+      const double rho = 100. * material.numberDensity();
+      addExponents(rho * (material.totalScatterXSection(lambdasBefore[j]) +
+                          material.absorbXSection(lambdasBefore[j])),
+                   paths.before[k]);
+      addExponents(rho * (material.totalScatterXSection(lambdasAfter[j]) +
+                          material.absorbXSection(lambdasAfter[j])),
+                   paths.after[k]);
+    }
+    double factor(0.0);
+    for (const auto exponent : exponents) {
+      factor += std::exp(-exponent);
+    }
+    attenuationFactors[j] = factor / static_cast<double>(m_nevents);
+  }
+}
+
+/// Report the failure to generate a valid track within the allowed attempts
+void MCAbsorptionStrategy::throwTooManyScatterAttempts() const {
+  throw std::runtime_error("Unable to generate valid track through "
+                           "sample interaction volume after " +
+                           std::to_string(m_maxScatterAttempts) +
+                           " attempts. Try increasing the maximum "
+                           "threshold or if this does not help then "
+                           "please check the defined shape.");
+}
+
 } // namespace Algorithms
 } // namespace Mantid
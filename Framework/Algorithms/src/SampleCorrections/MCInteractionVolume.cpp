@@ -6,6 +6,8 @@
 #include "MantidKernel/Material.h"
 #include "MantidKernel/PseudoRandomNumberGenerator.h"
 
+#include <algorithm>
+
 namespace Mantid {
 using Geometry::Track;
 using Kernel::V3D;
@@ -81,6 +83,76 @@ const Geometry::BoundingBox &MCInteractionVolume::getBoundingBox() const {
 double MCInteractionVolume::calculateAbsorption(
     Kernel::PseudoRandomNumberGenerator &rng, const Kernel::V3D &startPos,
     const Kernel::V3D &endPos, double lambdaBefore, double lambdaAfter) const {
+  Track beforeScatter, afterScatter;
+  if (!generateTracks(rng, startPos, endPos, beforeScatter, afterScatter)) {
+    return -1.0;
+  }
+
+  // Function to calculate total attenuation for a track
+  auto calculateAttenuation = [](const Track &path, double lambda) {
+    double factor(1.0);
+    for (const auto &segment : path) {
+      const double length = segment.distInsideObject;
+      const auto &segObj = *(segment.object);
+      const auto &segMat = segObj.material();
+      factor *= attenuation(segMat.numberDensity(),
+                            segMat.totalScatterXSection(lambda) +
+                                segMat.absorbXSection(lambda),
+                            length);
+    }
+    return factor;
+  };
+  return calculateAttenuation(beforeScatter, lambdaBefore) *
+         calculateAttenuation(afterScatter, lambdaAfter);
+}
+
+/**
+ * Generate a scatter point and store the distances travelled through each
+ * object on the way to it and on to the end point as one event of a batch.
+ * The random numbers are drawn as in calculateAbsorption.
+ * @param rng A reference to a PseudoRandomNumberGenerator producing
+ * random number between [0,1]
+ * @param startPos Origin of the initial track
+ * @param endPos Final position of neutron after scattering (assumed to be
+ * outside of the "volume")
+ * @param event Index of the event within the batch
+ * @param paths The batch to store the distances into
+ * @return False if the track was not valid, in which case nothing is stored
+ */
+bool MCInteractionVolume::calculatePathLengths(
+    Kernel::PseudoRandomNumberGenerator &rng, const Kernel::V3D &startPos,
+    const Kernel::V3D &endPos, const size_t event, PathLengths &paths) const {
+  Track beforeScatter, afterScatter;
+  if (!generateTracks(rng, startPos, endPos, beforeScatter, afterScatter)) {
+    return false;
+  }
+  for (const auto &segment : beforeScatter) {
+    const auto index = paths.objectIndex(segment.object);
+    paths.before[index][event] += segment.distInsideObject;
+  }
+  for (const auto &segment : afterScatter) {
+    const auto index = paths.objectIndex(segment.object);
+    paths.after[index][event] += segment.distInsideObject;
+  }
+  return true;
+}
+
+/**
+ * Generate a scatter point within the volume and trace the tracks leading to
+ * it and on to the end point.
+ * @param rng A reference to a PseudoRandomNumberGenerator producing
+ * random number between [0,1]
+ * @param startPos Origin of the initial track
+ * @param endPos Final position of neutron after scattering
+ * @param beforeScatter Filled with the track leading to the scatter point,
+ * traced backwards from it
+ * @param afterScatter Filled with the track from the scatter point
+ * @return False if the track leading to the scatter point is not valid
+ */
+bool MCInteractionVolume::generateTracks(
+    Kernel::PseudoRandomNumberGenerator &rng, const Kernel::V3D &startPos,
+    const Kernel::V3D &endPos, Track &beforeScatter,
+    Track &afterScatter) const {
   // Generate scatter point. If there is an environment present then
   // first select whether the scattering occurs on the sample or the
   // environment. The attenuation for the path leading to the scatter point
@@ -97,7 +169,7 @@ double MCInteractionVolume::calculateAbsorption(
   }
   auto toStart = startPos - scatterPos;
   toStart.normalize();
-  Track beforeScatter(scatterPos, toStart);
+  beforeScatter.reset(scatterPos, toStart);
   int nlinks = m_sample->interceptSurface(beforeScatter);
   if (m_env) {
     nlinks += m_env->interceptSurfaces(beforeScatter);
@@ -105,34 +177,36 @@ double MCInteractionVolume::calculateAbsorption(
   // This should not happen but numerical precision means that it can
   // occasionally occur with tracks that are very close to the surface
   if (nlinks == 0) {
-    return -1.0;
+    return false;
   }
 
-  // Function to calculate total attenuation for a track
-  auto calculateAttenuation = [](const Track &path, double lambda) {
-    double factor(1.0);
-    for (const auto &segment : path) {
-      const double length = segment.distInsideObject;
-      const auto &segObj = *(segment.object);
-      const auto &segMat = segObj.material();
-      factor *= attenuation(segMat.numberDensity(),
-                            segMat.totalScatterXSection(lambda) +
-                                segMat.absorbXSection(lambda),
-                            length);
-    }
-    return factor;
-  };
-
   // Now track to final destination
   V3D scatteredDirec = endPos - scatterPos;
   scatteredDirec.normalize();
-  Track afterScatter(scatterPos, scatteredDirec);
+  afterScatter.reset(scatterPos, scatteredDirec);
   m_sample->interceptSurface(afterScatter);
   if (m_env) {
     m_env->interceptSurfaces(afterScatter);
   }
-  return calculateAttenuation(beforeScatter, lambdaBefore) *
-         calculateAttenuation(afterScatter, lambdaAfter);
+  return true;
+}
+
+/**
+ * Find the arrays of an object, adding zeroed arrays if the object has not
+ * been met before.
+ * @param object An object of the volume
+ * @return The index of the object in objects, before and after
+ */
+size_t MCInteractionVolume::PathLengths::objectIndex(
+    const Geometry::IObject *object) {
+  const auto found = std::find(objects.cbegin(), objects.cend(), object);
+  if (found != objects.cend()) {
+    return static_cast<size_t>(std::distance(objects.cbegin(), found));
+  }
+  objects.push_back(object);
+  before.emplace_back(nevents, 0.0);
+  after.emplace_back(nevents, 0.0);
+  return objects.size() - 1;
 }
 
 } // namespace Algorithms
@@ -17,6 +17,9 @@
 #include <Poco/DOM/AutoPtr.h>
 #include <Poco/DOM/Document.h>
 
+#include <algorithm>
+#include <stdexcept>
+
 namespace {
 /** Check all detectors have the same EFixed value.
  *  @param eFixed An EFixedProvider object.
@@ -373,6 +376,70 @@ createDetectorGridDefinition(const API::MatrixWorkspace &modelWS,
   return Kernel::make_unique<Algorithms::DetectorGridDefinition>(
       minLat, maxLat, rows, minLong, maxLong, columns);
 }
+
+/** Estimate the error of interpolating from a detector grid by comparing
+ *  the values at the nodes of a refined grid with the values interpolated at
+ *  the same points from the coarse grid. The refined grid has either the
+ *  same number of rows or 2 * rows - 1 rows, and likewise for columns, so
+ *  that it contains all nodes of the coarse grid.
+ *  @param coarseWS A sparse workspace on the coarse grid.
+ *  @param coarseGrid The coarse grid.
+ *  @param fineWS A sparse workspace on the refined grid.
+ *  @param fineGrid The refined grid.
+ *  @return The largest relative errors at the new nodes between the rows and
+ *  between the columns of the coarse grid; nodes between both count towards
+ *  both errors.
+ *  @throw std::invalid_argument If fineGrid is not a refinement of coarseGrid
+ */
+std::pair<double, double>
+interpolationErrors(const API::MatrixWorkspace &coarseWS,
+                    const Algorithms::DetectorGridDefinition &coarseGrid,
+                    const API::MatrixWorkspace &fineWS,
+                    const Algorithms::DetectorGridDefinition &fineGrid) {
+  const auto isRefined = [](const size_t coarse, const size_t fine) {
+    if (fine != coarse && fine != 2 * coarse - 1) {
+      throw std::invalid_argument("The fine grid is not a refinement of the "
+                                  "coarse grid.");
+    }
+    return fine != coarse;
+  };
+  const bool rowsRefined =
+      isRefined(coarseGrid.numberRows(), fineGrid.numberRows());
+  const bool columnsRefined =
+      isRefined(coarseGrid.numberColumns(), fineGrid.numberColumns());
+  double latitudeError{0.0};
+  double longitudeError{0.0};
+  const auto rows = fineGrid.numberRows();
+  for (size_t col = 0; col < fineGrid.numberColumns(); ++col) {
+    const bool newColumn = columnsRefined && col % 2 == 1;
+    for (size_t row = 0; row < rows; ++row) {
+      const bool newRow = rowsRefined && row % 2 == 1;
+      if (!newRow && !newColumn) {
+        continue;
+      }
+      const double lat = fineGrid.latitudeAt(row);
+      const double lon = fineGrid.longitudeAt(col);
+      const auto indices = coarseGrid.nearestNeighbourIndices(lat, lon);
+      const auto h = interpolateFromDetectorGrid(lat, lon, coarseWS, indices);
+      const auto &interpolated = h.y();
+      const auto &simulated = fineWS.y(col * rows + row);
+      double error{0.0};
+      for (size_t i = 0; i < simulated.size(); ++i) {
+        const double diff = std::abs(interpolated[i] - simulated[i]);
+        error = std::max(error, simulated[i] != 0.0
+                                    ? diff / std::abs(simulated[i])
+                                    : diff);
+      }
+      if (newRow) {
+        latitudeError = std::max(latitudeError, error);
+      }
+      if (newColumn) {
+        longitudeError = std::max(longitudeError, error);
+      }
+    }
+  }
+  return std::make_pair(latitudeError, longitudeError);
+}
 }
 }
 }
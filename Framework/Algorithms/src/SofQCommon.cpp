@@ -2,6 +2,8 @@
 #include "MantidAPI/Algorithm.h"
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidAPI/Run.h"
+#include "MantidAPI/SpectrumGeometry.h"
+#include "MantidAPI/SpectrumInfo.h"
 
 namespace Mantid {
 namespace Algorithms {
@@ -82,5 +84,21 @@ double SofQCommon::getEFixed(const Geometry::IDetector &det) const {
   }
   return efixed;
 }
+
+/**
+ * Return the efixed for a spectrum, taking the Efixed parameter from the flat
+ * geometry table of the workspace if possible rather than from the instrument.
+ * @param geometry :: The SpectrumGeometry of the workspace
+ * @param spectrumInfo :: The SpectrumInfo of the workspace
+ * @param index :: The workspace index
+ * @return The efixed value
+ */
+double SofQCommon::getEFixed(const API::SpectrumGeometry &geometry,
+                             const API::SpectrumInfo &spectrumInfo,
+                             const size_t index) const {
+  if (m_emode == 2 && !m_efixedGiven && geometry.hasEFixed(index))
+    return geometry.eFixed(index);
+  return getEFixed(spectrumInfo.detector(index));
+}
 }
 }
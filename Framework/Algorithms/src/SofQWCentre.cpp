@@ -8,6 +8,7 @@
 #include "MantidAPI/InstrumentValidator.h"
 #include "MantidAPI/SpectraAxisValidator.h"
 #include "MantidAPI/SpectrumDetectorMapping.h"
+#include "MantidAPI/SpectrumGeometry.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidAPI/WorkspaceUnitValidator.h"
@@ -77,6 +78,7 @@ void SofQWCentre::exec() {
 
   const auto &detectorInfo = inputWorkspace->detectorInfo();
   const auto &spectrumInfo = inputWorkspace->spectrumInfo();
+  const auto geometry = inputWorkspace->spectrumGeometry();
   V3D beamDir = detectorInfo.samplePosition() - detectorInfo.sourcePosition();
   beamDir.normalize();
   double l1 = detectorInfo.l1();
@@ -93,11 +95,11 @@ void SofQWCentre::exec() {
   const size_t numBins = inputWorkspace->blocksize();
   Progress prog(this, 0.0, 1.0, numHists);
   for (int64_t i = 0; i < int64_t(numHists); ++i) {
-    if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i))
+    if (!geometry->hasDetectors(i) || geometry->isMonitor(i))
       continue;
 
-    const auto &spectrumDet = spectrumInfo.detector(i);
-    const double efixed = m_EmodeProperties.getEFixed(spectrumDet);
+    const double efixed =
+        m_EmodeProperties.getEFixed(*geometry, spectrumInfo, i);
 
     // For inelastic scattering the simple relationship q=4*pi*sinTheta/lambda
     // does not hold. In order to
@@ -3,6 +3,7 @@
 #include "MantidAPI/BinEdgeAxis.h"
 #include "MantidAPI/WorkspaceNearestNeighbourInfo.h"
 #include "MantidAPI/SpectrumDetectorMapping.h"
+#include "MantidAPI/SpectrumGeometry.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidDataObjects/FractionalRebinning.h"
@@ -107,6 +108,7 @@ void SofQWNormalisedPolygon::exec() {
 
   const auto &inputIndices = inputWS->indexInfo();
   const auto &spectrumInfo = inputWS->spectrumInfo();
+  const auto geometry = inputWS->spectrumGeometry();
 
   PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
   for (int64_t i = 0; i < static_cast<int64_t>(nHistos);
@@ -133,7 +135,8 @@ void SofQWNormalisedPolygon::exec() {
     const double phiLower = phi - phiHalfWidth;
     const double phiUpper = phi + phiHalfWidth;
 
-    const double efixed = m_EmodeProperties.getEFixed(spectrumInfo.detector(i));
+    const double efixed =
+        m_EmodeProperties.getEFixed(*geometry, spectrumInfo, i);
     const auto specNo = static_cast<specnum_t>(inputIndices.spectrumNumber(i));
     std::stringstream logStream;
     for (size_t j = 0; j < nEnergyBins; ++j) {
@@ -258,6 +261,7 @@ void SofQWNormalisedPolygon::initAngularCachesNonPSD(
   const PointingAlong upDir = inst->getReferenceFrame()->pointingUp();
 
   const auto &spectrumInfo = workspace->spectrumInfo();
+  const auto geometry = workspace->spectrumGeometry();
 
   for (size_t i = 0; i < nhist; ++i) // signed for OpenMP
   {
@@ -267,19 +271,19 @@ void SofQWNormalisedPolygon::initAngularCachesNonPSD(
     this->m_thetaWidths[i] = -1.0;
 
     // If no detector found, skip onto the next spectrum
-    if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i)) {
+    if (!geometry->hasDetectors(i) || geometry->isMonitor(i)) {
       continue;
     }
 
-    const auto &det = spectrumInfo.detector(i);
     // Check to see if there is an EFixed, if not skip it
     try {
-      m_EmodeProperties.getEFixed(det);
+      m_EmodeProperties.getEFixed(*geometry, spectrumInfo, i);
     } catch (std::runtime_error &) {
       continue;
     }
 
-    this->m_theta[i] = spectrumInfo.twoTheta(i);
+    const auto &det = spectrumInfo.detector(i);
+    this->m_theta[i] = geometry->twoTheta(i);
 
     /**
      * Determine width from shape geometry. A group is assumed to contain
@@ -3,6 +3,7 @@
 #include "MantidAlgorithms/ReplaceSpecialValues.h"
 #include "MantidAPI/SpectraAxis.h"
 #include "MantidAPI/SpectrumDetectorMapping.h"
+#include "MantidAPI/SpectrumGeometry.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidGeometry/Math/PolygonIntersection.h"
 #include "MantidGeometry/Math/Quadrilateral.h"
@@ -56,6 +57,8 @@ void SofQWPolygon::exec() {
 
   const size_t nTheta = m_thetaPts.size();
   const auto &X = inputWS->x(0);
+  const auto &spectrumInfo = inputWS->spectrumInfo();
+  const auto geometry = inputWS->spectrumGeometry();
 
   // Holds the spectrum-detector mapping
   std::vector<specnum_t> specNumberMapping;
@@ -84,12 +87,12 @@ void SofQWPolygon::exec() {
       continue;
     }
 
-    const auto &spectrumInfo = inputWS->spectrumInfo();
     const auto &det = spectrumInfo.detector(i);
     double halfWidth(0.5 * m_thetaWidth);
     const double thetaLower = theta - halfWidth;
     const double thetaUpper = theta + halfWidth;
-    const double efixed = m_EmodeProperties.getEFixed(det);
+    const double efixed =
+        m_EmodeProperties.getEFixed(*geometry, spectrumInfo, i);
 
     for (size_t j = 0; j < nenergyBins; ++j) {
       m_progress->report("Computing polygon intersections");
@@ -212,19 +215,20 @@ void SofQWPolygon::initThetaCache(const API::MatrixWorkspace &workspace) {
   double minTheta(DBL_MAX), maxTheta(-DBL_MAX);
 
   const auto &spectrumInfo = workspace.spectrumInfo();
+  const auto geometry = workspace.spectrumGeometry();
   for (int64_t i = 0; i < static_cast<int64_t>(nhist); ++i) {
     m_progress->report("Calculating detector angles");
     m_thetaPts[i] = -1.0; // Indicates a detector to skip
-    if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i))
+    if (!geometry->hasDetectors(i) || geometry->isMonitor(i))
       continue;
     // Check to see if there is an EFixed, if not skip it
     try {
-      m_EmodeProperties.getEFixed(spectrumInfo.detector(i));
+      m_EmodeProperties.getEFixed(*geometry, spectrumInfo, i);
     } catch (std::runtime_error &) {
       continue;
     }
     ++ndets;
-    const double theta = spectrumInfo.twoTheta(i);
+    const double theta = geometry->twoTheta(i);
     m_thetaPts[i] = theta;
     minTheta = std::min(minTheta, theta);
     maxTheta = std::max(maxTheta, theta);
@@ -261,6 +261,60 @@ public:
     return;
   }
 
+  //----------------------------------------------------------------------------------------------
+  /**  Filter events of an input workspace in compact storage
+   *  Event workspace: as for test_FilterNoCorrection, with its event lists
+   *  in compact storage
+   *
+   *  In this test
+   *  (1) The input is not converted back to row storage
+   *  (2) The outputs are in compact storage and hold the same events
+   */
+  void test_FilterCompactInput() {
+    int64_t runstart_i64 = 20000000000;
+    int64_t pulsedt = 100 * 1000 * 1000;
+    int64_t tofdt = 10 * 1000 * 1000;
+    size_t numpulses = 5;
+
+    EventWorkspace_sptr inpWS =
+        createEventWorkspace(runstart_i64, pulsedt, tofdt, numpulses);
+    inpWS->setEventStorageMode(COMPACT_STORAGE);
+    AnalysisDataService::Instance().addOrReplace("TestCompact", inpWS);
+
+    SplittersWorkspace_sptr splws =
+        createSplittersWorkspace(runstart_i64, pulsedt, tofdt);
+    AnalysisDataService::Instance().addOrReplace("SplitterCompact", splws);
+
+    FilterEvents filter;
+    filter.initialize();
+    filter.setProperty("InputWorkspace", "TestCompact");
+    filter.setProperty("OutputWorkspaceBaseName", "FilteredCompact");
+    filter.setProperty("SplitterWorkspace", "SplitterCompact");
+    TS_ASSERT_THROWS_NOTHING(filter.execute());
+    TS_ASSERT(filter.isExecuted());
+
+    // The input is split a spectrum at a time and is not converted
+    for (size_t i = 0; i < inpWS->getNumberHistograms(); ++i)
+      TS_ASSERT_EQUALS(inpWS->getSpectrum(i).getStorageMode(),
+                       COMPACT_STORAGE);
+
+    // Same events as test_FilterNoCorrection, in compact storage
+    EventWorkspace_sptr filteredws1 =
+        boost::dynamic_pointer_cast<EventWorkspace>(
+            AnalysisDataService::Instance().retrieve("FilteredCompact_1"));
+    TS_ASSERT(filteredws1);
+    TS_ASSERT_EQUALS(filteredws1->getSpectrum(1).getStorageMode(),
+                     COMPACT_STORAGE);
+    TS_ASSERT_EQUALS(filteredws1->getSpectrum(1).getNumberEvents(), 16);
+
+    AnalysisDataService::Instance().remove("TestCompact");
+    AnalysisDataService::Instance().remove("SplitterCompact");
+    std::vector<std::string> outputwsnames =
+        filter.getProperty("OutputWorkspaceNames");
+    for (const auto &name : outputwsnames)
+      AnalysisDataService::Instance().remove(name);
+  }
+
   //----------------------------------------------------------------------------------------------
   /**  Filter events without any correction and test for user-specified
    *workspace starting value
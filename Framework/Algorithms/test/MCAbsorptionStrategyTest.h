@@ -58,10 +58,92 @@ public:
     TS_ASSERT_DELTA(1.0 / std::sqrt(nevents), error, 1e-08);
   }
 
+  void test_Batch_Of_One_Wavelength_Matches_Single_Calculation() {
+    using Mantid::Kernel::V3D;
+    using namespace MonteCarloTesting;
+    using namespace ::testing;
+
+    auto testSampleSphere = MonteCarloTesting::createTestSample(
+        MonteCarloTesting::TestSampleType::SolidSphere);
+    MockBeamProfile testBeamProfile;
+    EXPECT_CALL(testBeamProfile, defineActiveRegion(_))
+        .WillOnce(Return(testSampleSphere.getShape().getBoundingBox()));
+    const size_t nevents(10), maxTries(100);
+    MCAbsorptionStrategy mcabsorb(testBeamProfile, testSampleSphere, nevents,
+                                  maxTries);
+    MockRNG rng;
+    EXPECT_CALL(rng, nextValue())
+        .Times(Exactly(30))
+        .WillRepeatedly(Return(0.5));
+    const Mantid::Algorithms::IBeamProfile::Ray testRay = {V3D(-2, 0, 0),
+                                                           V3D(1, 0, 0)};
+    EXPECT_CALL(testBeamProfile, generatePoint(_, _))
+        .Times(Exactly(static_cast<int>(nevents)))
+        .WillRepeatedly(Return(testRay));
+    const V3D endPos(0.7, 0.7, 1.4);
+
+    std::vector<double> factors;
+    mcabsorb.calculate(rng, endPos, {2.5}, {3.5}, factors);
+    TS_ASSERT_EQUALS(1, factors.size());
+    TS_ASSERT_DELTA(0.0043828472, factors[0], 1e-08);
+    TS_ASSERT_DELTA(1.0 / std::sqrt(nevents), mcabsorb.error(), 1e-08);
+  }
+
+  void test_Batch_Generates_Events_Once_For_All_Wavelengths() {
+    using Mantid::Kernel::V3D;
+    using namespace MonteCarloTesting;
+    using namespace ::testing;
+
+    auto testSampleSphere = MonteCarloTesting::createTestSample(
+        MonteCarloTesting::TestSampleType::SolidSphere);
+    MockBeamProfile testBeamProfile;
+    EXPECT_CALL(testBeamProfile, defineActiveRegion(_))
+        .WillOnce(Return(testSampleSphere.getShape().getBoundingBox()));
+    const size_t nevents(10), maxTries(100);
+    MCAbsorptionStrategy mcabsorb(testBeamProfile, testSampleSphere, nevents,
+                                  maxTries);
+    // Still 3 random numbers per event, whatever the number of wavelengths
+    MockRNG rng;
+    EXPECT_CALL(rng, nextValue())
+        .Times(Exactly(30))
+        .WillRepeatedly(Return(0.5));
+    const Mantid::Algorithms::IBeamProfile::Ray testRay = {V3D(-2, 0, 0),
+                                                           V3D(1, 0, 0)};
+    EXPECT_CALL(testBeamProfile, generatePoint(_, _))
+        .Times(Exactly(static_cast<int>(nevents)))
+        .WillRepeatedly(Return(testRay));
+    const V3D endPos(0.7, 0.7, 1.4);
+
+    std::vector<double> factors;
+    mcabsorb.calculate(rng, endPos, {1.0, 2.5, 5.0}, {1.0, 3.5, 5.0},
+                       factors);
+    TS_ASSERT_EQUALS(3, factors.size());
+    TS_ASSERT_DELTA(0.0043828472, factors[1], 1e-08);
+    TS_ASSERT_LESS_THAN(factors[1], factors[0]);
+    TS_ASSERT_LESS_THAN(factors[2], factors[1]);
+  }
+
   //----------------------------------------------------------------------------
   // Failure cases
   //----------------------------------------------------------------------------
 
+  void test_Batch_Requires_Matching_Wavelengths() {
+    using Mantid::Algorithms::RectangularBeamProfile;
+    using namespace Mantid::Geometry;
+    using namespace Mantid::Kernel;
+
+    auto testSampleSphere = MonteCarloTesting::createTestSample(
+        MonteCarloTesting::TestSampleType::SolidSphere);
+    RectangularBeamProfile testBeamProfile(
+        ReferenceFrame(Y, Z, Right, "source"), V3D(), 1, 1);
+    MCAbsorptionStrategy mcabs(testBeamProfile, testSampleSphere, 10, 100);
+    MersenneTwister rng(1);
+    std::vector<double> factors;
+    TS_ASSERT_THROWS(
+        mcabs.calculate(rng, V3D(0.7, 0.7, 1.4), {1.0, 2.0}, {1.0}, factors),
+        std::invalid_argument)
+  }
+
   void test_thin_object_fails_to_generate_point_in_sample() {
     using Mantid::Algorithms::RectangularBeamProfile;
     using namespace Mantid::Geometry;
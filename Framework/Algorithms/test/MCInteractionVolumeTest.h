@@ -54,6 +54,44 @@ public:
     TS_ASSERT_DELTA(0.0028357258, factor, 1e-8);
   }
 
+  void test_Path_Lengths_Give_The_Same_Absorption() {
+    using Mantid::Kernel::V3D;
+    using namespace MonteCarloTesting;
+    using namespace ::testing;
+
+    const V3D startPos(-2.0, 0.0, 0.0), endPos(2.0, 0.0, 0.0);
+    auto sample = createTestSample(TestSampleType::Annulus);
+    MCInteractionVolume interactor(sample, sample.getShape().getBoundingBox());
+    MockRNG rng;
+    // Scatter in segment 1 then in segment 2
+    EXPECT_CALL(rng, nextValue())
+        .Times(Exactly(6))
+        .WillOnce(Return(0.25))
+        .WillOnce(Return(0.25))
+        .WillOnce(Return(0.25))
+        .WillRepeatedly(Return(0.75));
+
+    MCInteractionVolume::PathLengths paths(2);
+    TS_ASSERT(interactor.calculatePathLengths(rng, startPos, endPos, 0, paths));
+    TS_ASSERT(interactor.calculatePathLengths(rng, startPos, endPos, 1, paths));
+    TS_ASSERT_EQUALS(1, paths.objects.size());
+    TS_ASSERT_EQUALS(2, paths.before[0].size());
+
+    const auto &material = sample.getShape().material();
+    const double lambdaBefore(2.5), lambdaAfter(3.5);
+    auto mu = [&material](const double lambda) {
+      return 100. * material.numberDensity() *
+             (material.totalScatterXSection(lambda) +
+              material.absorbXSection(lambda));
+    };
+    const double factorSeg1 = std::exp(-mu(lambdaBefore) * paths.before[0][0] -
+                                       mu(lambdaAfter) * paths.after[0][0]);
+    const double factorSeg2 = std::exp(-mu(lambdaBefore) * paths.before[0][1] -
+                                       mu(lambdaAfter) * paths.after[0][1]);
+    TS_ASSERT_DELTA(0.030489479, factorSeg1, 1e-8);
+    TS_ASSERT_DELTA(0.033119242, factorSeg2, 1e-8);
+  }
+
   void test_Absorption_In_Sample_With_Hole_Container_Scatter_In_All_Segments() {
     using Mantid::Kernel::V3D;
     using namespace MonteCarloTesting;
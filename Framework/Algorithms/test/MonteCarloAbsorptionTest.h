@@ -7,6 +7,7 @@
 #include "MantidAlgorithms/MonteCarloAbsorption.h"
 #include "MantidGeometry/Instrument/SampleEnvironment.h"
 #include "MantidGeometry/Objects/ShapeFactory.h"
+#include "MantidKernel/EmptyValues.h"
 #include "MantidKernel/Material.h"
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/UnitFactory.h"
@@ -121,6 +122,27 @@ public:
     TS_ASSERT_DELTA(1.2496885e-05, outputWS->y(4).back(), delta);
   }
 
+  void test_Reusing_Tracks_For_All_Wavelengths() {
+    using Mantid::Kernel::DeltaEMode;
+    TestWorkspaceDescriptor wsProps = {5, 10, Environment::SampleOnly,
+                                       DeltaEMode::Elastic, -1, -1};
+    auto mcabs = createAlgorithm();
+    mcabs->setProperty("InputWorkspace", setUpWS(wsProps));
+    mcabs->setProperty("ResimulateTracksForDifferentWavelengths", false);
+    mcabs->execute();
+    auto outputWS = getOutputWorkspace(mcabs);
+
+    verifyDimensions(wsProps, outputWS);
+    const double delta(1e-05);
+    const size_t middle_index(4);
+    // The first point sees the same events as when tracks are resimulated
+    TS_ASSERT_DELTA(0.0074366635, outputWS->y(0).front(), delta);
+    TS_ASSERT_DELTA(0.0073977126, outputWS->y(2).front(), delta);
+    // Attenuation increases with wavelength
+    TS_ASSERT_LESS_THAN(outputWS->y(0)[middle_index], outputWS->y(0).front());
+    TS_ASSERT_LESS_THAN(outputWS->y(0).back(), outputWS->y(0)[middle_index]);
+  }
+
   void test_Workspace_With_Just_Sample_For_Direct() {
     using Mantid::Kernel::DeltaEMode;
     TestWorkspaceDescriptor wsProps = {1, 10, Environment::SampleOnly,
@@ -317,6 +339,54 @@ public:
     TS_ASSERT_DELTA(9.16794e-07, outputWS->y(0).back(), delta);
   }
 
+  void test_Adaptive_Sparse_Instrument_Reports_Error_Estimate() {
+    using Mantid::Kernel::DeltaEMode;
+    TestWorkspaceDescriptor wsProps = {100, 10, Environment::SampleOnly,
+                                       DeltaEMode::Elastic, -1, -1};
+    auto inputWS = setUpWS(wsProps);
+    auto mcabs = createAlgorithm();
+    TS_ASSERT_THROWS_NOTHING(mcabs->setProperty("InputWorkspace", inputWS));
+    mcabs->setProperty("NumberOfWavelengthPoints", 5);
+    mcabs->setProperty("Interpolation", "Linear");
+    mcabs->setProperty("SparseInstrument", true);
+    mcabs->setProperty("NumberOfDetectorRows", 3);
+    mcabs->setProperty("NumberOfDetectorColumns", 2);
+    const double tolerance{1.0};
+    mcabs->setProperty("InterpolationTolerance", tolerance);
+    TS_ASSERT_THROWS_NOTHING(mcabs->execute());
+    auto outputWS = getOutputWorkspace(mcabs);
+
+    verifyDimensions(wsProps, outputWS);
+    const double estimate = mcabs->getProperty("InterpolationErrorEstimate");
+    TS_ASSERT_LESS_THAN_EQUALS(0.0, estimate)
+    TS_ASSERT_LESS_THAN_EQUALS(estimate, tolerance)
+    for (size_t i = 0; i < outputWS->getNumberHistograms(); ++i) {
+      TS_ASSERT_LESS_THAN(0.0, outputWS->y(i).front())
+      TS_ASSERT_LESS_THAN(outputWS->y(i).back(), outputWS->y(i).front())
+    }
+  }
+
+  void test_Adaptive_Sparse_Instrument_Stops_At_Input_Size() {
+    using Mantid::Kernel::DeltaEMode;
+    TestWorkspaceDescriptor wsProps = {5, 10, Environment::SampleOnly,
+                                       DeltaEMode::Elastic, -1, -1};
+    auto inputWS = setUpWS(wsProps);
+    auto mcabs = createAlgorithm();
+    TS_ASSERT_THROWS_NOTHING(mcabs->setProperty("InputWorkspace", inputWS));
+    mcabs->setProperty("NumberOfWavelengthPoints", 5);
+    mcabs->setProperty("Interpolation", "Linear");
+    mcabs->setProperty("SparseInstrument", true);
+    mcabs->setProperty("NumberOfDetectorRows", 3);
+    mcabs->setProperty("NumberOfDetectorColumns", 3);
+    mcabs->setProperty("InterpolationTolerance", 0.0);
+    TS_ASSERT_THROWS_NOTHING(mcabs->execute());
+    // No refinement is possible: the result is that of the initial grid
+    auto outputWS = getOutputWorkspace(mcabs);
+    TS_ASSERT_DELTA(0.00411903, outputWS->y(0).front(), 1e-04);
+    const double estimate = mcabs->getProperty("InterpolationErrorEstimate");
+    TS_ASSERT_EQUALS(estimate, Mantid::EMPTY_DBL())
+  }
+
 private:
   Mantid::API::MatrixWorkspace_const_sptr
   runAlgorithm(const TestWorkspaceDescriptor &wsProps, int nlambda = -1,
@@ -403,6 +473,15 @@ public:
     alg.execute();
   }
 
+  void test_exec_sample_elastic_reusing_tracks() {
+    Mantid::Algorithms::MonteCarloAbsorption alg;
+    alg.initialize();
+    alg.setProperty("InputWorkspace", inputElastic);
+    alg.setProperty("ResimulateTracksForDifferentWavelengths", false);
+    alg.setPropertyValue("OutputWorkspace", "__unused_on_child");
+    alg.execute();
+  }
+
   void test_exec_sample_direct() {
     Mantid::Algorithms::MonteCarloAbsorption alg;
     alg.initialize();
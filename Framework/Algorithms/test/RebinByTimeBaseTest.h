@@ -92,6 +92,8 @@ public:
                           Mantid::MantidVec &, Mantid::MantidVec &, bool));
   MOCK_METHOD0(clearMRU, void());
   MOCK_CONST_METHOD0(clearMRU, void());
+  MOCK_METHOD1(setSortBeforeHistogram, void(const bool));
+  MOCK_CONST_METHOD0(getSortBeforeHistogram, bool());
   MOCK_CONST_METHOD0(blocksize, std::size_t());
   MOCK_CONST_METHOD0(size, std::size_t());
   MOCK_CONST_METHOD0(getNumberHistograms, std::size_t());
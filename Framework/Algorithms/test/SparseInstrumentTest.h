@@ -279,6 +279,51 @@ public:
     TS_ASSERT_LESS_THAN(lon, grid->longitudeAt(1))
   }
 
+  void test_interpolationErrors() {
+    using namespace WorkspaceCreationHelper;
+    auto ws = create2DWorkspaceWithRectangularInstrument(1, 4, 1);
+    auto coarseGrid = createDetectorGridDefinition(*ws, 3, 3);
+    auto fineGrid = createDetectorGridDefinition(*ws, 5, 5);
+    const size_t wavelengths = 3;
+    auto coarseWS = createSparseWS(*ws, *coarseGrid, wavelengths);
+    auto fineWS = createSparseWS(*ws, *fineGrid, wavelengths);
+    for (size_t i = 0; i < coarseWS->getNumberHistograms(); ++i) {
+      coarseWS->mutableY(i) = 1.0;
+    }
+    for (size_t i = 0; i < fineWS->getNumberHistograms(); ++i) {
+      fineWS->mutableY(i) = 1.0;
+    }
+    double latError, lonError;
+    std::tie(latError, lonError) =
+        interpolationErrors(*coarseWS, *coarseGrid, *fineWS, *fineGrid);
+    TS_ASSERT_DELTA(latError, 0.0, 1e-12)
+    TS_ASSERT_DELTA(lonError, 0.0, 1e-12)
+    // A new node between two rows of the coarse grid.
+    fineWS->mutableY(1)[1] = 2.0;
+    std::tie(latError, lonError) =
+        interpolationErrors(*coarseWS, *coarseGrid, *fineWS, *fineGrid);
+    TS_ASSERT_DELTA(latError, 0.5, 1e-12)
+    TS_ASSERT_DELTA(lonError, 0.0, 1e-12)
+    // A node of the coarse grid does not count.
+    fineWS->mutableY(0)[1] = 2.0;
+    std::tie(latError, lonError) =
+        interpolationErrors(*coarseWS, *coarseGrid, *fineWS, *fineGrid);
+    TS_ASSERT_DELTA(latError, 0.5, 1e-12)
+    TS_ASSERT_DELTA(lonError, 0.0, 1e-12)
+  }
+
+  void test_interpolationErrors_throws_if_grid_is_not_refined() {
+    using namespace WorkspaceCreationHelper;
+    auto ws = create2DWorkspaceWithRectangularInstrument(1, 4, 1);
+    auto coarseGrid = createDetectorGridDefinition(*ws, 3, 3);
+    auto fineGrid = createDetectorGridDefinition(*ws, 4, 3);
+    auto coarseWS = createSparseWS(*ws, *coarseGrid, 1);
+    auto fineWS = createSparseWS(*ws, *fineGrid, 1);
+    TS_ASSERT_THROWS(
+        interpolationErrors(*coarseWS, *coarseGrid, *fineWS, *fineGrid),
+        std::invalid_argument)
+  }
+
 private:
   const Mantid::Geometry::ReferenceFrame m_goofyRefFrame;
   const Mantid::Geometry::ReferenceFrame m_standardRefFrame;
@@ -78,6 +78,24 @@ class DLLExport PlotPeakByLogValue : public API::Algorithm {
     std::vector<int> indx; ///< a list of ws indices to fit if i and spec < 0
   };
 
+  /// A single spectrum to fit
+  struct FitJob {
+    size_t input;                 ///< Index of the input in the Input list
+    std::string name;             ///< Name of the input
+    API::MatrixWorkspace_sptr ws; ///< The workspace to fit
+    int index;                    ///< Workspace index of the spectrum
+    double logValue;              ///< The value to plot the parameters against
+    std::string minimizer;        ///< The minimizer string
+    std::string outputBaseName;   ///< Base name of the output of Fit
+  };
+
+  /// The outcome of fitting a spectrum
+  struct FitResult {
+    std::vector<double> parameters; ///< Fitted parameter values
+    std::vector<double> errors;     ///< Errors of the parameters
+    double chi2 = 0.0;              ///< Chi squared over degrees of freedom
+  };
+
 public:
   /// Algorithm's name for identification overriding a virtual method
   const std::string name() const override { return "PlotPeakByLogValue"; }
@@ -99,6 +117,13 @@ private:
   /// Get a workspace
   InputData getWorkspace(const InputData &data);
 
+  /// Make the list of spectra to fit
+  std::vector<FitJob> makeJobs(const std::vector<InputData> &wsNames);
+
+  /// Fit a single spectrum
+  void fitSpectrum(const FitJob &job, API::IFunction_sptr &function,
+                   FitResult &result) const;
+
   /// Set any WorkspaceIndex attributes in the fitting function
   void setWorkspaceIndexAttribute(API::IFunction_sptr fun, int wsIndex) const;
 
@@ -7,6 +7,7 @@
 #include "MantidAPI/CompositeFunction.h"
 #include <boost/shared_array.hpp>
 #include <cmath>
+#include <memory>
 #include <vector>
 
 namespace Mantid {
@@ -115,6 +116,8 @@ public:
 
   /// Constructor
   Convolution();
+  /// Destructor
+  ~Convolution() override;
 
   /// overwrite IFunction base class methods
   std::string name() const override { return "Convolution"; }
@@ -140,19 +143,35 @@ public:
   /// Set up the function for a fit.
   void setUpForFit() override;
 
-  /// Deletes and zeroes pointer m_resolution forsing function(...) to
-  /// recalculate the resolution function
+  /// Clears m_resolution if the parameters of the resolution function have
+  /// changed, forcing function(...) to recalculate the resolution function
   void refreshResolution() const;
 
 protected:
   /// overwrite IFunction base class method, which declare function parameters
   void init() override;
+  /// The members are convolved
+  bool membersAreSummed() const override { return false; }
 
 private:
+  /// GSL workspace and wavetables for transforms of a given size
+  struct FFTWorkspace;
+  FFTWorkspace &fftWorkspace(const size_t nData) const;
+
   /// Keep the Fourier transform of the resolution function (divided by the
   /// step in xValues) when in FFT mode, and the inverted resolution if in
   /// Direct mode
   mutable std::vector<double> m_resolution;
+  /// The size, first and last x of the domain of the transform in
+  /// m_resolution. Empty if m_resolution is not a transform.
+  mutable std::vector<double> m_resolutionDomain;
+  /// The parameters of the resolution function used for m_resolution
+  mutable std::vector<double> m_resolutionParameters;
+  /// The significant values of the resolution times the step in x, centred on
+  /// x == 0, if few enough for a direct convolution to be faster than the FFT
+  mutable std::vector<double> m_resolutionKernel;
+  /// Cached FFT workspace, reused while the size of the domain is unchanged
+  mutable std::unique_ptr<FFTWorkspace> m_fftWorkspace;
 };
 
 } // namespace Functions
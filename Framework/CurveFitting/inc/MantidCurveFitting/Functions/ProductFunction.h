@@ -56,6 +56,8 @@ public:
 protected:
   /// overwrite IFunction base class method, which declare function parameters
   void init() override{};
+  /// The members are multiplied
+  bool membersAreSummed() const override { return false; }
 };
 
 } // namespace Functions
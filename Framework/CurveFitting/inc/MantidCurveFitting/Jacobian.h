@@ -88,6 +88,9 @@ public:
   }
   /// overwrite base method
   void zero() override { m_data.assign(m_data.size(), 0.0); }
+  /// Get the stored derivatives without checking the indices. The
+  /// derivatives of data point iY start at iY * (number of parameters).
+  const double *data() const { return m_data.data(); }
 };
 
 } // namespace CurveFitting
@@ -19,14 +19,18 @@
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/FunctionFactory.h"
 #include "MantidAPI/IFunction.h"
+#include "MantidAPI/MatrixWorkspace.h"
 #include "MantidAPI/CompositeFunction.h"
 #include "MantidAPI/TableRow.h"
 #include "MantidAPI/ITableWorkspace.h"
 #include "MantidAPI/BinEdgeAxis.h"
 #include "MantidAPI/Run.h"
 #include "MantidAPI/WorkspaceFactory.h"
+#include "MantidKernel/BoundedValidator.h"
+#include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 
 namespace {
 Mantid::Kernel::Logger g_log("PlotPeakByLogValue");
@@ -137,6 +141,23 @@ void PlotPeakByLogValue::init() {
       "Convolution are output convolved\n"
       "with corresponding resolution");
 
+  declareProperty("Parallel", false,
+                  "If true, the spectra are fitted on several threads. With "
+                  "the 'Sequential' FitType the spectra are split into "
+                  "blocks of ParallelBlockSize consecutive spectra: the fits "
+                  "of a block are done in turn, each starting with the "
+                  "parameters returned by the previous fit, while the blocks "
+                  "are fitted in parallel. The output is in the same order "
+                  "as without this option.");
+  auto positiveInt = boost::make_shared<BoundedValidator<int>>();
+  positiveInt->setLower(1);
+  declareProperty("ParallelBlockSize", 10, positiveInt,
+                  "The number of consecutive spectra fitted in turn by a "
+                  "thread when Parallel is true and FitType is 'Sequential'.");
+  setPropertySettings("ParallelBlockSize",
+                      make_unique<EnabledWhenProperty>(
+                          "Parallel", ePropertyCriterion::IS_NOT_DEFAULT));
+
   std::array<std::string, 2> evaluationTypes = {{"CentrePoint", "Histogram"}};
   declareProperty(
       "EvaluationType", "CentrePoint",
@@ -160,8 +181,7 @@ void PlotPeakByLogValue::exec() {
   bool individual = getPropertyValue("FitType") == "Individual";
   bool passWSIndexToFunction = getProperty("PassWSIndexToFunction");
   bool createFitOutput = getProperty("CreateOutput");
-  bool outputCompositeMembers = getProperty("OutputCompositeMembers");
-  bool outputConvolvedMembers = getProperty("ConvolveMembers");
+  const bool parallel = getProperty("Parallel");
   m_baseName = getPropertyValue("OutputWorkspace");
 
   bool isDataName = false; // if true first output column is of type string and
@@ -201,13 +221,132 @@ void PlotPeakByLogValue::exec() {
 
   setProperty("OutputWorkspace", result);
 
-  std::vector<std::string> covariance_workspaces;
-  std::vector<std::string> fit_workspaces;
-  std::vector<std::string> parameter_workspaces;
+  const std::vector<FitJob> jobs = makeJobs(wsNames);
+  std::vector<FitResult> results(jobs.size());
+  Progress prog(this, 0.0, 1.0, jobs.size());
+
+  if (!parallel) {
+    for (size_t k = 0; k < jobs.size(); ++k) {
+      if (passWSIndexToFunction) {
+        setWorkspaceIndexAttribute(ifun, jobs[k].index);
+      }
+      fitSpectrum(jobs[k], ifun, results[k]);
+      prog.report("Fitting Workspace: (" + std::to_string(jobs[k].input) +
+                  ") - ");
+      interruption_point();
+
+      if (individual) {
+        for (size_t i = 0; i < initialParams.size(); ++i) {
+          ifun->setParameter(i, initialParams[i]);
+        }
+      }
+    }
+  } else {
+    // Each block of consecutive spectra is fitted on one thread with its own
+    // copy of the function. The blocks do not depend on the number of
+    // threads, so neither do the results.
+    const int blockSizeProperty = getProperty("ParallelBlockSize");
+    const size_t blockSize =
+        individual ? 1 : static_cast<size_t>(blockSizeProperty);
+    const size_t nblocks = (jobs.size() + blockSize - 1) / blockSize;
+    std::vector<IFunction_sptr> functions(nblocks);
+    std::generate(functions.begin(), functions.end(),
+                  [&ifun]() { return ifun->clone(); });
+    const bool threadSafe =
+        std::all_of(jobs.cbegin(), jobs.cend(), [](const FitJob &job) {
+          return Kernel::threadSafe(*job.ws);
+        });
+    PARALLEL_FOR_IF(threadSafe)
+    for (int64_t b = 0; b < static_cast<int64_t>(nblocks); ++b) {
+      PARALLEL_START_INTERUPT_REGION
+      auto &function = functions[b];
+      const size_t begin = static_cast<size_t>(b) * blockSize;
+      const size_t end = std::min(begin + blockSize, jobs.size());
+      for (size_t k = begin; k < end; ++k) {
+        if (passWSIndexToFunction) {
+          setWorkspaceIndexAttribute(function, jobs[k].index);
+        }
+        fitSpectrum(jobs[k], function, results[k]);
+        prog.report("Fitting Workspace: (" + std::to_string(jobs[k].input) +
+                    ") - ");
+      }
+      PARALLEL_END_INTERUPT_REGION
+    }
+    PARALLEL_CHECK_INTERUPT_REGION
+  }
+
+  // Put the fitted parameters into the result table in the order of the input
+  for (size_t k = 0; k < jobs.size(); ++k) {
+    TableRow row = result->appendRow();
+    if (isDataName) {
+      row << jobs[k].name;
+    } else {
+      row << jobs[k].logValue;
+    }
+    const auto &fitResult = results[k];
+    for (size_t iPar = 0; iPar < fitResult.parameters.size(); ++iPar) {
+      row << fitResult.parameters[iPar] << fitResult.errors[iPar];
+    }
+    row << fitResult.chi2;
+  }
+
+  if (createFitOutput) {
+    std::vector<std::string> covariance_workspaces;
+    std::vector<std::string> fit_workspaces;
+    std::vector<std::string> parameter_workspaces;
+    covariance_workspaces.reserve(jobs.size());
+    fit_workspaces.reserve(jobs.size());
+    parameter_workspaces.reserve(jobs.size());
+    for (const auto &job : jobs) {
+      covariance_workspaces.push_back(job.outputBaseName +
+                                      "_NormalisedCovarianceMatrix");
+      parameter_workspaces.push_back(job.outputBaseName + "_Parameters");
+      fit_workspaces.push_back(job.outputBaseName + "_Workspace");
+    }
+
+    // collect output of fit for each spectrum into workspace groups
+    API::IAlgorithm_sptr groupAlg =
+        AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
+    groupAlg->initialize();
+    groupAlg->setProperty("InputWorkspaces", covariance_workspaces);
+    groupAlg->setProperty("OutputWorkspace",
+                          m_baseName + "_NormalisedCovarianceMatrices");
+    groupAlg->execute();
+
+    groupAlg = AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
+    groupAlg->initialize();
+    groupAlg->setProperty("InputWorkspaces", parameter_workspaces);
+    groupAlg->setProperty("OutputWorkspace", m_baseName + "_Parameters");
+    groupAlg->execute();
+
+    groupAlg = AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
+    groupAlg->initialize();
+    groupAlg->setProperty("InputWorkspaces", fit_workspaces);
+    groupAlg->setProperty("OutputWorkspace", m_baseName + "_Workspaces");
+    groupAlg->execute();
+  }
 
-  double dProg = 1. / static_cast<double>(wsNames.size());
-  double Prog = 0.;
-  for (int i = 0; i < static_cast<int>(wsNames.size()); ++i) {
+  for (auto &minimizerWorkspace : m_minimizerWorkspaces) {
+    const std::string paramName = minimizerWorkspace.first;
+    API::IAlgorithm_sptr groupAlg =
+        AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
+    groupAlg->initialize();
+    groupAlg->setProperty("InputWorkspaces", minimizerWorkspace.second);
+    groupAlg->setProperty("OutputWorkspace", m_baseName + "_" + paramName);
+    groupAlg->execute();
+  }
+}
+
+/** Make the list of spectra to fit, in the order of the output table.
+ * @param wsNames :: The input data.
+ * @return A FitJob for every spectrum of every input that can be accessed.
+ */
+std::vector<PlotPeakByLogValue::FitJob>
+PlotPeakByLogValue::makeJobs(const std::vector<InputData> &wsNames) {
+  const std::string logName = getProperty("LogValue");
+  const bool createFitOutput = getProperty("CreateOutput");
+  std::vector<FitJob> jobs;
+  for (size_t i = 0; i < wsNames.size(); ++i) {
     InputData data = getWorkspace(wsNames[i]);
 
     if (!data.ws) {
@@ -230,26 +369,24 @@ void PlotPeakByLogValue::exec() {
       jend = data.indx.back() + 1;
     }
 
-    if (createFitOutput) {
-      covariance_workspaces.reserve(covariance_workspaces.size() + jend);
-      fit_workspaces.reserve(fit_workspaces.size() + jend);
-      parameter_workspaces.reserve(parameter_workspaces.size() + jend);
-    }
-
-    dProg /= abs(jend - j);
     for (; j < jend; ++j) {
+      FitJob job;
+      job.input = i;
+      job.name = wsNames[i].name;
+      job.ws = data.ws;
+      job.index = j;
 
       // Find the log value: it is either a log-file value or simply the
       // workspace number
-      double logValue = 0;
+      job.logValue = 0;
       if (logName.empty()) {
         API::Axis *axis = data.ws->getAxis(1);
         if (dynamic_cast<BinEdgeAxis *>(axis)) {
           double lowerEdge((*axis)(j));
           double upperEdge((*axis)(j + 1));
-          logValue = lowerEdge + (upperEdge - lowerEdge) / 2;
+          job.logValue = lowerEdge + (upperEdge - lowerEdge) / 2;
         } else
-          logValue = (*axis)(j);
+          job.logValue = (*axis)(j);
       } else if (logName != "SourceName") {
         Kernel::Property *prop = data.ws->run().getLogData(logName);
         if (!prop) {
@@ -262,135 +399,82 @@ void PlotPeakByLogValue::exec() {
           throw std::runtime_error("Failed to cast " + logName +
                                    " to TimeSeriesProperty");
         }
-        logValue = logp->lastValue();
+        job.logValue = logp->lastValue();
       }
 
-      double chi2;
-
-      try {
-        if (passWSIndexToFunction) {
-          setWorkspaceIndexAttribute(ifun, j);
-        }
-
-        g_log.debug() << "Fitting " << data.ws->getName() << " index " << j
-                      << " with \n";
-        g_log.debug() << ifun->asString() << '\n';
-
-        const std::string spectrum_index = std::to_string(j);
-        std::string wsBaseName;
-
-        if (createFitOutput)
-          wsBaseName = wsNames[i].name + "_" + spectrum_index;
-
-        bool histogramFit = getPropertyValue("EvaluationType") == "Histogram";
-
-        // Fit the function
-        API::IAlgorithm_sptr fit =
-            AlgorithmManager::Instance().createUnmanaged("Fit");
-        fit->initialize();
-        fit->setPropertyValue("EvaluationType",
-                              getPropertyValue("EvaluationType"));
-        fit->setProperty("Function", ifun);
-        fit->setProperty("InputWorkspace", data.ws);
-        fit->setProperty("WorkspaceIndex", j);
-        fit->setPropertyValue("StartX", getPropertyValue("StartX"));
-        fit->setPropertyValue("EndX", getPropertyValue("EndX"));
-        fit->setPropertyValue(
-            "Minimizer", getMinimizerString(wsNames[i].name, spectrum_index));
-        fit->setPropertyValue("CostFunction", getPropertyValue("CostFunction"));
-        fit->setPropertyValue("MaxIterations",
-                              getPropertyValue("MaxIterations"));
-        fit->setPropertyValue("PeakRadius", getPropertyValue("PeakRadius"));
-        fit->setProperty("CalcErrors", true);
-        fit->setProperty("CreateOutput", createFitOutput);
-        if (!histogramFit) {
-          fit->setProperty("OutputCompositeMembers", outputCompositeMembers);
-          fit->setProperty("ConvolveMembers", outputConvolvedMembers);
-        }
-        fit->setProperty("Output", wsBaseName);
-        fit->execute();
-
-        if (!fit->isExecuted()) {
-          throw std::runtime_error("Fit child algorithm failed: " +
-                                   data.ws->getName());
-        }
-
-        ifun = fit->getProperty("Function");
-        chi2 = fit->getProperty("OutputChi2overDoF");
-
-        if (createFitOutput) {
-          covariance_workspaces.push_back(wsBaseName +
-                                          "_NormalisedCovarianceMatrix");
-          parameter_workspaces.push_back(wsBaseName + "_Parameters");
-          fit_workspaces.push_back(wsBaseName + "_Workspace");
-        }
-
-        g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus")
-                      << ' ' << chi2 << '\n';
-
-      } catch (...) {
-        g_log.error("Error in Fit ChildAlgorithm");
-        throw;
-      }
-
-      // Extract the fitted parameters and put them into the result table
-      TableRow row = result->appendRow();
-      if (isDataName) {
-        row << wsNames[i].name;
-      } else {
-        row << logValue;
-      }
-
-      for (size_t iPar = 0; iPar < ifun->nParams(); ++iPar) {
-        row << ifun->getParameter(iPar) << ifun->getError(iPar);
-      }
-      row << chi2;
-
-      Prog += dProg;
-      std::string current = std::to_string(i);
-      progress(Prog, ("Fitting Workspace: (" + current + ") - "));
-      interruption_point();
-
-      if (individual) {
-        for (size_t i = 0; i < initialParams.size(); ++i) {
-          ifun->setParameter(i, initialParams[i]);
-        }
-      }
-
-    } // for(;j < jend;++j)
+      const std::string spectrum_index = std::to_string(j);
+      if (createFitOutput)
+        job.outputBaseName = wsNames[i].name + "_" + spectrum_index;
+      job.minimizer = getMinimizerString(wsNames[i].name, spectrum_index);
+      jobs.push_back(std::move(job));
+    }
   }
+  return jobs;
+}
 
-  if (createFitOutput) {
-    // collect output of fit for each spectrum into workspace groups
-    API::IAlgorithm_sptr groupAlg =
-        AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
-    groupAlg->initialize();
-    groupAlg->setProperty("InputWorkspaces", covariance_workspaces);
-    groupAlg->setProperty("OutputWorkspace",
-                          m_baseName + "_NormalisedCovarianceMatrices");
-    groupAlg->execute();
+/** Fit a single spectrum. Safe to call from several threads for different
+ * functions.
+ * @param job :: The spectrum to fit.
+ * @param function :: The fitting function holding the initial values. It is
+ * set to the fitted function.
+ * @param result :: Set to the fitted parameters, their errors and chi^2.
+ */
+void PlotPeakByLogValue::fitSpectrum(const FitJob &job,
+                                     IFunction_sptr &function,
+                                     FitResult &result) const {
+  try {
+    g_log.debug() << "Fitting " << job.ws->getName() << " index " << job.index
+                  << " with \n";
+    g_log.debug() << function->asString() << '\n';
+
+    bool histogramFit = getPropertyValue("EvaluationType") == "Histogram";
+    bool createFitOutput = getProperty("CreateOutput");
+
+    // Fit the function
+    API::IAlgorithm_sptr fit =
+        AlgorithmManager::Instance().createUnmanaged("Fit");
+    fit->initialize();
+    fit->setPropertyValue("EvaluationType", getPropertyValue("EvaluationType"));
+    fit->setProperty("Function", function);
+    fit->setProperty("InputWorkspace", job.ws);
+    fit->setProperty("WorkspaceIndex", job.index);
+    fit->setPropertyValue("StartX", getPropertyValue("StartX"));
+    fit->setPropertyValue("EndX", getPropertyValue("EndX"));
+    fit->setPropertyValue("Minimizer", job.minimizer);
+    fit->setPropertyValue("CostFunction", getPropertyValue("CostFunction"));
+    fit->setPropertyValue("MaxIterations", getPropertyValue("MaxIterations"));
+    fit->setPropertyValue("PeakRadius", getPropertyValue("PeakRadius"));
+    fit->setProperty("CalcErrors", true);
+    fit->setProperty("CreateOutput", createFitOutput);
+    if (!histogramFit) {
+      fit->setPropertyValue("OutputCompositeMembers",
+                            getPropertyValue("OutputCompositeMembers"));
+      fit->setPropertyValue("ConvolveMembers",
+                            getPropertyValue("ConvolveMembers"));
+    }
+    fit->setProperty("Output", job.outputBaseName);
+    fit->execute();
 
-    groupAlg = AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
-    groupAlg->initialize();
-    groupAlg->setProperty("InputWorkspaces", parameter_workspaces);
-    groupAlg->setProperty("OutputWorkspace", m_baseName + "_Parameters");
-    groupAlg->execute();
+    if (!fit->isExecuted()) {
+      throw std::runtime_error("Fit child algorithm failed: " +
+                               job.ws->getName());
+    }
 
-    groupAlg = AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
-    groupAlg->initialize();
-    groupAlg->setProperty("InputWorkspaces", fit_workspaces);
-    groupAlg->setProperty("OutputWorkspace", m_baseName + "_Workspaces");
-    groupAlg->execute();
-  }
+    function = fit->getProperty("Function");
+    result.chi2 = fit->getProperty("OutputChi2overDoF");
+    result.parameters.resize(function->nParams());
+    result.errors.resize(function->nParams());
+    for (size_t iPar = 0; iPar < function->nParams(); ++iPar) {
+      result.parameters[iPar] = function->getParameter(iPar);
+      result.errors[iPar] = function->getError(iPar);
+    }
 
-  for (auto &minimizerWorkspace : m_minimizerWorkspaces) {
-    const std::string paramName = minimizerWorkspace.first;
-    API::IAlgorithm_sptr groupAlg =
-        AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
-    groupAlg->initialize();
-    groupAlg->setProperty("InputWorkspaces", minimizerWorkspace.second);
-    groupAlg->setProperty("OutputWorkspace", m_baseName + "_" + paramName);
-    groupAlg->execute();
+    g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus")
+                  << ' ' << result.chi2 << '\n';
+
+  } catch (...) {
+    g_log.error("Error in Fit ChildAlgorithm");
+    throw;
   }
 }
 
@@ -10,6 +10,7 @@
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/MultiThreaded.h"
 
+#include <algorithm>
 #include <sstream>
 
 namespace Mantid {
@@ -18,6 +19,8 @@ namespace CostFunctions {
 namespace {
 /// static logger
 Kernel::Logger g_log("CostFuncLeastSquares");
+/// Number of data points summed by a thread in one go
+constexpr size_t CHUNK_SIZE = 4096;
 }
 
 DECLARE_COSTFUNCTION(CostFuncLeastSquares, Least squares)
@@ -233,63 +236,86 @@ void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function,
   Jacobian jacobian(ny, np);
   function->functionDeriv(*domain, jacobian);
 
-  size_t iActiveP = 0;
-  double fVal = 0.0;
+  std::vector<size_t> activeParams;
+  for (size_t ip = 0; ip < np; ++ip) {
+    if (function->isActive(ip))
+      activeParams.push_back(ip);
+  }
+  const size_t na = activeParams.size();
   std::vector<double> weights = getFitWeights(values);
 
-  for (size_t ip = 0; ip < np; ++ip) {
-    if (!function->isActive(ip))
-      continue;
-    double d = 0.0;
-    for (size_t i = 0; i < ny; ++i) {
+  // The sums over the data are split into chunks of consecutive points which
+  // are summed on different threads. Each chunk holds the value, the
+  // derivatives and the lower triangle of the Hessian. The chunks only depend
+  // on the number of data points and are added up in order, so the result
+  // does not depend on the number of threads.
+  const size_t hessianSize = evalHessian ? na * (na + 1) / 2 : 0;
+  const size_t stride = 1 + na + hessianSize;
+  const size_t nChunks = (ny + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  std::vector<double> sums(nChunks * stride, 0.0);
+  const double *derivatives = jacobian.data();
+
+  PARALLEL_FOR_IF(nChunks > 1)
+  for (int64_t chunk = 0; chunk < static_cast<int64_t>(nChunks); ++chunk) {
+    double *chunkSums = &sums[static_cast<size_t>(chunk) * stride];
+    double *chunkDer = chunkSums + 1;
+    double *chunkHessian = chunkDer + na;
+    const size_t begin = static_cast<size_t>(chunk) * CHUNK_SIZE;
+    const size_t end = std::min(begin + CHUNK_SIZE, ny);
+    for (size_t i = begin; i < end; ++i) {
       double calc = values->getCalculated(i);
       double obs = values->getFitData(i);
       double w = weights[i];
       double y = (calc - obs) * w;
-      d += y * jacobian.get(i, ip) * w;
-      if (iActiveP == 0) {
-        fVal += y * y;
+      chunkSums[0] += y * y;
+      const double *row = derivatives + i * np;
+      for (size_t ia = 0; ia < na; ++ia) {
+        chunkDer[ia] += y * row[activeParams[ia]] * w;
+      }
+      if (!evalHessian)
+        continue;
+      size_t k = 0;
+      for (size_t i1 = 0; i1 < na; ++i1) {
+        const double d1 = row[activeParams[i1]];
+        for (size_t i2 = 0; i2 <= i1; ++i2) {
+          chunkHessian[k++] += d1 * row[activeParams[i2]] * w * w;
+        }
       }
     }
-    PARALLEL_CRITICAL(der_set) {
-      double der = m_der.get(iActiveP);
-      m_der.set(iActiveP, der + d);
+  }
+
+  std::vector<double> total(stride, 0.0);
+  for (size_t chunk = 0; chunk < nChunks; ++chunk) {
+    for (size_t k = 0; k < stride; ++k) {
+      total[k] += sums[chunk * stride + k];
+    }
+  }
+
+  PARALLEL_CRITICAL(der_set) {
+    for (size_t ia = 0; ia < na; ++ia) {
+      double der = m_der.get(ia);
+      m_der.set(ia, der + total[1 + ia]);
     }
-    ++iActiveP;
   }
 
   PARALLEL_ATOMIC
-  m_value += 0.5 * fVal;
+  m_value += 0.5 * total[0];
 
   if (!evalHessian)
     return;
 
-  size_t i1 = 0;                  // active parameter index
-  for (size_t i = 0; i < np; ++i) // over parameters
-  {
-    if (!function->isActive(i))
-      continue;
-    size_t i2 = 0;                  // active parameter index
-    for (size_t j = 0; j <= i; ++j) // over ~ half of parameters
-    {
-      if (!function->isActive(j))
-        continue;
-      double d = 0.0;
-      for (size_t k = 0; k < ny; ++k) // over fitting data
-      {
-        double w = weights[k];
-        d += jacobian.get(k, i) * jacobian.get(k, j) * w * w;
-      }
-      PARALLEL_CRITICAL(hessian_set) {
+  PARALLEL_CRITICAL(hessian_set) {
+    size_t k = 1 + na;
+    for (size_t i1 = 0; i1 < na; ++i1) {
+      for (size_t i2 = 0; i2 <= i1; ++i2) {
+        const double d = total[k++];
         double h = m_hessian.get(i1, i2);
         m_hessian.set(i1, i2, h + d);
         if (i1 != i2) {
           m_hessian.set(i2, i1, h + d);
         }
       }
-      ++i2;
     }
-    ++i1;
   }
 }
 
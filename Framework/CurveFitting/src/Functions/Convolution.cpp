@@ -7,6 +7,7 @@
 #include "MantidAPI/FunctionFactory.h"
 #include "MantidAPI/FunctionValues.h"
 #include "MantidAPI/FunctionDomain1D.h"
+#include "MantidKernel/make_unique.h"
 
 #include <cmath>
 #include <algorithm>
@@ -21,7 +22,58 @@
 
 namespace {
 const double tolerance{0.02};
+/// Values of the resolution smaller than this fraction of its maximum are
+/// left out of a direct convolution
+const double kernelCutoff{1e-15};
+/// A direct convolution is used if the number of significant values of the
+/// resolution is at most this factor times log2 of the size of the domain,
+/// which makes its cost comparable to the forward and inverse transforms
+const double directKernelFactor{4.0};
+
+/**
+ * Find the significant values of a resolution function sampled on a grid
+ * rotated such that x == 0 is at index 0 and negative x wrap around to the end.
+ * @param resolution :: The rotated resolution
+ * @param dx :: The step in x
+ * @return The significant values times dx, ordered from the most negative x to
+ * the most positive one, or an empty vector if there are too many of them for
+ * a direct convolution to pay off.
+ */
+std::vector<double> shortKernel(const std::vector<double> &resolution,
+                                const double dx) {
+  const size_t n = resolution.size();
+  double maxValue = 0.;
+  for (const auto value : resolution) {
+    maxValue = std::max(maxValue, std::abs(value));
+  }
+  if (n < 2 || maxValue == 0.) {
+    return std::vector<double>();
+  }
+  const double cutoff = kernelCutoff * maxValue;
+  // The most negative x of an even sized grid has no positive partner
+  if (n % 2 == 0 && std::abs(resolution[n / 2]) > cutoff) {
+    return std::vector<double>();
+  }
+  size_t halfWidth = 0;
+  for (size_t k = 1; k <= (n - 1) / 2; ++k) {
+    if (std::abs(resolution[k]) > cutoff ||
+        std::abs(resolution[n - k]) > cutoff) {
+      halfWidth = k;
+    }
+  }
+  const size_t width = 2 * halfWidth + 1;
+  if (static_cast<double>(width) >
+      directKernelFactor * std::log2(static_cast<double>(n))) {
+    return std::vector<double>();
+  }
+  std::vector<double> kernel(width);
+  for (size_t k = 0; k <= halfWidth; ++k) {
+    kernel[halfWidth + k] = resolution[k] * dx;
+    kernel[halfWidth - k] = resolution[(n - k) % n] * dx;
+  }
+  return kernel;
 }
+} // namespace
 
 namespace Mantid {
 namespace CurveFitting {
@@ -41,6 +93,9 @@ Convolution::Convolution() {
   setAttributeValue("NumDeriv", true);
 }
 
+/// Destructor
+Convolution::~Convolution() = default;
+
 void Convolution::init() {}
 
 void Convolution::functionDeriv(const FunctionDomain &domain,
@@ -66,21 +121,36 @@ void Convolution::setAttribute(const std::string &attName,
   CompositeFunction::setAttribute(attName, att);
 }
 
-namespace {
-// anonymous namespace for local definitions
-
 // A struct incapsulating workspaces for real fft
-struct RealFFTWorkspace {
-  explicit RealFFTWorkspace(size_t nData)
-      : workspace(gsl_fft_real_workspace_alloc(nData)),
-        wavetable(gsl_fft_real_wavetable_alloc(nData)) {}
-  ~RealFFTWorkspace() {
+struct Convolution::FFTWorkspace {
+  explicit FFTWorkspace(size_t nData)
+      : size(nData), workspace(gsl_fft_real_workspace_alloc(nData)),
+        wavetable(gsl_fft_real_wavetable_alloc(nData)),
+        inverseWavetable(gsl_fft_halfcomplex_wavetable_alloc(nData)) {}
+  ~FFTWorkspace() {
+    gsl_fft_halfcomplex_wavetable_free(inverseWavetable);
     gsl_fft_real_wavetable_free(wavetable);
     gsl_fft_real_workspace_free(workspace);
   }
+  FFTWorkspace(const FFTWorkspace &) = delete;
+  FFTWorkspace &operator=(const FFTWorkspace &) = delete;
+  const size_t size;
   gsl_fft_real_workspace *workspace;
   gsl_fft_real_wavetable *wavetable;
+  gsl_fft_halfcomplex_wavetable *inverseWavetable;
 };
+
+/**
+ * Get the FFT workspace for a domain, allocating it only if the size of the
+ * domain has changed since the last call.
+ * @param nData :: The size of the domain
+ * @return The workspace
+ */
+Convolution::FFTWorkspace &Convolution::fftWorkspace(const size_t nData) const {
+  if (!m_fftWorkspace || m_fftWorkspace->size != nData) {
+    m_fftWorkspace = Kernel::make_unique<FFTWorkspace>(nData);
+  }
+  return *m_fftWorkspace;
 }
 
 /**
@@ -129,7 +199,13 @@ void Convolution::functionFFTMode(const FunctionDomain &domain,
   size_t nData = domain.size();
   const double *xValues = d1d.getPointerAt(0);
   refreshResolution();
-  RealFFTWorkspace workspace(nData);
+  // The transform can only be reused on the same grid
+  const std::vector<double> domainKey{static_cast<double>(nData), xValues[0],
+                                      xValues[nData - 1]};
+  if (domainKey != m_resolutionDomain) {
+    m_resolution.clear();
+  }
+  FFTWorkspace &workspace = fftWorkspace(nData);
   int n2 = static_cast<int>(nData) / 2;
   bool odd = n2 * 2 != static_cast<int>(nData);
   if (m_resolution.empty()) {
@@ -157,6 +233,10 @@ void Convolution::functionFFTMode(const FunctionDomain &domain,
       throw std::runtime_error("Convolution can work only with IFunction1D");
     }
     fun->function1D(m_resolution.data(), xr.data(), nData);
+    m_resolutionParameters.resize(fun->nParams());
+    for (size_t i = 0; i < m_resolutionParameters.size(); ++i) {
+      m_resolutionParameters[i] = fun->getParameter(i);
+    }
 
     // rotate the data to produce the right transform
     if (odd) {
@@ -173,11 +253,13 @@ void Convolution::functionFFTMode(const FunctionDomain &domain,
         m_resolution[n2 + i] = tmp;
       }
     }
+    m_resolutionKernel = shortKernel(m_resolution, dx);
     gsl_fft_real_transform(m_resolution.data(), 1, nData, workspace.wavetable,
                            workspace.workspace);
     std::transform(m_resolution.begin(), m_resolution.end(),
                    m_resolution.begin(),
                    std::bind2nd(std::multiplies<double>(), dx));
+    m_resolutionDomain = domainKey;
   }
 
   // Now m_resolution contains fourier transform of the resolution
@@ -231,7 +313,23 @@ void Convolution::functionFFTMode(const FunctionDomain &domain,
   // out points to the calculated values in values
   double *out = values.getPointerToCalculated(0);
 
-  if (!deltaFunctionsOnly) {
+  if (!deltaFunctionsOnly && !m_resolutionKernel.empty()) {
+    // The resolution is short: convolve in real space. The model is wrapped
+    // around the ends of the domain as in the periodic FFT convolution.
+    getFunction(1)->function(domain, values);
+    const size_t halfWidth = m_resolutionKernel.size() / 2;
+    std::vector<double> model(nData + 2 * halfWidth);
+    std::copy(out + nData - halfWidth, out + nData, model.begin());
+    std::copy(out, out + nData, model.begin() + halfWidth);
+    std::copy(out, out + halfWidth, model.begin() + halfWidth + nData);
+    for (size_t i = 0; i < nData; ++i) {
+      double tmp{0.0};
+      for (size_t k = 0; k < m_resolutionKernel.size(); ++k) {
+        tmp += m_resolutionKernel[k] * model[i + 2 * halfWidth - k];
+      }
+      out[i] = tmp;
+    }
+  } else if (!deltaFunctionsOnly) {
     // Transform the model function
     getFunction(1)->function(domain, values);
     gsl_fft_real_transform(out, 1, nData, workspace.wavetable,
@@ -260,11 +358,8 @@ void Convolution::functionFFTMode(const FunctionDomain &domain,
     }
 
     // Inverse fourier transform of fun
-    gsl_fft_halfcomplex_wavetable *wavetable_r =
-        gsl_fft_halfcomplex_wavetable_alloc(nData);
-    gsl_fft_halfcomplex_inverse(out, 1, nData, wavetable_r,
+    gsl_fft_halfcomplex_inverse(out, 1, nData, workspace.inverseWavetable,
                                 workspace.workspace);
-    gsl_fft_halfcomplex_wavetable_free(wavetable_r);
 
     // Inverse fourier transform is integration - multiply by the step in the
     // integration variable
@@ -341,9 +436,9 @@ void Convolution::functionDirectMode(const FunctionDomain &domain,
   if (!resolution) {
     throw std::runtime_error("Convolution can work only with IFunction1D");
   }
-  if (m_resolution.empty()) {
-    m_resolution.resize(nData);
-  }
+  // m_resolution no longer holds a transform
+  m_resolutionDomain.clear();
+  m_resolution.resize(nData);
   resolution->function1D(m_resolution.data(), xValues, nData);
 
   // Reverse the axis of the resolution data
@@ -474,21 +569,22 @@ size_t Convolution::addFunction(IFunction_sptr f) {
   * Make sure that the resolution is updated if this function is reused in
  * several Fits.
   */
-void Convolution::setUpForFit() { m_resolution.clear(); }
+void Convolution::setUpForFit() {
+  m_resolution.clear();
+  m_resolutionDomain.clear();
+}
 
-/// Deletes and zeroes pointer m_resolution forsing function(...) to recalculate
-/// the resolution function
+/// Clears m_resolution if the parameters of the resolution function have
+/// changed, forcing function(...) to recalculate the resolution function
 void Convolution::refreshResolution() const {
   // refresh when calculation for the first time
   bool needRefreshing = m_resolution.empty();
   if (!needRefreshing) {
-    // if resolution has active parameters always refresh
-    IFunction &res = *getFunction(0);
-    for (size_t i = 0; i < res.nParams(); ++i) {
-      if (res.isActive(i)) {
-        needRefreshing = true;
-        break;
-      }
+    // refresh if the resolution has different parameters than the cached one
+    const IFunction &res = *getFunction(0);
+    needRefreshing = res.nParams() != m_resolutionParameters.size();
+    for (size_t i = 0; i < res.nParams() && !needRefreshing; ++i) {
+      needRefreshing = res.getParameter(i) != m_resolutionParameters[i];
     }
   }
   if (!needRefreshing)
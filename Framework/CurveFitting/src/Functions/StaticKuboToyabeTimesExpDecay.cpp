@@ -14,6 +14,19 @@ using namespace API;
 
 DECLARE_FUNCTION(StaticKuboToyabeTimesExpDecay)
 
+namespace {
+/// The function at x, for parameters of type double or DualNumber
+template <typename T>
+T kuboToyabeTimesExp(const double x, const T &A, const T &D, const T &L) {
+  using std::exp;
+  using std::pow;
+  const double C1 = 2.0 / 3;
+  const double C2 = 1.0 / 3;
+  const T DXSquared = pow(D * x, 2);
+  return A * (exp(-DXSquared / 2) * (1 - DXSquared) * C1 + C2) * exp(-L * x);
+}
+} // namespace
+
 void StaticKuboToyabeTimesExpDecay::init() {
   declareParameter("A", 0.2, "Amplitude at time 0");
   declareParameter("Delta", 0.2, "StaticKuboToyabe decay rate");
@@ -27,17 +40,20 @@ void StaticKuboToyabeTimesExpDecay::function1D(double *out,
   const double D = getParameter("Delta");
   const double L = getParameter("Lambda");
 
-  const double C1 = 2.0 / 3;
-  const double C2 = 1.0 / 3;
-
   for (size_t i = 0; i < nData; i++) {
-    double x = xValues[i];
-    double DXSquared = pow(D * x, 2);
-    out[i] =
-        A * (exp(-DXSquared / 2) * (1 - DXSquared) * C1 + C2) * exp(-L * x);
+    out[i] = kuboToyabeTimesExp(xValues[i], A, D, L);
   }
 }
 
+void StaticKuboToyabeTimesExpDecay::functionDeriv1D(Jacobian *out,
+                                                    const double *xValues,
+                                                    const size_t nData) {
+  functionDerivAutoDiff<3>(out, xValues, nData,
+                           [](const double x, const auto &p) {
+                             return kuboToyabeTimesExp(x, p[0], p[1], p[2]);
+                           });
+}
+
 } // namespace Functions
 } // namespace CurveFitting
 } // namespace Mantid
@@ -14,6 +14,20 @@ using namespace API;
 
 DECLARE_FUNCTION(StaticKuboToyabeTimesGausDecay)
 
+namespace {
+/// The function at x for precalculated squares of Delta and Sigma, for
+/// parameters of type double or DualNumber
+template <typename T>
+T kuboToyabeTimesGaus(const double x, const T &A, const T &D2, const T &S2) {
+  using std::exp;
+  using std::pow;
+  const double C1 = 2.0 / 3;
+  const double C2 = 1.0 / 3;
+  const double x2 = pow(x, 2);
+  return A * (exp(-(x2 * D2) / 2) * (1 - x2 * D2) * C1 + C2) * exp(-S2 * x2);
+}
+} // namespace
+
 void StaticKuboToyabeTimesGausDecay::init() {
   declareParameter("A", 1.0, "Amplitude at time 0");
   declareParameter("Delta", 0.2, "StaticKuboToyabe decay rate");
@@ -31,16 +45,20 @@ void StaticKuboToyabeTimesGausDecay::function1D(double *out,
   const double D2 = pow(D, 2);
   const double S2 = pow(S, 2);
 
-  // Precalculate constants
-  const double C1 = 2.0 / 3;
-  const double C2 = 1.0 / 3;
-
   for (size_t i = 0; i < nData; i++) {
-    double x2 = pow(xValues[i], 2);
-    out[i] =
-        A * (exp(-(x2 * D2) / 2) * (1 - x2 * D2) * C1 + C2) * exp(-S2 * x2);
+    out[i] = kuboToyabeTimesGaus(xValues[i], A, D2, S2);
   }
 }
+
+void StaticKuboToyabeTimesGausDecay::functionDeriv1D(Jacobian *out,
+                                                     const double *xValues,
+                                                     const size_t nData) {
+  functionDerivAutoDiff<3>(out, xValues, nData,
+                           [](const double x, const auto &p) {
+                             return kuboToyabeTimesGaus(x, p[0], p[1] * p[1],
+                                                        p[2] * p[2]);
+                           });
+}
 } // namespace Functions
 } // namespace CurveFitting
 } // namespace Mantid
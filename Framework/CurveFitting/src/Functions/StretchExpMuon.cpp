@@ -17,6 +17,16 @@ using namespace API;
 
 DECLARE_FUNCTION(StretchExpMuon)
 
+namespace {
+/// The function at x, for parameters of type double or DualNumber
+template <typename T>
+T stretchExp(const double x, const T &A, const T &G, const T &b) {
+  using std::exp;
+  using std::pow;
+  return A * exp(-pow(G * x, b));
+}
+} // namespace
+
 void StretchExpMuon::init() {
   declareParameter("A", 0.2, "Amplitude (height at origin)");
   declareParameter("Lambda", 0.2, "Decay rate of the standard exponential");
@@ -31,10 +41,18 @@ void StretchExpMuon::function1D(double *out, const double *xValues,
   const double b = getParameter("Beta");
 
   for (size_t i = 0; i < nData; i++) {
-    out[i] = A * exp(-pow(G * xValues[i], b));
+    out[i] = stretchExp(xValues[i], A, G, b);
   }
 }
 
+void StretchExpMuon::functionDeriv1D(Jacobian *out, const double *xValues,
+                                     const size_t nData) {
+  functionDerivAutoDiff<3>(out, xValues, nData,
+                           [](const double x, const auto &p) {
+                             return stretchExp(x, p[0], p[1], p[2]);
+                           });
+}
+
 } // namespace Functions
 } // namespace CurveFitting
 } // namespace Mantid
@@ -220,6 +220,66 @@ public:
     WorkspaceCreationHelper::removeWS("PlotPeakResult");
   }
 
+  void test_parallel_fit_keeps_the_order_of_the_input() {
+    createData();
+
+    for (const std::string fitType : {"Individual", "Sequential"}) {
+      PlotPeakByLogValue alg;
+      alg.initialize();
+      alg.setPropertyValue("Input", "PlotPeakGroup_2;PlotPeakGroup_0;"
+                                    "PlotPeakGroup_1");
+      alg.setPropertyValue("OutputWorkspace", "PlotPeakResult");
+      alg.setPropertyValue("WorkspaceIndex", "1");
+      alg.setPropertyValue("LogValue", "var");
+      alg.setPropertyValue("FitType", fitType);
+      alg.setProperty("Parallel", true);
+      alg.setProperty("ParallelBlockSize", 2);
+      alg.setPropertyValue("Function", "name=LinearBackground,A0=1,A1=0.3;"
+                                       "name=Gaussian,PeakCentre=5,Height=2,"
+                                       "Sigma=0.1");
+      TS_ASSERT_THROWS_NOTHING(alg.execute());
+      TS_ASSERT(alg.isExecuted());
+
+      TWS_type result =
+          WorkspaceCreationHelper::getWS<TableWorkspace>("PlotPeakResult");
+      TS_ASSERT_EQUALS(result->rowCount(), 3);
+      TS_ASSERT_EQUALS(result->columnCount(), 12);
+
+      TS_ASSERT_DELTA(result->Double(0, 0), 1.6, 1e-10);
+      TS_ASSERT_DELTA(result->Double(0, 1), 1.2, 1e-10);
+      TS_ASSERT_DELTA(result->Double(0, 5), 1.6, 1e-10);
+      TS_ASSERT_DELTA(result->Double(0, 7), 5.06, 1e-10);
+
+      TS_ASSERT_DELTA(result->Double(1, 0), 1, 1e-10);
+      TS_ASSERT_DELTA(result->Double(1, 1), 1, 1e-10);
+      TS_ASSERT_DELTA(result->Double(1, 5), 2, 1e-10);
+      TS_ASSERT_DELTA(result->Double(1, 7), 5, 1e-10);
+
+      TS_ASSERT_DELTA(result->Double(2, 0), 1.3, 1e-10);
+      TS_ASSERT_DELTA(result->Double(2, 1), 1.1, 1e-10);
+      TS_ASSERT_DELTA(result->Double(2, 5), 1.8, 1e-10);
+      TS_ASSERT_DELTA(result->Double(2, 7), 5.03, 1e-10);
+
+      WorkspaceCreationHelper::removeWS("PlotPeakResult");
+    }
+    deleteData();
+  }
+
+  void test_parallel_fit_matches_serial_fit() {
+    auto ws = createManySpectraWorkspace(16);
+    AnalysisDataService::Instance().addOrReplace("PlotPeakManySpectra", ws);
+    const auto serial = runManySpectraFit(false);
+    const auto parallel = runManySpectraFit(true);
+    TS_ASSERT_EQUALS(serial->rowCount(), 16);
+    TS_ASSERT_EQUALS(parallel->rowCount(), 16);
+    for (size_t row = 0; row < serial->rowCount(); ++row) {
+      for (size_t col = 0; col < serial->columnCount(); ++col) {
+        TS_ASSERT_EQUALS(serial->Double(row, col), parallel->Double(row, col));
+      }
+    }
+    AnalysisDataService::Instance().clear();
+  }
+
   void testWorkspaceList_plotting_against_ws_names() {
     createData();
 
@@ -676,6 +736,39 @@ private:
     return testWS;
   }
 
+  /// Gaussians on a flat background with the centre moving with the index
+  MatrixWorkspace_sptr createManySpectraWorkspace(const int nspectra) {
+    auto ws = WorkspaceFactory::Instance().create("Workspace2D", nspectra,
+                                                  200, 200);
+    for (int i = 0; i < nspectra; ++i) {
+      ws->setPoints(i, 200, LinearGenerator(0.0, 0.05));
+      const double centre = 4.0 + 0.1 * i;
+      auto &y = ws->mutableY(i);
+      const auto &x = ws->x(i);
+      for (size_t j = 0; j < y.size(); ++j) {
+        y[j] = 0.5 +
+               3.0 * exp(-0.5 * (x[j] - centre) * (x[j] - centre) / 0.04);
+      }
+    }
+    return ws;
+  }
+
+  ITableWorkspace_sptr runManySpectraFit(const bool parallel) {
+    PlotPeakByLogValue alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setPropertyValue("Input", "PlotPeakManySpectra,v1:16");
+    alg.setPropertyValue("OutputWorkspace", "unused");
+    alg.setPropertyValue("FitType", "Individual");
+    alg.setProperty("Parallel", parallel);
+    alg.setPropertyValue("Function", "name=FlatBackground,A0=0.4;"
+                                     "name=Gaussian,PeakCentre=4.5,Height=2,"
+                                     "Sigma=0.3");
+    alg.execute();
+    TS_ASSERT(alg.isExecuted());
+    return alg.getProperty("OutputWorkspace");
+  }
+
   void deleteData() {
     FrameworkManager::Instance().deleteWorkspace(m_wsg->getName());
     m_wsg.reset();
@@ -15,6 +15,7 @@
 #include "MantidCurveFitting/Functions/Gaussian.h"
 #include "MantidCurveFitting/Functions/UserFunction.h"
 #include "MantidCurveFitting/Functions/ExpDecay.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 #include <gsl/gsl_blas.h>
 #include <sstream>
@@ -267,6 +268,66 @@ public:
     TS_ASSERT_EQUALS(s.getError(), "success");
   }
 
+  void test_valDerivHessian_on_a_large_domain() {
+    // More points than are summed by a single thread
+    const size_t ny = 10001;
+    API::FunctionDomain1D_sptr domain(
+        new API::FunctionDomain1DVector(-5.0, 5.0, ny));
+    API::FunctionValues_sptr values(new API::FunctionValues(*domain));
+    std::vector<double> y(ny), w(ny);
+    for (size_t i = 0; i < ny; ++i) {
+      const double x = (*domain)[i];
+      y[i] = 1.0 + 3.0 * exp(-0.5 * x * x);
+      w[i] = 1.0 + 0.5 * static_cast<double>(i % 3);
+    }
+    values->setFitData(y);
+    values->setFitWeights(w);
+
+    auto fun = boost::make_shared<Gaussian>();
+    fun->initialize();
+    fun->setParameter("PeakCentre", 0.1);
+    fun->setParameter("Height", 2.5);
+    fun->setParameter("Sigma", 1.2);
+    fun->fix(1);
+
+    boost::shared_ptr<CostFuncLeastSquares> costFun =
+        boost::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(fun, domain, values);
+    TS_ASSERT_EQUALS(costFun->nParams(), 2);
+
+    // Sum up directly
+    API::FunctionValues calculated(*domain);
+    fun->function(*domain, calculated);
+    CurveFitting::Jacobian jacobian(ny, 3);
+    fun->functionDeriv(*domain, jacobian);
+    const size_t active[] = {0, 2};
+    double value = 0.0;
+    std::vector<double> der(2, 0.0);
+    std::vector<double> hessian(4, 0.0);
+    for (size_t i = 0; i < ny; ++i) {
+      const double r = (calculated.getCalculated(i) - y[i]) * w[i];
+      value += 0.5 * r * r;
+      for (size_t k = 0; k < 2; ++k) {
+        der[k] += r * w[i] * jacobian.get(i, active[k]);
+        for (size_t l = 0; l < 2; ++l) {
+          hessian[2 * k + l] += w[i] * w[i] * jacobian.get(i, active[k]) *
+                                jacobian.get(i, active[l]);
+        }
+      }
+    }
+
+    TS_ASSERT_DELTA(costFun->valDerivHessian(), value, 1e-8 * value);
+    const GSLVector &g = costFun->getDeriv();
+    const GSLMatrix &H = costFun->getHessian();
+    for (size_t k = 0; k < 2; ++k) {
+      TS_ASSERT_DELTA(g.get(k), der[k], 1e-8 * std::abs(der[k]));
+      for (size_t l = 0; l < 2; ++l) {
+        TS_ASSERT_DELTA(H.get(k, l), hessian[2 * k + l],
+                        1e-8 * std::abs(hessian[2 * k + l]));
+      }
+    }
+  }
+
   void testDerivatives() {
     API::FunctionDomain1D_sptr domain(
         new API::FunctionDomain1DVector(79300., 79600., 41));
@@ -394,6 +394,105 @@ public:
     }
   }
 
+  void test_short_resolution_is_convolved_directly() {
+    // The resolution spans few enough points to be convolved in real space
+    const double pi = acos(0.) * 2;
+    const double s1 = 500.;
+    const double s2 = 4.;
+    const double c2 = 0.3;
+    auto res = boost::make_shared<ConvolutionTest_Gauss>();
+    res->setParameter("s", s1);
+    auto fun = boost::make_shared<ConvolutionTest_Gauss>();
+    fun->setParameter("c", c2);
+    fun->setParameter("s", s2);
+    Convolution conv;
+    conv.addFunction(res);
+    conv.addFunction(fun);
+
+    for (const size_t N : {300, 301}) {
+      std::vector<double> x(N);
+      for (size_t i = 0; i < N; i++) {
+        x[i] = -3. + 0.02 * static_cast<double>(i);
+      }
+      FunctionDomain1DView xView(x.data(), N);
+      FunctionValues out(xView);
+      conv.function(xView, out);
+
+      const double sp = s1 * s2 / (s1 + s2);
+      const double hp = sqrt(pi / (s1 + s2));
+      for (size_t i = 0; i < N; i++) {
+        const double xi = x[i] - c2;
+        TS_ASSERT_DELTA(out.getCalculated(i), hp * exp(-sp * xi * xi), 1e-10);
+      }
+    }
+  }
+
+  void test_resolution_is_recalculated_when_its_parameters_change() {
+    auto res = boost::make_shared<ConvolutionTest_Gauss>();
+    res->setParameter("s", 1.3);
+    auto fun = boost::make_shared<ConvolutionTest_Gauss>();
+    fun->setParameter("c", 1.);
+    Convolution conv;
+    conv.addFunction(res);
+    conv.addFunction(fun);
+
+    std::vector<double> x(101);
+    for (size_t i = 0; i < x.size(); i++) {
+      x[i] = -5. + 0.1 * static_cast<double>(i);
+    }
+    FunctionDomain1DView xView(x.data(), x.size());
+    FunctionValues out(xView);
+    conv.function(xView, out);
+    // The resolution is fixed but its width is changed by hand
+    res->setParameter("s", 2.6);
+    conv.function(xView, out);
+
+    auto res2 = boost::make_shared<ConvolutionTest_Gauss>();
+    res2->setParameter("s", 2.6);
+    Convolution expected;
+    expected.addFunction(res2);
+    expected.addFunction(fun);
+    FunctionValues expectedOut(xView);
+    expected.function(xView, expectedOut);
+    for (size_t i = 0; i < x.size(); i++) {
+      TS_ASSERT_EQUALS(out.getCalculated(i), expectedOut.getCalculated(i));
+    }
+  }
+
+  void test_resolution_is_recalculated_for_a_new_domain() {
+    auto res = boost::make_shared<ConvolutionTest_Gauss>();
+    res->setParameter("s", 1.3);
+    auto fun = boost::make_shared<ConvolutionTest_Gauss>();
+    fun->setParameter("c", 1.);
+    Convolution conv;
+    conv.addFunction(res);
+    conv.addFunction(fun);
+
+    std::vector<double> x1(101);
+    std::vector<double> x2(80);
+    for (size_t i = 0; i < x1.size(); i++) {
+      x1[i] = -5. + 0.1 * static_cast<double>(i);
+    }
+    for (size_t i = 0; i < x2.size(); i++) {
+      x2[i] = -6. + 0.15 * static_cast<double>(i);
+    }
+    FunctionDomain1DView xView1(x1.data(), x1.size());
+    FunctionDomain1DView xView2(x2.data(), x2.size());
+    FunctionValues out1(xView1);
+    FunctionValues out2(xView2);
+    conv.function(xView1, out1);
+    conv.function(xView2, out2);
+
+    Convolution expected;
+    expected.addFunction(res);
+    expected.addFunction(fun);
+    FunctionValues expectedOut(xView2);
+    expected.function(xView2, expectedOut);
+    for (size_t i = 0; i < x2.size(); i++) {
+      TS_ASSERT_EQUALS(out2.getCalculated(i), expectedOut.getCalculated(i));
+    }
+  }
+
   void testForCategories() {
     Convolution forCat;
     const std::vector<std::string> categories = forCat.categories();
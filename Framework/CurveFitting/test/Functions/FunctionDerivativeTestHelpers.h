@@ -0,0 +1,44 @@
+#ifndef FUNCTIONDERIVATIVETESTHELPERS_H_
+#define FUNCTIONDERIVATIVETESTHELPERS_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/IFunction.h"
+#include "MantidCurveFitting/Jacobian.h"
+
+namespace FunctionDerivativeTestHelpers {
+
+/**
+ * Check the derivatives given by functionDeriv against central differences
+ * of function, on ten points in [0, 2], for each parameter.
+ * @param fn :: an initialised function with its parameters set
+ * @param tolerance :: the largest difference allowed
+ */
+static void checkDerivativesMatchFiniteDifferences(
+    Mantid::API::IFunction &fn, const double tolerance = 1e-7) {
+  Mantid::API::FunctionDomain1DVector x(0, 2, 10);
+  Mantid::CurveFitting::Jacobian jacobian(x.size(), fn.nParams());
+  TS_ASSERT_THROWS_NOTHING(fn.functionDeriv(x, jacobian));
+
+  const double h = 1e-6;
+  Mantid::API::FunctionValues plus(x);
+  Mantid::API::FunctionValues minus(x);
+  for (size_t ip = 0; ip < fn.nParams(); ++ip) {
+    const double p = fn.getParameter(ip);
+    fn.setParameter(ip, p + h);
+    fn.function(x, plus);
+    fn.setParameter(ip, p - h);
+    fn.function(x, minus);
+    fn.setParameter(ip, p);
+    for (size_t i = 0; i < x.size(); ++i) {
+      TS_ASSERT_DELTA(jacobian.get(i, ip), (plus[i] - minus[i]) / (2 * h),
+                      tolerance);
+    }
+  }
+}
+
+} // namespace FunctionDerivativeTestHelpers
+
+#endif /* FUNCTIONDERIVATIVETESTHELPERS_H_ */
@@ -3,6 +3,8 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "FunctionDerivativeTestHelpers.h"
+
 #include "MantidCurveFitting/Functions/StaticKuboToyabeTimesExpDecay.h"
 
 using Mantid::CurveFitting::Functions::StaticKuboToyabeTimesExpDecay;
@@ -63,6 +65,16 @@ public:
     TS_ASSERT_DELTA(y[9], 0.0234, 1e-4);
   }
 
+  void test_derivatives_match_finite_differences() {
+    StaticKuboToyabeTimesExpDecay fn;
+    fn.initialize();
+    fn.setParameter("A", 0.45);
+    fn.setParameter("Delta", 1.05);
+    fn.setParameter("Lambda", 0.23);
+
+    FunctionDerivativeTestHelpers::checkDerivativesMatchFiniteDifferences(fn);
+  }
+
   StaticKuboToyabeTimesExpDecay fn;
 };
 
@@ -3,6 +3,8 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "FunctionDerivativeTestHelpers.h"
+
 #include "MantidCurveFitting/Functions/StaticKuboToyabeTimesGausDecay.h"
 
 using Mantid::CurveFitting::Functions::StaticKuboToyabeTimesGausDecay;
@@ -61,6 +63,14 @@ public:
     TS_ASSERT_DELTA(y[9], 0.0317, 1e-4);
   }
 
+  void test_derivatives_match_finite_differences() {
+    fn.setParameter("A", 0.45);
+    fn.setParameter("Delta", 1.05);
+    fn.setParameter("Sigma", 0.2);
+
+    FunctionDerivativeTestHelpers::checkDerivativesMatchFiniteDifferences(fn);
+  }
+
   StaticKuboToyabeTimesGausDecay fn;
 };
 
@@ -3,6 +3,8 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "FunctionDerivativeTestHelpers.h"
+
 #include "MantidCurveFitting/Functions/StretchExpMuon.h"
 
 using namespace Mantid::CurveFitting::Functions;
@@ -40,6 +42,16 @@ public:
     TS_ASSERT_DELTA(y[8], 0.1214, 1e-4);
     TS_ASSERT_DELTA(y[9], 0.1068, 1e-4);
   }
+
+  void test_derivatives_match_finite_differences() {
+    StretchExpMuon fn;
+    fn.initialize();
+    fn.setParameter("A", 1.00);
+    fn.setParameter("Lambda", 2.5);
+    fn.setParameter("Beta", 0.50);
+
+    FunctionDerivativeTestHelpers::checkDerivativesMatchFiniteDifferences(fn);
+  }
 };
 
 #endif /*STRETCHEXPTEST_H_*/
@@ -0,0 +1,116 @@
+#ifndef MANTID_DATAHANDLING_BANKLOADPIPELINE_H_
+#define MANTID_DATAHANDLING_BANKLOADPIPELINE_H_
+
+#include "MantidDataHandling/DllConfig.h"
+#include "MantidKernel/Task.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace DataHandling {
+
+/** BankLoadPipeline : Runs the loading of event banks as a two stage
+  producer/consumer pipeline.
+
+  The read stage runs the tasks given to addReadTask(), largest first, on a
+  single thread: HDF5 serialises access to the file and decompresses the data
+  inside the read call, so reading and decompression form one stage. Each read
+  task hands the work needed to put its events into the workspace to
+  pushProcessTasks(). Those tasks are queued and run by the process stage
+  threads while the next banks are read. The stages run on the threads of a
+  Kernel::ThreadPool.
+
+  The queue holds at most a fixed number of banks. When it is full the reader
+  waits, which bounds the memory held by banks that are read but not yet
+  processed; when it is empty the processing threads wait. The time each stage
+  spends working and waiting is recorded, to show which stage limits the
+  loading.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAHANDLING_DLL BankLoadPipeline {
+public:
+  /// Time spent by the threads of each stage, summed over the threads
+  struct Timings {
+    /// Seconds spent running read tasks
+    double read;
+    /// Seconds the reader waited for space in the queue
+    double readBlocked;
+    /// Seconds spent running process tasks
+    double process;
+    /// Seconds the processing threads waited for a bank to process
+    double processIdle;
+  };
+
+  BankLoadPipeline(size_t queueDepth, size_t numProcessThreads);
+
+  void addReadTask(std::unique_ptr<Kernel::Task> task);
+  void pushProcessTasks(std::vector<std::unique_ptr<Kernel::Task>> tasks);
+  void run();
+
+  /// @return the time spent by each stage during run()
+  const Timings &timings() const { return m_timings; }
+  std::string timingSummary() const;
+  /// @return the largest number of banks that were waiting in the queue
+  size_t maxQueued() const { return m_maxQueued; }
+
+private:
+  void runReadStage();
+  void runProcessStage();
+  std::unique_ptr<Kernel::Task> popProcessTask(double &idleSeconds);
+  void runTask(Kernel::Task &task);
+  void abort(std::exception_ptr exception);
+
+  /// Maximum number of banks waiting to be processed
+  const size_t m_queueDepth;
+  /// Number of threads running the process stage
+  const size_t m_numProcessThreads;
+  /// Tasks of the read stage
+  std::vector<std::unique_ptr<Kernel::Task>> m_readTasks;
+  /// Process tasks of the banks that were read, one entry per bank
+  std::deque<std::vector<std::unique_ptr<Kernel::Task>>> m_queue;
+  /// Guards the queue, the flags and the timings
+  std::mutex m_mutex;
+  /// Signalled when a bank is added to the queue or reading ends
+  std::condition_variable m_bankQueued;
+  /// Signalled when a bank leaves the queue
+  std::condition_variable m_bankTaken;
+  /// True once the read stage has finished
+  bool m_readingDone;
+  /// The first exception thrown by a task; stops the pipeline
+  std::exception_ptr m_exception;
+  /// Time spent by each stage
+  Timings m_timings;
+  /// Largest number of banks in the queue
+  size_t m_maxQueued;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
+
+#endif /* MANTID_DATAHANDLING_BANKLOADPIPELINE_H_ */
@@ -4,6 +4,9 @@
 #include "MantidDataHandling/DllConfig.h"
 #include "MantidDataHandling/EventWorkspaceCollection.h"
 #include "MantidAPI/Axis.h"
+#include "MantidDataObjects/EventHistogrammer.h"
+
+#include <memory>
 
 class BankPulseTimes;
 
@@ -85,6 +88,21 @@ public:
   std::vector<std::vector<std::vector<Mantid::DataObjects::WeightedEvent> *>>
       weightedEventVectors;
 
+  /// True if the events are histogrammed into LoadEventNexus'
+  /// histogramWorkspaces rather than kept
+  bool histogramming;
+
+  /// Finds the bins of the events, when histogramming
+  std::unique_ptr<DataObjects::EventHistogrammer> histogrammer;
+
+  /// Vector where index = event_id; value = ptr to the counts of the
+  /// histogram, when histogramming
+  std::vector<std::vector<double *>> histogramCounts;
+
+  /// Vector where index = event_id; value = ptr to the summed squared errors
+  /// of the histogram, when histogramming weighted events
+  std::vector<std::vector<double *>> histogramErrors;
+
   /// Vector where (index = pixel ID+pixelID_to_wi_offset), value = workspace
   /// index)
   std::vector<size_t> pixelID_to_wi_vector;
@@ -103,6 +121,10 @@ private:
   /// Map detector IDs to event lists.
   template <class T>
   void makeMapToEventLists(std::vector<std::vector<T>> &vectors);
+  /// Map detector IDs to histograms.
+  void makeMapToHistograms();
+  /// Store the events in compact form once they are all loaded.
+  void compactEventLists();
 };
 
 /** Generate a look-up table where the index = the pixel ID of an event
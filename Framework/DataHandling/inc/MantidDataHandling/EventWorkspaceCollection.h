@@ -5,6 +5,7 @@
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/Workspace2D.h"
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidDataHandling/DllConfig.h"
 #include <vector>
@@ -67,6 +68,10 @@ public:
   size_t nPeriods() const;
   DataObjects::EventWorkspace_sptr getSingleHeldWorkspace();
   API::Workspace_sptr combinedWorkspace();
+  std::vector<DataObjects::Workspace2D_sptr>
+  createHistogramWorkspaces(const HistogramData::BinEdges &binEdges) const;
+  API::Workspace_sptr combinedHistogramWorkspace(
+      const std::vector<DataObjects::Workspace2D_sptr> &histograms) const;
   const DataObjects::EventList &getSpectrum(const size_t workspace_index,
                                             const size_t periodNumber) const;
   DataObjects::EventList &getSpectrum(const size_t workspace_index,
@@ -4,7 +4,6 @@
 #include "MantidDataHandling/DllConfig.h"
 #include "MantidAPI/Progress.h"
 #include "MantidKernel/Task.h"
-#include "MantidKernel/ThreadScheduler.h"
 
 #include <nexus/NeXusFile.hpp>
 
@@ -12,6 +11,7 @@ class BankPulseTimes;
 
 namespace Mantid {
 namespace DataHandling {
+class BankLoadPipeline;
 class DefaultEventLoader;
 
 /** This task does the disk IO from loading the NXS file, and so will be on a
@@ -47,7 +47,7 @@ public:
                        const std::size_t numEvents,
                        const bool oldNeXusFileNames, API::Progress *prog,
                        boost::shared_ptr<std::mutex> ioMutex,
-                       Kernel::ThreadScheduler &scheduler,
+                       BankLoadPipeline &pipeline,
                        const std::vector<int> &framePeriodNumbers);
 
   void run() override;
@@ -70,8 +70,8 @@ private:
   std::string entry_type;
   /// Progress reporting
   API::Progress *prog;
-  /// ThreadScheduler running this task
-  Kernel::ThreadScheduler &scheduler;
+  /// Pipeline running this task, which processes the data loaded
+  BankLoadPipeline &pipeline;
   /// Object with the pulse times for this bank
   boost::shared_ptr<BankPulseTimes> thisBankPulseTimes;
   /// Did we get an error in loading
@@ -96,6 +96,8 @@ private:
   float *m_event_weight;
   /// Frame period numbers
   const std::vector<int> m_framePeriodNumbers;
+  /// Guards the file while it is read. Not held while handing the data on.
+  boost::shared_ptr<std::mutex> m_ioMutex;
 }; // END-DEF-CLASS LoadBankFromDiskTask
 
 } // namespace DataHandling
@@ -11,6 +11,7 @@
 #include "MantidGeometry/Instrument/ParameterMap.h"
 #include "MantidKernel/OptionalBool.h"
 #include "MantidKernel/TimeSeriesProperty.h"
+#include "MantidKernel/TimeSplitter.h"
 
 #ifdef _WIN32 // fixing windows issue causing conflict between
 // winnt char and nexus char
@@ -160,6 +161,31 @@ public:
   /// Tolerance for CompressEvents; use -1 to mean don't compress.
   double compressTolerance;
 
+  /// Store the events in compact form once all the banks are loaded
+  bool compactEvents;
+
+  /// Number of banks read and waiting to be processed
+  int loadQueueDepth;
+
+  /// Number of threads processing the banks read; 0 for automatic
+  int numberOfProcessThreads;
+
+  /// Bin boundaries to histogram the events into as they are loaded; empty
+  /// to keep the events
+  std::vector<double> histogramBinEdges;
+
+  /// Workspaces the events are histogrammed into, one per period
+  std::vector<DataObjects::Workspace2D_sptr> histogramWorkspaces;
+
+  /// Offset (T0) added to the times-of-flight before they are histogrammed
+  double histogramTofOffset;
+
+  /// Pulse time intervals whose events are histogrammed; empty to keep all
+  Kernel::TimeSplitterType histogramPulseFilter;
+
+  /// Number of events added to the histograms
+  size_t histogrammed_events;
+
   /// Pulse times for ALL banks, taken from proton_charge log.
   boost::shared_ptr<BankPulseTimes> m_allBanksPulseTimes;
 
@@ -186,6 +212,14 @@ private:
   DataObjects::EventWorkspace_sptr createEmptyEventWorkspace();
 
   void loadEvents(API::Progress *const prog, const bool monitors);
+  double getInstrumentT0() const;
+  Kernel::TimeSplitterType makePauseFilter() const;
+  void finalizeHistograms(const bool haveWeights);
+  std::string eventCacheSignature() const;
+  bool mapEventCache(const std::string &cacheFilename,
+                     const std::string &signature);
+  void writeEventCache(const std::string &cacheFilename,
+                       const std::string &signature);
   void createSpectraMapping(
       const std::string &nxsfile, const bool monitorsOnly,
       const std::vector<std::string> &bankNames = std::vector<std::string>());
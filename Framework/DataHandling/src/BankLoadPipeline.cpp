@@ -0,0 +1,208 @@
+#include "MantidDataHandling/BankLoadPipeline.h"
+#include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadScheduler.h"
+
+#include <boost/bind.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace Mantid {
+namespace DataHandling {
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/// @return the seconds elapsed since a time point
+double secondsSince(const Clock::time_point &start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+} // namespace
+
+/** Constructor
+ * @param queueDepth :: maximum number of banks read and waiting to be
+ * processed. At least 1.
+ * @param numProcessThreads :: number of threads running the process tasks. At
+ * least 1.
+ */
+BankLoadPipeline::BankLoadPipeline(const size_t queueDepth,
+                                   const size_t numProcessThreads)
+    : m_queueDepth(std::max(queueDepth, size_t(1))),
+      m_numProcessThreads(std::max(numProcessThreads, size_t(1))),
+      m_readingDone(false), m_timings{0., 0., 0., 0.}, m_maxQueued(0) {}
+
+/** Add a task to the read stage. Read tasks are run by run(), largest cost
+ * first.
+ * @param task :: the task. It should hand its processing to
+ * pushProcessTasks().
+ */
+void BankLoadPipeline::addReadTask(std::unique_ptr<Kernel::Task> task) {
+  m_readTasks.push_back(std::move(task));
+}
+
+/** Queue the process tasks of one bank. Called by the read tasks; waits while
+ * the queue is full. The tasks are dropped if the pipeline has been stopped
+ * by an error.
+ * @param tasks :: the tasks processing the bank
+ */
+void BankLoadPipeline::pushProcessTasks(
+    std::vector<std::unique_ptr<Kernel::Task>> tasks) {
+  if (tasks.empty())
+    return;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  const auto start = Clock::now();
+  m_bankTaken.wait(lock, [this] {
+    return m_queue.size() < m_queueDepth || m_exception;
+  });
+  m_timings.readBlocked += secondsSince(start);
+  if (m_exception)
+    return;
+  m_queue.push_back(std::move(tasks));
+  m_maxQueued = std::max(m_maxQueued, m_queue.size());
+  lock.unlock();
+  m_bankQueued.notify_all();
+}
+
+/** Run all the read tasks and the process tasks they queue. Returns once
+ * everything has run.
+ * @throw the first exception thrown by a task, once all threads have stopped
+ */
+void BankLoadPipeline::run() {
+  m_readingDone = false;
+  m_exception = nullptr;
+  m_timings = Timings{0., 0., 0., 0.};
+  m_maxQueued = 0;
+
+  // One thread per stage task. The read stage is scheduled first, so it is
+  // always started: the process stages wait for it.
+  Kernel::ThreadPool pool(new Kernel::ThreadSchedulerFIFO(),
+                          1 + m_numProcessThreads);
+  pool.schedule(new Kernel::FunctionTask(
+      boost::bind(&BankLoadPipeline::runReadStage, this)));
+  for (size_t i = 0; i < m_numProcessThreads; ++i)
+    pool.schedule(new Kernel::FunctionTask(
+        boost::bind(&BankLoadPipeline::runProcessStage, this)));
+  // The stages catch the exceptions of the tasks they run
+  pool.joinAll();
+
+  m_readTasks.clear();
+  m_queue.clear();
+  if (m_exception)
+    std::rethrow_exception(m_exception);
+}
+
+/// Run the read tasks in turn, largest first
+void BankLoadPipeline::runReadStage() {
+  std::stable_sort(m_readTasks.begin(), m_readTasks.end(),
+                   [](const std::unique_ptr<Kernel::Task> &lhs,
+                      const std::unique_ptr<Kernel::Task> &rhs) {
+                     return lhs->cost() > rhs->cost();
+                   });
+  const auto start = Clock::now();
+  for (auto &task : m_readTasks) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_exception)
+        break;
+    }
+    runTask(*task);
+    task.reset();
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Time blocked on a full queue was spent inside the read tasks
+    m_timings.read = secondsSince(start) - m_timings.readBlocked;
+    m_readingDone = true;
+  }
+  m_bankQueued.notify_all();
+}
+
+/// Run queued process tasks until reading is done and the queue is empty
+void BankLoadPipeline::runProcessStage() {
+  double busy = 0.;
+  double idle = 0.;
+  while (auto task = popProcessTask(idle)) {
+    const auto start = Clock::now();
+    runTask(*task);
+    busy += secondsSince(start);
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_timings.process += busy;
+  m_timings.processIdle += idle;
+}
+
+/** Take a process task from the queue, waiting for one if needed.
+ * @param idleSeconds :: incremented by the time spent waiting
+ * @return the task; null once there is nothing left to process
+ */
+std::unique_ptr<Kernel::Task>
+BankLoadPipeline::popProcessTask(double &idleSeconds) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  const auto start = Clock::now();
+  m_bankQueued.wait(lock, [this] {
+    return !m_queue.empty() || m_readingDone || m_exception;
+  });
+  idleSeconds += secondsSince(start);
+  if (m_exception || m_queue.empty())
+    return nullptr;
+
+  auto &bank = m_queue.front();
+  auto task = std::move(bank.back());
+  bank.pop_back();
+  if (bank.empty()) {
+    m_queue.pop_front();
+    lock.unlock();
+    m_bankTaken.notify_one();
+  }
+  return task;
+}
+
+/** Run a task, holding its mutex if it has one. An exception stops the
+ * pipeline. A read task should not have a mutex: it would be held while the
+ * task waits for space in the queue. Read tasks that share a resource lock it
+ * themselves around their use of it instead.
+ * @param task :: the task to run
+ */
+void BankLoadPipeline::runTask(Kernel::Task &task) {
+  auto mutex = task.getMutex();
+  std::unique_lock<std::mutex> taskLock;
+  if (mutex)
+    taskLock = std::unique_lock<std::mutex>(*mutex);
+  try {
+    task.run();
+  } catch (...) {
+    abort(std::current_exception());
+  }
+}
+
+/** Stop the pipeline: the reader stops after its current task and the
+ * queued process tasks are dropped.
+ * @param exception :: the error that stopped it; only the first is kept
+ */
+void BankLoadPipeline::abort(std::exception_ptr exception) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_exception)
+      m_exception = exception;
+  }
+  m_bankQueued.notify_all();
+  m_bankTaken.notify_all();
+}
+
+/// @return a one line description of the time spent by each stage
+std::string BankLoadPipeline::timingSummary() const {
+  std::ostringstream summary;
+  summary << std::fixed << std::setprecision(2) << "read " << m_timings.read
+          << " s (blocked " << m_timings.readBlocked
+          << " s on a full queue), process " << m_timings.process << " s on "
+          << m_numProcessThreads << " threads (idle " << m_timings.processIdle
+          << " s waiting for data), at most " << m_maxQueued << " of "
+          << m_queueDepth << " banks queued";
+  return summary.str();
+}
+
+} // namespace DataHandling
+} // namespace Mantid
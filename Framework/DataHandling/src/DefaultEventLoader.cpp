@@ -1,9 +1,10 @@
 #include "MantidDataHandling/DefaultEventLoader.h"
+#include "MantidDataHandling/BankLoadPipeline.h"
 #include "MantidDataHandling/LoadBankFromDiskTask.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidAPI/Progress.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/ThreadPool.h"
-#include "MantidKernel/ThreadSchedulerMutexes.h"
 #include "MantidKernel/make_unique.h"
 
 using namespace Mantid::Kernel;
@@ -23,10 +24,16 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
                             bankNames.size(), precount, chunk, totalChunks);
 
   auto bankRange = loader.setupChunking(bankNames, bankNumEvents);
+  // There are no event lists to reserve space in
+  if (loader.histogramming)
+    loader.precount = false;
 
-  // Make the thread pool
-  auto scheduler = new ThreadSchedulerMutexes;
-  ThreadPool pool(scheduler);
+  // One thread reads the banks while the others process those already read
+  size_t processThreads = static_cast<size_t>(alg->numberOfProcessThreads);
+  if (processThreads == 0)
+    processThreads = std::max(ThreadPool::getNumPhysicalCores(), size_t(2)) - 1;
+  BankLoadPipeline pipeline(static_cast<size_t>(alg->loadQueueDepth),
+                            processThreads);
   auto diskIOMutex = boost::make_shared<std::mutex>();
 
   // set up progress bar for the rest of the (multi-threaded) process
@@ -37,13 +44,19 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
 
   for (size_t i = bankRange.first; i < bankRange.second; i++) {
     if (bankNumEvents[i] > 0)
-      pool.schedule(new LoadBankFromDiskTask(
+      pipeline.addReadTask(Kernel::make_unique<LoadBankFromDiskTask>(
           loader, bankNames[i], classType, bankNumEvents[i], oldNeXusFileNames,
-          prog.get(), diskIOMutex, *scheduler, periodLog));
+          prog.get(), diskIOMutex, pipeline, periodLog));
   }
-  // Start and end all threads
-  pool.joinAll();
+  pipeline.run();
   diskIOMutex.reset();
+  alg->getLogger().information() << "Bank loading pipeline: "
+                                 << pipeline.timingSummary() << '\n';
+
+  // Only once every bank is loaded: the tasks add events through pointers to
+  // the event vectors, and a pixel can get events from several tasks
+  if (!loader.histogramming && alg->compactEvents)
+    loader.compactEventLists();
 }
 
 DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg,
@@ -64,7 +77,12 @@ DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg,
         m_ws.getDetectorIDToWorkspaceIndexVector(pixelID_to_wi_offset, true);
 
   // Cache a map for speed.
-  if (!haveWeights) {
+  histogramming = !alg->histogramWorkspaces.empty();
+  if (histogramming) {
+    histogrammer = Kernel::make_unique<DataObjects::EventHistogrammer>(
+        alg->histogramBinEdges);
+    makeMapToHistograms();
+  } else if (!haveWeights) {
     makeMapToEventLists(eventVectors);
   } else {
     // Convert to weighted events
@@ -79,6 +97,66 @@ DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg,
   splitProcessing = bool(numBanks * 2 < ThreadPool::getNumPhysicalCores());
 }
 
+/** Generate look-up tables where the index = the ID of an event and the value
+ * = a pointer to the counts (and the summed squared errors, for weighted
+ * events) of the histogram it is added to. As makeMapToEventLists().
+ */
+void DefaultEventLoader::makeMapToHistograms() {
+  const auto &histograms = alg->histogramWorkspaces;
+  // Pairs of event ID and workspace index
+  std::vector<std::pair<int32_t, size_t>> eventIdToIndex;
+  if (event_id_is_spec) {
+    auto *ax1 = m_ws.getAxis(1);
+    specnum_t maxSpecNo = -std::numeric_limits<specnum_t>::max();
+    for (size_t i = 0; i < ax1->length(); i++)
+      maxSpecNo = std::max(maxSpecNo, ax1->spectraNo(i));
+    eventid_max = maxSpecNo;
+    for (size_t i = 0; i < m_ws.getNumberHistograms(); ++i)
+      eventIdToIndex.emplace_back(m_ws.getSpectrum(i).getSpectrumNo(), i);
+  } else {
+    eventid_max = static_cast<int32_t>(pixelID_to_wi_vector.size()) +
+                  pixelID_to_wi_offset;
+    for (size_t j = size_t(pixelID_to_wi_offset);
+         j < pixelID_to_wi_vector.size(); j++) {
+      const size_t wi = pixelID_to_wi_vector[j];
+      if (wi < m_ws.getNumberHistograms())
+        eventIdToIndex.emplace_back(
+            static_cast<int32_t>(j) - pixelID_to_wi_offset, wi);
+    }
+  }
+
+  histogramCounts.resize(histograms.size());
+  if (m_haveWeights)
+    histogramErrors.resize(histograms.size());
+  for (size_t period = 0; period < histograms.size(); ++period) {
+    auto &ws = *histograms[period];
+    histogramCounts[period].resize(eventid_max + 1, nullptr);
+    if (m_haveWeights)
+      histogramErrors[period].resize(eventid_max + 1, nullptr);
+    for (const auto &entry : eventIdToIndex) {
+      // mutableY() makes the data unique, so the pointers stay valid
+      histogramCounts[period][entry.first] = &ws.mutableY(entry.second)[0];
+      if (m_haveWeights)
+        histogramErrors[period][entry.first] = &ws.mutableE(entry.second)[0];
+    }
+  }
+}
+
+/** Store the events of every event list in compact form. This releases the
+ * event vectors, so the look-up tables to them are cleared.
+ */
+void DefaultEventLoader::compactEventLists() {
+  const auto numHistograms = static_cast<int64_t>(m_ws.getNumberHistograms());
+  for (size_t period = 0; period < m_ws.nPeriods(); ++period) {
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < numHistograms; ++i)
+      m_ws.getSpectrum(static_cast<size_t>(i), period)
+          .setStorageMode(DataObjects::COMPACT_STORAGE);
+  }
+  eventVectors.clear();
+  weightedEventVectors.clear();
+}
+
 std::pair<size_t, size_t>
 DefaultEventLoader::setupChunking(std::vector<std::string> &bankNames,
                                   std::vector<std::size_t> &bankNumEvents) {
@@ -137,6 +137,47 @@ API::Workspace_sptr EventWorkspaceCollection::combinedWorkspace() {
   return final;
 }
 
+/** Create empty histogram workspaces matching the held workspaces, one per
+ * period, for loading events straight into histograms.
+ * @param binEdges :: the bin boundaries of every spectrum
+ * @return the histogram workspaces
+ */
+std::vector<Workspace2D_sptr>
+EventWorkspaceCollection::createHistogramWorkspaces(
+    const HistogramData::BinEdges &binEdges) const {
+  std::vector<Workspace2D_sptr> histograms;
+  histograms.reserve(m_WsVec.size());
+  for (const auto &ws : m_WsVec)
+    histograms.push_back(create<Workspace2D>(*ws, binEdges));
+  return histograms;
+}
+
+/** Combine histogram workspaces made by createHistogramWorkspaces() as
+ * combinedWorkspace() combines the held workspaces. The instrument, sample,
+ * logs and monitor workspace are copied again from the held workspaces, as
+ * they may have changed since the histograms were created.
+ * @param histograms :: one histogram workspace per period
+ * @return the single workspace, or a group of them if there are several
+ * periods
+ */
+API::Workspace_sptr EventWorkspaceCollection::combinedHistogramWorkspace(
+    const std::vector<Workspace2D_sptr> &histograms) const {
+  if (histograms.size() != m_WsVec.size())
+    throw std::invalid_argument(
+        "Expected one histogram workspace for each period");
+  for (size_t i = 0; i < histograms.size(); ++i) {
+    histograms[i]->copyExperimentInfoFrom(m_WsVec[i].get());
+    if (auto monitors = m_WsVec[i]->monitorWorkspace())
+      histograms[i]->setMonitorWorkspace(monitors);
+  }
+  if (histograms.size() == 1)
+    return histograms.front();
+  auto wsg = boost::make_shared<API::WorkspaceGroup>();
+  for (const auto &ws : histograms)
+    wsg->addWorkspace(ws);
+  return wsg;
+}
+
 Geometry::Instrument_const_sptr
 EventWorkspaceCollection::getInstrument() const {
   return m_WsVec[0]->getInstrument();
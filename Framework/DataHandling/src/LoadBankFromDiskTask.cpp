@@ -1,8 +1,10 @@
+#include "MantidDataHandling/BankLoadPipeline.h"
 #include "MantidDataHandling/BankPulseTimes.h"
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidDataHandling/LoadBankFromDiskTask.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
+#include "MantidKernel/make_unique.h"
 
 namespace Mantid {
 namespace DataHandling {
@@ -16,21 +18,21 @@ namespace DataHandling {
 * @param oldNeXusFileNames :: Identify if file is of old variety.
 * @param prog :: an optional Progress object
 * @param ioMutex :: a mutex shared for all Disk I-O tasks
-* @param scheduler :: the ThreadScheduler that runs this task.
+* @param pipeline :: the BankLoadPipeline that runs this task.
 * @param framePeriodNumbers :: Period numbers corresponding to each frame
 */
 LoadBankFromDiskTask::LoadBankFromDiskTask(
     DefaultEventLoader &loader, const std::string &entry_name,
     const std::string &entry_type, const std::size_t numEvents,
     const bool oldNeXusFileNames, API::Progress *prog,
-    boost::shared_ptr<std::mutex> ioMutex, Kernel::ThreadScheduler &scheduler,
+    boost::shared_ptr<std::mutex> ioMutex, BankLoadPipeline &pipeline,
     const std::vector<int> &framePeriodNumbers)
     : m_loader(loader), entry_name(entry_name), entry_type(entry_type),
-      prog(prog), scheduler(scheduler), m_loadError(false),
+      prog(prog), pipeline(pipeline), m_loadError(false),
       m_oldNexusFileNames(oldNeXusFileNames), m_event_id(nullptr),
       m_event_time_of_flight(nullptr), m_have_weight(false),
-      m_event_weight(nullptr), m_framePeriodNumbers(framePeriodNumbers) {
-  setMutex(ioMutex);
+      m_event_weight(nullptr), m_framePeriodNumbers(framePeriodNumbers),
+      m_ioMutex(ioMutex) {
   m_cost = static_cast<double>(numEvents);
   m_min_id = std::numeric_limits<uint32_t>::max();
   m_max_id = 0;
@@ -351,74 +353,78 @@ void LoadBankFromDiskTask::run() {
 
   prog->report(entry_name + ": load from disk");
 
-  // Open the file
-  ::NeXus::File file(m_loader.alg->m_filename);
-  try {
-    // Navigate into the file
-    file.openGroup(m_loader.alg->m_top_entry_name, "NXentry");
-    // Open the bankN_event group
-    file.openGroup(entry_name, entry_type);
-
-    // Load the event_index field.
-    this->loadEventIndex(file, event_index);
-
-    if (!m_loadError) {
-      // Load and validate the pulse times
-      this->loadPulseTimes(file);
-
-      // The event_index should be the same length as the pulse times from DAS
-      // logs.
-      if (event_index.size() != thisBankPulseTimes->numPulses)
-        m_loader.alg->getLogger().warning()
-            << "Bank " << entry_name
-            << " has a mismatch between the number of event_index entries "
-               "and the number of pulse times in event_time_zero.\n";
-
-      // Open and validate event_id field.
-      size_t start_event = 0;
-      size_t stop_event = 0;
-      this->prepareEventId(file, start_event, stop_event, event_index);
-
-      // These are the arguments to getSlab()
-      m_loadStart[0] = static_cast<int>(start_event);
-      m_loadSize[0] = static_cast<int>(stop_event - start_event);
-
-      if ((m_loadSize[0] > 0) && (m_loadStart[0] >= 0)) {
-        // Load pixel IDs
-        this->loadEventId(file);
-        if (m_loader.alg->getCancel())
-          m_loadError = true; // To allow cancelling the algorithm
-
-        // And TOF.
-        if (!m_loadError) {
-          this->loadTof(file);
-          if (m_have_weight) {
-            this->loadEventWeights(file);
+  {
+    // Hold the file only while reading it, not while handing the data on
+    std::lock_guard<std::mutex> ioLock(*m_ioMutex);
+    // Open the file
+    ::NeXus::File file(m_loader.alg->m_filename);
+    try {
+      // Navigate into the file
+      file.openGroup(m_loader.alg->m_top_entry_name, "NXentry");
+      // Open the bankN_event group
+      file.openGroup(entry_name, entry_type);
+
+      // Load the event_index field.
+      this->loadEventIndex(file, event_index);
+
+      if (!m_loadError) {
+        // Load and validate the pulse times
+        this->loadPulseTimes(file);
+
+        // The event_index should be the same length as the pulse times from DAS
+        // logs.
+        if (event_index.size() != thisBankPulseTimes->numPulses)
+          m_loader.alg->getLogger().warning()
+              << "Bank " << entry_name
+              << " has a mismatch between the number of event_index entries "
+                 "and the number of pulse times in event_time_zero.\n";
+
+        // Open and validate event_id field.
+        size_t start_event = 0;
+        size_t stop_event = 0;
+        this->prepareEventId(file, start_event, stop_event, event_index);
+
+        // These are the arguments to getSlab()
+        m_loadStart[0] = static_cast<int>(start_event);
+        m_loadSize[0] = static_cast<int>(stop_event - start_event);
+
+        if ((m_loadSize[0] > 0) && (m_loadStart[0] >= 0)) {
+          // Load pixel IDs
+          this->loadEventId(file);
+          if (m_loader.alg->getCancel())
+            m_loadError = true; // To allow cancelling the algorithm
+
+          // And TOF.
+          if (!m_loadError) {
+            this->loadTof(file);
+            if (m_have_weight) {
+              this->loadEventWeights(file);
+            }
           }
+        } // Size is at least 1
+        else {
+          // Found a size that was 0 or less; stop processing
+          m_loadError = true;
         }
-      } // Size is at least 1
-      else {
-        // Found a size that was 0 or less; stop processing
-        m_loadError = true;
-      }
 
-    } // no error
+      } // no error
 
-  } // try block
-  catch (std::exception &e) {
-    m_loader.alg->getLogger().error() << "Error while loading bank "
-                                      << entry_name << ":\n";
-    m_loader.alg->getLogger().error() << e.what() << '\n';
-    m_loadError = true;
-  } catch (...) {
-    m_loader.alg->getLogger().error() << "Unspecified error while loading bank "
-                                      << entry_name << '\n';
-    m_loadError = true;
-  }
+    } // try block
+    catch (std::exception &e) {
+      m_loader.alg->getLogger().error() << "Error while loading bank "
+                                        << entry_name << ":\n";
+      m_loader.alg->getLogger().error() << e.what() << '\n';
+      m_loadError = true;
+    } catch (...) {
+      m_loader.alg->getLogger().error()
+          << "Unspecified error while loading bank " << entry_name << '\n';
+      m_loadError = true;
+    }
 
-  // Close up the file even if errors occured.
-  file.closeGroup();
-  file.close();
+    // Close up the file even if errors occured.
+    file.closeGroup();
+    file.close();
+  }
 
   // Abort if anything failed
   if (m_loadError) {
@@ -479,18 +485,19 @@ void LoadBankFromDiskTask::run() {
   boost::shared_array<float> event_weight_shrd(m_event_weight);
   boost::shared_ptr<std::vector<uint64_t>> event_index_shrd(event_index_ptr);
 
-  ProcessBankData *newTask1 = new ProcessBankData(
+  std::vector<std::unique_ptr<Kernel::Task>> processTasks;
+  processTasks.push_back(Kernel::make_unique<ProcessBankData>(
       m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
       numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
-      event_weight_shrd, m_min_id, mid_id);
-  scheduler.push(newTask1);
+      event_weight_shrd, m_min_id, mid_id));
   if (m_loader.splitProcessing && (mid_id < m_max_id)) {
-    ProcessBankData *newTask2 = new ProcessBankData(
+    processTasks.push_back(Kernel::make_unique<ProcessBankData>(
         m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
         numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
-        event_weight_shrd, (mid_id + 1), m_max_id);
-    scheduler.push(newTask2);
+        event_weight_shrd, (mid_id + 1), m_max_id));
   }
+  // Waits while the pipeline holds as many banks as it may
+  pipeline.pushProcessTasks(std::move(processTasks));
 }
 
 /**
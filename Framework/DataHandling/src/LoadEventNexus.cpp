@@ -8,16 +8,20 @@
 #include "MantidAPI/RegisterFileLoader.h"
 #include "MantidAPI/Run.h"
 #include "MantidAPI/Sample.h"
+#include "MantidDataObjects/EventCacheFile.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/Goniometer.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/DateAndTimeHelpers.h"
+#include "MantidKernel/ITimeSeriesProperty.h"
 #include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/RebinParamsValidator.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/UnitFactory.h"
+#include "MantidKernel/VectorHelper.h"
 #include "MantidKernel/VisibleWhenProperty.h"
 #include "MantidIndexing/IndexInfo.h"
 
@@ -27,7 +31,12 @@
 #include <boost/shared_array.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <Poco/File.h>
+
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <sstream>
 
 using Mantid::Types::Core::DateAndTime;
 using Mantid::Types::Event::TofEvent;
@@ -78,7 +87,10 @@ void copyLogs(const Mantid::DataHandling::EventWorkspaceCollection_sptr &from,
 LoadEventNexus::LoadEventNexus()
     : filter_tof_min(0), filter_tof_max(0), m_specMin(0), m_specMax(0),
       longest_tof(0), shortest_tof(0), bad_tofs(0), discarded_events(0),
-      compressTolerance(0), m_instrument_loaded_correctly(false),
+      compressTolerance(0), compactEvents(false), loadQueueDepth(4),
+      numberOfProcessThreads(0), histogramTofOffset(0),
+      histogrammed_events(0),
+      m_instrument_loaded_correctly(false),
       loadlogs(false), m_logs_loaded_correctly(false), event_id_is_spec(false) {
 }
 
@@ -187,6 +199,25 @@ void LoadEventNexus::init() {
                   "This specified the tolerance to use (in microseconds) when "
                   "compressing.");
 
+  declareProperty(
+      make_unique<PropertyWithValue<bool>>("CompactEvents", false,
+                                           Direction::Input),
+      "Store the events in compact form (8 bytes per event, with single "
+      "precision times-of-flight) once all the banks are loaded (optional, "
+      "default False). This halves the memory used by the events. "
+      "Times-of-flight changed after loading are rounded to single "
+      "precision, a relative error of at most 6e-8.");
+
+  declareProperty(
+      make_unique<ArrayProperty<double>>(
+          "HistogramBinning", boost::make_shared<RebinParamsValidator>(true)),
+      "If given, the events are histogrammed as they are read, with these "
+      "binning parameters (as for Rebin), and the output is a Workspace2D. "
+      "No events are kept in memory, so this uses much less memory than "
+      "loading the events and then rebinning them with "
+      "PreserveEvents=False. CompressTolerance and CompactEvents are "
+      "ignored.");
+
   auto mustBePositive = boost::make_shared<BoundedValidator<int>>();
   mustBePositive->setLower(1);
   declareProperty("ChunkNumber", EMPTY_INT(), mustBePositive,
@@ -204,6 +235,8 @@ void LoadEventNexus::init() {
   std::string grp3 = "Reduce Memory Use";
   setPropertyGroup("Precount", grp3);
   setPropertyGroup("CompressTolerance", grp3);
+  setPropertyGroup("CompactEvents", grp3);
+  setPropertyGroup("HistogramBinning", grp3);
   setPropertyGroup("ChunkNumber", grp3);
   setPropertyGroup("TotalChunks", grp3);
 
@@ -302,6 +335,30 @@ void LoadEventNexus::init() {
       make_unique<PropertyWithValue<bool>>("LoadLogs", true, Direction::Input),
       "Load the Sample/DAS logs from the file (default True).");
 
+  declareProperty("LoadQueueDepth", 4, mustBePositive,
+                  "The number of banks that may be read from the file and "
+                  "waiting to be processed. Larger values keep the processing "
+                  "threads busy when bank sizes vary, at the cost of memory.");
+  auto mustBeNonNegative = boost::make_shared<BoundedValidator<int>>();
+  mustBeNonNegative->setLower(0);
+  declareProperty("NumberOfProcessThreads", 0, mustBeNonNegative,
+                  "The number of threads putting the events read into the "
+                  "workspace, while another thread reads the file. 0 (the "
+                  "default) uses one fewer than the number of cores.");
+  declareProperty(
+      make_unique<FileProperty>("EventCacheFile", "",
+                                FileProperty::OptionalSave, ".evc"),
+      "If given, the events loaded are kept in this file, in a native format "
+      "that is memory-mapped rather than read: the events stay on disk and "
+      "are paged in when used. If the file already holds the events of the "
+      "same NeXus file loaded with the same filtering options, they are "
+      "mapped from it instead of being loaded again. Used for single period "
+      "files without time-of-flight bins, unless HistogramBinning is given.");
+  std::string grp5 = "Performance";
+  setPropertyGroup("LoadQueueDepth", grp5);
+  setPropertyGroup("NumberOfProcessThreads", grp5);
+  setPropertyGroup("EventCacheFile", grp5);
+
 #ifdef MPI_EXPERIMENTAL
   declareProperty(make_unique<PropertyWithValue<bool>>("UseParallelLoader",
                                                        true, Direction::Input),
@@ -384,6 +441,14 @@ void LoadEventNexus::exec() {
   m_filename = getPropertyValue("Filename");
 
   compressTolerance = getProperty("CompressTolerance");
+  compactEvents = getProperty("CompactEvents");
+  loadQueueDepth = getProperty("LoadQueueDepth");
+  numberOfProcessThreads = getProperty("NumberOfProcessThreads");
+  const std::vector<double> histogramBinning = getProperty("HistogramBinning");
+  histogramBinEdges.clear();
+  if (!histogramBinning.empty())
+    VectorHelper::createAxisFromRebinParams(histogramBinning,
+                                            histogramBinEdges);
 
   loadlogs = getProperty("LoadLogs");
 
@@ -421,8 +486,13 @@ void LoadEventNexus::exec() {
 
   // add filename
   m_ws->mutableRun().addProperty("Filename", m_filename);
-  // Save output
-  this->setProperty("OutputWorkspace", m_ws->combinedWorkspace());
+  // Save output. Histograms are output once the monitors are loaded, which
+  // are attached to the data workspace, and must not receive monitor events.
+  const auto dataWS = m_ws;
+  std::vector<Workspace2D_sptr> histograms;
+  histograms.swap(histogramWorkspaces);
+  if (histograms.empty())
+    this->setProperty("OutputWorkspace", m_ws->combinedWorkspace());
   // Load the monitors
   if (load_monitors) {
     prog.report("Loading monitors");
@@ -447,6 +517,9 @@ void LoadEventNexus::exec() {
       this->runLoadMonitors();
     }
   }
+  if (!histograms.empty())
+    this->setProperty("OutputWorkspace",
+                      dataWS->combinedHistogramWorkspace(histograms));
   m_file->close();
 }
 
@@ -851,13 +924,44 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
   for (size_t i = 0; i < m_ws->getNumberHistograms(); i++)
     m_ws->getSpectrum(i).setSortOrder(DataObjects::PULSETIME_SORT);
 
+  // Histogram the events as they are loaded instead of keeping them
+  histogramWorkspaces.clear();
+  if (!monitors && !histogramBinEdges.empty()) {
+    histogramWorkspaces = m_ws->createHistogramWorkspaces(
+        HistogramData::BinEdges(histogramBinEdges));
+    histogramTofOffset = getInstrumentT0();
+    histogramPulseFilter = makePauseFilter();
+    histogrammed_events = 0;
+  }
+
   // Count the limits to time of flight
   shortest_tof =
       static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
   longest_tof = 0.;
 
+  // The cache holds the events as they are once loaded, so is only used when
+  // nothing is done to them afterwards that depends on more than the events
+  std::string cacheFilename;
+  if (!monitors && histogramWorkspaces.empty())
+    cacheFilename = getPropertyValue("EventCacheFile");
+  if (!cacheFilename.empty() &&
+      (m_ws->nPeriods() != 1 ||
+       entries.find("detector_1_events") != entries.end())) {
+    g_log.warning("EventCacheFile is ignored for files with several periods "
+                  "or with time-of-flight bins.\n");
+    cacheFilename.clear();
+  }
+  const std::string cacheSignature =
+      cacheFilename.empty() ? "" : eventCacheSignature();
+
   bool loaded{false};
-  if (canUseParallelLoader(haveWeights, oldNeXusFileNames, classType)) {
+  bool fromCache{false};
+  if (!cacheFilename.empty() && mapEventCache(cacheFilename, cacheSignature)) {
+    loaded = true;
+    fromCache = true;
+  }
+  if (!loaded &&
+      canUseParallelLoader(haveWeights, oldNeXusFileNames, classType)) {
     auto ws = m_ws->getSingleHeldWorkspace();
     m_file->close();
     try {
@@ -883,8 +987,13 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
                              totalChunks);
   }
 
+  if (!histogramWorkspaces.empty())
+    finalizeHistograms(haveWeights);
+
   // Info reporting
-  const std::size_t eventsLoaded = m_ws->getNumberEvents();
+  const std::size_t eventsLoaded = histogramWorkspaces.empty()
+                                       ? m_ws->getNumberEvents()
+                                       : histogrammed_events;
   g_log.information() << "Read " << eventsLoaded << " events"
                       << ". Shortest TOF: " << shortest_tof
                       << " microsec; longest TOF: " << longest_tof
@@ -899,27 +1008,24 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
                                                "TOF data.\n";
 
   // Use T0 offset from TOPAZ Parameter file if it exists
-  if (m_ws->getInstrument()->hasParameter("T0")) {
-    std::vector<double> instrumentT0 =
-        m_ws->getInstrument()->getNumberParameter("T0", true);
-    if (!instrumentT0.empty()) {
-      const double mT0 = instrumentT0.front();
-      if (mT0 != 0.0) {
-        int64_t numHistograms =
-            static_cast<int64_t>(m_ws->getNumberHistograms());
-        PARALLEL_FOR_IF(Kernel::threadSafe(*m_ws))
-        for (int64_t i = 0; i < numHistograms; ++i) {
-          PARALLEL_START_INTERUPT_REGION
-          // Do the offsetting
-          m_ws->getSpectrum(i).addTof(mT0);
-          PARALLEL_END_INTERUPT_REGION
-        }
-        PARALLEL_CHECK_INTERUPT_REGION
-        // set T0 in the run parameters
-        API::Run &run = m_ws->mutableRun();
-        run.addProperty<double>("T0", mT0, true);
+  const double mT0 = getInstrumentT0();
+  if (mT0 != 0.0) {
+    // Histogrammed events had it added as they were binned, and cached events
+    // before they were written
+    if (histogramWorkspaces.empty() && !fromCache) {
+      int64_t numHistograms = static_cast<int64_t>(m_ws->getNumberHistograms());
+      PARALLEL_FOR_IF(Kernel::threadSafe(*m_ws))
+      for (int64_t i = 0; i < numHistograms; ++i) {
+        PARALLEL_START_INTERUPT_REGION
+        // Do the offsetting
+        m_ws->getSpectrum(i).addTof(mT0);
+        PARALLEL_END_INTERUPT_REGION
       }
+      PARALLEL_CHECK_INTERUPT_REGION
     }
+    // set T0 in the run parameters
+    API::Run &run = m_ws->mutableRun();
+    run.addProperty<double>("T0", mT0, true);
   }
   // Now, create a default X-vector for histogramming, with just 2 bins.
   if (eventsLoaded > 0)
@@ -928,7 +1034,152 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
     m_ws->setAllX(HistogramData::BinEdges{0.0, 1.0});
 
   // if there is time_of_flight load it
-  loadTimeOfFlight(m_ws, m_top_entry_name, classType);
+  if (histogramWorkspaces.empty())
+    loadTimeOfFlight(m_ws, m_top_entry_name, classType);
+
+  if (!cacheFilename.empty() && !fromCache)
+    writeEventCache(cacheFilename, cacheSignature);
+}
+
+/** Describe what the events loaded depend on: the NeXus file, down to its
+ * size and modification time, and the properties that select or change the
+ * events. A cache file written with a different signature is not used.
+ * @return the signature
+ */
+std::string LoadEventNexus::eventCacheSignature() const {
+  Poco::File file(m_filename);
+  std::ostringstream signature;
+  signature << "file=" << m_filename << ";size=" << file.getSize()
+            << ";modified=" << file.getLastModified().epochMicroseconds();
+  for (const auto &name :
+       {"NXentryName", "FilterByTofMin", "FilterByTofMax", "FilterByTimeStart",
+        "FilterByTimeStop", "BankName", "SingleBankPixelsOnly", "SpectrumMin",
+        "SpectrumMax", "SpectrumList", "ChunkNumber", "TotalChunks",
+        "CompressTolerance", "LoadLogs"})
+    signature << ';' << name << '=' << getPropertyValue(name);
+  return signature.str();
+}
+
+/** Give the workspace the events of a cache file, if it holds the events
+ * this load would produce. The events are mapped, not read. Besides the file
+ * named, the files written next to it while it was in use are looked at.
+ * @param cacheFilename :: the cache file
+ * @param signature :: the signature of this load
+ * @return true if the events were mapped from one of the files
+ */
+bool LoadEventNexus::mapEventCache(const std::string &cacheFilename,
+                                   const std::string &signature) {
+  for (const auto &filename :
+       DataObjects::EventCacheFile::existingNames(cacheFilename)) {
+    try {
+      auto cache = DataObjects::EventCacheFile::open(filename);
+      if (cache->signature() != signature) {
+        g_log.information() << filename << " holds other events.\n";
+        continue;
+      }
+      cache->mapInto(*m_ws->getSingleHeldWorkspace());
+      // The cache holds the times-of-flight after the T0 offset was added
+      const double mT0 = getInstrumentT0();
+      shortest_tof = cache->getTofMin() - mT0;
+      longest_tof = cache->getTofMax() - mT0;
+      g_log.information() << "Mapped " << cache->getNumberEvents()
+                          << " events from " << filename << ".\n";
+      return true;
+    } catch (std::exception &e) {
+      g_log.warning() << "Could not use the event cache " << filename << ": "
+                      << e.what() << '\n';
+    }
+  }
+  return false;
+}
+
+/** Write the events loaded to a cache file, then map them from it so that
+ * they no longer take memory. A failure to write leaves the events loaded.
+ * @param cacheFilename :: the cache file
+ * @param signature :: the signature of this load
+ */
+void LoadEventNexus::writeEventCache(const std::string &cacheFilename,
+                                     const std::string &signature) {
+  try {
+    auto ws = m_ws->getSingleHeldWorkspace();
+    const std::string written =
+        DataObjects::EventCacheFile::write(cacheFilename, *ws, signature);
+    DataObjects::EventCacheFile::open(written)->mapInto(*ws);
+    if (written != cacheFilename)
+      g_log.warning() << cacheFilename << " is in use by another workspace. "
+                      << "The events were written to " << written
+                      << " instead.\n";
+    else
+      g_log.information() << "Wrote the events to " << written << ".\n";
+  } catch (std::exception &e) {
+    g_log.warning() << "Could not write the event cache " << cacheFilename
+                    << ": " << e.what() << '\n';
+  }
+}
+
+/// @return the T0 offset of the times-of-flight given by the instrument
+/// parameters (TOPAZ), or 0 if there is none
+double LoadEventNexus::getInstrumentT0() const {
+  const auto instrument = m_ws->getInstrument();
+  if (instrument->hasParameter("T0")) {
+    const auto instrumentT0 = instrument->getNumberParameter("T0", true);
+    if (!instrumentT0.empty())
+      return instrumentT0.front();
+  }
+  return 0.0;
+}
+
+/** Make the filter removing the events recorded while the run was paused,
+ * for events that are histogrammed as they are loaded. filterDuringPause()
+ * cannot remove those afterwards.
+ * @return the pulse time intervals whose events are kept; empty to keep all
+ */
+TimeSplitterType LoadEventNexus::makePauseFilter() const {
+  TimeSplitterType filter;
+  if (ConfigService::Instance().hasProperty(
+          "loadeventnexus.keeppausedevents") ||
+      !m_ws->run().hasProperty("pause"))
+    return filter;
+  auto *pauseLog = m_ws->run().getLogData("pause");
+  auto *log = dynamic_cast<ITimeSeriesProperty *>(pauseLog);
+  if (!log || pauseLog->size() <= 1)
+    return filter;
+
+  g_log.notice("Filtering out events when the run was marked as paused. "
+               "Set the loadeventnexus.keeppausedevents configuration "
+               "property to override this.");
+  // The log value is set to 1 when the run is paused, 0 otherwise.
+  log->makeFilterByValue(filter, 0.0, 0.0, 0.0, false);
+  log->expandFilterToRange(
+      filter, 0.0, 0.0,
+      TimeInterval(DateAndTime::minimum(), DateAndTime::maximum()));
+  // Paused throughout: keep an empty interval so that nothing is kept
+  if (filter.empty())
+    filter.emplace_back(DateAndTime::minimum(), DateAndTime::minimum());
+  return filter;
+}
+
+/** Turn the sums accumulated in the histograms into counts and errors. The
+ * errors of weighted events hold their summed squared errors; those of plain
+ * counts are still empty.
+ * @param haveWeights :: were the events weighted?
+ */
+void LoadEventNexus::finalizeHistograms(const bool haveWeights) {
+  for (const auto &ws : histogramWorkspaces) {
+    const auto numHistograms = static_cast<int64_t>(ws->getNumberHistograms());
+    PARALLEL_FOR_IF(Kernel::threadSafe(*ws))
+    for (int64_t i = 0; i < numHistograms; ++i) {
+      auto &e = ws->mutableE(i);
+      if (haveWeights)
+        std::transform(e.cbegin(), e.cend(), e.begin(),
+                       [](const double errorSq) { return std::sqrt(errorSq); });
+      else {
+        const auto &y = ws->y(i);
+        std::transform(y.cbegin(), y.cend(), e.begin(),
+                       [](const double counts) { return std::sqrt(counts); });
+      }
+    }
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -1683,6 +1934,8 @@ bool LoadEventNexus::canUseParallelLoader(const bool haveWeights,
 #endif
   if (m_ws->nPeriods() != 1)
     return false;
+  if (!histogramWorkspaces.empty())
+    return false;
   if (haveWeights)
     return false;
   if (oldNeXusFileNames)
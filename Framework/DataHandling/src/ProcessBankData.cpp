@@ -2,12 +2,31 @@
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
 
+#include <algorithm>
+
 using namespace Mantid::DataObjects;
 using Mantid::Types::Event::TofEvent;
 
 namespace Mantid {
 namespace DataHandling {
 
+namespace {
+/** Is a pulse time in one of the intervals of a filter?
+ * @param filter :: sorted, non-overlapping intervals
+ * @param pulseTime :: the time to look up
+ */
+bool isInFilter(const Kernel::TimeSplitterType &filter,
+                const Types::Core::DateAndTime &pulseTime) {
+  auto next = std::upper_bound(
+      filter.cbegin(), filter.cend(), pulseTime,
+      [](const Types::Core::DateAndTime &time,
+         const Kernel::SplittingInterval &interval) {
+        return time < interval.start();
+      });
+  return next != filter.cbegin() && pulseTime < std::prev(next)->stop();
+}
+} // namespace
+
 ProcessBankData::ProcessBankData(
     DefaultEventLoader &m_loader, std::string entry_name, API::Progress *prog,
     boost::shared_array<uint32_t> event_id,
@@ -44,6 +63,7 @@ void ProcessBankData::run() { // override {
   // ---- Pre-counting events per pixel ID ----
   auto &outputWS = m_loader.m_ws;
   auto *alg = m_loader.alg;
+  const bool histogramming = m_loader.histogramming;
   if (m_loader.precount) {
 
     std::vector<size_t> counts(m_max_id - m_min_id + 1, 0);
@@ -101,7 +121,14 @@ void ProcessBankData::run() { // override {
   prog->report(entry_name + ": filling events");
 
   // Will we need to compress?
-  bool compress = (alg->compressTolerance >= 0);
+  bool compress = !histogramming && (alg->compressTolerance >= 0);
+
+  // Histogrammed events are only kept if their pulse is not filtered out
+  const auto &pulseFilter = alg->histogramPulseFilter;
+  const bool filterPulses = histogramming && !pulseFilter.empty();
+  bool keepPulse = !filterPulses || isInFilter(pulseFilter, pulsetime);
+  Mantid::Types::Core::DateAndTime filteredPulse = pulsetime;
+  size_t myHistogrammedEvents = 0;
 
   // Which detector IDs were touched? - only matters if compress is on
   std::vector<bool> usedDetIds;
@@ -145,6 +172,10 @@ void ProcessBankData::run() { // override {
       if (breakOut)
         break;
     }
+    if (filterPulses && pulsetime != filteredPulse) {
+      keepPulse = isInFilter(pulseFilter, pulsetime);
+      filteredPulse = pulsetime;
+    }
 
     // We cached a pointer to the vector<tofEvent> -> so retrieve it and add
     // the event
@@ -153,8 +184,29 @@ void ProcessBankData::run() { // override {
       // Create the tofevent
       double tof = static_cast<double>(event_time_of_flight[i]);
       if ((tof >= alg->filter_tof_min) && (tof <= alg->filter_tof_max)) {
-        // Handle simulated data if present
-        if (have_weight) {
+        if (histogramming) {
+          // Add the event straight to its histogram
+          double *counts = m_loader.histogramCounts[periodIndex][detId];
+          // NULL counts indicates a bad spectrum lookup
+          if (!counts) {
+            ++my_discarded_events;
+          } else if (keepPulse) {
+            const size_t bin =
+                m_loader.histogrammer->findBin(tof + alg->histogramTofOffset);
+            if (bin < m_loader.histogrammer->numberOfBins()) {
+              if (have_weight) {
+                const double weight = static_cast<double>(event_weight[i]);
+                counts[bin] += weight;
+                m_loader.histogramErrors[periodIndex][detId][bin] +=
+                    weight * weight;
+              } else {
+                counts[bin] += 1.;
+              }
+              ++myHistogrammedEvents;
+            }
+          }
+        } else if (have_weight) {
+          // Handle simulated data if present
           double weight = static_cast<double>(event_weight[i]);
           double errorSq = weight * weight;
           auto *eventVector = m_loader.weightedEventVectors[periodIndex][detId];
@@ -235,6 +287,7 @@ void ProcessBankData::run() { // override {
     }
     alg->bad_tofs += badTofs;
     alg->discarded_events += my_discarded_events;
+    alg->histogrammed_events += myHistogrammedEvents;
   }
 
 #ifndef _WIN32
@@ -0,0 +1,161 @@
+#ifndef MANTID_DATAHANDLING_BANKLOADPIPELINETEST_H_
+#define MANTID_DATAHANDLING_BANKLOADPIPELINETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataHandling/BankLoadPipeline.h"
+#include "MantidKernel/make_unique.h"
+
+#include <atomic>
+#include <stdexcept>
+
+using Mantid::DataHandling::BankLoadPipeline;
+using Mantid::Kernel::Task;
+
+namespace {
+/// Counts the events it "processes"
+class CountingTask : public Task {
+public:
+  CountingTask(std::atomic<size_t> &processed, size_t numEvents)
+      : m_processed(processed), m_numEvents(numEvents) {}
+  void run() override { m_processed += m_numEvents; }
+
+private:
+  std::atomic<size_t> &m_processed;
+  size_t m_numEvents;
+};
+
+/// Stands in for LoadBankFromDiskTask: hands two process tasks to the pipeline
+class ReadTask : public Task {
+public:
+  ReadTask(BankLoadPipeline &pipeline, std::atomic<size_t> &processed,
+           std::vector<size_t> &readOrder, size_t numEvents)
+      : m_pipeline(pipeline), m_processed(processed), m_readOrder(readOrder),
+        m_numEvents(numEvents) {
+    m_cost = static_cast<double>(numEvents);
+  }
+  void run() override {
+    m_readOrder.push_back(m_numEvents);
+    std::vector<std::unique_ptr<Task>> tasks;
+    tasks.push_back(Mantid::Kernel::make_unique<CountingTask>(
+        m_processed, m_numEvents / 2));
+    tasks.push_back(Mantid::Kernel::make_unique<CountingTask>(
+        m_processed, m_numEvents - m_numEvents / 2));
+    m_pipeline.pushProcessTasks(std::move(tasks));
+  }
+
+private:
+  BankLoadPipeline &m_pipeline;
+  std::atomic<size_t> &m_processed;
+  std::vector<size_t> &m_readOrder;
+  size_t m_numEvents;
+};
+
+class ThrowingTask : public Task {
+  void run() override { throw std::runtime_error("corrupt bank"); }
+};
+} // namespace
+
+class BankLoadPipelineTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BankLoadPipelineTest *createSuite() {
+    return new BankLoadPipelineTest();
+  }
+  static void destroySuite(BankLoadPipelineTest *suite) { delete suite; }
+
+  void test_all_banks_are_processed() {
+    BankLoadPipeline pipeline(2, 3);
+    std::atomic<size_t> processed(0);
+    std::vector<size_t> readOrder;
+    size_t expected = 0;
+    for (size_t numEvents = 1; numEvents <= 50; ++numEvents) {
+      pipeline.addReadTask(Mantid::Kernel::make_unique<ReadTask>(
+          pipeline, processed, readOrder, numEvents));
+      expected += numEvents;
+    }
+    TS_ASSERT_THROWS_NOTHING(pipeline.run());
+    TS_ASSERT_EQUALS(processed.load(), expected);
+    TS_ASSERT_EQUALS(readOrder.size(), 50);
+    TS_ASSERT_LESS_THAN_EQUALS(pipeline.maxQueued(), 2);
+    TS_ASSERT_LESS_THAN(0, pipeline.maxQueued());
+  }
+
+  void test_largest_banks_are_read_first() {
+    BankLoadPipeline pipeline(4, 1);
+    std::atomic<size_t> processed(0);
+    std::vector<size_t> readOrder;
+    for (const size_t numEvents : {10, 300, 20, 4000, 5})
+      pipeline.addReadTask(Mantid::Kernel::make_unique<ReadTask>(
+          pipeline, processed, readOrder, numEvents));
+    pipeline.run();
+    TS_ASSERT_EQUALS(readOrder, std::vector<size_t>({4000, 300, 20, 10, 5}));
+  }
+
+  void test_queue_depth_of_one() {
+    BankLoadPipeline pipeline(1, 2);
+    std::atomic<size_t> processed(0);
+    std::vector<size_t> readOrder;
+    for (size_t i = 0; i < 20; ++i)
+      pipeline.addReadTask(Mantid::Kernel::make_unique<ReadTask>(
+          pipeline, processed, readOrder, 100));
+    pipeline.run();
+    TS_ASSERT_EQUALS(processed.load(), 2000);
+    TS_ASSERT_EQUALS(pipeline.maxQueued(), 1);
+  }
+
+  void test_timings() {
+    BankLoadPipeline pipeline(2, 2);
+    std::atomic<size_t> processed(0);
+    std::vector<size_t> readOrder;
+    pipeline.addReadTask(Mantid::Kernel::make_unique<ReadTask>(
+        pipeline, processed, readOrder, 100));
+    pipeline.run();
+    const auto &timings = pipeline.timings();
+    TS_ASSERT_LESS_THAN_EQUALS(0., timings.read);
+    TS_ASSERT_LESS_THAN_EQUALS(0., timings.readBlocked);
+    TS_ASSERT_LESS_THAN_EQUALS(0., timings.process);
+    TS_ASSERT_LESS_THAN_EQUALS(0., timings.processIdle);
+    TS_ASSERT_DIFFERS(pipeline.timingSummary().find("2 threads"),
+                      std::string::npos);
+  }
+
+  void test_nothing_to_read() {
+    BankLoadPipeline pipeline(4, 4);
+    TS_ASSERT_THROWS_NOTHING(pipeline.run());
+    TS_ASSERT_EQUALS(pipeline.maxQueued(), 0);
+  }
+
+  void test_read_error_is_rethrown() {
+    BankLoadPipeline pipeline(1, 2);
+    std::atomic<size_t> processed(0);
+    std::vector<size_t> readOrder;
+    for (size_t i = 0; i < 10; ++i)
+      pipeline.addReadTask(Mantid::Kernel::make_unique<ReadTask>(
+          pipeline, processed, readOrder, 100));
+    pipeline.addReadTask(Mantid::Kernel::make_unique<ThrowingTask>());
+    TS_ASSERT_THROWS(pipeline.run(), std::runtime_error);
+  }
+
+  void test_process_error_is_rethrown() {
+    BankLoadPipeline pipeline(2, 2);
+    std::atomic<size_t> processed(0);
+    std::vector<size_t> readOrder;
+    for (size_t i = 0; i < 10; ++i)
+      pipeline.addReadTask(Mantid::Kernel::make_unique<ReadTask>(
+          pipeline, processed, readOrder, 100));
+    std::vector<std::unique_ptr<Task>> tasks;
+    tasks.push_back(Mantid::Kernel::make_unique<ThrowingTask>());
+    pipeline.pushProcessTasks(std::move(tasks));
+    TS_ASSERT_THROWS(pipeline.run(), std::runtime_error);
+    // The pipeline can be reused once an error has been reported
+    pipeline.addReadTask(Mantid::Kernel::make_unique<ReadTask>(
+        pipeline, processed, readOrder, 100));
+    processed = 0;
+    TS_ASSERT_THROWS_NOTHING(pipeline.run());
+    TS_ASSERT_EQUALS(processed.load(), 100);
+  }
+};
+
+#endif /* MANTID_DATAHANDLING_BANKLOADPIPELINETEST_H_ */
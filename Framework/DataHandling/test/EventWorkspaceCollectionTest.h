@@ -167,6 +167,35 @@ public:
       TS_ASSERT_EQUALS(eventWS->sample().getThickness(), thickness);
     }
   }
+
+  void test_histogram_workspaces() {
+    EventWorkspaceCollection collection;
+    auto periodLog = make_unique<const TimeSeriesProperty<int>>("period_log");
+    const size_t periods = 2;
+    collection.setNPeriods(periods, periodLog);
+    collection.setIndexInfo(Indexing::IndexInfo({3, 1, 2}));
+
+    const auto histograms = collection.createHistogramWorkspaces(
+        HistogramData::BinEdges{0.0, 1.0, 2.0});
+    TS_ASSERT_EQUALS(histograms.size(), periods);
+    for (const auto &ws : histograms) {
+      TS_ASSERT_EQUALS(ws->getNumberHistograms(), 3);
+      TS_ASSERT_EQUALS(ws->getSpectrum(0).getSpectrumNo(), 3);
+      TS_ASSERT_EQUALS(ws->blocksize(), 2);
+    }
+
+    // Changes made after the histograms were created are picked up
+    const float thickness = static_cast<float>(1.23);
+    collection.setThickness(thickness);
+    const auto ws = boost::dynamic_pointer_cast<WorkspaceGroup>(
+        collection.combinedHistogramWorkspace(histograms));
+    TSM_ASSERT("Should be a WorkspaceGroup", ws);
+    TS_ASSERT_EQUALS(ws->size(), periods);
+    for (size_t i = 0; i < periods; ++i) {
+      TS_ASSERT_EQUALS(ws->getItem(i), histograms[i]);
+      TS_ASSERT_EQUALS(histograms[i]->sample().getThickness(), thickness);
+    }
+  }
 };
 
 #endif /* MANTID_DATAHANDLING_EventWorkspaceCollectionTEST_H_ */
@@ -8,7 +8,10 @@
 #include "MantidAPI/Run.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/Workspace.h"
+#include "MantidDataObjects/EventCacheFile.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/Workspace2D.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidDataHandling/LoadEventNexus.h"
@@ -22,6 +25,8 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include <Poco/File.h>
+
 using namespace Mantid;
 using namespace Mantid::Geometry;
 using namespace Mantid::API;
@@ -48,6 +53,23 @@ load_reference_workspace(const std::string &filename) {
   return boost::dynamic_pointer_cast<const EventWorkspace>(out);
 }
 
+/// Load CNCS_7860 with an event cache, filtered by a minimum tof if given
+EventWorkspace_sptr load_with_event_cache(const std::string &cacheFile,
+                                          const std::string &tofMin = "") {
+  LoadEventNexus ld;
+  ld.setChild(true);
+  ld.initialize();
+  ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+  ld.setPropertyValue("OutputWorkspace", "dummy");
+  ld.setPropertyValue("EventCacheFile", cacheFile);
+  ld.setPropertyValue("FilterByTofMin", tofMin);
+  ld.setProperty<bool>("LoadLogs", false); // Time-saver
+  ld.execute();
+  TS_ASSERT(ld.isExecuted());
+  Workspace_sptr ws = ld.getProperty("OutputWorkspace");
+  return boost::dynamic_pointer_cast<EventWorkspace>(ws);
+}
+
 void run_MPI_load(const Parallel::Communicator &comm,
                   boost::shared_ptr<std::mutex> mutex,
                   const std::string &filename) {
@@ -499,6 +521,44 @@ public:
     TS_ASSERT_DELTA(monWS->readE(0)[0], 0, 1e-6);
   }
 
+  void test_CompactEvents_keeps_every_event_of_each_chunk() {
+    Mantid::API::FrameworkManager::Instance();
+    auto load = [](const int chunk, const bool compact) {
+      LoadEventNexus ld;
+      ld.setChild(true);
+      ld.initialize();
+      ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+      ld.setPropertyValue("OutputWorkspace", "dummy");
+      ld.setProperty("ChunkNumber", chunk);
+      ld.setProperty("TotalChunks", 3);
+      ld.setProperty("CompactEvents", compact);
+      ld.setProperty<bool>("LoadLogs", false); // Time-saver
+      ld.execute();
+      TS_ASSERT(ld.isExecuted());
+      Workspace_sptr ws = ld.getProperty("OutputWorkspace");
+      return boost::dynamic_pointer_cast<EventWorkspace>(ws);
+    };
+    for (int chunk = 1; chunk <= 3; ++chunk) {
+      const auto expected = load(chunk, false);
+      const auto compact = load(chunk, true);
+      TS_ASSERT_EQUALS(compact->getNumberEvents(),
+                       expected->getNumberEvents());
+      size_t notCompact = 0;
+      size_t different = 0;
+      for (size_t wi = 0; wi < expected->getNumberHistograms(); ++wi) {
+        const auto &events = compact->getSpectrum(wi);
+        if (events.getStorageMode() != COMPACT_STORAGE)
+          ++notCompact;
+        if (events.getNumberEvents() !=
+                expected->getSpectrum(wi).getNumberEvents() ||
+            compact->readY(wi) != expected->readY(wi))
+          ++different;
+      }
+      TS_ASSERT_EQUALS(notCompact, 0);
+      TS_ASSERT_EQUALS(different, 0);
+    }
+  }
+
   void test_Load_And_CompressEvents() {
     Mantid::API::FrameworkManager::Instance();
     LoadEventNexus ld;
@@ -563,6 +623,108 @@ public:
                              ->monitorWorkspace());
   }
 
+  void test_HistogramBinning_matches_Rebin() {
+    Mantid::API::FrameworkManager::Instance();
+    const std::string params = "40000,100,75000";
+    LoadEventNexus histogramLoader;
+    histogramLoader.setChild(true);
+    histogramLoader.initialize();
+    histogramLoader.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    histogramLoader.setPropertyValue("OutputWorkspace", "dummy");
+    histogramLoader.setPropertyValue("HistogramBinning", params);
+    histogramLoader.setProperty<bool>("LoadLogs", false); // Time-saver
+    histogramLoader.execute();
+    TS_ASSERT(histogramLoader.isExecuted());
+    Workspace_sptr outWS = histogramLoader.getProperty("OutputWorkspace");
+    auto histograms = boost::dynamic_pointer_cast<Workspace2D>(outWS);
+    TSM_ASSERT("The output should be a Workspace2D", histograms);
+
+    LoadEventNexus eventLoader;
+    eventLoader.setChild(true);
+    eventLoader.initialize();
+    eventLoader.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    eventLoader.setPropertyValue("OutputWorkspace", "dummy");
+    eventLoader.setProperty<bool>("LoadLogs", false);
+    eventLoader.execute();
+    Workspace_sptr events = eventLoader.getProperty("OutputWorkspace");
+    auto rebin = AlgorithmManager::Instance().createUnmanaged("Rebin");
+    rebin->initialize();
+    rebin->setChild(true);
+    rebin->setProperty("InputWorkspace", events);
+    rebin->setPropertyValue("OutputWorkspace", "dummy");
+    rebin->setPropertyValue("Params", params);
+    rebin->setProperty("PreserveEvents", false);
+    rebin->execute();
+    MatrixWorkspace_sptr expected = rebin->getProperty("OutputWorkspace");
+
+    TS_ASSERT_EQUALS(histograms->getNumberHistograms(),
+                     expected->getNumberHistograms());
+    TS_ASSERT_EQUALS(histograms->getSpectrum(1234).getDetectorIDs(),
+                     expected->getSpectrum(1234).getDetectorIDs());
+    for (size_t wi = 0; wi < expected->getNumberHistograms(); ++wi) {
+      TS_ASSERT_EQUALS(histograms->x(wi).rawData(), expected->x(wi).rawData());
+      TS_ASSERT_EQUALS(histograms->y(wi).rawData(), expected->y(wi).rawData());
+      TS_ASSERT_EQUALS(histograms->e(wi).rawData(), expected->e(wi).rawData());
+      if (histograms->y(wi).rawData() != expected->y(wi).rawData())
+        break;
+    }
+  }
+
+  void test_EventCacheFile_is_written_then_mapped() {
+    const std::string cacheFile =
+        ConfigService::Instance().getString("defaultsave.directory") +
+        "LoadEventNexusTest.evc";
+    auto written = load_with_event_cache(cacheFile);
+    TS_ASSERT(Poco::File(cacheFile).exists());
+    auto mapped = load_with_event_cache(cacheFile);
+    auto filtered = load_with_event_cache(cacheFile, "45000");
+
+    TS_ASSERT_EQUALS(written->getNumberEvents(), 112266);
+    TS_ASSERT_EQUALS(mapped->getNumberEvents(), written->getNumberEvents());
+    TS_ASSERT_EQUALS(mapped->getSpectrum(1234).getStorageMode(),
+                     MAPPED_STORAGE);
+    TS_ASSERT_EQUALS(mapped->x(1234).rawData(), written->x(1234).rawData());
+    TS_ASSERT_EQUALS(mapped->y(1234).rawData(), written->y(1234).rawData());
+    // Other filtering options replace the cached events
+    TS_ASSERT_LESS_THAN(filtered->getNumberEvents(),
+                        written->getNumberEvents());
+    // Unmap the files before removing them
+    written.reset();
+    mapped.reset();
+    filtered.reset();
+    for (const auto &name : EventCacheFile::existingNames(cacheFile))
+      Poco::File(name).remove();
+  }
+
+  void test_EventCacheFile_in_use_is_mapped_without_writing_it_again() {
+    const std::string directory =
+        ConfigService::Instance().getString("defaultsave.directory");
+    const std::string cacheFile = directory + "LoadEventNexusTest.evc";
+    const std::string numbered = directory + "LoadEventNexusTest-1.evc";
+
+    // Reloading while the workspace loaded first still maps the file
+    auto written = load_with_event_cache(cacheFile);
+    auto mapped = load_with_event_cache(cacheFile);
+    TS_ASSERT_EQUALS(mapped->getSpectrum(1234).getStorageMode(),
+                     MAPPED_STORAGE);
+    TS_ASSERT_EQUALS(mapped->getNumberEvents(), written->getNumberEvents());
+    TS_ASSERT_EQUALS(EventCacheFile::existingNames(cacheFile),
+                     std::vector<std::string>({cacheFile}));
+    written.reset();
+    mapped.reset();
+
+    // Events written next to a file in use are found there
+    Poco::File(cacheFile).renameTo(numbered);
+    auto fromNumbered = load_with_event_cache(cacheFile);
+    TS_ASSERT_EQUALS(fromNumbered->getSpectrum(1234).getStorageMode(),
+                     MAPPED_STORAGE);
+    TS_ASSERT_EQUALS(fromNumbered->getNumberEvents(), 112266);
+    TS_ASSERT(!Poco::File(cacheFile).exists());
+    fromNumbered.reset();
+    for (const auto &name : EventCacheFile::existingNames(cacheFile))
+      Poco::File(name).remove();
+  }
+
   void doTestSingleBank(bool SingleBankPixelsOnly, bool Precount,
                         std::string BankName = "bank36",
                         bool willFail = false) {
@@ -49,6 +49,10 @@ public:
   const std::string &getFileName() const override { return m_fileName; }
   /**Return the size of the NeXus data block used in NeXus data array*/
   size_t getDataChunk() const override { return m_dataChunk; }
+  /// Compress the event data created by the next openFile() calls
+  void setCompression(const bool compress) { m_compress = compress; }
+  /// @return true if new event data are compressed
+  bool getCompression() const { return m_compress; }
 
   bool openFile(const std::string &fileName, const std::string &mode) override;
 
@@ -94,6 +98,8 @@ private:
   /// The size of the events block which can be written in the neXus array at
   /// once (continious part of the data block)
   size_t m_dataChunk;
+  /// compress the event data of new files, chunk by chunk
+  bool m_compress;
   /// shared pointer to the box controller, which is repsoponsible for this IO
   API::BoxController *const m_bc;
   //------
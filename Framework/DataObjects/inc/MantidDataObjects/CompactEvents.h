@@ -0,0 +1,137 @@
+#ifndef MANTID_DATAOBJECTS_COMPACTEVENTS_H_
+#define MANTID_DATAOBJECTS_COMPACTEVENTS_H_
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/Events.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** An event held in 8 bytes: a single precision time-of-flight and the index
+ * of its pulse time in the pulse time table of the CompactEvents holding it.
+ */
+struct CompactEvent {
+  /// Time-of-flight (or whatever unit the X axis is in)
+  float m_tof;
+  /// Index of the pulse time in CompactEvents::pulseTimes()
+  uint32_t m_pulseIndex;
+
+  /// @return the time-of-flight
+  double tof() const { return m_tof; }
+};
+
+/** CompactEvents : Compact storage for the events of an EventList.
+
+  Each event is a CompactEvent of 8 bytes, half the size of a TofEvent. Pulse
+  times are not stored per event but in a table of the distinct pulse times of
+  the list, which each event refers to by index; a run has far fewer pulses
+  than events. Weights and squared errors, when the events have them, are held
+  in separate single precision arrays, as they are in WeightedEvent. A
+  WeightedEvent therefore takes 16 bytes instead of 32.
+
+  Times-of-flight are held in single precision, which is the precision event
+  NeXus files record them with, so events loaded from a file are stored
+  exactly. Other times-of-flight, e.g. after a unit conversion, are rounded to
+  the nearest float when they are stored: unlike the other storage modes this
+  loses precision, with a relative error of at most 2^-24 (about 6e-8) per
+  event. Weights and squared errors are single precision in WeightedEvent
+  already, so they are stored exactly. Converting back
+  to TofEvent, WeightedEvent or WeightedEventNoTime and again to compact
+  storage is lossless.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL CompactEvents {
+public:
+  void assign(const std::vector<Types::Event::TofEvent> &events);
+  void assign(const std::vector<WeightedEvent> &events);
+  void assign(const std::vector<WeightedEventNoTime> &events);
+
+  void copyTo(std::vector<Types::Event::TofEvent> &events) const;
+  void copyTo(std::vector<WeightedEvent> &events) const;
+  void copyTo(std::vector<WeightedEventNoTime> &events) const;
+
+  void push_back(const Types::Event::TofEvent &event);
+  void push_back(const WeightedEvent &event);
+  void push_back(const WeightedEventNoTime &event);
+
+  /// @return the number of events held
+  size_t size() const { return m_events.size(); }
+  /// @return true if no events are held
+  bool empty() const { return m_events.empty(); }
+  /// @return true if the events carry a pulse time
+  bool hasPulseTimes() const { return !m_pulseTimes.empty(); }
+  /// @return true if the events carry a weight and error
+  bool hasWeights() const { return !m_weight.empty(); }
+
+  void addWeights();
+  void removePulseTimes();
+
+  void clear();
+  void reserve(size_t num);
+  size_t getMemorySize() const;
+
+  void sortTof();
+  void sortPulseTime();
+  void sortPulseTimeTof();
+  void reverse();
+  void erase(size_t first, size_t last);
+
+  void copyTofs(size_t first, size_t count, double *tofs) const;
+
+  /// @return the events
+  std::vector<CompactEvent> &events() { return m_events; }
+  /// @return the events
+  const std::vector<CompactEvent> &events() const { return m_events; }
+  /// @return the table of pulse times, in nanoseconds since the epoch
+  const std::vector<int64_t> &pulseTimes() const { return m_pulseTimes; }
+  /// @return the weight of each event
+  const std::vector<float> &weights() const { return m_weight; }
+  /// @return the squared error of each event
+  const std::vector<float> &errorSquareds() const { return m_errorSquared; }
+
+private:
+  void buildPulseTable(std::vector<int64_t> pulseTimes);
+  uint32_t pulseIndex(const int64_t pulseTime);
+  void applyOrder(const std::vector<size_t> &order);
+
+  /// The events
+  std::vector<CompactEvent> m_events;
+  /// Distinct pulse times, as total nanoseconds. Empty for WeightedEventNoTime.
+  std::vector<int64_t> m_pulseTimes;
+  /// True if m_pulseTimes is sorted, and so can be searched
+  bool m_pulseTimesSorted = true;
+  /// Indices into m_pulseTimes in order of time, once it is not sorted
+  std::vector<uint32_t> m_pulseOrder;
+  /// Event weights. Empty for TofEvent.
+  std::vector<float> m_weight;
+  /// Squared errors of the event weights. Empty for TofEvent.
+  std::vector<float> m_errorSquared;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_COMPACTEVENTS_H_ */
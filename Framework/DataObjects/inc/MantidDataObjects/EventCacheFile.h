@@ -0,0 +1,106 @@
+#ifndef MANTID_DATAOBJECTS_EVENTCACHEFILE_H_
+#define MANTID_DATAOBJECTS_EVENTCACHEFILE_H_
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/MappedEvents.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+class EventWorkspace;
+
+/** EventCacheFile : A native on-disk copy of the events of an EventWorkspace,
+  which is memory-mapped to give the workspace its events without reading or
+  copying them.
+
+  The file holds a header, the signature given when the file was written (used
+  by the writer to tell whether the file is still a valid copy of its source),
+  an index with the offset, count and type of the events of each spectrum and
+  then the events of each spectrum. The events are stored sorted by
+  time-of-flight, in the in-memory layout of TofEvent, WeightedEvent or
+  WeightedEventNoTime and aligned to 64 bytes, so they can be used in place.
+  The file is only meaningful on machines with the byte order and struct
+  layout of the one that wrote it; open() rejects any other file.
+
+  mapInto() puts the spectra of a workspace into MAPPED_STORAGE. Reading the
+  events (histogramming, integrating, time-of-flight ranges) then touches only
+  the pages of the file that are needed. Anything that modifies the events of
+  a spectrum first copies them into memory.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL EventCacheFile
+    : public std::enable_shared_from_this<EventCacheFile> {
+public:
+  static std::string write(const std::string &filename,
+                           const EventWorkspace &workspace,
+                           const std::string &signature);
+  static std::shared_ptr<EventCacheFile> open(const std::string &filename);
+  static std::vector<std::string> existingNames(const std::string &filename);
+
+  /// @return the signature the file was written with
+  const std::string &signature() const { return m_signature; }
+  /// @return the number of spectra in the file
+  size_t getNumberHistograms() const { return m_numberOfSpectra; }
+  /// @return the total number of events in the file
+  size_t getNumberEvents() const { return m_numberOfEvents; }
+  /// @return the smallest time-of-flight in the file
+  double getTofMin() const { return m_tofMin; }
+  /// @return the largest time-of-flight in the file
+  double getTofMax() const { return m_tofMax; }
+
+  MappedEvents events(size_t index) const;
+  void mapInto(EventWorkspace &workspace) const;
+
+private:
+  explicit EventCacheFile(const std::string &filename);
+  const char *indexEntry(size_t index) const;
+
+  /// The file
+  boost::interprocess::file_mapping m_file;
+  /// The whole file, mapped read-only
+  boost::interprocess::mapped_region m_region;
+  /// Signature the file was written with
+  std::string m_signature;
+  /// Number of spectra
+  size_t m_numberOfSpectra;
+  /// Number of events
+  size_t m_numberOfEvents;
+  /// Smallest time-of-flight
+  double m_tofMin;
+  /// Largest time-of-flight
+  double m_tofMax;
+  /// Offset of the index from the start of the file
+  size_t m_indexOffset;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_EVENTCACHEFILE_H_ */
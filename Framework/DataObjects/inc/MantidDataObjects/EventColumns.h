@@ -0,0 +1,121 @@
+#ifndef MANTID_DATAOBJECTS_EVENTCOLUMNS_H_
+#define MANTID_DATAOBJECTS_EVENTCOLUMNS_H_
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/Events.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** EventColumns : Structure-of-arrays storage for the events of an EventList.
+
+  Instead of holding a vector of TofEvent/WeightedEvent/WeightedEventNoTime,
+  the time-of-flight, pulse time, weight and squared error of each event are
+  held in separate contiguous arrays. Operations that only need the
+  time-of-flight (histogramming, unit conversion, masking) then only stream
+  the tof column through the cache.
+
+  Only the columns that are meaningful for the type of event stored are
+  filled: pulse times for TofEvent and WeightedEvent, weights and errors for
+  WeightedEvent and WeightedEventNoTime. Conversion to and from the
+  array-of-structs event vectors is lossless.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL EventColumns {
+public:
+  void assign(const std::vector<Types::Event::TofEvent> &events);
+  void assign(const std::vector<WeightedEvent> &events);
+  void assign(const std::vector<WeightedEventNoTime> &events);
+
+  void copyTo(std::vector<Types::Event::TofEvent> &events) const;
+  void copyTo(std::vector<WeightedEvent> &events) const;
+  void copyTo(std::vector<WeightedEventNoTime> &events) const;
+
+  /// Append a TofEvent to the tof and pulse time columns
+  inline void push_back(const Types::Event::TofEvent &event) {
+    m_tof.push_back(event.tof());
+    m_pulseTime.push_back(event.pulseTime().totalNanoseconds());
+  }
+  /// Append a WeightedEvent to all the columns
+  inline void push_back(const WeightedEvent &event) {
+    m_tof.push_back(event.tof());
+    m_pulseTime.push_back(event.pulseTime().totalNanoseconds());
+    m_weight.push_back(event.m_weight);
+    m_errorSquared.push_back(event.m_errorSquared);
+  }
+  /// Append a WeightedEventNoTime to the tof, weight and error columns
+  inline void push_back(const WeightedEventNoTime &event) {
+    m_tof.push_back(event.tof());
+    m_weight.push_back(event.m_weight);
+    m_errorSquared.push_back(event.m_errorSquared);
+  }
+
+  /// @return the number of events held
+  size_t size() const { return m_tof.size(); }
+  /// @return true if no events are held
+  bool empty() const { return m_tof.empty(); }
+  /// @return true if the events carry a pulse time
+  bool hasPulseTimes() const { return !m_pulseTime.empty(); }
+  /// @return true if the events carry a weight and error
+  bool hasWeights() const { return !m_weight.empty(); }
+
+  void addWeights();
+  void removePulseTimes();
+
+  void clear();
+  void reserve(size_t num);
+  size_t getMemorySize() const;
+
+  void sortTof();
+  void reverse();
+  void erase(size_t first, size_t last);
+
+  /// @return the time-of-flight column
+  std::vector<double> &tofs() { return m_tof; }
+  /// @return the time-of-flight column
+  const std::vector<double> &tofs() const { return m_tof; }
+  /// @return the pulse time column, in nanoseconds since the epoch
+  const std::vector<int64_t> &pulseTimes() const { return m_pulseTime; }
+  /// @return the weight column
+  const std::vector<float> &weights() const { return m_weight; }
+  /// @return the squared error column
+  const std::vector<float> &errorSquareds() const { return m_errorSquared; }
+
+private:
+  /// Times-of-flight (or whatever unit the X axis is in)
+  std::vector<double> m_tof;
+  /// Pulse times as total nanoseconds. Empty for WeightedEventNoTime.
+  std::vector<int64_t> m_pulseTime;
+  /// Event weights. Empty for TofEvent.
+  std::vector<float> m_weight;
+  /// Squared errors of the event weights. Empty for TofEvent.
+  std::vector<float> m_errorSquared;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_EVENTCOLUMNS_H_ */
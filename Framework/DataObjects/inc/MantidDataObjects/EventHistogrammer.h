@@ -0,0 +1,122 @@
+#ifndef MANTID_DATAOBJECTS_EVENTHISTOGRAMMER_H_
+#define MANTID_DATAOBJECTS_EVENTHISTOGRAMMER_H_
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/Events.h"
+#include "MantidKernel/cow_ptr.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** EventHistogrammer : Finds the bins of events for a fixed set of bin
+  boundaries and accumulates them into a histogram.
+
+  The bin boundaries are classified once, on construction:
+  - Linear: all bins (except possibly a shorter last one) have the same
+    width. The bin of an event is computed in closed form.
+  - Logarithmic: all bins (except possibly a shorter last one) have the same
+    width in log space. The bin of an event is computed in closed form.
+  - Arbitrary: the bin of an event is found with a branch-free binary search.
+
+  The closed form index computation for linear bins is vectorised with AVX or
+  SSE2 where available; the instruction set is chosen at runtime, with a scalar
+  fallback. Closed form results are always checked against the actual bin
+  boundaries, so the result is identical to a search whatever the rounding.
+
+  Events do not need to be sorted. Events outside [X.front(), X.back()) are
+  ignored, as in EventList::generateHistogram(). When the caller knows the
+  events are sorted and there are at least as many events as bins, the bin
+  boundaries are located in the events instead, which is cheaper than
+  binning every event.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL EventHistogrammer {
+public:
+  /// Classification of the bin boundaries
+  enum class Binning { Linear, Logarithmic, Arbitrary };
+
+  EventHistogrammer(const MantidVec &X, const bool vectorise = true);
+
+  /// @return the classification of the bin boundaries
+  Binning binning() const { return m_binning; }
+  /// @return the number of bins
+  size_t numberOfBins() const { return m_numBins; }
+
+  size_t findBin(const double tof) const;
+
+  void addCounts(const double *tofs, const size_t numEvents, double *Y,
+                 const bool sorted = false) const;
+  void addWeights(const double *tofs, const float *weights,
+                  const float *errorSquareds, const size_t numEvents,
+                  double *Y, double *E, const bool sorted = false) const;
+
+  void addCounts(const std::vector<Types::Event::TofEvent> &events,
+                 MantidVec &Y, const bool sorted = false) const;
+  template <class T>
+  void addWeights(const std::vector<T> &events, MantidVec &Y, MantidVec &E,
+                  const bool sorted = false) const;
+
+  static std::string instructionSet();
+
+  /// Signature of the kernels computing first guesses of the bin indices
+  using GuessKernel = void (*)(const double *, const size_t, const double,
+                               const double, const double, int32_t *);
+
+private:
+  void guessBins(const double *tofs, const size_t numEvents,
+                 int32_t *guesses) const;
+  size_t resolveBin(const double tof, const int32_t guess) const;
+
+  template <class Accumulate>
+  void forEachBin(const double *tofs, const size_t numEvents,
+                  Accumulate accumulate) const;
+  template <class T, class Accumulate>
+  void forEachEventBin(const std::vector<T> &events,
+                       Accumulate accumulate) const;
+  template <class TofAt, class AddRange>
+  void forEachSortedRange(const size_t numEvents, TofAt tofAt,
+                          AddRange addRange) const;
+  bool useSortedRanges(const bool sorted, const size_t numEvents) const;
+
+  /// The bin boundaries
+  const MantidVec &m_edges;
+  /// Number of bins
+  size_t m_numBins;
+  /// Classification of the bin boundaries
+  Binning m_binning;
+  /// Origin of the closed form: X[0], or log(X[0]) for logarithmic bins
+  double m_origin;
+  /// Inverse of the bin width, in log space for logarithmic bins
+  double m_inverseWidth;
+  /// Kernel used for linear bins
+  GuessKernel m_linearKernel;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_EVENTHISTOGRAMMER_H_ */
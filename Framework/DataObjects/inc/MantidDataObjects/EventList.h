@@ -2,7 +2,10 @@
 #define MANTID_DATAOBJECTS_EVENTLIST_H_ 1
 
 #include "MantidAPI/IEventList.h"
+#include "MantidDataObjects/CompactEvents.h"
+#include "MantidDataObjects/EventColumns.h"
 #include "MantidDataObjects/Events.h"
+#include "MantidDataObjects/MappedEvents.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/cow_ptr.h"
@@ -21,6 +24,7 @@ typedef std::vector<SplittingInterval> TimeSplitterType;
 class Unit;
 } // namespace Kernel
 namespace DataObjects {
+class EventHistogrammer;
 class EventWorkspaceMRU;
 
 /// How the event list is sorted.
@@ -33,6 +37,18 @@ enum EventSortType {
   TIMEATSAMPLE_SORT
 };
 
+/// How the events are laid out in memory.
+enum EventStorageMode {
+  /// One vector of event structs (TofEvent, WeightedEvent, ...)
+  ROW_STORAGE,
+  /// Separate tof/pulse time/weight/error arrays, see EventColumns
+  COLUMN_STORAGE,
+  /// 8-byte events with a table of pulse times, see CompactEvents
+  COMPACT_STORAGE,
+  /// Read-only events in a memory-mapped EventCacheFile, see MappedEvents
+  MAPPED_STORAGE
+};
+
 //==========================================================================================
 /** @class Mantid::DataObjects::EventList
 
@@ -119,7 +135,14 @@ public:
    * @param event :: TofEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const Types::Event::TofEvent &event) {
-    this->events.push_back(event);
+    if (m_storageMode == MAPPED_STORAGE)
+      this->ensureRowStorage();
+    if (m_storageMode == COLUMN_STORAGE)
+      this->addStoredEvent(m_columns, event);
+    else if (m_storageMode == COMPACT_STORAGE)
+      this->addStoredEvent(m_compact, event);
+    else
+      this->events.push_back(event);
     this->order = UNSORTED;
   }
 
@@ -129,7 +152,14 @@ public:
    * @param event :: WeightedEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEvent &event) {
-    this->weightedEvents.push_back(event);
+    if (m_storageMode == MAPPED_STORAGE)
+      this->ensureRowStorage();
+    if (m_storageMode == COLUMN_STORAGE)
+      this->addStoredEvent(m_columns, event);
+    else if (m_storageMode == COMPACT_STORAGE)
+      this->addStoredEvent(m_compact, event);
+    else
+      this->weightedEvents.push_back(event);
     this->order = UNSORTED;
   }
 
@@ -139,7 +169,14 @@ public:
    * @param event :: WeightedEventNoTime to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEventNoTime &event) {
-    this->weightedEventsNoTime.push_back(event);
+    if (m_storageMode == MAPPED_STORAGE)
+      this->ensureRowStorage();
+    if (m_storageMode == COLUMN_STORAGE)
+      this->addStoredEvent(m_columns, event);
+    else if (m_storageMode == COMPACT_STORAGE)
+      this->addStoredEvent(m_compact, event);
+    else
+      this->weightedEventsNoTime.push_back(event);
     this->order = UNSORTED;
   }
 
@@ -147,6 +184,16 @@ public:
 
   void switchTo(Mantid::API::EventType newType) override;
 
+  void setStorageMode(const EventStorageMode mode);
+
+  EventStorageMode getStorageMode() const;
+
+  void mapEvents(const MappedEvents &events);
+
+  void setSortBeforeHistogram(const bool sort);
+
+  bool getSortBeforeHistogram() const;
+
   WeightedEvent getEvent(size_t event_number);
 
   std::vector<Types::Event::TofEvent> &getEvents();
@@ -398,6 +445,22 @@ private:
   /// MRU lists of the parent EventWorkspace
   mutable EventWorkspaceMRU *mru;
 
+  /// Events held in columnar form when m_storageMode is COLUMN_STORAGE
+  mutable EventColumns m_columns;
+
+  /// Events held in compact form when m_storageMode is COMPACT_STORAGE
+  mutable CompactEvents m_compact;
+
+  /// Events in a mapped file when m_storageMode is MAPPED_STORAGE
+  mutable MappedEvents m_mapped;
+
+  /// Where the events currently live: the event vectors, m_columns,
+  /// m_compact or m_mapped
+  mutable EventStorageMode m_storageMode;
+
+  /// If false, histogramming may bin unsorted events without sorting them
+  bool m_sortBeforeHistogram;
+
   /// Mutex that is locked while sorting an event list
   mutable std::mutex m_sortMutex;
 
@@ -420,7 +483,12 @@ private:
   static typename std::vector<T>::iterator
   findFirstEvent(std::vector<T> &events, const double seek_tof);
 
-  void generateCountsHistogram(const MantidVec &X, MantidVec &Y) const;
+  void histogramHelper(const EventHistogrammer &histogrammer, MantidVec &Y,
+                       MantidVec &E, const bool skipError,
+                       const bool sorted) const;
+
+  void countsHistogramHelper(const EventHistogrammer &histogrammer,
+                             MantidVec &Y, const bool sorted) const;
 
   void generateCountsHistogramPulseTime(const MantidVec &X, MantidVec &Y) const;
 
@@ -432,6 +500,40 @@ private:
 
   void switchToWeightedEvents();
   void switchToWeightedEventsNoTime();
+  void ensureRowStorage() const;
+  void switchStoredEventsTo(Mantid::API::EventType newType);
+
+  // --------------------------------------------------------------------------
+  /// Append an event to the columns or compact events, converting it or the
+  /// events held so that every column stays as long as the tof column
+  template <class Storage>
+  inline void addStoredEvent(Storage &storage,
+                             const Types::Event::TofEvent &event) {
+    if (eventType == Mantid::API::TOF)
+      storage.push_back(event);
+    else if (eventType == Mantid::API::WEIGHTED)
+      storage.push_back(WeightedEvent(event));
+    else
+      storage.push_back(WeightedEventNoTime(event));
+  }
+  /// @copydoc addStoredEvent(Storage &, const Types::Event::TofEvent &)
+  template <class Storage>
+  inline void addStoredEvent(Storage &storage, const WeightedEvent &event) {
+    if (eventType == Mantid::API::TOF)
+      this->switchStoredEventsTo(Mantid::API::WEIGHTED);
+    if (eventType == Mantid::API::WEIGHTED)
+      storage.push_back(event);
+    else
+      storage.push_back(WeightedEventNoTime(event));
+  }
+  /// @copydoc addStoredEvent(Storage &, const Types::Event::TofEvent &)
+  template <class Storage>
+  inline void addStoredEvent(Storage &storage,
+                             const WeightedEventNoTime &event) {
+    if (eventType != Mantid::API::WEIGHTED_NOTIME)
+      this->switchStoredEventsTo(Mantid::API::WEIGHTED_NOTIME);
+    storage.push_back(event);
+  }
   // should not be called externally
   void sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start,
                              const double seconds) const;
@@ -455,28 +557,62 @@ private:
       const double seconds);
 
   template <class T>
-  static void histogramForWeightsHelper(const std::vector<T> &events,
-                                        const MantidVec &X, MantidVec &Y,
-                                        MantidVec &E);
+  static void
+  histogramForWeightsHelper(const std::vector<T> &events,
+                            const EventHistogrammer &histogrammer,
+                            MantidVec &Y, MantidVec &E, const bool sorted);
+  static void
+  histogramForWeightsHelper(const EventColumns &events,
+                            const EventHistogrammer &histogrammer,
+                            MantidVec &Y, MantidVec &E, const bool sorted);
+  static void
+  histogramForWeightsHelper(const CompactEvents &events,
+                            const EventHistogrammer &histogrammer,
+                            MantidVec &Y, MantidVec &E, const bool sorted);
+  static void
+  histogramForWeightsHelper(const MappedEvents &events,
+                            const EventHistogrammer &histogrammer,
+                            MantidVec &Y, MantidVec &E, const bool sorted);
   template <class T>
   static void integrateHelper(std::vector<T> &events, const double minX,
                               const double maxX, const bool entireRange,
                               double &sum, double &error);
+  static void integrateHelper(const EventColumns &events, const double minX,
+                              const double maxX, const bool entireRange,
+                              double &sum, double &error);
+  static void integrateHelper(const CompactEvents &events, const double minX,
+                              const double maxX, const bool entireRange,
+                              double &sum, double &error);
+  static void integrateHelper(const MappedEvents &events, const double minX,
+                              const double maxX, const bool entireRange,
+                              double &sum, double &error);
   template <class T>
   static double integrateHelper(std::vector<T> &events, const double minX,
                                 const double maxX, const bool entireRange);
   template <class T>
   void convertTofHelper(std::vector<T> &events,
                         std::function<double(double)> func);
+  void convertTofHelper(EventColumns &events,
+                        std::function<double(double)> func);
+  void convertTofHelper(CompactEvents &events,
+                        std::function<double(double)> func);
 
   template <class T>
   void convertTofHelper(std::vector<T> &events, const double factor,
                         const double offset);
+  void convertTofHelper(EventColumns &events, const double factor,
+                        const double offset);
+  void convertTofHelper(CompactEvents &events, const double factor,
+                        const double offset);
   template <class T>
   void addPulsetimeHelper(std::vector<T> &events, const double seconds);
   template <class T>
   static std::size_t maskTofHelper(std::vector<T> &events, const double tofMin,
                                    const double tofMax);
+  static std::size_t maskTofHelper(EventColumns &events, const double tofMin,
+                                   const double tofMax);
+  static std::size_t maskTofHelper(CompactEvents &events, const double tofMin,
+                                   const double tofMax);
   template <class T>
   static void getTofsHelper(const std::vector<T> &events,
                             std::vector<double> &tofs);
@@ -0,0 +1,74 @@
+#ifndef MANTID_DATAOBJECTS_EVENTSORTER_H_
+#define MANTID_DATAOBJECTS_EVENTSORTER_H_
+
+#include "MantidDataObjects/CompactEvents.h"
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/Events.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** EventSorter : Sorts vectors of events with a least significant digit
+  radix sort.
+
+  Times-of-flight and pulse times are mapped to unsigned 64 bit keys whose
+  order is the order of the values, and the events are sorted one byte of the
+  key at a time. The counts for every byte are taken in a single read of the
+  events, and bytes that are the same for every event are skipped. Pulse
+  times within a run share their high bytes, and times-of-flight read from
+  NeXus files as single precision values have zero low bytes, so most sorts
+  need five or six passes over the events rather than eight. Sorting by pulse
+  time then time-of-flight sorts by time-of-flight, then stably by pulse time.
+
+  The sort needs a buffer the size of the events. Lists that are already
+  sorted are left untouched. Short lists are sorted with std::sort. Very long
+  lists, such as monitors or summed banks, are counted and scattered in
+  parallel.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL EventSorter {
+public:
+  /// Lists shorter than this are sorted with std::sort
+  static constexpr size_t RADIX_THRESHOLD = 512;
+  /// Lists at least this long are sorted in parallel
+  static constexpr size_t PARALLEL_THRESHOLD = 1 << 20;
+
+  static void sortTof(std::vector<Types::Event::TofEvent> &events);
+  static void sortTof(std::vector<WeightedEvent> &events);
+  static void sortTof(std::vector<WeightedEventNoTime> &events);
+  static void sortTof(std::vector<CompactEvent> &events);
+
+  static void sortPulseTime(std::vector<Types::Event::TofEvent> &events);
+  static void sortPulseTime(std::vector<WeightedEvent> &events);
+
+  static void sortPulseTimeTof(std::vector<Types::Event::TofEvent> &events);
+  static void sortPulseTimeTof(std::vector<WeightedEvent> &events);
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_EVENTSORTER_H_ */
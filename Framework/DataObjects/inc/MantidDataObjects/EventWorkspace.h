@@ -15,6 +15,7 @@ class Progress;
 
 namespace DataObjects {
 class EventWorkspaceMRU;
+struct HistogramCacheStatistics;
 
 /** \class EventWorkspace
 
@@ -123,6 +124,13 @@ public:
   // Change the event type
   void switchEventType(const Mantid::API::EventType type);
 
+  // Set the event storage layout of all the event lists
+  void setEventStorageMode(const EventStorageMode mode);
+
+  // Choose whether histogramming sorts the events first
+  void setSortBeforeHistogram(const bool sort) override;
+  bool getSortBeforeHistogram() const override;
+
   // Returns true always - an EventWorkspace always represents histogramm-able
   // data
   bool isHistogramData() const override;
@@ -131,6 +139,8 @@ public:
 
   void clearMRU() const override;
 
+  HistogramCacheStatistics getHistogramCacheStatistics() const;
+
   EventSortType getSortType() const;
 
   // Sort all event lists. Uses a parallelized algorithm
@@ -157,8 +167,11 @@ private:
    */
   std::vector<EventList *> data;
 
-  /// Container for the MRU lists of the event lists contained.
+  /// Cache of the histograms generated from the event lists contained.
   mutable EventWorkspaceMRU *mru;
+
+  /// Whether the event lists sort by TOF before histogramming
+  bool m_sortBeforeHistogram;
 };
 
 /// shared pointer to the EventWorkspace class
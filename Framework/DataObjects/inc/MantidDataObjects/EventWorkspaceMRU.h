@@ -2,15 +2,16 @@
 #define MANTID_DATAOBJECTS_EVENTWORKSPACEMRU_H_
 
 #include "MantidKernel/System.h"
-#include "MantidKernel/Exception.h"
 #include "MantidKernel/cow_ptr.h"
-#include "MantidKernel/MRUList.h"
 #include "MantidHistogramData/HistogramY.h"
 #include "MantidHistogramData/HistogramE.h"
 
-#include "Poco/RWLock.h"
-
+#include <atomic>
 #include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace Mantid {
@@ -18,40 +19,43 @@ namespace DataObjects {
 
 class EventList;
 
-//============================================================================
-//============================================================================
-/**
- * This little class holds data and an index marker that is used for uniqueness.
- * This is used in the MRUList.
- */
-template <class T> class TypeWithMarker {
-public:
-  /**
-   * Constructor.
-   * @param the_index :: unique index into the workspace of this data
-   */
-  TypeWithMarker(const uintptr_t the_index) : m_index(the_index) {}
-  TypeWithMarker(const TypeWithMarker &other) = delete;
-  TypeWithMarker &operator=(const TypeWithMarker &other) = delete;
-
-public:
-  /// Unique index value.
-  uintptr_t m_index;
+/// Counters describing the use of an EventWorkspaceMRU
+struct HistogramCacheStatistics {
+  /// Number of lookups that found a cached histogram
+  uint64_t hits;
+  /// Number of lookups that found nothing
+  uint64_t misses;
+  /// Number of histograms dropped to stay within the memory budget
+  uint64_t evictions;
+  /// Number of event lists with a cached Y and/or E
+  size_t entries;
+  /// Memory held by the cached histograms, in bytes
+  size_t memory;
+  /// Memory held by the histograms handed out by reference, in bytes
+  size_t heldMemory;
+  /// The memory budget, in bytes
+  size_t budget;
+};
 
-  /// Pointer to a vector of data
-  T m_data;
+//============================================================================
+/** This is a container for the most-recently-used histograms generated from
+ * the event lists of an EventWorkspace.
 
-  /// Function returns a unique index, used for hashing for MRU list
-  uintptr_t hashIndexFunction() const { return m_index; }
+  The cache is shared by all threads and split into shards by event list, each
+  with its own lock and least-recently-used eviction. A lock is only held to
+  look up or swap an entry, never while histogramming, so threads working on
+  different spectra almost never wait for each other.
 
-  /// Set the unique index value.
-  void setIndex(const uintptr_t the_index) { m_index = the_index; }
-};
+  The total size of the cached histograms is bounded by a memory budget, read
+  from the EventWorkspace.HistogramCache.MaxMemoryMB configuration property.
 
-//============================================================================
-//============================================================================
-/** This is a container for the MRU (most-recently-used) list
- * of generated histograms.
+  Histograms handed out by reference (EventList::y(), dataY(), readY() and
+  the E equivalents) are also held for the calling thread until it has been
+  handed 50 more, so that such a reference stays valid when the entry is
+  evicted by this or another thread, as with the previous per-thread lists.
+  They are kept in a worker slot that the thread gives back when it exits,
+  so their number is bounded by the number of threads running at once, and
+  their memory is taken out of the budget left for the cache.
 
   Copyright &copy; 2011-2 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
  National Laboratory & European Spallation Source
@@ -78,41 +82,91 @@ class DLLExport EventWorkspaceMRU {
 public:
   using YType = Kernel::cow_ptr<HistogramData::HistogramY>;
   using EType = Kernel::cow_ptr<HistogramData::HistogramE>;
-  using YWithMarker = TypeWithMarker<YType>;
-  using EWithMarker = TypeWithMarker<EType>;
-  // Typedef for a Most-Recently-Used list of Data objects.
-  using mru_listY = Kernel::MRUList<YWithMarker>;
-  using mru_listE = Kernel::MRUList<EWithMarker>;
 
+  EventWorkspaceMRU();
+  explicit EventWorkspaceMRU(const size_t memoryBudget);
   ~EventWorkspaceMRU();
 
-  void ensureEnoughBuffersY(size_t thread_num) const;
-  void ensureEnoughBuffersE(size_t thread_num) const;
-
   void clear();
 
-  YType findY(size_t thread_num, const EventList *index);
-  EType findE(size_t thread_num, const EventList *index);
-  void insertY(size_t thread_num, YType data, const EventList *index);
-  void insertE(size_t thread_num, EType data, const EventList *index);
-
+  YType findY(const EventList *index);
+  EType findE(const EventList *index);
+  void insertY(YType data, const EventList *index);
+  void insertE(EType data, const EventList *index);
   void deleteIndex(const EventList *index);
 
-  /** Return how many entries in the Y MRU list are used.
-   * Only used in tests. It only returns the 0-th MRU list size.
-   * @return :: number of entries in the MRU list. */
-  size_t MRUSize() const;
-
-protected:
-  /// The most-recently-used list of dataY histograms
-  mutable std::vector<mru_listY *> m_bufferedDataY;
+  const HistogramData::HistogramY &holdY(YType data);
+  const HistogramData::HistogramE &holdE(EType data);
 
-  /// The most-recently-used list of dataE histograms
-  mutable std::vector<mru_listE *> m_bufferedDataE;
+  /** Return how many event lists have cached histograms.
+   * @return :: number of entries in the cache. */
+  size_t MRUSize() const;
 
-  /// Mutex when adding entries in the MRU list
-  mutable Poco::RWLock m_changeMruListsMutexE;
-  mutable Poco::RWLock m_changeMruListsMutexY;
+  HistogramCacheStatistics statistics() const;
+  void resetStatistics();
+
+  static size_t defaultMemoryBudget();
+
+private:
+  /// Cached histograms of one event list
+  struct Entry {
+    const EventList *index;
+    YType y;
+    EType e;
+    /// Memory used by y and e, in bytes
+    size_t memory;
+  };
+  /// One independently locked part of the cache
+  struct Shard {
+    std::mutex mutex;
+    /// Entries, most recently used first
+    std::list<Entry> entries;
+    /// Position of each event list in entries
+    std::unordered_map<const EventList *, std::list<Entry>::iterator> lookup;
+    /// Memory used by the entries, in bytes
+    size_t memory = 0;
+  };
+
+  /// Histograms handed out by reference to one thread, kept alive in a ring
+  struct Held {
+    std::vector<YType> y;
+    std::vector<EType> e;
+    size_t nextY = 0;
+    size_t nextE = 0;
+  };
+  /// One independently locked part of the held histograms, by worker slot
+  struct HeldShard {
+    std::mutex mutex;
+    std::unordered_map<size_t, Held> slots;
+    /// Memory used by the held histograms, in bytes
+    size_t memory = 0;
+  };
+
+  Shard &shardFor(const EventList *index) const;
+  size_t shardBudget() const;
+  template <class T>
+  const T &hold(Kernel::cow_ptr<T> data,
+                std::vector<Kernel::cow_ptr<T>> Held::*ring,
+                size_t Held::*next);
+  template <class T> T find(const EventList *index, T Entry::*member);
+  template <class T>
+  void insert(T data, const EventList *index, T Entry::*member);
+  void evict(Shard &shard, const EventList *keep);
+
+  /// The shards; their number is a power of two
+  std::unique_ptr<Shard[]> m_shards;
+  /// The held histograms of each worker slot, sharded by slot
+  std::unique_ptr<HeldShard[]> m_held;
+  /// Number of shards minus one, used to mask a hash into a shard index
+  size_t m_shardMask;
+  /// Memory budget for the whole cache, in bytes
+  size_t m_memoryBudget;
+  /// Memory used by the held histograms of all the slots, in bytes
+  std::atomic<size_t> m_heldMemory;
+
+  std::atomic<uint64_t> m_hits;
+  std::atomic<uint64_t> m_misses;
+  std::atomic<uint64_t> m_evictions;
 };
 
 } // namespace DataObjects
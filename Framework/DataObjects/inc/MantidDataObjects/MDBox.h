@@ -141,6 +141,7 @@ public:
   size_t addEvents(const std::vector<MDE> &events) override;
   // unhide MDBoxBase methods
   size_t addEventsUnsafe(const std::vector<MDE> &events) override;
+  size_t addEventsUnsafe(const MDE *begin, const MDE *end);
 
   /*--------------->  EVENTS from event data
    * <-------------------------------------------------------------*/
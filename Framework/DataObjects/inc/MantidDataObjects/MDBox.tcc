@@ -816,6 +816,20 @@ TMDE(size_t MDBox)::addEvents(const std::vector<MDE> &events) {
   return 0;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Add a range of events to the box, in a NON-THREAD-SAFE manner.
+ * No lock is performed and no bounds checking is made!
+ *
+ * @param begin :: pointer to the first event to copy.
+ * @param end :: pointer past the last event to copy.
+ *
+ * @return the number of events added
+ */
+TMDE(size_t MDBox)::addEventsUnsafe(const MDE *begin, const MDE *end) {
+  this->data.insert(this->data.end(), begin, end);
+  return static_cast<size_t>(end - begin);
+}
+
 /**Make this box file-backed
 * @param fileLocation -- the starting position of this box data are/should be
 * located in the direct access file
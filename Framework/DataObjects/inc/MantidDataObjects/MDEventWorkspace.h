@@ -163,6 +163,8 @@ public:
 
   size_t addEvents(const std::vector<MDE> &events);
 
+  size_t addEventsInBulk(const std::vector<MDE> &events);
+
   std::vector<Mantid::Geometry::MDDimensionExtents<coord_t>>
   getMinimumExtents(size_t depth = 2) const override;
 
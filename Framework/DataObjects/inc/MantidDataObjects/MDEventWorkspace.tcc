@@ -592,6 +592,29 @@ TMDE(size_t MDEventWorkspace)::addEvents(const std::vector<MDE> &events) {
   return data->addEvents(events);
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Add a large batch of MDEvents to the workspace, splitting the boxes that
+ * receive enough events to be worth it while adding, see
+ * MDGridBox::addEventsInBulk(). The top-level box is split first if needed.
+ *
+ * Note! nPoints, signal and error must be re-calculated using refreshCache()
+ * after all events have been added.
+ *
+ * @param events :: the events to add.
+ * @return the number of events added
+ */
+TMDE(size_t MDEventWorkspace)::addEventsInBulk(const std::vector<MDE> &events) {
+  if (!isGridBox()) {
+    if (!m_BoxController->willSplit(data->getNPoints() + events.size(),
+                                    data->getDepth())) {
+      data->addEvents(events);
+      return events.size();
+    }
+    splitBox();
+  }
+  return static_cast<MDGridBox<MDE, nd> *>(data)->addEventsInBulk(events);
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Split the contained MDBox into a MDGridBox or MDSplitBox, if it is not
  * that already.
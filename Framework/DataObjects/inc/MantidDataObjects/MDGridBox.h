@@ -143,6 +143,7 @@ public:
                            const std::vector<uint16_t> &runIndex,
                            const std::vector<uint32_t> &detectorId) override;
   //----------------------------------------------------------------------------------------------------------------------
+  size_t addEventsInBulk(const std::vector<MDE> &events);
 
   void centerpointBin(MDBin<MDE, nd> &bin, bool *fullyContained) const override;
 
@@ -244,6 +245,8 @@ private:
   size_t getLinearIndex(size_t *indices) const;
 
   size_t computeSizesFromSplit();
+  size_t addEventRange(MDE *events, MDE *scratch, const size_t numEvents,
+                       const bool parallel);
   void fillBoxShell(const size_t tot, const coord_t ChildInverseVolume);
   /**private default copy constructor as the only correct constructor is the one
    * with box controller */
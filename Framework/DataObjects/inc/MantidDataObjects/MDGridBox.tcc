@@ -11,6 +11,7 @@
 #include "MantidDataObjects/MDGridBox.h"
 #include <boost/math/special_functions/round.hpp>
 #include <boost/optional.hpp>
+#include <numeric>
 #include <ostream>
 #include "MantidKernel/Strings.h"
 
@@ -1683,6 +1684,97 @@ TMDE(inline size_t MDGridBox)::addEventUnsafe(const MDE &event) {
     return 0;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Add a large batch of events to the grid box, splitting the boxes that
+ * receive enough events to be worth it on the way down.
+ *
+ * The events are sorted by the child box they fall in, one level of the tree
+ * at a time, so that each box receives its events as one contiguous range and
+ * is split at most once, before its events are added. The children of this
+ * box are filled in parallel unless the workspace is file-backed. If the
+ * boxes were split as needed beforehand, the boxes and the order of the
+ * events within them are the same as when adding the events one by one and
+ * then calling splitAllIfNeeded().
+ *
+ * Warning! No bounds checking is done (for performance). Events outside of
+ * the grid box are dropped, as in addEvent().
+ *
+ * Note! nPoints, signal and error must be re-calculated using refreshCache()
+ * after all events have been added.
+ *
+ * @param events :: the events to add.
+ * @return the number of events added
+ */
+TMDE(size_t MDGridBox)::addEventsInBulk(const std::vector<MDE> &events) {
+  if (events.empty())
+    return 0;
+  std::vector<MDE> buffer(events);
+  std::vector<MDE> scratch(events.size());
+  return addEventRange(buffer.data(), scratch.data(), buffer.size(),
+                       !this->m_BoxController->isFileBacked());
+}
+
+//-----------------------------------------------------------------------------------------------
+/** Sort a range of events by child box and add each child's events at once.
+ * The sorted events are written to scratch; the events array then serves as
+ * scratch space for the children, which get the same part of both arrays.
+ *
+ * @param events :: the events to add; overwritten.
+ * @param scratch :: space for numEvents events.
+ * @param numEvents :: the number of events.
+ * @param parallel :: fill the children on several threads.
+ * @return the number of events added
+ */
+TMDE(size_t MDGridBox)::addEventRange(MDE *events, MDE *scratch,
+                                      const size_t numEvents,
+                                      const bool parallel) {
+  // Index of the child of every event; numBoxes for events outside of the box
+  std::vector<size_t> childIndices(numEvents);
+  // begin[i] is the position of the first event of child i in the sorted range
+  std::vector<size_t> begin(numBoxes + 2, 0);
+  for (size_t i = 0; i < numEvents; ++i) {
+    size_t cindex = calculateChildIndex(events[i]);
+    // Events on the upper boundary of the last child box go to that box
+    if (cindex == numBoxes)
+      cindex = numBoxes - 1;
+    else if (cindex > numBoxes)
+      cindex = numBoxes;
+    childIndices[i] = cindex;
+    ++begin[cindex + 1];
+  }
+  std::partial_sum(begin.begin(), begin.end(), begin.begin());
+  std::vector<size_t> next(begin.begin(), begin.end() - 1);
+  for (size_t i = 0; i < numEvents; ++i)
+    scratch[next[childIndices[i]]++] = events[i];
+
+  const auto numChildren = static_cast<int>(numBoxes);
+  PRAGMA_OMP(parallel for schedule(dynamic, 1) if (parallel))
+  for (int i = 0; i < numChildren; ++i) {
+    const size_t first = begin[i];
+    const size_t count = begin[i + 1] - first;
+    if (count == 0)
+      continue;
+    auto box = dynamic_cast<MDBox<MDE, nd> *>(m_Children[i]);
+    if (box && this->m_BoxController->willSplit(box->getNPoints() + count,
+                                                box->getDepth())) {
+      // Split before adding, so that the new events are only routed once
+      auto gridBox = new MDGridBox<MDE, nd>(box);
+      this->m_BoxController->trackNumBoxes(box->getDepth());
+      m_Children[i] = gridBox;
+      delete box;
+      box = nullptr;
+    }
+    if (box) {
+      box->addEventsUnsafe(scratch + first, scratch + first + count);
+    } else {
+      auto gridBox = dynamic_cast<MDGridBox<MDE, nd> *>(m_Children[i]);
+      if (gridBox)
+        gridBox->addEventRange(scratch + first, events + first, count, false);
+    }
+  }
+  return begin[numBoxes];
+}
+
 /**Sets particular child MDgridBox at the index, specified by the input
 *parameters
 *@param index     -- the position of the new child in the list of GridBox
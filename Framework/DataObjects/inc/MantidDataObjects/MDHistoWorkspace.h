@@ -1,6 +1,7 @@
 #ifndef MANTID_DATAOBJECTS_MDHISTOWORKSPACE_H_
 #define MANTID_DATAOBJECTS_MDHISTOWORKSPACE_H_
 
+#include "MantidAPI/DualNumber.h"
 #include "MantidAPI/IMDIterator.h"
 #include "MantidAPI/IMDWorkspace.h"
 #include "MantidAPI/MDGeometry.h"
@@ -8,6 +9,7 @@
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
 #include "MantidGeometry/MDGeometry/MDImplicitFunction.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/System.h"
 #include "MantidDataObjects/WorkspaceSingleValue.h"
 #include "MantidAPI/IMDHistoWorkspace.h"
@@ -132,6 +134,10 @@ public:
   void setUsingMask(const MDHistoWorkspace &mask, const signal_t signal,
                     const signal_t error);
 
+  template <size_t N, typename Expression>
+  void setToExpression(const std::array<const MDHistoWorkspace *, N> &operands,
+                       const Expression &expression);
+
   // --------------------------------------------------------------------------------------------
   /** @return a const reference to the indexMultiplier array.
    * To find the index into the linear array, dim0 + indexMultiplier[0]*dim1 +
@@ -434,6 +440,8 @@ private:
 
   void initVertexesArray();
 
+  template <typename Function> void forEachBin(const Function &function);
+
   /// Number of dimensions in this workspace
   size_t numDimensions;
 
@@ -498,6 +506,69 @@ protected:
   bool *m_masks;
 };
 
+//----------------------------------------------------------------------------------------------
+/** Call a function with the index of every bin. Large workspaces are split
+ * between threads. The function is inlined into the loop, so that simple
+ * element-wise operations on the arrays are vectorised.
+ *
+ * @param function :: callable taking the linear index of a bin
+ */
+template <typename Function>
+void MDHistoWorkspace::forEachBin(const Function &function) {
+  const int64_t length = static_cast<int64_t>(m_length);
+  // Below this, starting the threads costs more than the loop
+  const int64_t minimumParallelLength = 65536;
+  PARALLEL_FOR_IF(length >= minimumParallelLength)
+  for (int64_t i = 0; i < length; ++i) {
+    function(static_cast<size_t>(i));
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Set the signals to a function of the signals of other workspaces,
+ * element-by-element, in a single pass over the bins. Chaining several
+ * operations this way, e.g. (a - b) / c, avoids a pass and a temporary
+ * workspace per operation.
+ *
+ * The errors are propagated from those of the operands, taken as
+ * independent: \f$ df^2 = \sum_k (\partial f / \partial a_k)^2 da_k^2 \f$,
+ * with the derivatives evaluated exactly by forward differentiation.
+ * The number of events is left unchanged. This workspace may be one of the
+ * operands.
+ *
+ * @param operands :: the N workspaces whose signals are the arguments
+ * @param expression :: callable taking a const reference to a
+ * std::array<API::DualNumber<N>, N> of the signals of the operands in a bin,
+ * and returning the new signal as an API::DualNumber<N>
+ */
+template <size_t N, typename Expression>
+void MDHistoWorkspace::setToExpression(
+    const std::array<const MDHistoWorkspace *, N> &operands,
+    const Expression &expression) {
+  std::array<const signal_t *, N> signals;
+  std::array<const signal_t *, N> errorsSquared;
+  for (size_t k = 0; k < N; ++k) {
+    checkWorkspaceSize(*operands[k], "expression");
+    signals[k] = operands[k]->m_signals;
+    errorsSquared[k] = operands[k]->m_errorsSquared;
+  }
+  signal_t *outSignals = m_signals;
+  signal_t *outErrorsSquared = m_errorsSquared;
+  forEachBin([&](const size_t i) {
+    std::array<API::DualNumber<N>, N> arguments;
+    for (size_t k = 0; k < N; ++k)
+      arguments[k] = API::DualNumber<N>::variable(signals[k][i], k);
+    const API::DualNumber<N> f = expression(arguments);
+    signal_t errorSquared = 0.;
+    for (size_t k = 0; k < N; ++k) {
+      const signal_t derivative = f.derivative(k);
+      errorSquared += derivative * derivative * errorsSquared[k][i];
+    }
+    outSignals[i] = f.value();
+    outErrorsSquared[i] = errorSquared;
+  });
+}
+
 /// A shared pointer to a MDHistoWorkspace
 typedef boost::shared_ptr<MDHistoWorkspace> MDHistoWorkspace_sptr;
 
@@ -0,0 +1,87 @@
+#ifndef MANTID_DATAOBJECTS_MAPPEDEVENTS_H_
+#define MANTID_DATAOBJECTS_MAPPEDEVENTS_H_
+
+#include "MantidAPI/IEventList.h"
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/Events.h"
+
+#include <memory>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+class EventCacheFile;
+
+/** MappedEvents : A read-only view of the events of one spectrum inside a
+  memory-mapped EventCacheFile.
+
+  The events are TofEvent, WeightedEvent or WeightedEventNoTime structs laid
+  out in the file exactly as they are in memory, sorted by time-of-flight.
+  Nothing is copied when the view is created: pages of the file are read by
+  the operating system when the events are first accessed. The view holds a
+  reference to the file, which stays mapped as long as a view of it exists.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL MappedEvents {
+public:
+  MappedEvents() = default;
+  MappedEvents(std::shared_ptr<const EventCacheFile> file, const void *data,
+               size_t size, API::EventType eventType);
+
+  /// @return the number of events
+  size_t size() const { return m_size; }
+  /// @return true if there are no events
+  bool empty() const { return m_size == 0; }
+  /// @return the type of the events
+  API::EventType eventType() const { return m_eventType; }
+  /// @return the first event, which must be of type T
+  template <class T> const T *data() const {
+    return static_cast<const T *>(m_data);
+  }
+
+  double tofAt(size_t index) const;
+  void copyTofs(size_t first, size_t count, double *tofs) const;
+  void copyWeights(size_t first, size_t count, float *weights,
+                   float *errorSquareds) const;
+
+  void copyTo(std::vector<Types::Event::TofEvent> &events) const;
+  void copyTo(std::vector<WeightedEvent> &events) const;
+  void copyTo(std::vector<WeightedEventNoTime> &events) const;
+
+  void clear();
+
+private:
+  /// The file the events live in
+  std::shared_ptr<const EventCacheFile> m_file;
+  /// The first event
+  const void *m_data = nullptr;
+  /// The number of events
+  size_t m_size = 0;
+  /// The type of the events
+  API::EventType m_eventType = API::TOF;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_MAPPEDEVENTS_H_ */
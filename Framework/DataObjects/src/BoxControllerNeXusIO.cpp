@@ -18,6 +18,22 @@ const char *EventHeaders[] = {
     "signal, errorSquared, center (each dim.)",
     "signal, errorSquared, runIndex, detectorId, center (each dim.)"};
 
+namespace {
+/// Configuration property: write the boxes out on a thread of their own
+const char *WRITE_BEHIND_PROPERTY = "MDWorkspace.FileBackEnd.WriteBehind";
+/// Configuration property: compress the events written to new files
+const char *COMPRESSION_PROPERTY = "MDWorkspace.FileBackEnd.Compression";
+
+/// @return the value of a configuration property which is 0 or 1, or
+/// fallback if it is not set
+bool configFlag(const char *key, const bool fallback) {
+  int value(0);
+  if (!Kernel::ConfigService::Instance().getValue(key, value))
+    return fallback;
+  return value != 0;
+}
+} // namespace
+
 std::string BoxControllerNeXusIO::g_EventGroupName("event_data");
 std::string BoxControllerNeXusIO::g_DBDataName("free_space_blocks");
 
@@ -25,11 +41,13 @@ std::string BoxControllerNeXusIO::g_DBDataName("free_space_blocks");
  @param bc shared pointer to the box controller which uses this IO operations
 */
 BoxControllerNeXusIO::BoxControllerNeXusIO(API::BoxController *const bc)
-    : m_File(nullptr), m_ReadOnly(true), m_dataChunk(DATA_CHUNK), m_bc(bc),
+    : m_File(nullptr), m_ReadOnly(true), m_dataChunk(DATA_CHUNK),
+      m_compress(configFlag(COMPRESSION_PROPERTY, false)), m_bc(bc),
       m_BlockStart(2, 0), m_BlockSize(2, 0), m_CoordSize(sizeof(coord_t)),
       m_EventType(FatEvent), m_EventsVersion("1.0"),
       m_ReadConversion(noConversion) {
   m_BlockSize[1] = 4 + m_bc->getNDims();
+  this->setWriteBehind(configFlag(WRITE_BEHIND_PROPERTY, true));
 
   for (auto &EventHeader : EventHeaders) {
     m_EventsTypeHeaders.push_back(EventHeader);
@@ -217,13 +235,15 @@ void BoxControllerNeXusIO::prepareNxSToWrite_CurVersion() {
     std::vector<int64_t> chunk(m_BlockSize);
     chunk[0] = static_cast<int64_t>(m_dataChunk);
 
-    // Make and open the data
+    // Make and open the data. Each chunk is compressed on its own, so a
+    // block rewritten in place only recompresses the chunks it spans.
+    const auto compression = m_compress ? ::NeXus::LZW : ::NeXus::NONE;
     if (m_CoordSize == 4)
       m_File->makeCompData("event_data", ::NeXus::FLOAT32, m_BlockSize,
-                           ::NeXus::NONE, chunk, true);
+                           compression, chunk, true);
     else
       m_File->makeCompData("event_data", ::NeXus::FLOAT64, m_BlockSize,
-                           ::NeXus::NONE, chunk, true);
+                           compression, chunk, true);
 
     // A little bit of description for humans to read later
     m_File->putAttr("description", m_EventsTypeHeaders[m_EventType]);
@@ -463,6 +483,8 @@ void BoxControllerNeXusIO::flushData() const {
 }
 /** flush disk buffer data from memory and close underlying NeXus file*/
 void BoxControllerNeXusIO::closeFile() {
+  // The write-behind thread writes through this object
+  this->stopWriteBehind();
   if (m_File) {
     // write all file-backed data still stack in the data buffer into the file.
     this->flushCache();
@@ -0,0 +1,373 @@
+#include "MantidDataObjects/CompactEvents.h"
+#include "MantidDataObjects/EventSorter.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/** Reorder a column in place following a permutation of indices.
+ * @param column :: the column to reorder. Ignored if empty.
+ * @param order :: order[i] is the index of the element that goes to i.
+ */
+template <typename T>
+void applyPermutation(std::vector<T> &column,
+                      const std::vector<size_t> &order) {
+  if (column.empty())
+    return;
+  std::vector<T> sorted;
+  sorted.reserve(column.size());
+  for (const auto index : order)
+    sorted.push_back(column[index]);
+  column.swap(sorted);
+}
+
+/// Erase the index range [first, last) from a column, if it is in use
+template <typename T>
+void eraseRange(std::vector<T> &column, const size_t first, const size_t last) {
+  if (!column.empty())
+    column.erase(column.begin() + first, column.begin() + last);
+}
+
+/// Release the memory held by a column
+template <typename T> void releaseColumn(std::vector<T> &column) {
+  std::vector<T>().swap(column);
+}
+
+/// @throw std::length_error if another pulse time cannot be indexed
+void checkPulseTableSize(const std::vector<int64_t> &pulseTimes) {
+  if (pulseTimes.size() > std::numeric_limits<uint32_t>::max())
+    throw std::length_error(
+        "CompactEvents: too many distinct pulse times in one event list");
+}
+
+/// Collect the pulse times of a vector of events, in nanoseconds
+template <typename T>
+std::vector<int64_t> collectPulseTimes(const std::vector<T> &events) {
+  std::vector<int64_t> pulseTimes;
+  pulseTimes.reserve(events.size());
+  for (const auto &event : events)
+    pulseTimes.push_back(event.pulseTime().totalNanoseconds());
+  return pulseTimes;
+}
+} // namespace
+
+/** Fill from a vector of TofEvent. Any existing content is replaced.
+ * @param events :: events to copy
+ */
+void CompactEvents::assign(const std::vector<TofEvent> &events) {
+  clear();
+  buildPulseTable(collectPulseTimes(events));
+  m_events.reserve(events.size());
+  for (const auto &event : events)
+    push_back(event);
+}
+
+/** Fill from a vector of WeightedEvent. Any existing content is replaced.
+ * @param events :: events to copy
+ */
+void CompactEvents::assign(const std::vector<WeightedEvent> &events) {
+  clear();
+  buildPulseTable(collectPulseTimes(events));
+  m_events.reserve(events.size());
+  m_weight.reserve(events.size());
+  m_errorSquared.reserve(events.size());
+  for (const auto &event : events)
+    push_back(event);
+}
+
+/** Fill from a vector of WeightedEventNoTime. Any existing content is
+ * replaced.
+ * @param events :: events to copy
+ */
+void CompactEvents::assign(const std::vector<WeightedEventNoTime> &events) {
+  clear();
+  m_events.reserve(events.size());
+  m_weight.reserve(events.size());
+  m_errorSquared.reserve(events.size());
+  for (const auto &event : events)
+    push_back(event);
+}
+
+/** Rebuild a vector of TofEvent.
+ * @param events :: output vector, replaced by the events held
+ */
+void CompactEvents::copyTo(std::vector<TofEvent> &events) const {
+  events.clear();
+  events.reserve(size());
+  const bool havePulse = hasPulseTimes();
+  for (const auto &event : m_events)
+    events.emplace_back(
+        event.tof(), havePulse ? DateAndTime(m_pulseTimes[event.m_pulseIndex])
+                               : DateAndTime(int64_t(0)));
+}
+
+/** Rebuild a vector of WeightedEvent.
+ * @param events :: output vector, replaced by the events held
+ */
+void CompactEvents::copyTo(std::vector<WeightedEvent> &events) const {
+  const size_t numEvents = size();
+  events.clear();
+  events.reserve(numEvents);
+  const bool havePulse = hasPulseTimes();
+  const bool haveWeights = hasWeights();
+  for (size_t i = 0; i < numEvents; ++i) {
+    const auto &event = m_events[i];
+    events.emplace_back(event.tof(),
+                        havePulse
+                            ? DateAndTime(m_pulseTimes[event.m_pulseIndex])
+                            : DateAndTime(int64_t(0)),
+                        haveWeights ? m_weight[i] : 1.0f,
+                        haveWeights ? m_errorSquared[i] : 1.0f);
+  }
+}
+
+/** Rebuild a vector of WeightedEventNoTime.
+ * @param events :: output vector, replaced by the events held
+ */
+void CompactEvents::copyTo(std::vector<WeightedEventNoTime> &events) const {
+  const size_t numEvents = size();
+  events.clear();
+  events.reserve(numEvents);
+  const bool haveWeights = hasWeights();
+  for (size_t i = 0; i < numEvents; ++i)
+    events.emplace_back(m_events[i].tof(), haveWeights ? m_weight[i] : 1.0f,
+                        haveWeights ? m_errorSquared[i] : 1.0f);
+}
+
+/** Append a TofEvent
+ * @param event :: the event. Its time-of-flight is rounded to single precision.
+ */
+void CompactEvents::push_back(const TofEvent &event) {
+  m_events.push_back(
+      CompactEvent{static_cast<float>(event.tof()),
+                   pulseIndex(event.pulseTime().totalNanoseconds())});
+}
+
+/** Append a WeightedEvent
+ * @param event :: the event. Its time-of-flight is rounded to single precision.
+ */
+void CompactEvents::push_back(const WeightedEvent &event) {
+  m_events.push_back(
+      CompactEvent{static_cast<float>(event.tof()),
+                   pulseIndex(event.pulseTime().totalNanoseconds())});
+  m_weight.push_back(event.m_weight);
+  m_errorSquared.push_back(event.m_errorSquared);
+}
+
+/** Append a WeightedEventNoTime
+ * @param event :: the event. Its time-of-flight is rounded to single precision.
+ */
+void CompactEvents::push_back(const WeightedEventNoTime &event) {
+  m_events.push_back(CompactEvent{static_cast<float>(event.tof()), 0});
+  m_weight.push_back(event.m_weight);
+  m_errorSquared.push_back(event.m_errorSquared);
+}
+
+/** Give every event held a weight and squared error of 1, as when converting
+ * TofEvent to WeightedEvent. Does nothing if the events already have weights.
+ */
+void CompactEvents::addWeights() {
+  if (hasWeights())
+    return;
+  m_weight.assign(size(), 1.0f);
+  m_errorSquared.assign(size(), 1.0f);
+}
+
+/** Drop the pulse times, as when converting to WeightedEventNoTime.
+ */
+void CompactEvents::removePulseTimes() {
+  for (auto &event : m_events)
+    event.m_pulseIndex = 0;
+  releaseColumn(m_pulseTimes);
+  releaseColumn(m_pulseOrder);
+  m_pulseTimesSorted = true;
+}
+
+/** Set the pulse time table to the distinct values of some pulse times.
+ * @param pulseTimes :: pulse times, in nanoseconds
+ */
+void CompactEvents::buildPulseTable(std::vector<int64_t> pulseTimes) {
+  std::sort(pulseTimes.begin(), pulseTimes.end());
+  pulseTimes.erase(std::unique(pulseTimes.begin(), pulseTimes.end()),
+                   pulseTimes.end());
+  pulseTimes.shrink_to_fit();
+  m_pulseTimes.swap(pulseTimes);
+  m_pulseTimesSorted = true;
+  releaseColumn(m_pulseOrder);
+}
+
+/** Find the index of a pulse time in the table, adding it if needed.
+ * Events are usually appended pulse by pulse, so the last entry is checked
+ * first. Each pulse time is held once: when one arrives out of order the
+ * table stops being sorted, and m_pulseOrder is kept sorted instead so that
+ * it can still be searched.
+ * @param pulseTime :: the pulse time, in nanoseconds
+ * @return the index of the pulse time in m_pulseTimes
+ * @throw std::length_error if the table is full
+ */
+uint32_t CompactEvents::pulseIndex(const int64_t pulseTime) {
+  if (!m_pulseTimes.empty() && m_pulseTimes.back() == pulseTime)
+    return static_cast<uint32_t>(m_pulseTimes.size() - 1);
+
+  if (m_pulseTimesSorted) {
+    if (m_pulseTimes.empty() || pulseTime > m_pulseTimes.back()) {
+      checkPulseTableSize(m_pulseTimes);
+      m_pulseTimes.push_back(pulseTime);
+      return static_cast<uint32_t>(m_pulseTimes.size() - 1);
+    }
+    const auto it = std::lower_bound(m_pulseTimes.cbegin(),
+                                     m_pulseTimes.cend(), pulseTime);
+    if (*it == pulseTime)
+      return static_cast<uint32_t>(it - m_pulseTimes.cbegin());
+    // A new pulse time out of order: index the table in time order instead
+    m_pulseOrder.resize(m_pulseTimes.size());
+    std::iota(m_pulseOrder.begin(), m_pulseOrder.end(), uint32_t(0));
+    m_pulseTimesSorted = false;
+  }
+
+  const auto position = std::lower_bound(
+      m_pulseOrder.begin(), m_pulseOrder.end(), pulseTime,
+      [this](const uint32_t index, const int64_t time) {
+        return m_pulseTimes[index] < time;
+      });
+  if (position != m_pulseOrder.end() && m_pulseTimes[*position] == pulseTime)
+    return *position;
+  checkPulseTableSize(m_pulseTimes);
+  const auto index = static_cast<uint32_t>(m_pulseTimes.size());
+  m_pulseTimes.push_back(pulseTime);
+  m_pulseOrder.insert(position, index);
+  return index;
+}
+
+/// Remove all the events and release the memory they used
+void CompactEvents::clear() {
+  releaseColumn(m_events);
+  releaseColumn(m_pulseTimes);
+  releaseColumn(m_weight);
+  releaseColumn(m_errorSquared);
+  releaseColumn(m_pulseOrder);
+  m_pulseTimesSorted = true;
+}
+
+/** Reserve space for a number of events. As with EventList::reserve(), this
+ * is intended for un-weighted events.
+ * @param num :: number of events that will be held
+ */
+void CompactEvents::reserve(size_t num) { m_events.reserve(num); }
+
+/** Memory used by the events and pulse time table. Reports the capacity
+ * rather than the size, as EventList::getMemorySize() does for the event
+ * vectors.
+ * @return the memory used, in bytes
+ */
+size_t CompactEvents::getMemorySize() const {
+  return m_events.capacity() * sizeof(CompactEvent) +
+         m_pulseTimes.capacity() * sizeof(int64_t) +
+         m_pulseOrder.capacity() * sizeof(uint32_t) +
+         (m_weight.capacity() + m_errorSquared.capacity()) * sizeof(float);
+}
+
+/** Reorder the events, and their weights and errors, following a permutation.
+ * @param order :: order[i] is the index of the event that goes to i.
+ */
+void CompactEvents::applyOrder(const std::vector<size_t> &order) {
+  applyPermutation(m_events, order);
+  applyPermutation(m_weight, order);
+  applyPermutation(m_errorSquared, order);
+}
+
+/// Sort the events by time-of-flight
+void CompactEvents::sortTof() {
+  const auto byTof = [](const CompactEvent &lhs, const CompactEvent &rhs) {
+    return lhs.m_tof < rhs.m_tof;
+  };
+  if (std::is_sorted(m_events.begin(), m_events.end(), byTof))
+    return;
+  if (!hasWeights()) {
+    EventSorter::sortTof(m_events);
+    return;
+  }
+
+  std::vector<size_t> order(size());
+  std::iota(order.begin(), order.end(), size_t(0));
+  std::sort(order.begin(), order.end(),
+            [this](const size_t lhs, const size_t rhs) {
+              return m_events[lhs].m_tof < m_events[rhs].m_tof;
+            });
+  applyOrder(order);
+}
+
+/// Sort the events by pulse time. Does nothing if they have no pulse time.
+void CompactEvents::sortPulseTime() {
+  if (!hasPulseTimes())
+    return;
+  std::vector<size_t> order(size());
+  std::iota(order.begin(), order.end(), size_t(0));
+  std::sort(order.begin(), order.end(),
+            [this](const size_t lhs, const size_t rhs) {
+              return m_pulseTimes[m_events[lhs].m_pulseIndex] <
+                     m_pulseTimes[m_events[rhs].m_pulseIndex];
+            });
+  applyOrder(order);
+}
+
+/** Sort the events by pulse time, then time-of-flight. Does nothing if they
+ * have no pulse time.
+ */
+void CompactEvents::sortPulseTimeTof() {
+  if (!hasPulseTimes())
+    return;
+  std::vector<size_t> order(size());
+  std::iota(order.begin(), order.end(), size_t(0));
+  std::sort(order.begin(), order.end(),
+            [this](const size_t lhs, const size_t rhs) {
+              const auto &left = m_events[lhs];
+              const auto &right = m_events[rhs];
+              const int64_t leftPulse = m_pulseTimes[left.m_pulseIndex];
+              const int64_t rightPulse = m_pulseTimes[right.m_pulseIndex];
+              if (leftPulse != rightPulse)
+                return leftPulse < rightPulse;
+              return left.m_tof < right.m_tof;
+            });
+  applyOrder(order);
+}
+
+/// Reverse the order of the events
+void CompactEvents::reverse() {
+  std::reverse(m_events.begin(), m_events.end());
+  std::reverse(m_weight.begin(), m_weight.end());
+  std::reverse(m_errorSquared.begin(), m_errorSquared.end());
+}
+
+/** Remove the events in the index range [first, last). The pulse time table
+ * is left as it is.
+ * @param first :: index of the first event to remove
+ * @param last :: one past the index of the last event to remove
+ */
+void CompactEvents::erase(size_t first, size_t last) {
+  eraseRange(m_events, first, last);
+  eraseRange(m_weight, first, last);
+  eraseRange(m_errorSquared, first, last);
+}
+
+/** Copy the times-of-flight of a range of events, in double precision.
+ * @param first :: index of the first event
+ * @param count :: number of events
+ * @param tofs :: output array of at least count elements
+ */
+void CompactEvents::copyTofs(size_t first, size_t count, double *tofs) const {
+  const CompactEvent *events = m_events.data() + first;
+  for (size_t i = 0; i < count; ++i)
+    tofs[i] = events[i].m_tof;
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -0,0 +1,355 @@
+#include "MantidDataObjects/EventCacheFile.h"
+#include "MantidDataObjects/EventWorkspace.h"
+
+#include <Poco/Exception.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using Mantid::Types::Event::TofEvent;
+namespace bip = boost::interprocess;
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// Identifies an event cache file
+const char MAGIC[8] = {'M', 'T', 'D', 'E', 'V', 'C', 'A', 'C'};
+/// Version of the layout below. Increase it whenever the layout changes.
+const uint32_t VERSION = 1;
+/// Written in native byte order, to reject files from other machines
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+/// Alignment of the event arrays in the file
+const uint64_t EVENT_ALIGNMENT = 64;
+
+/// The start of the file
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byteOrderMark;
+  /// sizeof the event types, which must match those of the reader
+  uint32_t tofEventSize;
+  uint32_t weightedEventSize;
+  uint32_t weightedEventNoTimeSize;
+  /// Length of the signature, which follows the header
+  uint32_t signatureLength;
+  uint64_t numberOfSpectra;
+  uint64_t numberOfEvents;
+  double tofMin;
+  double tofMax;
+};
+
+/// Where the events of one spectrum are. The index follows the signature.
+struct IndexEntry {
+  /// Offset of the first event from the start of the file
+  uint64_t offset;
+  /// Number of events
+  uint64_t count;
+  /// The API::EventType of the events
+  uint32_t eventType;
+  uint32_t unused;
+};
+
+/// @return value rounded up to a multiple of alignment
+uint64_t alignUp(const uint64_t value, const uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+/// @return the size of one event of a type
+uint64_t eventSize(const API::EventType eventType) {
+  switch (eventType) {
+  case API::TOF:
+    return sizeof(TofEvent);
+  case API::WEIGHTED:
+    return sizeof(WeightedEvent);
+  case API::WEIGHTED_NOTIME:
+    return sizeof(WeightedEventNoTime);
+  }
+  throw std::runtime_error("EventCacheFile: invalid event type");
+}
+
+/// @return the offset of the index, after the header and signature
+uint64_t indexOffset(const uint64_t signatureLength) {
+  return alignUp(sizeof(FileHeader) + signatureLength, sizeof(uint64_t));
+}
+
+/// Write the events of a vector sorted by tof, and widen the tof range
+template <class T>
+void writeEvents(std::ostream &out, const std::vector<T> &events,
+                 double &tofMin, double &tofMax) {
+  if (events.empty())
+    return;
+  out.write(reinterpret_cast<const char *>(events.data()),
+            static_cast<std::streamsize>(events.size() * sizeof(T)));
+  tofMin = std::min(tofMin, events.front().tof());
+  tofMax = std::max(tofMax, events.back().tof());
+}
+
+/// @return filename with "-number" added to its base name
+std::string numberedName(const std::string &filename, const int number) {
+  Poco::Path path(filename);
+  path.setBaseName(path.getBaseName() + "-" + std::to_string(number));
+  return path.toString();
+}
+
+/** Give a complete file its final name. Replacing a file that is mapped,
+ * which is not allowed on Windows, is avoided by switching to the first of
+ * the names filename-1, filename-2, ... that is not mapped, so that the
+ * number of files stays that of the files in use.
+ * @param temporary :: the complete file
+ * @param filename :: the name wanted
+ * @return the name the file was given
+ */
+std::string moveIntoPlace(const std::string &temporary,
+                          const std::string &filename) {
+  try {
+    Poco::File(temporary).renameTo(filename);
+    return filename;
+  } catch (Poco::FileException &) {
+    // filename is still mapped by a workspace loaded from it earlier
+  }
+  for (int i = 1;; ++i) {
+    const std::string fresh = numberedName(filename, i);
+    const bool exists = Poco::File(fresh).exists();
+    try {
+      Poco::File(temporary).renameTo(fresh);
+      return fresh;
+    } catch (Poco::FileException &ex) {
+      // Also mapped, try the next name
+      if (exists)
+        continue;
+      Poco::File(temporary).remove();
+      throw std::runtime_error("EventCacheFile: cannot replace " + filename +
+                               ": " + ex.displayText());
+    }
+  }
+}
+
+/// Write zeros up to an offset
+void padTo(std::ostream &out, const uint64_t offset) {
+  const auto position = static_cast<uint64_t>(out.tellp());
+  const std::vector<char> zeros(offset - position, 0);
+  out.write(zeros.data(), static_cast<std::streamsize>(zeros.size()));
+}
+} // namespace
+
+/** Write the events of a workspace to a cache file. The file is written
+ * under a temporary name and renamed once complete, so a file that is mapped
+ * by an existing workspace is never modified in place. Where such a file
+ * cannot be replaced (Windows does not allow it) the new file is given a
+ * numbered name, filename with "-1", "-2", ... added to its base name; see
+ * existingNames().
+ * @param filename :: the file to write. It is replaced if it exists.
+ * @param workspace :: the workspace whose events are written
+ * @param signature :: describes where the events came from
+ * @return the name of the file written
+ * @throw std::runtime_error if the file cannot be written
+ */
+std::string EventCacheFile::write(const std::string &filename,
+                                  const EventWorkspace &workspace,
+                                  const std::string &signature) {
+  const size_t numberOfSpectra = workspace.getNumberHistograms();
+
+  // Lay out the file
+  FileHeader header;
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.byteOrderMark = BYTE_ORDER_MARK;
+  header.tofEventSize = sizeof(TofEvent);
+  header.weightedEventSize = sizeof(WeightedEvent);
+  header.weightedEventNoTimeSize = sizeof(WeightedEventNoTime);
+  header.signatureLength = static_cast<uint32_t>(signature.size());
+  header.numberOfSpectra = numberOfSpectra;
+  header.numberOfEvents = 0;
+  header.tofMin = std::numeric_limits<double>::max();
+  header.tofMax = std::numeric_limits<double>::lowest();
+
+  std::vector<IndexEntry> index(numberOfSpectra);
+  uint64_t offset = indexOffset(signature.size()) +
+                    numberOfSpectra * sizeof(IndexEntry);
+  for (size_t i = 0; i < numberOfSpectra; ++i) {
+    const EventList &spectrum = workspace.getSpectrum(i);
+    const auto eventType = spectrum.getEventType();
+    index[i].offset = 0;
+    index[i].count = spectrum.getNumberEvents();
+    index[i].eventType = static_cast<uint32_t>(eventType);
+    index[i].unused = 0;
+    // Empty spectra take no space
+    if (index[i].count > 0) {
+      index[i].offset = alignUp(offset, EVENT_ALIGNMENT);
+      offset = index[i].offset + index[i].count * eventSize(eventType);
+    }
+    header.numberOfEvents += index[i].count;
+  }
+
+  const std::string temporary = filename + ".part";
+  std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+  if (!out)
+    throw std::runtime_error("EventCacheFile: cannot write " + temporary);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(signature.data(), static_cast<std::streamsize>(signature.size()));
+  padTo(out, indexOffset(signature.size()));
+  out.write(reinterpret_cast<const char *>(index.data()),
+            static_cast<std::streamsize>(index.size() * sizeof(IndexEntry)));
+
+  // Write a sorted copy of each list, one at a time, leaving the workspace
+  // untouched
+  for (size_t i = 0; i < numberOfSpectra; ++i) {
+    if (index[i].count == 0)
+      continue;
+    padTo(out, index[i].offset);
+    EventList spectrum(workspace.getSpectrum(i));
+    spectrum.sortTof();
+    switch (spectrum.getEventType()) {
+    case API::TOF:
+      writeEvents(out, spectrum.getEvents(), header.tofMin, header.tofMax);
+      break;
+    case API::WEIGHTED:
+      writeEvents(out, spectrum.getWeightedEvents(), header.tofMin,
+                  header.tofMax);
+      break;
+    case API::WEIGHTED_NOTIME:
+      writeEvents(out, spectrum.getWeightedEventsNoTime(), header.tofMin,
+                  header.tofMax);
+      break;
+    }
+  }
+
+  // The tof range is now known
+  out.seekp(0);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.close();
+  if (!out) {
+    Poco::File(temporary).remove();
+    throw std::runtime_error("EventCacheFile: error writing " + temporary);
+  }
+  return moveIntoPlace(temporary, filename);
+}
+
+/** List the cache files that write() may have used for a file name: filename
+ * itself and the names write() falls back to, filename-1, filename-2, ...
+ * @param filename :: the file name given to write()
+ * @return the names of those files that exist, in that order
+ */
+std::vector<std::string>
+EventCacheFile::existingNames(const std::string &filename) {
+  std::vector<std::string> names;
+  if (Poco::File(filename).exists())
+    names.push_back(filename);
+  for (int i = 1;; ++i) {
+    const std::string fresh = numberedName(filename, i);
+    if (!Poco::File(fresh).exists())
+      return names;
+    names.push_back(fresh);
+  }
+}
+
+/** Map a cache file.
+ * @param filename :: the file to open
+ * @return the mapped file
+ * @throw std::runtime_error if the file is not an event cache file written
+ * on a compatible machine, or is truncated
+ */
+std::shared_ptr<EventCacheFile>
+EventCacheFile::open(const std::string &filename) {
+  try {
+    return std::shared_ptr<EventCacheFile>(new EventCacheFile(filename));
+  } catch (bip::interprocess_exception &ex) {
+    throw std::runtime_error("EventCacheFile: cannot map " + filename + ": " +
+                             ex.what());
+  }
+}
+
+/** Constructor. Maps the file and checks its header and index.
+ * @param filename :: the file to open
+ */
+EventCacheFile::EventCacheFile(const std::string &filename)
+    : m_file(filename.c_str(), bip::read_only),
+      m_region(m_file, bip::read_only) {
+  const auto fileSize = static_cast<uint64_t>(m_region.get_size());
+  const char *base = static_cast<const char *>(m_region.get_address());
+  const std::string invalid =
+      "EventCacheFile: " + filename + " is not a valid event cache: ";
+
+  FileHeader header;
+  if (fileSize < sizeof(header))
+    throw std::runtime_error(invalid + "too short");
+  std::memcpy(&header, base, sizeof(header));
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    throw std::runtime_error(invalid + "wrong file type");
+  if (header.version != VERSION)
+    throw std::runtime_error(invalid + "unsupported version");
+  if (header.byteOrderMark != BYTE_ORDER_MARK ||
+      header.tofEventSize != sizeof(TofEvent) ||
+      header.weightedEventSize != sizeof(WeightedEvent) ||
+      header.weightedEventNoTimeSize != sizeof(WeightedEventNoTime))
+    throw std::runtime_error(invalid + "written on an incompatible machine");
+
+  m_indexOffset = indexOffset(header.signatureLength);
+  if (header.numberOfSpectra >
+      (fileSize - std::min(fileSize, m_indexOffset)) / sizeof(IndexEntry))
+    throw std::runtime_error(invalid + "truncated index");
+  m_signature.assign(base + sizeof(header), header.signatureLength);
+  m_numberOfSpectra = header.numberOfSpectra;
+  m_numberOfEvents = header.numberOfEvents;
+  m_tofMin = header.tofMin;
+  m_tofMax = header.tofMax;
+
+  for (size_t i = 0; i < m_numberOfSpectra; ++i) {
+    IndexEntry entry;
+    std::memcpy(&entry, indexEntry(i), sizeof(entry));
+    if (entry.eventType > API::WEIGHTED_NOTIME ||
+        entry.offset % EVENT_ALIGNMENT != 0 || entry.offset > fileSize ||
+        entry.count > (fileSize - entry.offset) /
+                          eventSize(static_cast<API::EventType>(
+                              entry.eventType)))
+      throw std::runtime_error(invalid + "bad index entry for spectrum " +
+                               std::to_string(i));
+  }
+}
+
+/// @return the start of the index entry of a spectrum
+const char *EventCacheFile::indexEntry(const size_t index) const {
+  return static_cast<const char *>(m_region.get_address()) + m_indexOffset +
+         index * sizeof(IndexEntry);
+}
+
+/** Get a view of the events of one spectrum. The view keeps the file mapped.
+ * @param index :: the workspace index of the spectrum
+ * @return the events, sorted by time-of-flight
+ */
+MappedEvents EventCacheFile::events(const size_t index) const {
+  if (index >= m_numberOfSpectra)
+    throw std::out_of_range("EventCacheFile::events: index out of range");
+  IndexEntry entry;
+  std::memcpy(&entry, indexEntry(index), sizeof(entry));
+  const char *data = static_cast<const char *>(m_region.get_address());
+  return MappedEvents(shared_from_this(), data + entry.offset,
+                      static_cast<size_t>(entry.count),
+                      static_cast<API::EventType>(entry.eventType));
+}
+
+/** Replace the events of each spectrum of a workspace by those of the file,
+ * mapped in place.
+ * @param workspace :: a workspace with as many spectra as the file
+ * @throw std::invalid_argument if the number of spectra differs
+ */
+void EventCacheFile::mapInto(EventWorkspace &workspace) const {
+  if (workspace.getNumberHistograms() != m_numberOfSpectra)
+    throw std::invalid_argument("EventCacheFile::mapInto: the workspace has " +
+                                std::to_string(
+                                    workspace.getNumberHistograms()) +
+                                " spectra but the file has " +
+                                std::to_string(m_numberOfSpectra));
+  for (size_t i = 0; i < m_numberOfSpectra; ++i)
+    workspace.getSpectrum(i).mapEvents(events(i));
+}
+
+} // namespace DataObjects
+} // namespace Mantid
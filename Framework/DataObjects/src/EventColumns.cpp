@@ -0,0 +1,203 @@
+#include "MantidDataObjects/EventColumns.h"
+
+#include <algorithm>
+#include <numeric>
+
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/** Reorder a column in place following a permutation of indices.
+ * @param column :: the column to reorder. Ignored if empty.
+ * @param order :: order[i] is the index of the element that goes to i.
+ */
+template <typename T>
+void applyPermutation(std::vector<T> &column,
+                      const std::vector<size_t> &order) {
+  if (column.empty())
+    return;
+  std::vector<T> sorted;
+  sorted.reserve(column.size());
+  for (const auto index : order)
+    sorted.push_back(column[index]);
+  column.swap(sorted);
+}
+
+/// Erase the index range [first, last) from a column, if it is in use
+template <typename T>
+void eraseRange(std::vector<T> &column, const size_t first, const size_t last) {
+  if (!column.empty())
+    column.erase(column.begin() + first, column.begin() + last);
+}
+
+/// Release the memory held by a column
+template <typename T> void releaseColumn(std::vector<T> &column) {
+  std::vector<T>().swap(column);
+}
+} // namespace
+
+/** Fill the columns from a vector of TofEvent. Any existing content is
+ * replaced.
+ * @param events :: events to copy
+ */
+void EventColumns::assign(const std::vector<TofEvent> &events) {
+  clear();
+  reserve(events.size());
+  for (const auto &event : events)
+    push_back(event);
+}
+
+/** Fill the columns from a vector of WeightedEvent. Any existing content is
+ * replaced.
+ * @param events :: events to copy
+ */
+void EventColumns::assign(const std::vector<WeightedEvent> &events) {
+  clear();
+  reserve(events.size());
+  m_weight.reserve(events.size());
+  m_errorSquared.reserve(events.size());
+  for (const auto &event : events)
+    push_back(event);
+}
+
+/** Fill the columns from a vector of WeightedEventNoTime. Any existing content
+ * is replaced.
+ * @param events :: events to copy
+ */
+void EventColumns::assign(const std::vector<WeightedEventNoTime> &events) {
+  clear();
+  m_tof.reserve(events.size());
+  m_weight.reserve(events.size());
+  m_errorSquared.reserve(events.size());
+  for (const auto &event : events)
+    push_back(event);
+}
+
+/** Rebuild a vector of TofEvent from the columns.
+ * @param events :: output vector, replaced by the content of the columns
+ */
+void EventColumns::copyTo(std::vector<TofEvent> &events) const {
+  const size_t numEvents = size();
+  events.clear();
+  events.reserve(numEvents);
+  const bool havePulse = hasPulseTimes();
+  for (size_t i = 0; i < numEvents; ++i)
+    events.emplace_back(m_tof[i], havePulse ? DateAndTime(m_pulseTime[i])
+                                            : DateAndTime(int64_t(0)));
+}
+
+/** Rebuild a vector of WeightedEvent from the columns.
+ * @param events :: output vector, replaced by the content of the columns
+ */
+void EventColumns::copyTo(std::vector<WeightedEvent> &events) const {
+  const size_t numEvents = size();
+  events.clear();
+  events.reserve(numEvents);
+  const bool havePulse = hasPulseTimes();
+  const bool haveWeights = hasWeights();
+  for (size_t i = 0; i < numEvents; ++i)
+    events.emplace_back(
+        m_tof[i],
+        havePulse ? DateAndTime(m_pulseTime[i]) : DateAndTime(int64_t(0)),
+        haveWeights ? m_weight[i] : 1.0f,
+        haveWeights ? m_errorSquared[i] : 1.0f);
+}
+
+/** Rebuild a vector of WeightedEventNoTime from the columns.
+ * @param events :: output vector, replaced by the content of the columns
+ */
+void EventColumns::copyTo(std::vector<WeightedEventNoTime> &events) const {
+  const size_t numEvents = size();
+  events.clear();
+  events.reserve(numEvents);
+  const bool haveWeights = hasWeights();
+  for (size_t i = 0; i < numEvents; ++i)
+    events.emplace_back(m_tof[i], haveWeights ? m_weight[i] : 1.0f,
+                        haveWeights ? m_errorSquared[i] : 1.0f);
+}
+
+/// Remove all the events and release the memory of all columns
+void EventColumns::clear() {
+  releaseColumn(m_tof);
+  releaseColumn(m_pulseTime);
+  releaseColumn(m_weight);
+  releaseColumn(m_errorSquared);
+}
+
+/** Give every event held a weight and squared error of 1, as when converting
+ * TofEvent to WeightedEvent. Does nothing if the events already have weights.
+ */
+void EventColumns::addWeights() {
+  if (hasWeights())
+    return;
+  m_weight.assign(m_tof.size(), 1.0f);
+  m_errorSquared.assign(m_tof.size(), 1.0f);
+}
+
+/** Drop the pulse times, as when converting to WeightedEventNoTime.
+ */
+void EventColumns::removePulseTimes() { releaseColumn(m_pulseTime); }
+
+/** Reserve space for a number of events in the tof and pulse time columns.
+ * As with EventList::reserve(), this is intended for un-weighted events.
+ * @param num :: number of events that will be held
+ */
+void EventColumns::reserve(size_t num) {
+  m_tof.reserve(num);
+  m_pulseTime.reserve(num);
+}
+
+/** Memory used by the columns. Reports the capacity rather than the size, as
+ * EventList::getMemorySize() does for the event vectors.
+ * @return the memory used, in bytes
+ */
+size_t EventColumns::getMemorySize() const {
+  return m_tof.capacity() * sizeof(double) +
+         m_pulseTime.capacity() * sizeof(int64_t) +
+         (m_weight.capacity() + m_errorSquared.capacity()) * sizeof(float);
+}
+
+/** Sort all the columns by time-of-flight. The permutation is computed on the
+ * tof column only and then applied to each of the other columns.
+ */
+void EventColumns::sortTof() {
+  if (std::is_sorted(m_tof.begin(), m_tof.end()))
+    return;
+
+  std::vector<size_t> order(m_tof.size());
+  std::iota(order.begin(), order.end(), size_t(0));
+  std::sort(order.begin(), order.end(),
+            [this](const size_t lhs, const size_t rhs) {
+              return m_tof[lhs] < m_tof[rhs];
+            });
+
+  applyPermutation(m_tof, order);
+  applyPermutation(m_pulseTime, order);
+  applyPermutation(m_weight, order);
+  applyPermutation(m_errorSquared, order);
+}
+
+/// Reverse the order of the events in all columns
+void EventColumns::reverse() {
+  std::reverse(m_tof.begin(), m_tof.end());
+  std::reverse(m_pulseTime.begin(), m_pulseTime.end());
+  std::reverse(m_weight.begin(), m_weight.end());
+  std::reverse(m_errorSquared.begin(), m_errorSquared.end());
+}
+
+/** Remove the events in the index range [first, last) from all columns.
+ * @param first :: index of the first event to remove
+ * @param last :: one past the index of the last event to remove
+ */
+void EventColumns::erase(size_t first, size_t last) {
+  eraseRange(m_tof, first, last);
+  eraseRange(m_pulseTime, first, last);
+  eraseRange(m_weight, first, last);
+  eraseRange(m_errorSquared, first, last);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
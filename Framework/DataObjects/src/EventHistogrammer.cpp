@@ -0,0 +1,463 @@
+#include "MantidDataObjects/EventHistogrammer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MANTID_HISTOGRAM_AVX
+#endif
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MANTID_HISTOGRAM_SSE2
+#endif
+
+#if defined(MANTID_HISTOGRAM_AVX) || defined(MANTID_HISTOGRAM_SSE2)
+#include <immintrin.h>
+#endif
+
+using Mantid::Types::Event::TofEvent;
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// Number of events whose bins are computed in one go
+constexpr size_t BLOCK_SIZE = 256;
+/// Tolerance, as a fraction of a bin width, for the closed form binnings
+constexpr double BINNING_TOLERANCE = 1e-6;
+
+/// Clamp a fractional bin index to [0, maxGuess]. NaN maps to 0.
+inline int32_t clampGuess(const double index, const double maxGuess) {
+  return static_cast<int32_t>(
+      index >= 0. ? (index < maxGuess ? index : maxGuess) : 0.);
+}
+
+/// Scalar kernel for linear bins
+void guessLinearScalar(const double *tofs, const size_t numEvents,
+                       const double origin, const double inverseWidth,
+                       const double maxGuess, int32_t *guesses) {
+  for (size_t i = 0; i < numEvents; ++i)
+    guesses[i] = clampGuess((tofs[i] - origin) * inverseWidth, maxGuess);
+}
+
+#ifdef MANTID_HISTOGRAM_SSE2
+/// SSE2 kernel for linear bins, 2 events at a time
+void guessLinearSSE2(const double *tofs, const size_t numEvents,
+                     const double origin, const double inverseWidth,
+                     const double maxGuess, int32_t *guesses) {
+  const __m128d vOrigin = _mm_set1_pd(origin);
+  const __m128d vInverseWidth = _mm_set1_pd(inverseWidth);
+  const __m128d vMax = _mm_set1_pd(maxGuess);
+  const __m128d vZero = _mm_setzero_pd();
+  size_t i = 0;
+  for (; i + 2 <= numEvents; i += 2) {
+    __m128d index = _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(tofs + i), vOrigin),
+                               vInverseWidth);
+    // max() returns its second operand for NaN, which sends NaN to 0
+    index = _mm_min_pd(_mm_max_pd(index, vZero), vMax);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(guesses + i),
+                     _mm_cvttpd_epi32(index));
+  }
+  guessLinearScalar(tofs + i, numEvents - i, origin, inverseWidth, maxGuess,
+                    guesses + i);
+}
+#endif
+
+#ifdef MANTID_HISTOGRAM_AVX
+/// AVX kernel for linear bins, 4 events at a time
+__attribute__((target("avx"))) void
+guessLinearAVX(const double *tofs, const size_t numEvents, const double origin,
+               const double inverseWidth, const double maxGuess,
+               int32_t *guesses) {
+  const __m256d vOrigin = _mm256_set1_pd(origin);
+  const __m256d vInverseWidth = _mm256_set1_pd(inverseWidth);
+  const __m256d vMax = _mm256_set1_pd(maxGuess);
+  const __m256d vZero = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= numEvents; i += 4) {
+    __m256d index = _mm256_mul_pd(
+        _mm256_sub_pd(_mm256_loadu_pd(tofs + i), vOrigin), vInverseWidth);
+    index = _mm256_min_pd(_mm256_max_pd(index, vZero), vMax);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(guesses + i),
+                     _mm256_cvttpd_epi32(index));
+  }
+  guessLinearScalar(tofs + i, numEvents - i, origin, inverseWidth, maxGuess,
+                    guesses + i);
+}
+
+/// @return true if the CPU we run on supports AVX
+bool cpuSupportsAVX() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx");
+}
+#endif
+
+/// Pick the fastest kernel for linear bins supported by this CPU
+EventHistogrammer::GuessKernel bestLinearKernel() {
+#ifdef MANTID_HISTOGRAM_AVX
+  static const bool haveAVX = cpuSupportsAVX();
+  if (haveAVX)
+    return guessLinearAVX;
+#endif
+#ifdef MANTID_HISTOGRAM_SSE2
+  return guessLinearSSE2;
+#else
+  return guessLinearScalar;
+#endif
+}
+
+/** Find the bin containing a value with a binary search that compiles to
+ * conditional moves rather than branches.
+ * @param edges :: bin boundaries, sorted
+ * @param numEdges :: number of bin boundaries
+ * @param tof :: value to find, which must be in [edges[0], edges[numEdges-1])
+ * @return the index of the bin containing tof
+ */
+inline size_t branchFreeSearch(const double *edges, size_t numEdges,
+                               const double tof) {
+  const double *base = edges;
+  while (numEdges > 1) {
+    const size_t half = numEdges / 2;
+    base = (base[half] <= tof) ? base + half : base;
+    numEdges -= half;
+  }
+  return static_cast<size_t>(base - edges);
+}
+} // namespace
+
+/** Constructor. Classifies the bin boundaries.
+ * @param X :: bin boundaries, sorted in increasing order. They are not copied
+ * and must outlive this object.
+ * @param vectorise :: if false, never use the SIMD kernels. For testing and
+ * benchmarking.
+ */
+EventHistogrammer::EventHistogrammer(const MantidVec &X, const bool vectorise)
+    : m_edges(X), m_numBins(X.size() > 1 ? X.size() - 1 : 0),
+      m_binning(Binning::Arbitrary), m_origin(0.), m_inverseWidth(0.),
+      m_linearKernel(vectorise ? bestLinearKernel() : guessLinearScalar) {
+  if (m_numBins == 0 ||
+      m_numBins > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+    return;
+
+  // The last bin may be shorter than the others, as produced by Rebin when
+  // the range is not a multiple of the step, so fit on the other boundaries.
+  const size_t numRegular = std::max(m_numBins - 1, size_t(1));
+  const double front = X.front();
+
+  const double width =
+      (X[numRegular] - front) / static_cast<double>(numRegular);
+  if (width > 0.) {
+    const double tolerance = BINNING_TOLERANCE * width;
+    bool linear = (X.back() - X[m_numBins - 1] <= width + tolerance);
+    for (size_t i = 1; linear && i < numRegular; ++i)
+      linear = std::abs(X[i] - (front + static_cast<double>(i) * width)) <=
+               tolerance;
+    if (linear) {
+      m_binning = Binning::Linear;
+      m_origin = front;
+      m_inverseWidth = 1. / width;
+      return;
+    }
+  }
+
+  if (front > 0.) {
+    const double ratio =
+        std::pow(X[numRegular] / front, 1. / static_cast<double>(numRegular));
+    if (ratio > 1.) {
+      const double tolerance = BINNING_TOLERANCE * (ratio - 1.);
+      bool logarithmic = (X.back() <= X[m_numBins - 1] * (ratio + tolerance));
+      double expected = front;
+      for (size_t i = 1; logarithmic && i < numRegular; ++i) {
+        expected *= ratio;
+        logarithmic = std::abs(X[i] - expected) <= tolerance * expected;
+      }
+      if (logarithmic) {
+        m_binning = Binning::Logarithmic;
+        m_origin = std::log(front);
+        m_inverseWidth = 1. / std::log(ratio);
+      }
+    }
+  }
+}
+
+/** Find the bin containing a value.
+ * @param tof :: the value to look up
+ * @return the index of the bin, or numberOfBins() if tof is outside
+ * [X.front(), X.back())
+ */
+size_t EventHistogrammer::findBin(const double tof) const {
+  if (m_numBins == 0 || !(tof >= m_edges.front() && tof < m_edges.back()))
+    return m_numBins;
+  int32_t guess = 0;
+  guessBins(&tof, 1, &guess);
+  return resolveBin(tof, guess);
+}
+
+/** Compute a first guess of the bins of a block of events. Guesses are
+ * clamped to valid bin indices but may be off by one.
+ * @param tofs :: the event values
+ * @param numEvents :: number of events, at most BLOCK_SIZE
+ * @param guesses :: output guesses
+ */
+void EventHistogrammer::guessBins(const double *tofs, const size_t numEvents,
+                                  int32_t *guesses) const {
+  const double maxGuess = static_cast<double>(m_numBins - 1);
+  switch (m_binning) {
+  case Binning::Linear:
+    m_linearKernel(tofs, numEvents, m_origin, m_inverseWidth, maxGuess,
+                   guesses);
+    break;
+  case Binning::Logarithmic:
+    for (size_t i = 0; i < numEvents; ++i)
+      guesses[i] = clampGuess((std::log(tofs[i]) - m_origin) * m_inverseWidth,
+                              maxGuess);
+    break;
+  case Binning::Arbitrary:
+    // Nothing to guess, resolveBin() does the search
+    break;
+  }
+}
+
+/** Turn a guess into the exact bin of an event.
+ * @param tof :: the event value, in [X.front(), X.back())
+ * @param guess :: guess from guessBins()
+ * @return the index of the bin
+ */
+size_t EventHistogrammer::resolveBin(const double tof,
+                                     const int32_t guess) const {
+  if (m_binning == Binning::Arbitrary)
+    return branchFreeSearch(m_edges.data(), m_edges.size(), tof);
+
+  size_t bin = static_cast<size_t>(guess);
+  // Both loops terminate as tof is within the first and last boundaries
+  while (tof < m_edges[bin])
+    --bin;
+  while (tof >= m_edges[bin + 1])
+    ++bin;
+  return bin;
+}
+
+/** Call accumulate(index, bin) for each event inside the bin boundaries.
+ * @param tofs :: event values
+ * @param numEvents :: number of events
+ * @param accumulate :: functor called with the index of the event and its bin
+ */
+template <class Accumulate>
+void EventHistogrammer::forEachBin(const double *tofs, const size_t numEvents,
+                                   Accumulate accumulate) const {
+  if (m_numBins == 0)
+    return;
+  const double xMin = m_edges.front();
+  const double xMax = m_edges.back();
+  int32_t guesses[BLOCK_SIZE];
+  for (size_t start = 0; start < numEvents; start += BLOCK_SIZE) {
+    const size_t count = std::min(BLOCK_SIZE, numEvents - start);
+    const double *block = tofs + start;
+    guessBins(block, count, guesses);
+    for (size_t i = 0; i < count; ++i) {
+      const double tof = block[i];
+      if (tof >= xMin && tof < xMax)
+        accumulate(start + i, resolveBin(tof, guesses[i]));
+    }
+  }
+}
+
+/** As forEachBin(), for a vector of events. The times-of-flight are gathered
+ * into a contiguous block before computing the bins.
+ * @param events :: the events
+ * @param accumulate :: functor called with the index of the event and its bin
+ */
+template <class T, class Accumulate>
+void EventHistogrammer::forEachEventBin(const std::vector<T> &events,
+                                        Accumulate accumulate) const {
+  double tofs[BLOCK_SIZE];
+  for (size_t start = 0; start < events.size(); start += BLOCK_SIZE) {
+    const size_t count = std::min(BLOCK_SIZE, events.size() - start);
+    for (size_t i = 0; i < count; ++i)
+      tofs[i] = events[start + i].tof();
+    forEachBin(tofs, count, [&accumulate, start](size_t index, size_t bin) {
+      accumulate(start + index, bin);
+    });
+  }
+}
+
+/** Call addRange(bin, first, last) for each bin holding events, where
+ * [first, last) is the range of events in that bin. The events must be sorted.
+ * Bin boundaries are located with a galloping search from the previous one,
+ * so the cost is logarithmic in the number of events per bin.
+ * @param numEvents :: number of events
+ * @param tofAt :: functor returning the value of the event at an index
+ * @param addRange :: functor called with a bin and its range of events
+ */
+template <class TofAt, class AddRange>
+void EventHistogrammer::forEachSortedRange(const size_t numEvents,
+                                           TofAt tofAt,
+                                           AddRange addRange) const {
+  // Index of the first event with a value not less than edge, searching from
+  // first onwards
+  auto gallop = [numEvents, &tofAt](size_t first, const double edge) {
+    size_t step = 1;
+    while (first + step < numEvents && tofAt(first + step) < edge) {
+      first += step;
+      step *= 2;
+    }
+    size_t last = std::min(first + step, numEvents);
+    // tofAt(first) < edge or first is where we started; tofAt(last) >= edge
+    while (first < last) {
+      const size_t middle = first + (last - first) / 2;
+      if (tofAt(middle) < edge)
+        first = middle + 1;
+      else
+        last = middle;
+    }
+    return first;
+  };
+
+  size_t first = gallop(0, m_edges.front());
+  for (size_t bin = 0; bin < m_numBins && first < numEvents; ++bin) {
+    const size_t last = gallop(first, m_edges[bin + 1]);
+    if (last > first)
+      addRange(bin, first, last);
+    first = last;
+  }
+}
+
+/** @return true if sorted events should be binned by locating the bin
+ * boundaries in the events rather than binning each event.
+ * @param sorted :: true if the events are sorted
+ * @param numEvents :: number of events
+ */
+bool EventHistogrammer::useSortedRanges(const bool sorted,
+                                        const size_t numEvents) const {
+  // With fewer events than bins, most boundary searches would find nothing
+  return sorted && numEvents >= m_numBins;
+}
+
+/** Add one count per event to the bins. Y must have numberOfBins() entries.
+ * @param tofs :: event values
+ * @param numEvents :: number of events
+ * @param Y :: counts, incremented
+ * @param sorted :: true if the events are sorted in increasing order
+ */
+void EventHistogrammer::addCounts(const double *tofs, const size_t numEvents,
+                                  double *Y, const bool sorted) const {
+  if (useSortedRanges(sorted, numEvents)) {
+    forEachSortedRange(numEvents, [tofs](size_t i) { return tofs[i]; },
+                       [Y](size_t bin, size_t first, size_t last) {
+                         Y[bin] += static_cast<double>(last - first);
+                       });
+    return;
+  }
+  forEachBin(tofs, numEvents, [Y](size_t, size_t bin) { Y[bin] += 1.0; });
+}
+
+/** Add the weight and squared error of each event to the bins. Y and E must
+ * have numberOfBins() entries.
+ * @param tofs :: event values
+ * @param weights :: event weights
+ * @param errorSquareds :: squared errors of the event weights
+ * @param numEvents :: number of events
+ * @param Y :: sum of weights, incremented
+ * @param E :: sum of squared errors, incremented
+ * @param sorted :: true if the events are sorted in increasing order
+ */
+void EventHistogrammer::addWeights(const double *tofs, const float *weights,
+                                   const float *errorSquareds,
+                                   const size_t numEvents, double *Y,
+                                   double *E, const bool sorted) const {
+  if (useSortedRanges(sorted, numEvents)) {
+    forEachSortedRange(
+        numEvents, [tofs](size_t i) { return tofs[i]; },
+        [=](size_t bin, size_t first, size_t last) {
+          // Convert to double before adding, to preserve precision
+          double y = 0., e = 0.;
+          for (size_t i = first; i < last; ++i) {
+            y += double(weights[i]);
+            e += double(errorSquareds[i]);
+          }
+          Y[bin] += y;
+          E[bin] += e;
+        });
+    return;
+  }
+  forEachBin(tofs, numEvents, [=](size_t index, size_t bin) {
+    Y[bin] += double(weights[index]);
+    E[bin] += double(errorSquareds[index]);
+  });
+}
+
+/** Add one count per event to the bins. Y must have numberOfBins() entries.
+ * @param events :: the events
+ * @param Y :: counts, incremented
+ * @param sorted :: true if the events are sorted by tof
+ */
+void EventHistogrammer::addCounts(const std::vector<TofEvent> &events,
+                                  MantidVec &Y, const bool sorted) const {
+  double *y = Y.data();
+  if (useSortedRanges(sorted, events.size())) {
+    forEachSortedRange(events.size(),
+                       [&events](size_t i) { return events[i].tof(); },
+                       [y](size_t bin, size_t first, size_t last) {
+                         y[bin] += static_cast<double>(last - first);
+                       });
+    return;
+  }
+  forEachEventBin(events, [y](size_t, size_t bin) { y[bin] += 1.0; });
+}
+
+/** Add the weight and squared error of each event to the bins. Y and E must
+ * have numberOfBins() entries.
+ * @param events :: the weighted events
+ * @param Y :: sum of weights, incremented
+ * @param E :: sum of squared errors, incremented
+ * @param sorted :: true if the events are sorted by tof
+ */
+template <class T>
+void EventHistogrammer::addWeights(const std::vector<T> &events, MantidVec &Y,
+                                   MantidVec &E, const bool sorted) const {
+  double *y = Y.data();
+  double *e = E.data();
+  if (useSortedRanges(sorted, events.size())) {
+    forEachSortedRange(
+        events.size(), [&events](size_t i) { return events[i].tof(); },
+        [&events, y, e](size_t bin, size_t first, size_t last) {
+          double sumY = 0., sumE = 0.;
+          for (size_t i = first; i < last; ++i) {
+            sumY += double(events[i].weight());
+            sumE += double(events[i].errorSquared());
+          }
+          y[bin] += sumY;
+          e[bin] += sumE;
+        });
+    return;
+  }
+  forEachEventBin(events, [&events, y, e](size_t index, size_t bin) {
+    y[bin] += double(events[index].weight());
+    e[bin] += double(events[index].errorSquared());
+  });
+}
+
+/// @return the name of the instruction set used for linear bins
+std::string EventHistogrammer::instructionSet() {
+  const auto kernel = bestLinearKernel();
+#ifdef MANTID_HISTOGRAM_AVX
+  if (kernel == guessLinearAVX)
+    return "AVX";
+#endif
+#ifdef MANTID_HISTOGRAM_SSE2
+  if (kernel == guessLinearSSE2)
+    return "SSE2";
+#endif
+  return "scalar";
+}
+
+template MANTID_DATAOBJECTS_DLL void
+EventHistogrammer::addWeights(const std::vector<WeightedEvent> &, MantidVec &,
+                              MantidVec &, const bool) const;
+template MANTID_DATAOBJECTS_DLL void
+EventHistogrammer::addWeights(const std::vector<WeightedEventNoTime> &,
+                              MantidVec &, MantidVec &, const bool) const;
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -1,4 +1,6 @@
 #include "MantidDataObjects/EventList.h"
+#include "MantidDataObjects/EventHistogrammer.h"
+#include "MantidDataObjects/EventSorter.h"
 #include "MantidDataObjects/Histogram1D.h"
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
@@ -98,31 +100,6 @@ template <typename T> bool compareEventTof(const T &e1, const T &e2) {
   return (e1.tof() < e2.tof());
 }
 
-/** Compare two events' FRAME id, return true if e1 should be before e2.
- * @param e1 :: first event
- * @param e2 :: second event
- *  */
-bool compareEventPulseTime(const TofEvent &e1, const TofEvent &e2) {
-  return (e1.pulseTime() < e2.pulseTime());
-}
-
-/** Compare two events' FRAME id, return true if e1 should be before e2.
- *  Assuming that if e1's pulse time is earlier than e2's, then e1 must be
- * earlier regardless TOF value
- * @param e1 :: first event
- * @param e2 :: second event
- *  */
-bool compareEventPulseTimeTOF(const TofEvent &e1, const TofEvent &e2) {
-
-  if (e1.pulseTime() < e2.pulseTime()) {
-    return true;
-  } else if ((e1.pulseTime() == e2.pulseTime()) && (e1.tof() < e2.tof())) {
-    return true;
-  }
-
-  return false;
-}
-
 // comparator for pulse time with tolerance
 struct comparePulseTimeTOFDelta {
   explicit comparePulseTimeTOFDelta(const Types::Core::DateAndTime &start,
@@ -156,7 +133,8 @@ struct comparePulseTimeTOFDelta {
 EventList::EventList()
     : m_histogram(HistogramData::Histogram::XMode::BinEdges,
                   HistogramData::Histogram::YMode::Counts),
-      eventType(TOF), order(UNSORTED), mru(nullptr) {}
+      eventType(TOF), order(UNSORTED), mru(nullptr),
+      m_storageMode(ROW_STORAGE), m_sortBeforeHistogram(true) {}
 
 /** Constructor with a MRU list
  * @param mru :: pointer to the MRU of the parent EventWorkspace
@@ -165,12 +143,14 @@ EventList::EventList()
 EventList::EventList(EventWorkspaceMRU *mru, specnum_t specNo)
     : IEventList(specNo), m_histogram(HistogramData::Histogram::XMode::BinEdges,
                                       HistogramData::Histogram::YMode::Counts),
-      eventType(TOF), order(UNSORTED), mru(mru) {}
+      eventType(TOF), order(UNSORTED), mru(mru), m_storageMode(ROW_STORAGE),
+      m_sortBeforeHistogram(true) {}
 
 /** Constructor copying from an existing event list
  * @param rhs :: EventList object to copy*/
 EventList::EventList(const EventList &rhs)
-    : IEventList(rhs), m_histogram(rhs.m_histogram), mru{nullptr} {
+    : IEventList(rhs), m_histogram(rhs.m_histogram), mru{nullptr},
+      m_storageMode(ROW_STORAGE), m_sortBeforeHistogram(true) {
   // Note that operator= also assigns m_histogram, but the above use of the copy
   // constructor avoid a memory allocation and is thus faster.
   this->operator=(rhs);
@@ -181,7 +161,8 @@ EventList::EventList(const EventList &rhs)
 EventList::EventList(const std::vector<TofEvent> &events)
     : m_histogram(HistogramData::Histogram::XMode::BinEdges,
                   HistogramData::Histogram::YMode::Counts),
-      eventType(TOF), mru(nullptr) {
+      eventType(TOF), mru(nullptr), m_storageMode(ROW_STORAGE),
+      m_sortBeforeHistogram(true) {
   this->events.assign(events.begin(), events.end());
   this->eventType = TOF;
   this->order = UNSORTED;
@@ -192,7 +173,7 @@ EventList::EventList(const std::vector<TofEvent> &events)
 EventList::EventList(const std::vector<WeightedEvent> &events)
     : m_histogram(HistogramData::Histogram::XMode::BinEdges,
                   HistogramData::Histogram::YMode::Counts),
-      mru(nullptr) {
+      mru(nullptr), m_storageMode(ROW_STORAGE), m_sortBeforeHistogram(true) {
   this->weightedEvents.assign(events.begin(), events.end());
   this->eventType = WEIGHTED;
   this->order = UNSORTED;
@@ -203,7 +184,7 @@ EventList::EventList(const std::vector<WeightedEvent> &events)
 EventList::EventList(const std::vector<WeightedEventNoTime> &events)
     : m_histogram(HistogramData::Histogram::XMode::BinEdges,
                   HistogramData::Histogram::YMode::Counts),
-      mru(nullptr) {
+      mru(nullptr), m_storageMode(ROW_STORAGE), m_sortBeforeHistogram(true) {
   this->weightedEventsNoTime.assign(events.begin(), events.end());
   this->eventType = WEIGHTED_NOTIME;
   this->order = UNSORTED;
@@ -232,6 +213,10 @@ void EventList::copyDataInto(EventList &sink) const {
   sink.events = events;
   sink.weightedEvents = weightedEvents;
   sink.weightedEventsNoTime = weightedEventsNoTime;
+  sink.m_columns = m_columns;
+  sink.m_compact = m_compact;
+  sink.m_mapped = m_mapped;
+  sink.m_storageMode = m_storageMode;
   sink.eventType = eventType;
   sink.order = order;
 }
@@ -258,6 +243,7 @@ void EventList::createFromHistogram(const ISpectrum *inSpec, bool GenerateZeros,
                                     int MaxEventsPerBin) {
   // Fresh start
   this->clear(true);
+  this->ensureRowStorage();
 
   // Get the input histogram
   const MantidVec &X = inSpec->readX();
@@ -342,6 +328,11 @@ EventList &EventList::operator=(const EventList &rhs) {
   events = rhs.events;
   weightedEvents = rhs.weightedEvents;
   weightedEventsNoTime = rhs.weightedEventsNoTime;
+  m_columns = rhs.m_columns;
+  m_compact = rhs.m_compact;
+  m_mapped = rhs.m_mapped;
+  m_storageMode = rhs.m_storageMode;
+  m_sortBeforeHistogram = rhs.m_sortBeforeHistogram;
   eventType = rhs.eventType;
   order = rhs.order;
   return *this;
@@ -353,6 +344,7 @@ EventList &EventList::operator=(const EventList &rhs) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const TofEvent &event) {
+  this->ensureRowStorage();
 
   switch (this->eventType) {
   case TOF:
@@ -381,6 +373,7 @@ EventList &EventList::operator+=(const TofEvent &event) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
+  this->ensureRowStorage();
   switch (this->eventType) {
   case TOF:
     // Simply push the events
@@ -421,6 +414,7 @@ EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const WeightedEvent &event) {
+  this->ensureRowStorage();
   this->switchTo(WEIGHTED);
   this->weightedEvents.push_back(event);
   this->order = UNSORTED;
@@ -437,6 +431,7 @@ EventList &EventList::operator+=(const WeightedEvent &event) {
  * */
 EventList &EventList::
 operator+=(const std::vector<WeightedEvent> &more_events) {
+  this->ensureRowStorage();
   switch (this->eventType) {
   case TOF:
     // Need to switch to weighted
@@ -474,6 +469,7 @@ operator+=(const std::vector<WeightedEvent> &more_events) {
  * */
 EventList &EventList::
 operator+=(const std::vector<WeightedEventNoTime> &more_events) {
+  this->ensureRowStorage();
   switch (this->eventType) {
   case TOF:
   case WEIGHTED:
@@ -502,6 +498,8 @@ operator+=(const std::vector<WeightedEventNoTime> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const EventList &more_events) {
+  this->ensureRowStorage();
+  more_events.ensureRowStorage();
   // We'll let the += operator for the given vector of event lists handle it
   switch (more_events.getEventType()) {
   case TOF:
@@ -570,6 +568,8 @@ EventList &EventList::operator-=(const EventList &more_events) {
     this->clearData();
     return *this;
   }
+  this->ensureRowStorage();
+  more_events.ensureRowStorage();
 
   // We'll let the -= operator for the given vector of event lists handle it
   switch (this->getEventType()) {
@@ -620,6 +620,8 @@ EventList &EventList::operator-=(const EventList &more_events) {
  * @return :: true if equal.
  */
 bool EventList::operator==(const EventList &rhs) const {
+  this->ensureRowStorage();
+  rhs.ensureRowStorage();
   if (this->getNumberEvents() != rhs.getNumberEvents())
     return false;
   if (this->eventType != rhs.eventType)
@@ -644,6 +646,8 @@ bool EventList::operator!=(const EventList &rhs) const {
 
 bool EventList::equals(const EventList &rhs, const double tolTof,
                        const double tolWeight, const int64_t tolPulse) const {
+  this->ensureRowStorage();
+  rhs.ensureRowStorage();
   // generic checks
   if (this->getNumberEvents() != rhs.getNumberEvents())
     return false;
@@ -692,6 +696,7 @@ EventType EventList::getEventType() const { return eventType; }
  * WEIGHTED_NOTIME)
  */
 void EventList::switchTo(EventType newType) {
+  this->ensureRowStorage();
   switch (newType) {
   case TOF:
     if (eventType != TOF)
@@ -772,6 +777,36 @@ void EventList::switchToWeightedEventsNoTime() {
   }
 }
 
+// -----------------------------------------------------------------------------------------------
+/** Switch the events of an EventList in COLUMN_STORAGE or COMPACT_STORAGE
+ * to a more general type of event, as switchTo() does for the event vectors.
+ * Existing events get a weight and squared error of 1; going to
+ * WEIGHTED_NOTIME drops their pulse times.
+ *
+ * @param newType :: WEIGHTED or WEIGHTED_NOTIME
+ */
+void EventList::switchStoredEventsTo(EventType newType) {
+  if (newType == eventType)
+    return;
+  if (newType == TOF || (newType == WEIGHTED && eventType == WEIGHTED_NOTIME))
+    throw std::runtime_error("EventList::switchStoredEventsTo() cannot "
+                             "restore pulse times or remove weights.");
+  const bool columns = m_storageMode == COLUMN_STORAGE;
+  if (eventType == TOF) {
+    if (columns)
+      m_columns.addWeights();
+    else
+      m_compact.addWeights();
+  }
+  if (newType == WEIGHTED_NOTIME) {
+    if (columns)
+      m_columns.removePulseTimes();
+    else
+      m_compact.removePulseTimes();
+  }
+  eventType = newType;
+}
+
 // ==============================================================================================
 // --- Testing functions (mostly)
 // ---------------------------------------------------------------
@@ -784,6 +819,7 @@ void EventList::switchToWeightedEventsNoTime() {
  * @return a WeightedEvent
  */
 WeightedEvent EventList::getEvent(size_t event_number) {
+  this->ensureRowStorage();
   switch (eventType) {
   case TOF:
     return WeightedEvent(events[event_number]);
@@ -797,6 +833,167 @@ WeightedEvent EventList::getEvent(size_t event_number) {
   throw std::runtime_error("EventList: invalid event type value was found.");
 }
 
+// -----------------------------------------------------------------------------------------------
+/** Choose how the events of this list are held in memory.
+ *
+ * COLUMN_STORAGE keeps the tof, pulse time, weight and error of the events in
+ * separate arrays (see EventColumns). Histogramming, integration, masking and
+ * tof/unit conversion then work directly on the tof array.
+ *
+ * COMPACT_STORAGE keeps each event in 8 bytes, with its time-of-flight in
+ * single precision and its pulse time in a table (see CompactEvents). The
+ * same operations as for COLUMN_STORAGE, and sorting, work on the compact
+ * events directly. Times-of-flight are rounded to single precision when the
+ * list is converted to compact storage, a relative error of at most 2^-24.
+ *
+ * Any other operation converts the list back to ROW_STORAGE first.
+ *
+ * MAPPED_STORAGE cannot be chosen here: lists are put in it by mapEvents().
+ *
+ * @param mode :: the storage to switch to
+ * @throw std::invalid_argument if mode is MAPPED_STORAGE
+ */
+void EventList::setStorageMode(const EventStorageMode mode) {
+  if (mode == m_storageMode)
+    return;
+  if (mode == MAPPED_STORAGE)
+    throw std::invalid_argument("EventList::setStorageMode: use mapEvents() "
+                                "to map events from an EventCacheFile");
+
+  this->ensureRowStorage();
+  if (mode == ROW_STORAGE)
+    return;
+
+  if (mode == COLUMN_STORAGE) {
+    switch (eventType) {
+    case TOF:
+      m_columns.assign(events);
+      break;
+    case WEIGHTED:
+      m_columns.assign(weightedEvents);
+      break;
+    case WEIGHTED_NOTIME:
+      m_columns.assign(weightedEventsNoTime);
+      break;
+    }
+  } else {
+    switch (eventType) {
+    case TOF:
+      m_compact.assign(events);
+      break;
+    case WEIGHTED:
+      m_compact.assign(weightedEvents);
+      break;
+    case WEIGHTED_NOTIME:
+      m_compact.assign(weightedEventsNoTime);
+      break;
+    }
+  }
+  m_storageMode = mode;
+  // The event vectors are now unused
+  std::vector<TofEvent>().swap(this->events);
+  std::vector<WeightedEvent>().swap(this->weightedEvents);
+  std::vector<WeightedEventNoTime>().swap(this->weightedEventsNoTime);
+}
+
+/** Return how the events of this list are currently held in memory.
+ * @return ROW_STORAGE, COLUMN_STORAGE, COMPACT_STORAGE or MAPPED_STORAGE
+ */
+EventStorageMode EventList::getStorageMode() const { return m_storageMode; }
+
+/** Replace the events of this list by events mapped from an EventCacheFile,
+ * without copying them. The list is then in MAPPED_STORAGE: histogramming,
+ * integration, getTofs() and the tof range read the mapped events in place.
+ * Any other operation copies them into ROW_STORAGE first. Detector IDs and X
+ * values are kept.
+ *
+ * @param events :: the events, which are sorted by time-of-flight
+ */
+void EventList::mapEvents(const MappedEvents &events) {
+  this->clear(false);
+  m_mapped = events;
+  this->eventType = events.eventType();
+  m_storageMode = MAPPED_STORAGE;
+  this->order = TOF_SORT;
+}
+
+// -----------------------------------------------------------------------------------------------
+/** Choose whether histogramming sorts the events by TOF first.
+ *
+ * When false, generateHistogram() bins unsorted events directly if the bin
+ * index can be computed in closed form (linear or logarithmic bins), which
+ * avoids an O(n log n) sort when the list is only histogrammed once. The
+ * events are then left unsorted; anything that needs them sorted still sorts
+ * them on demand. Arbitrary bins always sort first.
+ *
+ * @param sort :: true (the default) to always sort before histogramming
+ */
+void EventList::setSortBeforeHistogram(const bool sort) {
+  m_sortBeforeHistogram = sort;
+}
+
+/** @return true if histogramming always sorts the events by TOF first
+ */
+bool EventList::getSortBeforeHistogram() const { return m_sortBeforeHistogram; }
+
+/** Move the events back from the columns, compact storage or mapped file
+ * into the event vector matching the event type, if the list is not in
+ * ROW_STORAGE. This is called by every operation that needs access to whole
+ * events, or that modifies them.
+ */
+void EventList::ensureRowStorage() const {
+  if (m_storageMode == ROW_STORAGE)
+    return;
+
+  // Avoid converting from multiple threads
+  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  // If the list was converted while waiting for the lock, return.
+  if (m_storageMode == ROW_STORAGE)
+    return;
+
+  if (m_storageMode == COLUMN_STORAGE) {
+    switch (eventType) {
+    case TOF:
+      m_columns.copyTo(events);
+      break;
+    case WEIGHTED:
+      m_columns.copyTo(weightedEvents);
+      break;
+    case WEIGHTED_NOTIME:
+      m_columns.copyTo(weightedEventsNoTime);
+      break;
+    }
+    m_columns.clear();
+  } else if (m_storageMode == MAPPED_STORAGE) {
+    switch (eventType) {
+    case TOF:
+      m_mapped.copyTo(events);
+      break;
+    case WEIGHTED:
+      m_mapped.copyTo(weightedEvents);
+      break;
+    case WEIGHTED_NOTIME:
+      m_mapped.copyTo(weightedEventsNoTime);
+      break;
+    }
+    m_mapped.clear();
+  } else {
+    switch (eventType) {
+    case TOF:
+      m_compact.copyTo(events);
+      break;
+    case WEIGHTED:
+      m_compact.copyTo(weightedEvents);
+      break;
+    case WEIGHTED_NOTIME:
+      m_compact.copyTo(weightedEventsNoTime);
+      break;
+    }
+    m_compact.clear();
+  }
+  m_storageMode = ROW_STORAGE;
+}
+
 // ==============================================================================================
 // --- Handling the event list
 // -------------------------------------------------------------------
@@ -810,6 +1007,7 @@ WeightedEvent EventList::getEvent(size_t event_number) {
  * @return a const reference to the list of non-weighted events
  * */
 const std::vector<TofEvent> &EventList::getEvents() const {
+  this->ensureRowStorage();
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
@@ -825,6 +1023,7 @@ const std::vector<TofEvent> &EventList::getEvents() const {
  * @return a reference to the list of non-weighted events
  * */
 std::vector<TofEvent> &EventList::getEvents() {
+  this->ensureRowStorage();
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
@@ -840,6 +1039,7 @@ std::vector<TofEvent> &EventList::getEvents() {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEvent> &EventList::getWeightedEvents() {
+  this->ensureRowStorage();
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
@@ -855,6 +1055,7 @@ std::vector<WeightedEvent> &EventList::getWeightedEvents() {
  * @return a const reference to the list of weighted events
  * */
 const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
+  this->ensureRowStorage();
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
@@ -868,6 +1069,7 @@ const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
+  this->ensureRowStorage();
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEventNoTime. Use "
@@ -882,6 +1084,7 @@ std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
  * */
 const std::vector<WeightedEventNoTime> &
 EventList::getWeightedEventsNoTime() const {
+  this->ensureRowStorage();
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEventsNoTime() called for "
                              "an EventList not of type WeightedEventNoTime. "
@@ -903,6 +1106,12 @@ void EventList::clear(const bool removeDetIDs) {
   this->weightedEventsNoTime.clear();
   std::vector<WeightedEventNoTime>().swap(
       this->weightedEventsNoTime); // STL Trick to release memory
+  m_columns.clear();
+  m_compact.clear();
+  m_mapped.clear();
+  // Mapped events are dropped rather than copied
+  if (m_storageMode == MAPPED_STORAGE)
+    m_storageMode = ROW_STORAGE;
   if (removeDetIDs)
     this->clearDetectorIDs();
 }
@@ -946,7 +1155,16 @@ void EventList::setMRU(EventWorkspaceMRU *newMRU) { mru = newMRU; }
  *
  * @param num :: number of events that will be in this EventList
  */
-void EventList::reserve(size_t num) { this->events.reserve(num); }
+void EventList::reserve(size_t num) {
+  if (m_storageMode == MAPPED_STORAGE)
+    this->ensureRowStorage();
+  if (m_storageMode == COLUMN_STORAGE)
+    m_columns.reserve(num);
+  else if (m_storageMode == COMPACT_STORAGE)
+    m_compact.reserve(num);
+  else
+    this->events.reserve(num);
+}
 
 // ==============================================================================================
 // --- Sorting functions -----------------------------------------------------
@@ -1027,6 +1245,10 @@ void EventList::setSortOrder(const EventSortType order) const {
 void EventList::sortTof() const {
   if (this->order == TOF_SORT)
     return; // nothing to do
+  // Mapped events are read-only. Copy them before taking the lock, which
+  // ensureRowStorage() also takes.
+  if (m_storageMode == MAPPED_STORAGE)
+    this->ensureRowStorage();
 
   // Avoid sorting from multiple threads
   std::lock_guard<std::mutex> _lock(m_sortMutex);
@@ -1034,17 +1256,26 @@ void EventList::sortTof() const {
   if (this->order == TOF_SORT)
     return;
 
+  if (m_storageMode == COLUMN_STORAGE) {
+    m_columns.sortTof();
+    this->order = TOF_SORT;
+    return;
+  }
+  if (m_storageMode == COMPACT_STORAGE) {
+    m_compact.sortTof();
+    this->order = TOF_SORT;
+    return;
+  }
+
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventTof<TofEvent>);
+    EventSorter::sortTof(events);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventTof<WeightedEvent>);
+    EventSorter::sortTof(weightedEvents);
     break;
   case WEIGHTED_NOTIME:
-    tbb::parallel_sort(weightedEventsNoTime.begin(), weightedEventsNoTime.end(),
-                       compareEventTof<WeightedEventNoTime>);
+    EventSorter::sortTof(weightedEventsNoTime);
     break;
   }
   // Save the order to avoid unnecessary re-sorting.
@@ -1063,6 +1294,7 @@ void EventList::sortTof() const {
 void EventList::sortTimeAtSample(const double &tofFactor,
                                  const double &tofShift,
                                  bool forceResort) const {
+  this->ensureRowStorage();
   // Check pre-cached sort flag.
   if (this->order == TIMEATSAMPLE_SORT && !forceResort)
     return;
@@ -1097,6 +1329,8 @@ void EventList::sortTimeAtSample(const double &tofFactor,
 // --------------------------------------------------------------------------
 /** Sort events by Frame */
 void EventList::sortPulseTime() const {
+  if (m_storageMode != COMPACT_STORAGE)
+    this->ensureRowStorage();
   if (this->order == PULSETIME_SORT)
     return; // nothing to do
 
@@ -1106,14 +1340,19 @@ void EventList::sortPulseTime() const {
   if (this->order == PULSETIME_SORT)
     return;
 
+  if (m_storageMode == COMPACT_STORAGE) {
+    m_compact.sortPulseTime();
+    this->order = PULSETIME_SORT;
+    return;
+  }
+
   // Perform sort.
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTime);
+    EventSorter::sortPulseTime(events);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventPulseTime);
+    EventSorter::sortPulseTime(weightedEvents);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1128,6 +1367,8 @@ void EventList::sortPulseTime() const {
  * (the absolute time)
  */
 void EventList::sortPulseTimeTOF() const {
+  if (m_storageMode != COMPACT_STORAGE)
+    this->ensureRowStorage();
   if (this->order == PULSETIMETOF_SORT)
     return; // already ordered.
 
@@ -1137,13 +1378,18 @@ void EventList::sortPulseTimeTOF() const {
   if (this->order == PULSETIMETOF_SORT)
     return;
 
+  if (m_storageMode == COMPACT_STORAGE) {
+    m_compact.sortPulseTimeTof();
+    this->order = PULSETIMETOF_SORT;
+    return;
+  }
+
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTimeTOF);
+    EventSorter::sortPulseTimeTof(events);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventPulseTimeTOF);
+    EventSorter::sortPulseTimeTof(weightedEvents);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1163,6 +1409,7 @@ void EventList::sortPulseTimeTOF() const {
  */
 void EventList::sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start,
                                       const double seconds) const {
+  this->ensureRowStorage();
   // Avoid sorting from multiple threads
   std::lock_guard<std::mutex> _lock(m_sortMutex);
 
@@ -1203,9 +1450,15 @@ void EventList::reverse() {
   // reverse the histogram bin parameters
   MantidVec &x = dataX();
   std::reverse(x.begin(), x.end());
+  if (m_storageMode == MAPPED_STORAGE)
+    this->ensureRowStorage();
 
   // flip the events if they are tof sorted
-  if (this->isSortedByTof()) {
+  if (this->isSortedByTof() && m_storageMode == COLUMN_STORAGE) {
+    m_columns.reverse();
+  } else if (this->isSortedByTof() && m_storageMode == COMPACT_STORAGE) {
+    m_compact.reverse();
+  } else if (this->isSortedByTof()) {
     switch (eventType) {
     case TOF:
       std::reverse(this->events.begin(), this->events.end());
@@ -1232,6 +1485,12 @@ void EventList::reverse() {
  * @return the number of events in the list.
  *  */
 size_t EventList::getNumberEvents() const {
+  if (m_storageMode == COLUMN_STORAGE)
+    return m_columns.size();
+  if (m_storageMode == COMPACT_STORAGE)
+    return m_compact.size();
+  if (m_storageMode == MAPPED_STORAGE)
+    return m_mapped.size();
   switch (eventType) {
   case TOF:
     return this->events.size();
@@ -1247,6 +1506,12 @@ size_t EventList::getNumberEvents() const {
  * Much like stl containers, returns true if there is nothing in the event list.
  */
 bool EventList::empty() const {
+  if (m_storageMode == COLUMN_STORAGE)
+    return m_columns.empty();
+  if (m_storageMode == COMPACT_STORAGE)
+    return m_compact.empty();
+  if (m_storageMode == MAPPED_STORAGE)
+    return m_mapped.empty();
   switch (eventType) {
   case TOF:
     return this->events.empty();
@@ -1266,6 +1531,13 @@ bool EventList::empty() const {
  * @return :: the memory used by the EventList, in bytes.
  * */
 size_t EventList::getMemorySize() const {
+  if (m_storageMode == COLUMN_STORAGE)
+    return m_columns.getMemorySize() + sizeof(EventList);
+  if (m_storageMode == COMPACT_STORAGE)
+    return m_compact.getMemorySize() + sizeof(EventList);
+  // Mapped events live in the page cache, not in memory owned by the list
+  if (m_storageMode == MAPPED_STORAGE)
+    return sizeof(EventList);
   switch (eventType) {
   case TOF:
     return this->events.capacity() * sizeof(TofEvent) + sizeof(EventList);
@@ -1399,26 +1671,21 @@ const HistogramData::HistogramY &EventList::y() const {
     throw std::runtime_error(
         "'EventList::y()' called with no MRU set. This is not allowed.");
 
-  return *sharedY();
+  return mru->holdY(sharedY());
 }
 const HistogramData::HistogramE &EventList::e() const {
   if (!mru)
     throw std::runtime_error(
         "'EventList::e()' called with no MRU set. This is not allowed.");
 
-  return *sharedE();
+  return mru->holdE(sharedE());
 }
 Kernel::cow_ptr<HistogramData::HistogramY> EventList::sharedY() const {
-  // This is the thread number from which this function was called.
-  int thread = PARALLEL_THREAD_NUMBER;
-
   Kernel::cow_ptr<HistogramData::HistogramY> yData(nullptr);
 
   // Is the data in the mrulist?
-  if (mru) {
-    mru->ensureEnoughBuffersY(thread);
-    yData = mru->findY(thread, this);
-  }
+  if (mru)
+    yData = mru->findY(this);
 
   if (!yData) {
     MantidVec Y;
@@ -1430,25 +1697,19 @@ Kernel::cow_ptr<HistogramData::HistogramY> EventList::sharedY() const {
 
     // Lets save it in the MRU
     if (mru) {
-      mru->insertY(thread, yData, this);
+      mru->insertY(yData, this);
       auto eData = Kernel::make_cow<HistogramData::HistogramE>(std::move(E));
-      mru->ensureEnoughBuffersE(thread);
-      mru->insertE(thread, eData, this);
+      mru->insertE(eData, this);
     }
   }
   return yData;
 }
 Kernel::cow_ptr<HistogramData::HistogramE> EventList::sharedE() const {
-  // This is the thread number from which this function was called.
-  int thread = PARALLEL_THREAD_NUMBER;
-
   Kernel::cow_ptr<HistogramData::HistogramE> eData(nullptr);
 
   // Is the data in the mrulist?
-  if (mru) {
-    mru->ensureEnoughBuffersE(thread);
-    eData = mru->findE(thread, this);
-  }
+  if (mru)
+    eData = mru->findE(this);
 
   if (!eData) {
     // Now use that to get E -- Y values are generated from another function
@@ -1459,7 +1720,7 @@ Kernel::cow_ptr<HistogramData::HistogramE> EventList::sharedE() const {
 
     // Lets save it in the MRU
     if (mru)
-      mru->insertE(thread, eData, this);
+      mru->insertE(eData, this);
   }
   return eData;
 }
@@ -1473,9 +1734,9 @@ const MantidVec &EventList::dataY() const {
     throw std::runtime_error(
         "'EventList::dataY()' called with no MRU set. This is not allowed.");
 
-  // WARNING: The Y data of sharedY() is stored in MRU, returning reference fine
-  // as long as it stays there.
-  return sharedY()->rawData();
+  // The MRU holds the histogram for this thread, so the reference stays valid
+  // even if it is evicted
+  return mru->holdY(sharedY()).rawData();
 }
 
 /** Look in the MRU to see if the E histogram has been generated before.
@@ -1488,9 +1749,9 @@ const MantidVec &EventList::dataE() const {
     throw std::runtime_error(
         "'EventList::dataE()' called with no MRU set. This is not allowed.");
 
-  // WARNING: The E data of sharedE() is stored in MRU, returning reference fine
-  // as long as it stays there.
-  return sharedE()->rawData();
+  // The MRU holds the histogram for this thread, so the reference stays valid
+  // even if it is evicted
+  return mru->holdE(sharedE()).rawData();
 }
 
 // --------------------------------------------------------------------------
@@ -1748,6 +2009,12 @@ inline void EventList::compressFatEventsHelper(
  *be == this.
  */
 void EventList::compressEvents(double tolerance, EventList *destination) {
+  // The compressed events are stored the way the input events were. Mapped
+  // events are read-only, so compressing them gives events in memory.
+  const EventStorageMode storageMode =
+      m_storageMode == MAPPED_STORAGE ? ROW_STORAGE : m_storageMode;
+  this->ensureRowStorage();
+  destination->ensureRowStorage();
   if (!this->empty()) {
     this->sortTof();
     switch (eventType) {
@@ -1799,11 +2066,19 @@ void EventList::compressEvents(double tolerance, EventList *destination) {
   destination->order = TOF_SORT;
   // Empty out storage for vectors that are now unused.
   destination->clearUnused();
+  destination->setStorageMode(storageMode);
+  this->setStorageMode(storageMode);
 }
 
 void EventList::compressFatEvents(
     const double tolerance, const Mantid::Types::Core::DateAndTime &timeStart,
     const double seconds, EventList *destination) {
+  // The compressed events are stored the way the input events were. Mapped
+  // events are read-only, so compressing them gives events in memory.
+  const EventStorageMode storageMode =
+      m_storageMode == MAPPED_STORAGE ? ROW_STORAGE : m_storageMode;
+  this->ensureRowStorage();
+  destination->ensureRowStorage();
 
   // only worry about non-empty EventLists
   if (!this->empty()) {
@@ -1839,6 +2114,8 @@ void EventList::compressFatEvents(
   destination->order = PULSETIMETOF_SORT;
   // Empty out storage for vectors that are now unused.
   destination->clearUnused();
+  destination->setStorageMode(storageMode);
+  this->setStorageMode(storageMode);
 }
 
 // --------------------------------------------------------------------------
@@ -1950,19 +2227,20 @@ EventList::findFirstEvent(std::vector<T> &events, const double seek_tof) {
  * for an EventList with WeightedEvents.
  *
  * @param events: vector of events (with weights)
- * @param X: X-bins supplied
+ * @param histogrammer: bins the events into the X-bins supplied
  * @param Y: counts returned
  * @param E: errors returned
+ * @param sorted: true if the events are sorted by tof
  * @throw runtime_error if the EventList does not have weighted events
  */
 template <class T>
 void EventList::histogramForWeightsHelper(const std::vector<T> &events,
-                                          const MantidVec &X, MantidVec &Y,
-                                          MantidVec &E) {
-  // For slight speed=up.
-  size_t x_size = X.size();
+                                          const EventHistogrammer &histogrammer,
+                                          MantidVec &Y, MantidVec &E,
+                                          const bool sorted) {
+  const size_t numBins = histogrammer.numberOfBins();
 
-  if (x_size <= 1) {
+  if (numBins == 0) {
     // X was not set. Return an empty array.
     Y.resize(0, 0);
     return;
@@ -1970,12 +2248,12 @@ void EventList::histogramForWeightsHelper(const std::vector<T> &events,
 
   // If the sizes are the same, then the "resize" command will NOT clear the
   // original values.
-  bool mustFill = (Y.size() == x_size - 1);
+  bool mustFill = (Y.size() == numBins);
   // Clear the Y data, assign all to 0.
-  Y.resize(x_size - 1, 0.0);
+  Y.resize(numBins, 0.0);
   // Clear the Error data, assign all to 0.
   // Note: Errors will be squared until the last step.
-  E.resize(x_size - 1, 0.0);
+  E.resize(numBins, 0.0);
 
   if (mustFill) {
     // We must make sure the starting point is 0.0
@@ -1983,59 +2261,147 @@ void EventList::histogramForWeightsHelper(const std::vector<T> &events,
     std::fill(E.begin(), E.end(), 0.0);
   }
 
-  //---------------------- Histogram without weights
-  //---------------------------------
+  histogrammer.addWeights(events, Y, E, sorted);
 
-  // Do we even have any events to do?
-  if (!events.empty()) {
-    // Iterate through all events (sorted by tof)
-    auto itev = findFirstEvent(events, X[0]);
-    auto itev_end = events.cend();
-    // The above can still take you to end() if no events above X[0], so check
-    // again.
-    if (itev == itev_end)
-      return;
+  // Now do the sqrt of all errors
+  std::transform(E.begin(), E.end(), E.begin(),
+                 static_cast<double (*)(double)>(sqrt));
+}
 
-    // Find the first bin
-    size_t bin = 0;
-    // The tof is greater the first bin boundary, so we need to find the first
-    // bin
-    double tof = itev->tof();
-    while (bin < x_size - 1) {
-      // Within range?
-      if ((tof >= X[bin]) && (tof < X[bin + 1])) {
-        // Add up the weight (convert to double before adding, to preserve
-        // precision)
-        Y[bin] += double(itev->m_weight);
-        E[bin] += double(itev->m_errorSquared); // square of error
-        break;
-      }
-      ++bin;
-    }
-    // Go to the next event, we've already binned this first one.
-    ++itev;
+// --------------------------------------------------------------------------
+/** Generates both the Y and E (error) histograms for events held in columns.
+ * Only the tof column, and the weight columns if present, are read. Events
+ * without weights contribute a weight and squared error of 1.
+ *
+ * @param events: columns of events
+ * @param histogrammer: bins the events into the X-bins supplied
+ * @param Y: counts returned
+ * @param E: errors returned
+ * @param sorted: true if the events are sorted by tof
+ */
+void EventList::histogramForWeightsHelper(const EventColumns &events,
+                                          const EventHistogrammer &histogrammer,
+                                          MantidVec &Y, MantidVec &E,
+                                          const bool sorted) {
+  const size_t numBins = histogrammer.numberOfBins();
 
-    // Keep going through all the events
-    while ((itev != itev_end) && (bin < x_size - 1)) {
-      tof = itev->tof();
-      while (bin < x_size - 1) {
-        // Within range? Since both events and X are sorted, they are going to
-        // have
-        // tof >= X[bin] because the previous event was.
-        if (tof < X[bin + 1]) {
-          // Add up the weight (convert to double before adding, to preserve
-          // precision)
-          Y[bin] += double(itev->m_weight);
-          E[bin] += double(itev->m_errorSquared); // square of error
-          break;
-        }
-        ++bin;
-      }
-      ++itev;
+  if (numBins == 0) {
+    // X was not set. Return an empty array.
+    Y.resize(0, 0);
+    return;
+  }
+
+  Y.assign(numBins, 0.0);
+  // Note: Errors will be squared until the last step.
+  E.assign(numBins, 0.0);
+
+  if (events.hasWeights()) {
+    histogrammer.addWeights(events.tofs().data(), events.weights().data(),
+                            events.errorSquareds().data(), events.size(),
+                            Y.data(), E.data(), sorted);
+  } else {
+    histogrammer.addCounts(events.tofs().data(), events.size(), Y.data(),
+                           sorted);
+    E = Y;
+  }
+
+  std::transform(E.begin(), E.end(), E.begin(),
+                 static_cast<double (*)(double)>(sqrt));
+}
+
+/** Generates both the Y and E (error) histograms for events held in compact
+ * storage. The times-of-flight are widened to double precision a block at a
+ * time. Events without weights contribute a weight and squared error of 1.
+ *
+ * @param events: compact events
+ * @param histogrammer: bins the events into the X-bins supplied
+ * @param Y: counts returned
+ * @param E: errors returned
+ * @param sorted: true if the events are sorted by tof
+ */
+void EventList::histogramForWeightsHelper(const CompactEvents &events,
+                                          const EventHistogrammer &histogrammer,
+                                          MantidVec &Y, MantidVec &E,
+                                          const bool sorted) {
+  const size_t numBins = histogrammer.numberOfBins();
+
+  if (numBins == 0) {
+    // X was not set. Return an empty array.
+    Y.resize(0, 0);
+    return;
+  }
+
+  Y.assign(numBins, 0.0);
+  // Note: Errors will be squared until the last step.
+  E.assign(numBins, 0.0);
+
+  const size_t blockSize = 4096;
+  double tofs[blockSize];
+  const bool haveWeights = events.hasWeights();
+  for (size_t start = 0; start < events.size(); start += blockSize) {
+    const size_t count = std::min(blockSize, events.size() - start);
+    events.copyTofs(start, count, tofs);
+    if (haveWeights)
+      histogrammer.addWeights(tofs, events.weights().data() + start,
+                              events.errorSquareds().data() + start, count,
+                              Y.data(), E.data(), sorted);
+    else
+      histogrammer.addCounts(tofs, count, Y.data(), sorted);
+  }
+  if (!haveWeights)
+    E = Y;
+
+  std::transform(E.begin(), E.end(), E.begin(),
+                 static_cast<double (*)(double)>(sqrt));
+}
+
+/** Generates both the Y and E (error) histograms for events mapped from an
+ * EventCacheFile. The times-of-flight, and weights if the events have them,
+ * are copied out of the mapped file a block at a time, so only the pages
+ * holding the events are read. Events without weights contribute a weight and
+ * squared error of 1.
+ *
+ * @param events: mapped events
+ * @param histogrammer: bins the events into the X-bins supplied
+ * @param Y: counts returned
+ * @param E: errors returned
+ * @param sorted: true if the events are sorted by tof
+ */
+void EventList::histogramForWeightsHelper(const MappedEvents &events,
+                                          const EventHistogrammer &histogrammer,
+                                          MantidVec &Y, MantidVec &E,
+                                          const bool sorted) {
+  const size_t numBins = histogrammer.numberOfBins();
+
+  if (numBins == 0) {
+    // X was not set. Return an empty array.
+    Y.resize(0, 0);
+    return;
+  }
+
+  Y.assign(numBins, 0.0);
+  // Note: Errors will be squared until the last step.
+  E.assign(numBins, 0.0);
+
+  const size_t blockSize = 4096;
+  double tofs[blockSize];
+  float weights[blockSize];
+  float errorSquareds[blockSize];
+  const bool haveWeights = events.eventType() != TOF;
+  for (size_t start = 0; start < events.size(); start += blockSize) {
+    const size_t count = std::min(blockSize, events.size() - start);
+    events.copyTofs(start, count, tofs);
+    if (haveWeights) {
+      events.copyWeights(start, count, weights, errorSquareds);
+      histogrammer.addWeights(tofs, weights, errorSquareds, count, Y.data(),
+                              E.data(), sorted);
+    } else {
+      histogrammer.addCounts(tofs, count, Y.data(), sorted);
     }
-  } // end if (there are any events to histogram)
+  }
+  if (!haveWeights)
+    E = Y;
 
-  // Now do the sqrt of all errors
   std::transform(E.begin(), E.end(), E.begin(),
                  static_cast<double (*)(double)>(sqrt));
 }
@@ -2052,6 +2418,7 @@ void EventList::histogramForWeightsHelper(const std::vector<T> &events,
  */
 void EventList::generateHistogramPulseTime(const MantidVec &X, MantidVec &Y,
                                            MantidVec &E, bool skipError) const {
+  this->ensureRowStorage();
   // All types of weights need to be sorted by Pulse Time
   this->sortPulseTime();
 
@@ -2089,6 +2456,7 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
                                               const double &tofFactor,
                                               const double &tofOffset,
                                               bool skipError) const {
+  this->ensureRowStorage();
   // All types of weights need to be sorted by time at sample
   this->sortTimeAtSample(tofFactor, tofOffset);
 
@@ -2122,24 +2490,64 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
  */
 void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
                                   MantidVec &E, bool skipError) const {
-  // All types of weights need to be sorted by TOF
+  // Classify the bin boundaries once, for the choice below and the binning
+  const EventHistogrammer histogrammer(X);
+  if (!m_sortBeforeHistogram && !this->isSortedByTof() &&
+      histogrammer.binning() != EventHistogrammer::Binning::Arbitrary) {
+    // Hold the sort mutex so that no other thread sorts the events while they
+    // are being read
+    std::lock_guard<std::mutex> lock(m_sortMutex);
+    this->histogramHelper(histogrammer, Y, E, skipError, false);
+    return;
+  }
 
+  // All types of weights need to be sorted by TOF
   this->sortTof();
+  this->histogramHelper(histogrammer, Y, E, skipError, true);
+}
+
+/** Generates both the Y and E (error) histograms for the events as they are
+ * currently stored.
+ *
+ * @param histogrammer: bins the events into the x-bins supplied
+ * @param Y: counts returned
+ * @param E: errors returned
+ * @param skipError: skip calculating the error for unweighted events
+ * @param sorted: true if the events are sorted by tof
+ */
+void EventList::histogramHelper(const EventHistogrammer &histogrammer,
+                                MantidVec &Y, MantidVec &E,
+                                const bool skipError, const bool sorted) const {
+  if (m_storageMode == COLUMN_STORAGE) {
+    // Un-weighted columns are binned with an implied weight and error of 1
+    histogramForWeightsHelper(m_columns, histogrammer, Y, E, sorted);
+    return;
+  }
+  if (m_storageMode == COMPACT_STORAGE) {
+    histogramForWeightsHelper(m_compact, histogrammer, Y, E, sorted);
+    return;
+  }
+  if (m_storageMode == MAPPED_STORAGE) {
+    histogramForWeightsHelper(m_mapped, histogrammer, Y, E, sorted);
+    return;
+  }
 
   switch (eventType) {
   case TOF:
     // Make the single ones
-    this->generateCountsHistogram(X, Y);
+    this->countsHistogramHelper(histogrammer, Y, sorted);
     if (!skipError)
       this->generateErrorsHistogram(Y, E);
     break;
 
   case WEIGHTED:
-    histogramForWeightsHelper(this->weightedEvents, X, Y, E);
+    histogramForWeightsHelper(this->weightedEvents, histogrammer, Y, E,
+                              sorted);
     break;
 
   case WEIGHTED_NOTIME:
-    histogramForWeightsHelper(this->weightedEventsNoTime, X, Y, E);
+    histogramForWeightsHelper(this->weightedEventsNoTime, histogrammer, Y,
+                              E, sorted);
     break;
   }
 }
@@ -2232,6 +2640,7 @@ void EventList::generateCountsHistogramPulseTime(const double &xMin,
                                                  MantidVec &Y,
                                                  const double TOF_min,
                                                  const double TOF_max) const {
+  this->ensureRowStorage();
 
   if (this->events.empty())
     return;
@@ -2331,71 +2740,24 @@ void EventList::generateCountsHistogramTimeAtSample(
 // --------------------------------------------------------------------------
 /** Fill a histogram given specified histogram bounds. Does not modify
  * the eventlist (const method).
- * @param X :: The x bins
+ * @param histogrammer :: bins the events into the x bins
  * @param Y :: The generated counts histogram
+ * @param sorted :: true if the events are sorted by tof
  */
-void EventList::generateCountsHistogram(const MantidVec &X,
-                                        MantidVec &Y) const {
-  // For slight speed=up.
-  size_t x_size = X.size();
+void EventList::countsHistogramHelper(const EventHistogrammer &histogrammer,
+                                      MantidVec &Y, const bool sorted) const {
+  const size_t numBins = histogrammer.numberOfBins();
 
-  if (x_size <= 1) {
+  if (numBins == 0) {
     // X was not set. Return an empty array.
     Y.resize(0, 0);
     return;
   }
 
-  // Sort the events by tof
-  this->sortTof();
   // Clear the Y data, assign all to 0.
-  Y.resize(x_size - 1, 0);
-
-  //---------------------- Histogram without weights
-  //---------------------------------
-
-  // Do we even have any events to do?
-  if (!this->events.empty()) {
-    // Iterate through all events (sorted by tof)
-    std::vector<TofEvent>::const_iterator itev =
-        findFirstEvent(this->events, X[0]);
-    std::vector<TofEvent>::const_iterator itev_end =
-        events.end(); // cache for speed
-    // The above can still take you to end() if no events above X[0], so check
-    // again.
-    if (itev == itev_end)
-      return;
-
-    // Find the first bin
-    size_t bin = 0;
-
-    // The tof is greater the first bin boundary, so we need to find the first
-    // bin
-    double tof = itev->tof();
-    while (bin < x_size - 1) {
-      // Within range?
-      if ((tof >= X[bin]) && (tof < X[bin + 1])) {
-        Y[bin]++;
-        break;
-      }
-      ++bin;
-    }
-    // Go to the next event, we've already binned this first one.
-    ++itev;
+  Y.resize(numBins, 0);
 
-    // Keep going through all the events
-    while ((itev != itev_end) && (bin < x_size - 1)) {
-      tof = itev->tof();
-      while (bin < x_size - 1) {
-        // Within range?
-        if ((tof >= X[bin]) && (tof < X[bin + 1])) {
-          Y[bin]++;
-          break;
-        }
-        ++bin;
-      }
-      ++itev;
-    }
-  } // end if (there are any events to histogram)
+  histogrammer.addCounts(this->events, Y, sorted);
 }
 
 // --------------------------------------------------------------------------
@@ -2482,6 +2844,170 @@ void EventList::integrateHelper(std::vector<T> &events, const double minX,
   error = std::sqrt(error);
 }
 
+/** Integrate the events held in columns between a range of X values, or all
+ * events.
+ *
+ * @param events :: columns of events, sorted by tof unless entireRange.
+ * @param minX :: minimum X bin to use in integrating.
+ * @param maxX :: maximum X bin to use in integrating.
+ * @param entireRange :: set to true to use the entire range. minX and maxX are
+ *then ignored!
+ * @param sum :: reference to a double to put the sum in.
+ * @param error :: reference to a double to put the error in.
+ */
+void EventList::integrateHelper(const EventColumns &events, const double minX,
+                                const double maxX, const bool entireRange,
+                                double &sum, double &error) {
+  sum = 0;
+  error = 0;
+  if (events.empty())
+    return;
+
+  const std::vector<double> &tofs = events.tofs();
+  size_t low = 0;
+  size_t high = tofs.size();
+  if (!entireRange) {
+    // If a silly range was given, return 0.
+    if (maxX < minX)
+      return;
+    low = static_cast<size_t>(
+        std::lower_bound(tofs.cbegin(), tofs.cend(), minX) - tofs.cbegin());
+    high = static_cast<size_t>(
+        std::upper_bound(tofs.cbegin(), tofs.cend(), maxX) - tofs.cbegin());
+  }
+
+  if (events.hasWeights()) {
+    const std::vector<float> &weights = events.weights();
+    const std::vector<float> &errorSquareds = events.errorSquareds();
+    for (size_t i = low; i < high; ++i) {
+      sum += weights[i];
+      error += errorSquareds[i];
+    }
+  } else if (high > low) {
+    sum = static_cast<double>(high - low);
+    error = sum;
+  }
+  error = std::sqrt(error);
+}
+
+/** Integrate the events held in compact storage between a range of X values,
+ * or all events.
+ *
+ * @param events :: compact events, sorted by tof unless entireRange.
+ * @param minX :: minimum X bin to use in integrating.
+ * @param maxX :: maximum X bin to use in integrating.
+ * @param entireRange :: set to true to use the entire range. minX and maxX are
+ *then ignored!
+ * @param sum :: reference to a double to put the sum in.
+ * @param error :: reference to a double to put the error in.
+ */
+void EventList::integrateHelper(const CompactEvents &events, const double minX,
+                                const double maxX, const bool entireRange,
+                                double &sum, double &error) {
+  sum = 0;
+  error = 0;
+  if (events.empty())
+    return;
+
+  const std::vector<CompactEvent> &compact = events.events();
+  size_t low = 0;
+  size_t high = compact.size();
+  if (!entireRange) {
+    // If a silly range was given, return 0.
+    if (maxX < minX)
+      return;
+    low = static_cast<size_t>(
+        std::lower_bound(compact.cbegin(), compact.cend(), minX,
+                         [](const CompactEvent &event, const double x) {
+                           return event.tof() < x;
+                         }) -
+        compact.cbegin());
+    high = static_cast<size_t>(
+        std::upper_bound(compact.cbegin(), compact.cend(), maxX,
+                         [](const double x, const CompactEvent &event) {
+                           return x < event.tof();
+                         }) -
+        compact.cbegin());
+  }
+
+  if (events.hasWeights()) {
+    const std::vector<float> &weights = events.weights();
+    const std::vector<float> &errorSquareds = events.errorSquareds();
+    for (size_t i = low; i < high; ++i) {
+      sum += weights[i];
+      error += errorSquareds[i];
+    }
+  } else if (high > low) {
+    sum = static_cast<double>(high - low);
+    error = sum;
+  }
+  error = std::sqrt(error);
+}
+
+/** Integrate the events mapped from an EventCacheFile between a range of X
+ * values, or all events. The range is found by binary search, so only the
+ * pages holding the events in the range are read.
+ *
+ * @param events :: mapped events, sorted by tof.
+ * @param minX :: minimum X bin to use in integrating.
+ * @param maxX :: maximum X bin to use in integrating.
+ * @param entireRange :: set to true to use the entire range. minX and maxX are
+ *then ignored!
+ * @param sum :: reference to a double to put the sum in.
+ * @param error :: reference to a double to put the error in.
+ */
+void EventList::integrateHelper(const MappedEvents &events, const double minX,
+                                const double maxX, const bool entireRange,
+                                double &sum, double &error) {
+  sum = 0;
+  error = 0;
+  if (events.empty())
+    return;
+
+  // First index in [low, high) whose tof is not accepted by the predicate
+  auto partitionPoint = [&events](size_t low, size_t high, auto accept) {
+    while (low < high) {
+      const size_t middle = low + (high - low) / 2;
+      if (accept(events.tofAt(middle)))
+        low = middle + 1;
+      else
+        high = middle;
+    }
+    return low;
+  };
+
+  size_t low = 0;
+  size_t high = events.size();
+  if (!entireRange) {
+    // If a silly range was given, return 0.
+    if (maxX < minX)
+      return;
+    low = partitionPoint(low, high, [minX](double tof) { return tof < minX; });
+    high =
+        partitionPoint(low, high, [maxX](double tof) { return tof <= maxX; });
+  }
+  if (high <= low)
+    return;
+
+  if (events.eventType() == TOF) {
+    sum = static_cast<double>(high - low);
+    error = std::sqrt(sum);
+    return;
+  }
+  const size_t blockSize = 4096;
+  float weights[blockSize];
+  float errorSquareds[blockSize];
+  for (size_t start = low; start < high; start += blockSize) {
+    const size_t count = std::min(blockSize, high - start);
+    events.copyWeights(start, count, weights, errorSquareds);
+    for (size_t i = 0; i < count; ++i) {
+      sum += weights[i];
+      error += errorSquareds[i];
+    }
+  }
+  error = std::sqrt(error);
+}
+
 // --------------------------------------------------------------------------
 /** Integrate the events between a range of X values, or all events.
  *
@@ -2518,6 +3044,19 @@ void EventList::integrate(const double minX, const double maxX,
     this->sortTof();
   }
 
+  if (m_storageMode == COLUMN_STORAGE) {
+    integrateHelper(m_columns, minX, maxX, entireRange, sum, error);
+    return;
+  }
+  if (m_storageMode == COMPACT_STORAGE) {
+    integrateHelper(m_compact, minX, maxX, entireRange, sum, error);
+    return;
+  }
+  if (m_storageMode == MAPPED_STORAGE) {
+    integrateHelper(m_mapped, minX, maxX, entireRange, sum, error);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2548,6 +3087,8 @@ void EventList::integrate(const double minX, const double maxX,
  */
 void EventList::convertTof(std::function<double(double)> func,
                            const int sorting) {
+  if (m_storageMode == MAPPED_STORAGE)
+    this->ensureRowStorage();
   // fix the histogram parameter
   MantidVec &x = dataX();
   transform(x.begin(), x.end(), x.begin(), func);
@@ -2562,6 +3103,15 @@ void EventList::convertTof(std::function<double(double)> func,
   if (this->getNumberEvents() <= 0)
     return;
 
+  if (m_storageMode == COLUMN_STORAGE) {
+    this->convertTofHelper(m_columns, func);
+    return;
+  }
+  if (m_storageMode == COMPACT_STORAGE) {
+    this->convertTofHelper(m_compact, func);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2588,6 +3138,27 @@ void EventList::convertTofHelper(std::vector<T> &events,
     ev.m_tof = func(ev.m_tof);
 }
 
+/**
+ * @param events :: columns of events; only the tof column is changed.
+ * @param func :: function to apply to each tof.
+ */
+void EventList::convertTofHelper(EventColumns &events,
+                                 std::function<double(double)> func) {
+  auto &tofs = events.tofs();
+  std::transform(tofs.begin(), tofs.end(), tofs.begin(), func);
+}
+
+/**
+ * @param events :: compact events; only the tofs are changed, and are rounded
+ * to single precision.
+ * @param func :: function to apply to each tof.
+ */
+void EventList::convertTofHelper(CompactEvents &events,
+                                 std::function<double(double)> func) {
+  for (auto &event : events.events())
+    event.m_tof = static_cast<float>(func(event.m_tof));
+}
+
 // --------------------------------------------------------------------------
 /**
  * Convert the time of flight by tof'=tof*factor+offset
@@ -2595,6 +3166,8 @@ void EventList::convertTofHelper(std::vector<T> &events,
  * @param offset :: The value to shift the time-of-flight by
  */
 void EventList::convertTof(const double factor, const double offset) {
+  if (m_storageMode == MAPPED_STORAGE)
+    this->ensureRowStorage();
   // fix the histogram parameter
   MantidVec &x = dataX();
   for (double &iter : x)
@@ -2606,6 +3179,15 @@ void EventList::convertTof(const double factor, const double offset) {
   if (this->getNumberEvents() <= 0)
     return;
 
+  if (m_storageMode == COLUMN_STORAGE) {
+    this->convertTofHelper(m_columns, factor, offset);
+    return;
+  }
+  if (m_storageMode == COMPACT_STORAGE) {
+    this->convertTofHelper(m_compact, factor, offset);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2638,6 +3220,34 @@ void EventList::convertTofHelper(std::vector<T> &events, const double factor,
   }
 }
 
+/** Function to do the conversion factor work on the tof column.
+ * Does NOT reverse the event list if the factor < 0
+ *
+ * @param events :: columns of events; only the tof column is changed.
+ * @param factor :: multiply by this
+ * @param offset :: add this
+ */
+void EventList::convertTofHelper(EventColumns &events, const double factor,
+                                 const double offset) {
+  // A plain loop over contiguous doubles, which the compiler can vectorise
+  for (auto &tof : events.tofs())
+    tof = tof * factor + offset;
+}
+
+/** Function to do the conversion factor work on compact events.
+ * Does NOT reverse the event list if the factor < 0
+ *
+ * @param events :: compact events; only the tofs are changed, and are rounded
+ * to single precision.
+ * @param factor :: multiply by this
+ * @param offset :: add this
+ */
+void EventList::convertTofHelper(CompactEvents &events, const double factor,
+                                 const double offset) {
+  for (auto &event : events.events())
+    event.m_tof = static_cast<float>(event.m_tof * factor + offset);
+}
+
 // --------------------------------------------------------------------------
 /**
  * Convert the units in the TofEvent's m_tof field to
@@ -2675,6 +3285,7 @@ void EventList::addPulsetimeHelper(std::vector<T> &events,
  * @param seconds :: The value to shift the pulsetime by, in seconds
  */
 void EventList::addPulsetime(const double seconds) {
+  this->ensureRowStorage();
   if (this->getNumberEvents() <= 0)
     return;
 
@@ -2736,6 +3347,68 @@ std::size_t EventList::maskTofHelper(std::vector<T> &events,
   return 0;
 }
 
+/** Mask out events held in columns that have a tof between tofMin and tofMax
+ * (inclusively). Events are removed from all the columns.
+ * @param events :: columns of events, sorted by tof.
+ * @param tofMin :: lower bound of TOF to filter out
+ * @param tofMax :: upper bound of TOF to filter out
+ * @returns The number of events deleted.
+ */
+std::size_t EventList::maskTofHelper(EventColumns &events, const double tofMin,
+                                     const double tofMax) {
+  const auto &tofs = events.tofs();
+  // quick checks to make sure that the masking range is even in the data
+  if (tofMin > tofs.back())
+    return 0;
+  if (tofMax < tofs.front())
+    return 0;
+
+  const auto first = static_cast<size_t>(
+      std::lower_bound(tofs.cbegin(), tofs.cend(), tofMin) - tofs.cbegin());
+  const auto last = static_cast<size_t>(
+      std::upper_bound(tofs.cbegin() + first, tofs.cend(), tofMax) -
+      tofs.cbegin());
+  if (last <= first)
+    return 0;
+  events.erase(first, last);
+  return last - first;
+}
+
+/** Mask out compact events that have a tof between tofMin and tofMax
+ * (inclusively).
+ * @param events :: compact events, sorted by tof.
+ * @param tofMin :: lower bound of TOF to filter out
+ * @param tofMax :: upper bound of TOF to filter out
+ * @returns The number of events deleted.
+ */
+std::size_t EventList::maskTofHelper(CompactEvents &events,
+                                     const double tofMin,
+                                     const double tofMax) {
+  const auto &compact = events.events();
+  // quick checks to make sure that the masking range is even in the data
+  if (tofMin > compact.back().tof())
+    return 0;
+  if (tofMax < compact.front().tof())
+    return 0;
+
+  const auto first = static_cast<size_t>(
+      std::lower_bound(compact.cbegin(), compact.cend(), tofMin,
+                       [](const CompactEvent &event, const double tof) {
+                         return event.tof() < tof;
+                       }) -
+      compact.cbegin());
+  const auto last = static_cast<size_t>(
+      std::upper_bound(compact.cbegin() + first, compact.cend(), tofMax,
+                       [](const double tof, const CompactEvent &event) {
+                         return tof < event.tof();
+                       }) -
+      compact.cbegin());
+  if (last <= first)
+    return 0;
+  events.erase(first, last);
+  return last - first;
+}
+
 // --------------------------------------------------------------------------
 /**
  * Mask out events that have a tof between tofMin and tofMax (inclusively).
@@ -2753,10 +3426,26 @@ void EventList::maskTof(const double tofMin, const double tofMax) {
 
   // Start by sorting by tof
   this->sortTof();
+  if (m_storageMode == MAPPED_STORAGE)
+    this->ensureRowStorage();
 
   // Convert the list
   size_t numOrig = 0;
   size_t numDel = 0;
+  if (m_storageMode == COLUMN_STORAGE) {
+    numOrig = m_columns.size();
+    numDel = maskTofHelper(m_columns, tofMin, tofMax);
+    if (numDel >= numOrig)
+      this->clear(false);
+    return;
+  }
+  if (m_storageMode == COMPACT_STORAGE) {
+    numOrig = m_compact.size();
+    numDel = maskTofHelper(m_compact, tofMin, tofMax);
+    if (numDel >= numOrig)
+      this->clear(false);
+    return;
+  }
   switch (eventType) {
   case TOF:
     numOrig = this->events.size();
@@ -2797,6 +3486,20 @@ void EventList::getTofs(std::vector<double> &tofs) const {
   // Set the capacity of the vector to avoid multiple resizes
   tofs.reserve(this->getNumberEvents());
 
+  if (m_storageMode == COLUMN_STORAGE) {
+    tofs.assign(m_columns.tofs().cbegin(), m_columns.tofs().cend());
+    return;
+  }
+  if (m_storageMode == COMPACT_STORAGE) {
+    this->getTofsHelper(m_compact.events(), tofs);
+    return;
+  }
+  if (m_storageMode == MAPPED_STORAGE) {
+    tofs.resize(m_mapped.size());
+    m_mapped.copyTofs(0, m_mapped.size(), tofs.data());
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2840,6 +3543,7 @@ void EventList::getWeightsHelper(const std::vector<T> &events,
  *  @param weights :: A reference to the vector to be filled
  */
 void EventList::getWeights(std::vector<double> &weights) const {
+  this->ensureRowStorage();
   // Set the capacity of the vector to avoid multiple resizes
   weights.reserve(this->getNumberEvents());
 
@@ -2887,6 +3591,7 @@ void EventList::getWeightErrorsHelper(const std::vector<T> &events,
  *  @param weightErrors :: A reference to the vector to be filled
  */
 void EventList::getWeightErrors(std::vector<double> &weightErrors) const {
+  this->ensureRowStorage();
   // Set the capacity of the vector to avoid multiple resizes
   weightErrors.reserve(this->getNumberEvents());
 
@@ -2936,6 +3641,7 @@ void EventList::getPulseTimesHelper(
  * @return by copy a vector of DateAndTime times
  */
 std::vector<Mantid::Types::Core::DateAndTime> EventList::getPulseTimes() const {
+  this->ensureRowStorage();
   std::vector<Mantid::Types::Core::DateAndTime> times;
   // Set the capacity of the vector to avoid multiple resizes
   times.reserve(this->getNumberEvents());
@@ -2967,6 +3673,24 @@ double EventList::getTofMin() const {
   if (this->empty())
     return tMin;
 
+  if (m_storageMode == COLUMN_STORAGE) {
+    const auto &tofs = m_columns.tofs();
+    if (this->order == TOF_SORT)
+      return tofs.front();
+    return *std::min_element(tofs.cbegin(), tofs.cend());
+  }
+  if (m_storageMode == COMPACT_STORAGE) {
+    const auto &compact = m_compact.events();
+    if (this->order == TOF_SORT)
+      return compact.front().tof();
+    return std::min_element(compact.cbegin(), compact.cend(),
+                            compareEventTof<CompactEvent>)
+        ->tof();
+  }
+  // Mapped events are sorted by tof
+  if (m_storageMode == MAPPED_STORAGE)
+    return m_mapped.tofAt(0);
+
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
     switch (eventType) {
@@ -3013,6 +3737,24 @@ double EventList::getTofMax() const {
   if (this->empty())
     return tMax;
 
+  if (m_storageMode == COLUMN_STORAGE) {
+    const auto &tofs = m_columns.tofs();
+    if (this->order == TOF_SORT)
+      return tofs.back();
+    return *std::max_element(tofs.cbegin(), tofs.cend());
+  }
+  if (m_storageMode == COMPACT_STORAGE) {
+    const auto &compact = m_compact.events();
+    if (this->order == TOF_SORT)
+      return compact.back().tof();
+    return std::max_element(compact.cbegin(), compact.cend(),
+                            compareEventTof<CompactEvent>)
+        ->tof();
+  }
+  // Mapped events are sorted by tof
+  if (m_storageMode == MAPPED_STORAGE)
+    return m_mapped.tofAt(m_mapped.size() - 1);
+
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
     switch (eventType) {
@@ -3051,6 +3793,7 @@ double EventList::getTofMax() const {
  * @return The minimum tof value for the list of the events.
  */
 DateAndTime EventList::getPulseTimeMin() const {
+  this->ensureRowStorage();
   // set up as the maximum available date time.
   DateAndTime tMin = DateAndTime::maximum();
 
@@ -3095,6 +3838,7 @@ DateAndTime EventList::getPulseTimeMin() const {
  * @return The maximum tof value for the list of events.
  */
 DateAndTime EventList::getPulseTimeMax() const {
+  this->ensureRowStorage();
   // set up as the minimum available date time.
   DateAndTime tMax = DateAndTime::minimum();
 
@@ -3138,6 +3882,7 @@ DateAndTime EventList::getPulseTimeMax() const {
 void EventList::getPulseTimeMinMax(
     Mantid::Types::Core::DateAndTime &tMin,
     Mantid::Types::Core::DateAndTime &tMax) const {
+  this->ensureRowStorage();
   // set up as the minimum available date time.
   tMax = DateAndTime::minimum();
   tMin = DateAndTime::maximum();
@@ -3188,6 +3933,7 @@ void EventList::getPulseTimeMinMax(
 
 DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
                                           const double &tofOffset) const {
+  this->ensureRowStorage();
   // set up as the minimum available date time.
   DateAndTime tMax = DateAndTime::minimum();
 
@@ -3235,6 +3981,7 @@ DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
 
 DateAndTime EventList::getTimeAtSampleMin(const double &tofFactor,
                                           const double &tofOffset) const {
+  this->ensureRowStorage();
   // set up as the minimum available date time.
   DateAndTime tMin = DateAndTime::maximum();
 
@@ -3307,6 +4054,7 @@ void EventList::setTofsHelper(std::vector<T> &events,
  * @param tofs :: The vector of doubles to set the tofs to.
  */
 void EventList::setTofs(const MantidVec &tofs) {
+  this->ensureRowStorage();
   this->order = UNSORTED;
 
   // Convert the list
@@ -3409,6 +4157,7 @@ EventList &EventList::operator*=(const double value) {
  * @param error: error on 'value'. Can be 0.
  */
 void EventList::multiply(const double value, const double error) {
+  this->ensureRowStorage();
   // Do nothing if multiplying by exactly one and there is no error
   if ((value == 1.0) && (error == 0.0))
     return;
@@ -3532,6 +4281,7 @@ void EventList::multiplyHistogramHelper(std::vector<T> &events,
  */
 void EventList::multiply(const MantidVec &X, const MantidVec &Y,
                          const MantidVec &E) {
+  this->ensureRowStorage();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3669,6 +4419,7 @@ void EventList::divideHistogramHelper(std::vector<T> &events,
  */
 void EventList::divide(const MantidVec &X, const MantidVec &Y,
                        const MantidVec &E) {
+  this->ensureRowStorage();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3802,6 +4553,8 @@ void EventList::filterByTimeAtSampleHelper(std::vector<T> &events,
  */
 void EventList::filterByPulseTime(DateAndTime start, DateAndTime stop,
                                   EventList &output) const {
+  this->ensureRowStorage();
+  output.ensureRowStorage();
   if (this == &output) {
     throw std::invalid_argument("In-place filtering is not allowed");
   }
@@ -3836,6 +4589,8 @@ void EventList::filterByTimeAtSample(Types::Core::DateAndTime start,
                                      Types::Core::DateAndTime stop,
                                      double tofFactor, double tofOffset,
                                      EventList &output) const {
+  this->ensureRowStorage();
+  output.ensureRowStorage();
   if (this == &output) {
     throw std::invalid_argument("In-place filtering is not allowed");
   }
@@ -3951,6 +4706,7 @@ void EventList::filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
  *     that will be kept. Any other events will be deleted.
  */
 void EventList::filterInPlace(Kernel::TimeSplitterType &splitter) {
+  this->ensureRowStorage();
   // Start by sorting the event list by pulse time.
   this->sortPulseTime();
 
@@ -4042,6 +4798,7 @@ void EventList::splitByTimeHelper(Kernel::TimeSplitterType &splitter,
  */
 void EventList::splitByTime(Kernel::TimeSplitterType &splitter,
                             std::vector<EventList *> outputs) const {
+  this->ensureRowStorage();
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
                              "that no longer has time information.");
@@ -4182,6 +4939,7 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
                                 std::map<int, EventList *> outputs,
                                 bool docorrection, double toffactor,
                                 double tofshift) const {
+  this->ensureRowStorage();
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
                              "that no longer has time information.");
@@ -4413,6 +5171,7 @@ std::string EventList::splitByFullTimeMatrixSplitter(
     const std::vector<int> &vecgroups,
     std::map<int, EventList *> vec_outputEventList, bool docorrection,
     double toffactor, double tofshift) const {
+  this->ensureRowStorage();
   // Check validity
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4550,6 +5309,7 @@ void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
  */
 void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
                                  std::map<int, EventList *> outputs) const {
+  this->ensureRowStorage();
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4595,6 +5355,7 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
 void EventList::splitByPulseTimeWithMatrix(
     const std::vector<int64_t> &vec_times, const std::vector<int> &vec_target,
     std::map<int, EventList *> outputs) const {
+  this->ensureRowStorage();
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4789,6 +5550,20 @@ void EventList::convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit,
     throw std::runtime_error(
         "EventList::convertUnitsViaTof(): toUnit is not initialized!");
 
+  if (m_storageMode == MAPPED_STORAGE)
+    this->ensureRowStorage();
+  if (m_storageMode == COLUMN_STORAGE) {
+    for (auto &tof : m_columns.tofs())
+      tof = toUnit->singleFromTOF(fromUnit->singleToTOF(tof));
+    return;
+  }
+  if (m_storageMode == COMPACT_STORAGE) {
+    for (auto &event : m_compact.events())
+      event.m_tof = static_cast<float>(
+          toUnit->singleFromTOF(fromUnit->singleToTOF(event.m_tof)));
+    return;
+  }
+
   switch (eventType) {
   case TOF:
     convertUnitsViaTofHelper(this->events, fromUnit, toUnit);
@@ -4826,6 +5601,18 @@ void EventList::convertUnitsQuicklyHelper(typename std::vector<T> &events,
  *  @param power :: the Power b to apply to the conversion
  */
 void EventList::convertUnitsQuickly(const double &factor, const double &power) {
+  if (m_storageMode == MAPPED_STORAGE)
+    this->ensureRowStorage();
+  if (m_storageMode == COLUMN_STORAGE) {
+    for (auto &tof : m_columns.tofs())
+      tof = factor * std::pow(tof, power);
+    return;
+  }
+  if (m_storageMode == COMPACT_STORAGE) {
+    for (auto &event : m_compact.events())
+      event.m_tof = static_cast<float>(factor * std::pow(event.m_tof, power));
+    return;
+  }
   switch (eventType) {
   case TOF:
     convertUnitsQuicklyHelper(this->events, factor, power);
@@ -0,0 +1,274 @@
+#include "MantidDataObjects/EventSorter.h"
+
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+using Mantid::Types::Event::TofEvent;
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// Number of bytes in a sort key, and so the maximum number of passes
+constexpr size_t KEY_BYTES = sizeof(uint64_t);
+/// Number of values of one byte of a key
+constexpr size_t NUM_BUCKETS = 256;
+/// Number of keys with each value of one byte
+using Counts = std::array<size_t, NUM_BUCKETS>;
+/// Counts for every byte of the keys
+using DigitCounts = std::array<Counts, KEY_BYTES>;
+
+/// @return the value of one byte of a key
+inline size_t digit(const uint64_t key, const size_t byte) {
+  return static_cast<size_t>((key >> (8 * byte)) & 0xff);
+}
+
+/** Map a double to an unsigned integer with the same order. Negative values
+ * have all their bits flipped, so that larger magnitudes come first; positive
+ * values have the sign bit set, so that they come after negative ones.
+ */
+inline uint64_t doubleKey(const double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits ^ ((bits >> 63) ? ~uint64_t(0) : uint64_t(1) << 63);
+}
+
+/// Map a signed integer to an unsigned integer with the same order
+inline uint64_t int64Key(const int64_t value) {
+  return static_cast<uint64_t>(value) ^ (uint64_t(1) << 63);
+}
+
+/// Sort key of the time-of-flight of an event
+struct TofKey {
+  template <class T> uint64_t operator()(const T &event) const {
+    return doubleKey(event.tof());
+  }
+};
+
+/// Sort key of the pulse time of an event
+struct PulseTimeKey {
+  template <class T> uint64_t operator()(const T &event) const {
+    return int64Key(event.pulseTime().totalNanoseconds());
+  }
+};
+
+/// @return true if every key has the same value of a byte
+bool isTrivial(const Counts &counts, const size_t numKeys) {
+  return std::find(counts.cbegin(), counts.cend(), numKeys) != counts.cend();
+}
+
+/// Turn counts into the index of the first item of each bucket
+void exclusivePrefixSum(Counts &counts) {
+  size_t total = 0;
+  for (auto &count : counts) {
+    const size_t bucketSize = count;
+    count = total;
+    total += bucketSize;
+  }
+}
+
+/// Count the values of every byte of the keys of a range of items
+template <class T, class Key>
+DigitCounts countDigits(const T *items, const size_t numItems,
+                        const Key &key) {
+  DigitCounts counts{};
+  for (size_t i = 0; i < numItems; ++i) {
+    const uint64_t value = key(items[i]);
+    for (size_t byte = 0; byte < KEY_BYTES; ++byte)
+      ++counts[byte][digit(value, byte)];
+  }
+  return counts;
+}
+
+/** Stable sort by a key, one thread.
+ * @param items :: the items to sort
+ * @param buffer :: scratch space; resized to the number of items
+ * @param key :: gives the sort key of an item
+ */
+template <class T, class Key>
+void radixSortSerial(std::vector<T> &items, std::vector<T> &buffer,
+                     const Key &key) {
+  const size_t numItems = items.size();
+  auto counts = countDigits(items.data(), numItems, key);
+  buffer.resize(numItems);
+  for (size_t byte = 0; byte < KEY_BYTES; ++byte) {
+    if (isTrivial(counts[byte], numItems))
+      continue;
+    Counts &offsets = counts[byte];
+    exclusivePrefixSum(offsets);
+    for (const auto &item : items)
+      buffer[offsets[digit(key(item), byte)]++] = item;
+    items.swap(buffer);
+  }
+}
+
+/// @return the number of chunks to split a list into for a parallel sort
+size_t numberOfChunks() {
+  const size_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+  return std::min(std::max(2 * threads, size_t(2)), size_t(128));
+}
+
+/** Stable sort by a key, counting and scattering chunks of the items in
+ * parallel. Each chunk writes each bucket into its own slice of the output,
+ * so that the order of the items in a bucket is kept.
+ * @param items :: the items to sort
+ * @param buffer :: scratch space; resized to the number of items
+ * @param key :: gives the sort key of an item
+ */
+template <class T, class Key>
+void radixSortParallel(std::vector<T> &items, std::vector<T> &buffer,
+                       const Key &key) {
+  const size_t numItems = items.size();
+  const size_t numChunks = numberOfChunks();
+  const size_t chunkSize = (numItems + numChunks - 1) / numChunks;
+  const auto chunkBegin = [=](const size_t chunk) {
+    return std::min(chunk * chunkSize, numItems);
+  };
+
+  // Count every byte once to find the bytes that need a pass
+  std::vector<DigitCounts> chunkCounts(numChunks);
+  tbb::parallel_for(size_t(0), numChunks, [&](const size_t chunk) {
+    const size_t begin = chunkBegin(chunk);
+    chunkCounts[chunk] = countDigits(items.data() + begin,
+                                     chunkBegin(chunk + 1) - begin, key);
+  });
+  DigitCounts totals{};
+  for (const auto &counts : chunkCounts)
+    for (size_t byte = 0; byte < KEY_BYTES; ++byte)
+      for (size_t bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+        totals[byte][bucket] += counts[byte][bucket];
+
+  buffer.resize(numItems);
+  std::vector<Counts> offsets(numChunks);
+  bool firstPass = true;
+  for (size_t byte = 0; byte < KEY_BYTES; ++byte) {
+    if (isTrivial(totals[byte], numItems))
+      continue;
+    // The chunks hold different items after each pass, so count again
+    tbb::parallel_for(size_t(0), numChunks, [&](const size_t chunk) {
+      if (firstPass) {
+        offsets[chunk] = chunkCounts[chunk][byte];
+        return;
+      }
+      offsets[chunk].fill(0);
+      for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i)
+        ++offsets[chunk][digit(key(items[i]), byte)];
+    });
+    firstPass = false;
+
+    size_t total = 0;
+    for (size_t bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+      for (auto &chunkOffsets : offsets) {
+        const size_t count = chunkOffsets[bucket];
+        chunkOffsets[bucket] = total;
+        total += count;
+      }
+
+    tbb::parallel_for(size_t(0), numChunks, [&](const size_t chunk) {
+      Counts &chunkOffsets = offsets[chunk];
+      for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i)
+        buffer[chunkOffsets[digit(key(items[i]), byte)]++] = items[i];
+    });
+    items.swap(buffer);
+  }
+}
+
+/// Stable sort by a key, in parallel for very long lists
+template <class T, class Key>
+void radixSort(std::vector<T> &items, std::vector<T> &buffer, const Key &key) {
+  if (items.size() >= EventSorter::PARALLEL_THRESHOLD)
+    radixSortParallel(items, buffer, key);
+  else
+    radixSortSerial(items, buffer, key);
+}
+
+/// Sort events by a single key
+template <class T, class Key> void sortByKey(std::vector<T> &events) {
+  const Key key{};
+  const auto less = [&key](const T &lhs, const T &rhs) {
+    return key(lhs) < key(rhs);
+  };
+  if (std::is_sorted(events.cbegin(), events.cend(), less))
+    return;
+  if (events.size() < EventSorter::RADIX_THRESHOLD) {
+    std::sort(events.begin(), events.end(), less);
+    return;
+  }
+  std::vector<T> buffer;
+  radixSort(events, buffer, key);
+}
+
+/// Sort events by pulse time, then time-of-flight
+template <class T> void sortByPulseTimeTof(std::vector<T> &events) {
+  const PulseTimeKey pulseTimeKey{};
+  const TofKey tofKey{};
+  const auto less = [&](const T &lhs, const T &rhs) {
+    const uint64_t lhsPulse = pulseTimeKey(lhs);
+    const uint64_t rhsPulse = pulseTimeKey(rhs);
+    if (lhsPulse != rhsPulse)
+      return lhsPulse < rhsPulse;
+    return tofKey(lhs) < tofKey(rhs);
+  };
+  if (std::is_sorted(events.cbegin(), events.cend(), less))
+    return;
+  if (events.size() < EventSorter::RADIX_THRESHOLD) {
+    std::sort(events.begin(), events.end(), less);
+    return;
+  }
+  // Least significant key first; the second sort is stable
+  std::vector<T> buffer;
+  radixSort(events, buffer, tofKey);
+  radixSort(events, buffer, pulseTimeKey);
+}
+} // namespace
+
+constexpr size_t EventSorter::RADIX_THRESHOLD;
+constexpr size_t EventSorter::PARALLEL_THRESHOLD;
+
+/// Sort events by time-of-flight
+void EventSorter::sortTof(std::vector<TofEvent> &events) {
+  sortByKey<TofEvent, TofKey>(events);
+}
+
+/// Sort events by time-of-flight
+void EventSorter::sortTof(std::vector<WeightedEvent> &events) {
+  sortByKey<WeightedEvent, TofKey>(events);
+}
+
+/// Sort events by time-of-flight
+void EventSorter::sortTof(std::vector<WeightedEventNoTime> &events) {
+  sortByKey<WeightedEventNoTime, TofKey>(events);
+}
+
+/// Sort events by time-of-flight
+void EventSorter::sortTof(std::vector<CompactEvent> &events) {
+  sortByKey<CompactEvent, TofKey>(events);
+}
+
+/// Sort events by pulse time
+void EventSorter::sortPulseTime(std::vector<TofEvent> &events) {
+  sortByKey<TofEvent, PulseTimeKey>(events);
+}
+
+/// Sort events by pulse time
+void EventSorter::sortPulseTime(std::vector<WeightedEvent> &events) {
+  sortByKey<WeightedEvent, PulseTimeKey>(events);
+}
+
+/// Sort events by pulse time, then time-of-flight
+void EventSorter::sortPulseTimeTof(std::vector<TofEvent> &events) {
+  sortByPulseTimeTof(events);
+}
+
+/// Sort events by pulse time, then time-of-flight
+void EventSorter::sortPulseTimeTof(std::vector<WeightedEvent> &events) {
+  sortByPulseTimeTof(events);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
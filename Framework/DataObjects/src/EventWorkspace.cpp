@@ -19,6 +19,7 @@
 #include "MantidKernel/TimeSeriesProperty.h"
 
 #include "tbb/parallel_for.h"
+#include <algorithm>
 #include <limits>
 #include <numeric>
 
@@ -39,10 +40,12 @@ using std::size_t;
 using namespace Mantid::Kernel;
 
 EventWorkspace::EventWorkspace(const Parallel::StorageMode storageMode)
-    : IEventWorkspace(storageMode), mru(new EventWorkspaceMRU) {}
+    : IEventWorkspace(storageMode), mru(new EventWorkspaceMRU),
+      m_sortBeforeHistogram(true) {}
 
 EventWorkspace::EventWorkspace(const EventWorkspace &other)
-    : IEventWorkspace(other), mru(new EventWorkspaceMRU) {
+    : IEventWorkspace(other), mru(new EventWorkspaceMRU),
+      m_sortBeforeHistogram(other.m_sortBeforeHistogram) {
   for (const auto &el : other.data) {
     // Create a new event list, copying over the events
     auto newel = new EventList(*el);
@@ -102,6 +105,7 @@ void EventWorkspace::init(const std::size_t &NVectors,
     data[i] = new EventList(el);
     data[i]->setMRU(mru);
     data[i]->setSpectrumNo(specnum_t(i));
+    data[i]->setSortBeforeHistogram(m_sortBeforeHistogram);
   }
 
   // Create axes.
@@ -126,6 +130,7 @@ void EventWorkspace::init(const HistogramData::Histogram &histogram) {
     data[i] = new EventList(el);
     data[i]->setMRU(mru);
     data[i]->setSpectrumNo(specnum_t(i));
+    data[i]->setSortBeforeHistogram(m_sortBeforeHistogram);
   }
 
   m_axes.resize(2);
@@ -425,20 +430,57 @@ void EventWorkspace::switchEventType(const Mantid::API::EventType type) {
     eventList->switchTo(type);
 }
 
+/** Switch all event lists to the given storage layout. See
+ * EventList::setStorageMode() for the meaning of the modes.
+ *
+ * @param mode :: EventStorageMode to switch to
+ */
+void EventWorkspace::setEventStorageMode(const EventStorageMode mode) {
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(this->data.size()); ++i)
+    this->data[i]->setStorageMode(mode);
+}
+
+/** Choose whether the event lists sort their events by TOF before
+ * histogramming. Reduction workflows that histogram freshly loaded or filtered
+ * events only once can turn sorting off to avoid its cost; see
+ * EventList::setSortBeforeHistogram().
+ *
+ * @param sort :: true (the default) to always sort before histogramming
+ */
+void EventWorkspace::setSortBeforeHistogram(const bool sort) {
+  m_sortBeforeHistogram = sort;
+  for (auto &eventList : this->data)
+    eventList->setSortBeforeHistogram(sort);
+}
+
+/** @return true if the event lists always sort by TOF before histogramming
+ */
+bool EventWorkspace::getSortBeforeHistogram() const {
+  return m_sortBeforeHistogram;
+}
+
 /// Returns true always - an EventWorkspace always represents histogramm-able
 /// data
 /// @returns If the data is a histogram - always true for an eventWorkspace
 bool EventWorkspace::isHistogramData() const { return true; }
 
-/** Return how many entries in the Y MRU list are used.
- * Only used in tests. It only returns the 0-th MRU list size.
- * @return :: number of entries in the MRU list.
+/** Return how many event lists have histograms in the MRU.
+ * Only used in tests.
+ * @return :: number of entries in the MRU.
  */
 size_t EventWorkspace::MRUSize() const { return mru->MRUSize(); }
 
 /** Clears the MRU lists */
 void EventWorkspace::clearMRU() const { mru->clear(); }
 
+/** @return the hit, miss and eviction counters and the current size of the
+ * cache of histograms generated from the event lists
+ */
+HistogramCacheStatistics EventWorkspace::getHistogramCacheStatistics() const {
+  return mru->statistics();
+}
+
 /// Returns the amount of memory used in bytes
 size_t EventWorkspace::getMemorySize() const {
   // TODO: Add the MRU buffer
@@ -580,22 +622,63 @@ void EventWorkspace::setAllX(const HistogramData::BinEdges &x) {
   this->clearMRU();
 }
 
-/** Task for sorting an event list */
+/** Task for sorting the event lists of a workspace. The lists are taken
+ * largest first, in chunks holding similar numbers of events, so that the
+ * threads finish together rather than one of them picking up a large list at
+ * the end.
+ */
 class EventSortingTask {
 public:
   /// ctor
   EventSortingTask(const EventWorkspace *WS, EventSortType sortType,
                    Mantid::API::Progress *prog)
-      : m_sortType(sortType), m_WS(WS), prog(prog) {}
+      : m_sortType(sortType), m_WS(WS), prog(prog) {
+    const size_t numLists = WS->getNumberHistograms();
+    std::vector<size_t> numEvents(numLists);
+    size_t totalEvents = 0;
+    for (size_t wi = 0; wi < numLists; ++wi) {
+      numEvents[wi] = WS->getSpectrum(wi).getNumberEvents();
+      totalEvents += numEvents[wi];
+    }
+    m_order.resize(numLists);
+    std::iota(m_order.begin(), m_order.end(), size_t(0));
+    std::stable_sort(m_order.begin(), m_order.end(),
+                     [&numEvents](const size_t lhs, const size_t rhs) {
+                       return numEvents[lhs] > numEvents[rhs];
+                     });
+
+    // A few chunks per thread, so that idle threads can steal work
+    const auto numThreads = static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+    const size_t chunkEvents = std::max(totalEvents / (8 * numThreads),
+                                        static_cast<size_t>(1));
+    m_chunkStart.push_back(0);
+    size_t eventsInChunk = 0;
+    for (size_t i = 0; i < numLists; ++i) {
+      const size_t listEvents = numEvents[m_order[i]];
+      if (eventsInChunk > 0 && eventsInChunk + listEvents > chunkEvents) {
+        m_chunkStart.push_back(i);
+        eventsInChunk = 0;
+      }
+      eventsInChunk += listEvents;
+    }
+    m_chunkStart.push_back(numLists);
+  }
+
+  /// @return the number of chunks of event lists to sort
+  size_t numberOfChunks() const { return m_chunkStart.size() - 1; }
 
   // Execute the sort as specified.
   void operator()(const tbb::blocked_range<size_t> &range) const {
-    for (size_t wi = range.begin(); wi < range.end(); ++wi) {
-      m_WS->getSpectrum(wi).sort(m_sortType);
+    for (size_t chunk = range.begin(); chunk < range.end(); ++chunk) {
+      const size_t begin = m_chunkStart[chunk];
+      const size_t end = m_chunkStart[chunk + 1];
+      for (size_t i = begin; i < end; ++i) {
+        m_WS->getSpectrum(m_order[i]).sort(m_sortType);
+      }
+      // Report progress
+      if (prog)
+        prog->reportIncrement(end - begin, "Sorting");
     }
-    // Report progress
-    if (prog)
-      prog->report("Sorting");
   }
 
 private:
@@ -605,6 +688,10 @@ private:
   const EventWorkspace *m_WS;
   /// Optional Progress dialog.
   Mantid::API::Progress *prog;
+  /// Workspace indices, by decreasing number of events
+  std::vector<size_t> m_order;
+  /// Index in m_order of the first list of each chunk, then the end
+  std::vector<size_t> m_chunkStart;
 };
 
 /*
@@ -636,8 +723,10 @@ void EventWorkspace::sortAll(EventSortType sortType,
   }
 
   // Create the thread pool, and optimize by doing the longest sorts first.
+  // The chunks are already balanced, so each one is a separate task.
   EventSortingTask task(this, sortType, prog);
-  tbb::parallel_for(tbb::blocked_range<size_t>(0, data.size()), task);
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, task.numberOfChunks(), 1),
+                    task, tbb::simple_partitioner());
 }
 
 /** Integrate all the spectra in the matrix workspace within the range given.
@@ -1,176 +1,357 @@
 #include "MantidDataObjects/EventWorkspaceMRU.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Logger.h"
 #include "MantidKernel/System.h"
 
+#include <algorithm>
+#include <ostream>
+#include <thread>
+
 namespace Mantid {
 namespace DataObjects {
 
-EventWorkspaceMRU::~EventWorkspaceMRU() {
-  // Make sure you free up the memory in the MRUs
-  {
-    Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexY);
-    for (auto &data : m_bufferedDataY) {
-      if (data) {
-        data->clear();
-        delete data;
-      }
-    }
+namespace {
+// static logger
+Kernel::Logger g_log("EventWorkspaceMRU");
+
+/// Configuration property holding the memory budget, in megabytes
+const char *BUDGET_PROPERTY = "EventWorkspace.HistogramCache.MaxMemoryMB";
+/// Budget used when the property is not set, in megabytes
+constexpr double DEFAULT_BUDGET_MB = 256.;
+
+/// Number of histograms of each kind held for each thread
+constexpr size_t NUM_HELD = 50;
+
+/// @return the number of shards to use: a power of two, a few per core
+size_t numberOfShards() {
+  const size_t wanted =
+      4 * std::max(std::thread::hardware_concurrency(), 1u);
+  size_t shards = 16;
+  while (shards < wanted && shards < 1024)
+    shards *= 2;
+  return shards;
+}
+
+/// @return the memory used by a histogram held in a cow_ptr, in bytes
+template <class T> size_t memoryOf(const Kernel::cow_ptr<T> &data) {
+  return data ? data->size() * sizeof(double) : 0;
+}
+
+/// Hands out to each thread a number that no other running thread has, and
+/// takes it back for reuse when the thread exits
+class WorkerSlots {
+public:
+  size_t acquire() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_free.empty())
+      return m_next++;
+    const size_t slot = m_free.back();
+    m_free.pop_back();
+    return slot;
   }
-  Poco::ScopedWriteRWLock _lock2(m_changeMruListsMutexE);
-  for (auto &data : m_bufferedDataE) {
-    if (data) {
-      data->clear();
-      delete data;
-    }
+  void release(const size_t slot) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_free.push_back(slot);
   }
+
+private:
+  std::mutex m_mutex;
+  std::vector<size_t> m_free;
+  size_t m_next = 0;
+};
+
+WorkerSlots &workerSlots() {
+  // Never destroyed, so that threads exiting at shutdown can give back
+  // their slot
+  static WorkerSlots *slots = new WorkerSlots;
+  return *slots;
 }
 
-//---------------------------------------------------------------------------
-/** This function makes sure that there are enough data
- * buffers (MRU's) for E for the number of threads requested.
- * @param thread_num :: thread number that wants a MRU buffer
+/// The worker slot of a thread, given back when the thread exits
+struct ThreadSlot {
+  ThreadSlot() : slot(workerSlots().acquire()) {}
+  ~ThreadSlot() { workerSlots().release(slot); }
+  const size_t slot;
+};
+
+/// @return the worker slot of the calling thread
+size_t workerSlot() {
+  thread_local ThreadSlot threadSlot;
+  return threadSlot.slot;
+}
+} // namespace
+
+/// Constructor, with the memory budget from the configuration
+EventWorkspaceMRU::EventWorkspaceMRU()
+    : EventWorkspaceMRU(defaultMemoryBudget()) {}
+
+/** Constructor
+ * @param memoryBudget :: maximum memory held by the cached histograms, in
+ * bytes. Each shard keeps at least its most recent entry whatever the budget.
  */
-void EventWorkspaceMRU::ensureEnoughBuffersE(size_t thread_num) const {
-  Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexE);
-  if (m_bufferedDataE.size() <= thread_num) {
-    m_bufferedDataE.resize(thread_num + 1, nullptr);
-    for (auto &data : m_bufferedDataE) {
-      if (!data)
-        data = new mru_listE(50); // Create a MRU list with this many entries.
-    }
-  }
+EventWorkspaceMRU::EventWorkspaceMRU(const size_t memoryBudget)
+    : m_shards(new Shard[numberOfShards()]),
+      m_held(new HeldShard[numberOfShards()]),
+      m_shardMask(numberOfShards() - 1),
+      m_memoryBudget(memoryBudget), m_heldMemory(0), m_hits(0), m_misses(0),
+      m_evictions(0) {}
+
+EventWorkspaceMRU::~EventWorkspaceMRU() {
+  const auto stats = statistics();
+  if (stats.hits + stats.misses > 0)
+    g_log.debug() << "Histogram cache: " << stats.hits << " hits, "
+                  << stats.misses << " misses, " << stats.evictions
+                  << " evictions\n";
 }
-//---------------------------------------------------------------------------
-/** This function makes sure that there are enough data
- * buffers (MRU's) for Y for the number of threads requested.
- * @param thread_num :: thread number that wants a MRU buffer
+
+/** Read the memory budget from the EventWorkspace.HistogramCache.MaxMemoryMB
+ * configuration property.
+ * @return the budget, in bytes
  */
-void EventWorkspaceMRU::ensureEnoughBuffersY(size_t thread_num) const {
-  Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexY);
-  if (m_bufferedDataY.size() <= thread_num) {
-    m_bufferedDataY.resize(thread_num + 1, nullptr);
-    for (auto &data : m_bufferedDataY) {
-      if (!data)
-        data = new mru_listY(50); // Create a MRU list with this many entries.
-    }
-  }
+size_t EventWorkspaceMRU::defaultMemoryBudget() {
+  double megabytes = DEFAULT_BUDGET_MB;
+  if (!Kernel::ConfigService::Instance().getValue(BUDGET_PROPERTY, megabytes) ||
+      megabytes < 0.)
+    megabytes = DEFAULT_BUDGET_MB;
+  return static_cast<size_t>(megabytes * 1024. * 1024.);
 }
 
 //---------------------------------------------------------------------------
-/// Clear all the data in the MRU buffers
+/// @return the shard holding the entry of an event list
+EventWorkspaceMRU::Shard &
+EventWorkspaceMRU::shardFor(const EventList *index) const {
+  // Event lists are allocated separately; drop the alignment bits and mix
+  // the rest so that neighbouring lists land in different shards
+  auto hash = reinterpret_cast<std::uintptr_t>(index) >> 4;
+  hash ^= hash >> 7;
+  hash ^= hash >> 17;
+  return m_shards[hash & m_shardMask];
+}
+
+/// @return the memory budget of each shard, in bytes: what the held
+/// histograms leave of the budget, shared evenly
+size_t EventWorkspaceMRU::shardBudget() const {
+  const size_t held = m_heldMemory;
+  if (held >= m_memoryBudget)
+    return 0;
+  return (m_memoryBudget - held) / (m_shardMask + 1);
+}
+
+//---------------------------------------------------------------------------
+/// Clear all the data in the cache. The statistics are kept.
 void EventWorkspaceMRU::clear() {
-  {
-    // Make sure you free up the memory in the MRUs
-    Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexY);
-    for (auto &data : m_bufferedDataY) {
-      if (data) {
-        data->clear();
-      }
-    }
+  for (size_t i = 0; i <= m_shardMask; ++i) {
+    Shard &shard = m_shards[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.entries.clear();
+    shard.lookup.clear();
+    shard.memory = 0;
+    HeldShard &heldShard = m_held[i];
+    std::lock_guard<std::mutex> heldLock(heldShard.mutex);
+    heldShard.slots.clear();
+    m_heldMemory -= heldShard.memory;
+    heldShard.memory = 0;
   }
+}
 
-  Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexE);
-  for (auto &data : m_bufferedDataE) {
-    if (data) {
-      data->clear();
+/** Find a cached histogram and mark it as most recently used.
+ * @param index :: event list whose histogram to find
+ * @param member :: the histogram to find, Y or E
+ * @return the histogram; null if not found.
+ */
+template <class T>
+T EventWorkspaceMRU::find(const EventList *index, T Entry::*member) {
+  Shard &shard = shardFor(index);
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.lookup.find(index);
+    if (it != shard.lookup.end() && ((*it->second).*member)) {
+      shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+      ++m_hits;
+      return (*it->second).*member;
     }
   }
+  ++m_misses;
+  return T(nullptr);
 }
 
-//---------------------------------------------------------------------------
-/** Find a Y histogram in the MRU
+/** Find a Y histogram in the cache
  *
- * @param thread_num :: number of the thread in which this is run
  * @param index :: index of the data to return
- * @return pointer to the TypeWithMarker that has the data; NULL if not found.
+ * @return the histogram; NULL if not found.
  */
-Kernel::cow_ptr<HistogramData::HistogramY>
-EventWorkspaceMRU::findY(size_t thread_num, const EventList *index) {
-  Poco::ScopedReadRWLock _lock(m_changeMruListsMutexY);
-  auto result = m_bufferedDataY[thread_num]->find(
-      reinterpret_cast<const std::uintptr_t>(index));
-  if (result)
-    return result->m_data;
-  return YType(nullptr);
+EventWorkspaceMRU::YType EventWorkspaceMRU::findY(const EventList *index) {
+  return find(index, &Entry::y);
 }
 
-/** Find a Y histogram in the MRU
+/** Find an E histogram in the cache
  *
- * @param thread_num :: number of the thread in which this is run
  * @param index :: index of the data to return
- * @return pointer to the TypeWithMarker that has the data; NULL if not found.
+ * @return the histogram; NULL if not found.
+ */
+EventWorkspaceMRU::EType EventWorkspaceMRU::findE(const EventList *index) {
+  return find(index, &Entry::e);
+}
+
+/** Store a histogram, replacing any previous one, and evict the least
+ * recently used entries of the shard if it is over budget.
+ * @param data :: the histogram
+ * @param index :: event list the histogram belongs to
+ * @param member :: which histogram this is, Y or E
+ */
+template <class T>
+void EventWorkspaceMRU::insert(T data, const EventList *index,
+                               T Entry::*member) {
+  Shard &shard = shardFor(index);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto it = shard.lookup.find(index);
+  if (it == shard.lookup.end()) {
+    shard.entries.push_front(Entry{index, YType(nullptr), EType(nullptr), 0});
+    it = shard.lookup.emplace(index, shard.entries.begin()).first;
+  } else {
+    shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+  }
+  Entry &entry = *it->second;
+  const size_t oldMemory = memoryOf(entry.*member);
+  const size_t newMemory = memoryOf(data);
+  entry.*member = std::move(data);
+  entry.memory = entry.memory + newMemory - oldMemory;
+  shard.memory = shard.memory + newMemory - oldMemory;
+  evict(shard, index);
+}
+
+/** Drop least recently used entries until the shard is within its budget.
+ * The shard mutex must be held.
+ * @param shard :: the shard
+ * @param keep :: entry that must not be dropped
  */
-Kernel::cow_ptr<HistogramData::HistogramE>
-EventWorkspaceMRU::findE(size_t thread_num, const EventList *index) {
-  Poco::ScopedReadRWLock _lock(m_changeMruListsMutexE);
-  auto result = m_bufferedDataE[thread_num]->find(
-      reinterpret_cast<const std::uintptr_t>(index));
-  if (result)
-    return result->m_data;
-  return EType(nullptr);
+void EventWorkspaceMRU::evict(Shard &shard, const EventList *keep) {
+  const size_t budget = shardBudget();
+  while (shard.memory > budget && shard.entries.size() > 1) {
+    const Entry &oldest = shard.entries.back();
+    if (oldest.index == keep)
+      break;
+    shard.memory -= oldest.memory;
+    shard.lookup.erase(oldest.index);
+    shard.entries.pop_back();
+    ++m_evictions;
+  }
 }
 
-/** Insert a new histogram into the MRU
+/** Insert a new Y histogram into the cache
  *
- * @param thread_num :: thread being accessed
  * @param data :: the new data
  * @param index :: index of the data to insert
  */
-void EventWorkspaceMRU::insertY(size_t thread_num, YType data,
-                                const EventList *index) {
-  Poco::ScopedReadRWLock _lock(m_changeMruListsMutexY);
-  auto yWithMarker =
-      new TypeWithMarker<YType>(reinterpret_cast<const std::uintptr_t>(index));
-  yWithMarker->m_data = std::move(data);
-  auto oldData = m_bufferedDataY[thread_num]->insert(yWithMarker);
-  // And clear up the memory of the old one, if it is dropping out.
-  delete oldData;
-}
-
-/** Insert a new histogram into the MRU
+void EventWorkspaceMRU::insertY(YType data, const EventList *index) {
+  insert(std::move(data), index, &Entry::y);
+}
+
+/** Insert a new E histogram into the cache
  *
- * @param thread_num :: thread being accessed
  * @param data :: the new data
  * @param index :: index of the data to insert
  */
-void EventWorkspaceMRU::insertE(size_t thread_num, EType data,
-                                const EventList *index) {
-  Poco::ScopedReadRWLock _lock(m_changeMruListsMutexE);
-  auto eWithMarker =
-      new TypeWithMarker<EType>(reinterpret_cast<const std::uintptr_t>(index));
-  eWithMarker->m_data = std::move(data);
-  auto oldData = m_bufferedDataE[thread_num]->insert(eWithMarker);
-  // And clear up the memory of the old one, if it is dropping out.
-  delete oldData;
-}
-
-/** Delete any entries in the MRU at the given index
+void EventWorkspaceMRU::insertE(EType data, const EventList *index) {
+  insert(std::move(data), index, &Entry::e);
+}
+
+/** Delete any entries in the cache at the given index
  *
  * @param index :: index to delete.
  */
 void EventWorkspaceMRU::deleteIndex(const EventList *index) {
+  Shard &shard = shardFor(index);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto it = shard.lookup.find(index);
+  if (it == shard.lookup.end())
+    return;
+  shard.memory -= it->second->memory;
+  shard.entries.erase(it->second);
+  shard.lookup.erase(it);
+}
+
+/** Keep a histogram alive for the calling thread, and release the one it
+ * was handed NUM_HELD histograms ago. The histograms are kept in the worker
+ * slot of the thread, which a later thread takes over once it has exited.
+ * @param data :: the histogram
+ * @param ring :: the slot's held histograms of this kind
+ * @param next :: position of the oldest histogram in ring
+ * @return a reference to the histogram, valid until the thread has been
+ * handed NUM_HELD more histograms of the same kind or the cache is cleared.
+ */
+template <class T>
+const T &EventWorkspaceMRU::hold(Kernel::cow_ptr<T> data,
+                                 std::vector<Kernel::cow_ptr<T>> Held::*ring,
+                                 size_t Held::*next) {
+  const size_t slot = workerSlot();
+  HeldShard &shard = m_held[slot & m_shardMask];
+  const T &result = *data;
+  const size_t memory = memoryOf(data);
+  // Release the oldest histogram outside the lock
+  Kernel::cow_ptr<T> released(nullptr);
   {
-    Poco::ScopedReadRWLock _lock1(m_changeMruListsMutexE);
-    for (auto &data : m_bufferedDataE) {
-      if (data) {
-        data->deleteIndex(reinterpret_cast<const std::uintptr_t>(index));
-      }
-    }
-  }
-  Poco::ScopedReadRWLock _lock2(m_changeMruListsMutexY);
-  for (auto &data : m_bufferedDataY) {
-    if (data) {
-      data->deleteIndex(reinterpret_cast<const std::uintptr_t>(index));
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Held &held = shard.slots[slot];
+    auto &histograms = held.*ring;
+    if (histograms.size() < NUM_HELD) {
+      histograms.push_back(std::move(data));
+    } else {
+      released = std::move(histograms[held.*next]);
+      histograms[held.*next] = std::move(data);
+      held.*next = (held.*next + 1) % NUM_HELD;
     }
+    const size_t releasedMemory = memoryOf(released);
+    shard.memory = shard.memory + memory - releasedMemory;
+    m_heldMemory += memory;
+    m_heldMemory -= releasedMemory;
   }
+  return result;
+}
+
+/** Hold a Y histogram for the calling thread, see hold()
+ * @param data :: the histogram
+ * @return a reference to the histogram
+ */
+const HistogramData::HistogramY &EventWorkspaceMRU::holdY(YType data) {
+  return hold(std::move(data), &Held::y, &Held::nextY);
+}
+
+/** Hold an E histogram for the calling thread, see hold()
+ * @param data :: the histogram
+ * @return a reference to the histogram
+ */
+const HistogramData::HistogramE &EventWorkspaceMRU::holdE(EType data) {
+  return hold(std::move(data), &Held::e, &Held::nextE);
 }
 
 size_t EventWorkspaceMRU::MRUSize() const {
-  if (m_bufferedDataY.empty()) {
-    return 0;
-  } else {
-    return this->m_bufferedDataY.front()->size();
+  size_t size = 0;
+  for (size_t i = 0; i <= m_shardMask; ++i) {
+    std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+    size += m_shards[i].entries.size();
   }
+  return size;
+}
+
+/// @return the counters and current size of the cache
+HistogramCacheStatistics EventWorkspaceMRU::statistics() const {
+  HistogramCacheStatistics stats{m_hits, m_misses, m_evictions, 0, 0,
+                                 m_heldMemory, m_memoryBudget};
+  for (size_t i = 0; i <= m_shardMask; ++i) {
+    std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+    stats.entries += m_shards[i].entries.size();
+    stats.memory += m_shards[i].memory;
+  }
+  return stats;
+}
+
+/// Reset the hit, miss and eviction counters to zero
+void EventWorkspaceMRU::resetStatistics() {
+  m_hits = 0;
+  m_misses = 0;
+  m_evictions = 0;
 }
 
-} // namespace Mantid
 } // namespace DataObjects
+} // namespace Mantid
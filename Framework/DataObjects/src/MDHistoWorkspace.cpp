@@ -771,11 +771,14 @@ MDHistoWorkspace &MDHistoWorkspace::operator+=(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::add(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "add");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] += b.m_signals[i];
-    m_errorsSquared[i] += b.m_errorsSquared[i];
-    m_numEvents[i] += b.m_numEvents[i];
-  }
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  signal_t *numEvents = m_numEvents;
+  forEachBin([=, &b](const size_t i) {
+    signals[i] += b.m_signals[i];
+    errorsSquared[i] += b.m_errorsSquared[i];
+    numEvents[i] += b.m_numEvents[i];
+  });
   m_nEventsContributed += b.m_nEventsContributed;
 }
 
@@ -787,10 +790,12 @@ void MDHistoWorkspace::add(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::add(const signal_t signal, const signal_t error) {
   signal_t errorSquared = error * error;
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] += signal;
-    m_errorsSquared[i] += errorSquared;
-  }
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=](const size_t i) {
+    signals[i] += signal;
+    errorsSquared[i] += errorSquared;
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -810,11 +815,14 @@ MDHistoWorkspace &MDHistoWorkspace::operator-=(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::subtract(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "subtract");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] -= b.m_signals[i];
-    m_errorsSquared[i] += b.m_errorsSquared[i];
-    m_numEvents[i] += b.m_numEvents[i];
-  }
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  signal_t *numEvents = m_numEvents;
+  forEachBin([=, &b](const size_t i) {
+    signals[i] -= b.m_signals[i];
+    errorsSquared[i] += b.m_errorsSquared[i];
+    numEvents[i] += b.m_numEvents[i];
+  });
   m_nEventsContributed += b.m_nEventsContributed;
 }
 
@@ -826,10 +834,12 @@ void MDHistoWorkspace::subtract(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::subtract(const signal_t signal, const signal_t error) {
   signal_t errorSquared = error * error;
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] -= signal;
-    m_errorsSquared[i] += errorSquared;
-  }
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=](const size_t i) {
+    signals[i] -= signal;
+    errorsSquared[i] += errorSquared;
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -858,9 +868,11 @@ MDHistoWorkspace &MDHistoWorkspace::operator*=(const MDHistoWorkspace &b_ws) {
  * */
 void MDHistoWorkspace::multiply(const MDHistoWorkspace &b_ws) {
   checkWorkspaceSize(b_ws, "multiply");
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=, &b_ws](const size_t i) {
+    signal_t a = signals[i];
+    signal_t da2 = errorsSquared[i];
 
     signal_t b = b_ws.m_signals[i];
     signal_t db2 = b_ws.m_errorsSquared[i];
@@ -868,9 +880,9 @@ void MDHistoWorkspace::multiply(const MDHistoWorkspace &b_ws) {
     signal_t f = a * b;
     signal_t df2 = da2 * b * b + db2 * a * a;
 
-    m_signals[i] = f;
-    m_errorsSquared[i] = df2;
-  }
+    signals[i] = f;
+    errorsSquared[i] = df2;
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -889,16 +901,18 @@ void MDHistoWorkspace::multiply(const signal_t signal, const signal_t error) {
   signal_t b = signal;
   signal_t db2 = error * error;
 
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=](const size_t i) {
+    signal_t a = signals[i];
+    signal_t da2 = errorsSquared[i];
 
     signal_t f = a * b;
     signal_t df2 = da2 * b * b + db2 * a * a;
 
-    m_signals[i] = f;
-    m_errorsSquared[i] = df2;
-  }
+    signals[i] = f;
+    errorsSquared[i] = df2;
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -927,9 +941,11 @@ MDHistoWorkspace &MDHistoWorkspace::operator/=(const MDHistoWorkspace &b_ws) {
  **/
 void MDHistoWorkspace::divide(const MDHistoWorkspace &b_ws) {
   checkWorkspaceSize(b_ws, "divide");
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=, &b_ws](const size_t i) {
+    signal_t a = signals[i];
+    signal_t da2 = errorsSquared[i];
 
     signal_t b = b_ws.m_signals[i];
     signal_t db2 = b_ws.m_errorsSquared[i];
@@ -937,9 +953,9 @@ void MDHistoWorkspace::divide(const MDHistoWorkspace &b_ws) {
     signal_t f = a / b;
     signal_t df2 = da2 / (b * b) + db2 * f * f / (b * b);
 
-    m_signals[i] = f;
-    m_errorsSquared[i] = df2;
-  }
+    signals[i] = f;
+    errorsSquared[i] = df2;
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -958,16 +974,18 @@ void MDHistoWorkspace::divide(const signal_t signal, const signal_t error) {
   signal_t b = signal;
   signal_t db2 = error * error;
   signal_t db2_relative = db2 / (b * b);
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=](const size_t i) {
+    signal_t a = signals[i];
+    signal_t da2 = errorsSquared[i];
 
     signal_t f = a / b;
     signal_t df2 = da2 / (b * b) + db2_relative * f * f;
 
-    m_signals[i] = f;
-    m_errorsSquared[i] = df2;
-  }
+    signals[i] = f;
+    errorsSquared[i] = df2;
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -977,17 +995,19 @@ void MDHistoWorkspace::divide(const signal_t signal, const signal_t error) {
  * \f$ df^2 = a^2 / da^2 \f$
  */
 void MDHistoWorkspace::log(double filler) {
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=](const size_t i) {
+    signal_t a = signals[i];
+    signal_t da2 = errorsSquared[i];
     if (a <= 0) {
-      m_signals[i] = filler;
-      m_errorsSquared[i] = 0;
+      signals[i] = filler;
+      errorsSquared[i] = 0;
     } else {
-      m_signals[i] = std::log(a);
-      m_errorsSquared[i] = da2 / (a * a);
+      signals[i] = std::log(a);
+      errorsSquared[i] = da2 / (a * a);
     }
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -997,17 +1017,19 @@ void MDHistoWorkspace::log(double filler) {
  * \f$ df^2 = (ln(10)^-2) * a^2 / da^2 \f$
  */
 void MDHistoWorkspace::log10(double filler) {
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=](const size_t i) {
+    signal_t a = signals[i];
+    signal_t da2 = errorsSquared[i];
     if (a <= 0) {
-      m_signals[i] = filler;
-      m_errorsSquared[i] = 0;
+      signals[i] = filler;
+      errorsSquared[i] = 0;
     } else {
-      m_signals[i] = std::log10(a);
-      m_errorsSquared[i] = 0.1886117 * da2 / (a * a); // 0.1886117  = ln(10)^-2
+      signals[i] = std::log10(a);
+      errorsSquared[i] = 0.1886117 * da2 / (a * a); // 0.1886117  = ln(10)^-2
     }
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1017,12 +1039,14 @@ void MDHistoWorkspace::log10(double filler) {
  * \f$ df^2 = f^2 * da^2 \f$
  */
 void MDHistoWorkspace::exp() {
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t f = std::exp(m_signals[i]);
-    signal_t da2 = m_errorsSquared[i];
-    m_signals[i] = f;
-    m_errorsSquared[i] = f * f * da2;
-  }
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=](const size_t i) {
+    signal_t f = std::exp(signals[i]);
+    signal_t da2 = errorsSquared[i];
+    signals[i] = f;
+    errorsSquared[i] = f * f * da2;
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1034,13 +1058,15 @@ void MDHistoWorkspace::exp() {
  */
 void MDHistoWorkspace::power(double exponent) {
   double exponent_squared = exponent * exponent;
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=](const size_t i) {
+    signal_t a = signals[i];
     signal_t f = std::pow(a, exponent);
-    signal_t da2 = m_errorsSquared[i];
-    m_signals[i] = f;
-    m_errorsSquared[i] = f * f * exponent_squared * da2 / (a * a);
-  }
+    signal_t da2 = errorsSquared[i];
+    signals[i] = f;
+    errorsSquared[i] = f * f * exponent_squared * da2 / (a * a);
+  });
 }
 
 //==============================================================================================
@@ -1058,13 +1084,16 @@ void MDHistoWorkspace::power(double exponent) {
  * @return *this after operation */
 MDHistoWorkspace &MDHistoWorkspace::operator&=(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "&= (and)");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] = ((m_signals[i] != 0 && !m_masks[i]) &&
-                    (b.m_signals[i] != 0 && !b.m_masks[i]))
-                       ? 1.0
-                       : 0.0;
-    m_errorsSquared[i] = 0;
-  }
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  const bool *masks = m_masks;
+  forEachBin([=, &b](const size_t i) {
+    signals[i] = ((signals[i] != 0 && !masks[i]) &&
+                  (b.m_signals[i] != 0 && !b.m_masks[i]))
+                     ? 1.0
+                     : 0.0;
+    errorsSquared[i] = 0;
+  });
   return *this;
 }
 
@@ -1077,13 +1106,16 @@ MDHistoWorkspace &MDHistoWorkspace::operator&=(const MDHistoWorkspace &b) {
  * @return *this after operation */
 MDHistoWorkspace &MDHistoWorkspace::operator|=(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "|= (or)");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] = ((m_signals[i] != 0 && !m_masks[i]) ||
-                    (b.m_signals[i] != 0 && !b.m_masks[i]))
-                       ? 1.0
-                       : 0.0;
-    m_errorsSquared[i] = 0;
-  }
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  const bool *masks = m_masks;
+  forEachBin([=, &b](const size_t i) {
+    signals[i] = ((signals[i] != 0 && !masks[i]) ||
+                  (b.m_signals[i] != 0 && !b.m_masks[i]))
+                     ? 1.0
+                     : 0.0;
+    errorsSquared[i] = 0;
+  });
   return *this;
 }
 
@@ -1097,13 +1129,16 @@ MDHistoWorkspace &MDHistoWorkspace::operator|=(const MDHistoWorkspace &b) {
  * @return *this after operation */
 MDHistoWorkspace &MDHistoWorkspace::operator^=(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "^= (xor)");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] = ((m_signals[i] != 0 && !m_masks[i]) ^
-                    (b.m_signals[i] != 0 && !b.m_masks[i]))
-                       ? 1.0
-                       : 0.0;
-    m_errorsSquared[i] = 0;
-  }
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  const bool *masks = m_masks;
+  forEachBin([=, &b](const size_t i) {
+    signals[i] = ((signals[i] != 0 && !masks[i]) ^
+                  (b.m_signals[i] != 0 && !b.m_masks[i]))
+                     ? 1.0
+                     : 0.0;
+    errorsSquared[i] = 0;
+  });
   return *this;
 }
 
@@ -1114,10 +1149,13 @@ MDHistoWorkspace &MDHistoWorkspace::operator^=(const MDHistoWorkspace &b) {
  * 0.0 is "false", all other values are "true". All errors are set to 0.
  */
 void MDHistoWorkspace::operatorNot() {
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] = (m_signals[i] == 0.0 || m_masks[i]);
-    m_errorsSquared[i] = 0;
-  }
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  const bool *masks = m_masks;
+  forEachBin([=](const size_t i) {
+    signals[i] = (signals[i] == 0.0 || masks[i]);
+    errorsSquared[i] = 0;
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1130,10 +1168,12 @@ void MDHistoWorkspace::operatorNot() {
  */
 void MDHistoWorkspace::lessThan(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "lessThan");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] = (m_signals[i] < b.m_signals[i]) ? 1.0 : 0.0;
-    m_errorsSquared[i] = 0;
-  }
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=, &b](const size_t i) {
+    signals[i] = (signals[i] < b.m_signals[i]) ? 1.0 : 0.0;
+    errorsSquared[i] = 0;
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1145,10 +1185,12 @@ void MDHistoWorkspace::lessThan(const MDHistoWorkspace &b) {
  * @param signal :: signal value on the RHS of the comparison.
  */
 void MDHistoWorkspace::lessThan(const signal_t signal) {
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] = (m_signals[i] < signal) ? 1.0 : 0.0;
-    m_errorsSquared[i] = 0;
-  }
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=](const size_t i) {
+    signals[i] = (signals[i] < signal) ? 1.0 : 0.0;
+    errorsSquared[i] = 0;
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1161,10 +1203,12 @@ void MDHistoWorkspace::lessThan(const signal_t signal) {
  */
 void MDHistoWorkspace::greaterThan(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "greaterThan");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] = (m_signals[i] > b.m_signals[i]) ? 1.0 : 0.0;
-    m_errorsSquared[i] = 0;
-  }
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=, &b](const size_t i) {
+    signals[i] = (signals[i] > b.m_signals[i]) ? 1.0 : 0.0;
+    errorsSquared[i] = 0;
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1176,10 +1220,12 @@ void MDHistoWorkspace::greaterThan(const MDHistoWorkspace &b) {
  * @param signal :: signal value on the RHS of the comparison.
  */
 void MDHistoWorkspace::greaterThan(const signal_t signal) {
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] = (m_signals[i] > signal) ? 1.0 : 0.0;
-    m_errorsSquared[i] = 0;
-  }
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=](const size_t i) {
+    signals[i] = (signals[i] > signal) ? 1.0 : 0.0;
+    errorsSquared[i] = 0;
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1194,11 +1240,13 @@ void MDHistoWorkspace::greaterThan(const signal_t signal) {
 void MDHistoWorkspace::equalTo(const MDHistoWorkspace &b,
                                const signal_t tolerance) {
   checkWorkspaceSize(b, "equalTo");
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t diff = fabs(m_signals[i] - b.m_signals[i]);
-    m_signals[i] = (diff < tolerance) ? 1.0 : 0.0;
-    m_errorsSquared[i] = 0;
-  }
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=, &b](const size_t i) {
+    signal_t diff = fabs(signals[i] - b.m_signals[i]);
+    signals[i] = (diff < tolerance) ? 1.0 : 0.0;
+    errorsSquared[i] = 0;
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1212,11 +1260,13 @@ void MDHistoWorkspace::equalTo(const MDHistoWorkspace &b,
  */
 void MDHistoWorkspace::equalTo(const signal_t signal,
                                const signal_t tolerance) {
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t diff = fabs(m_signals[i] - signal);
-    m_signals[i] = (diff < tolerance) ? 1.0 : 0.0;
-    m_errorsSquared[i] = 0;
-  }
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=](const size_t i) {
+    signal_t diff = fabs(signals[i] - signal);
+    signals[i] = (diff < tolerance) ? 1.0 : 0.0;
+    errorsSquared[i] = 0;
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1239,12 +1289,14 @@ void MDHistoWorkspace::setUsingMask(const MDHistoWorkspace &mask,
                                     const MDHistoWorkspace &values) {
   checkWorkspaceSize(mask, "setUsingMask");
   checkWorkspaceSize(values, "setUsingMask");
-  for (size_t i = 0; i < m_length; ++i) {
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=, &mask, &values](const size_t i) {
     if (mask.m_signals[i] != 0.0) {
-      m_signals[i] = values.m_signals[i];
-      m_errorsSquared[i] = values.m_errorsSquared[i];
+      signals[i] = values.m_signals[i];
+      errorsSquared[i] = values.m_errorsSquared[i];
     }
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1269,12 +1321,14 @@ void MDHistoWorkspace::setUsingMask(const MDHistoWorkspace &mask,
                                     const signal_t error) {
   signal_t errorSquared = error * error;
   checkWorkspaceSize(mask, "setUsingMask");
-  for (size_t i = 0; i < m_length; ++i) {
+  signal_t *signals = m_signals;
+  signal_t *errorsSquared = m_errorsSquared;
+  forEachBin([=, &mask](const size_t i) {
     if (mask.m_signals[i] != 0.0) {
-      m_signals[i] = signal;
-      m_errorsSquared[i] = errorSquared;
+      signals[i] = signal;
+      errorsSquared[i] = errorSquared;
     }
-  }
+  });
 }
 
 /**
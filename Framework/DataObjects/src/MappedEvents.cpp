@@ -0,0 +1,140 @@
+#include "MantidDataObjects/MappedEvents.h"
+#include "MantidDataObjects/EventCacheFile.h"
+
+#include <stdexcept>
+
+using Mantid::Types::Event::TofEvent;
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// Copy the times-of-flight of a range of events
+template <class T>
+void copyTofsHelper(const T *events, const size_t count, double *tofs) {
+  for (size_t i = 0; i < count; ++i)
+    tofs[i] = events[i].tof();
+}
+
+/// Copy the weights and squared errors of a range of events
+template <class T>
+void copyWeightsHelper(const T *events, const size_t count, float *weights,
+                       float *errorSquareds) {
+  for (size_t i = 0; i < count; ++i) {
+    weights[i] = static_cast<float>(events[i].weight());
+    errorSquareds[i] = static_cast<float>(events[i].errorSquared());
+  }
+}
+} // namespace
+
+/** Constructor
+ * @param file :: the file holding the events, kept mapped by this view
+ * @param data :: the first event
+ * @param size :: the number of events
+ * @param eventType :: the type of the events
+ */
+MappedEvents::MappedEvents(std::shared_ptr<const EventCacheFile> file,
+                           const void *data, const size_t size,
+                           const API::EventType eventType)
+    : m_file(std::move(file)), m_data(data), m_size(size),
+      m_eventType(eventType) {}
+
+/** @param index :: index of an event
+ * @return the time-of-flight of the event
+ */
+double MappedEvents::tofAt(const size_t index) const {
+  switch (m_eventType) {
+  case API::TOF:
+    return data<TofEvent>()[index].tof();
+  case API::WEIGHTED:
+    return data<WeightedEvent>()[index].tof();
+  case API::WEIGHTED_NOTIME:
+    return data<WeightedEventNoTime>()[index].tof();
+  }
+  throw std::runtime_error("MappedEvents: invalid event type");
+}
+
+/** Copy the times-of-flight of a range of events
+ * @param first :: index of the first event
+ * @param count :: number of events
+ * @param tofs :: receives count times-of-flight
+ */
+void MappedEvents::copyTofs(const size_t first, const size_t count,
+                            double *tofs) const {
+  switch (m_eventType) {
+  case API::TOF:
+    copyTofsHelper(data<TofEvent>() + first, count, tofs);
+    break;
+  case API::WEIGHTED:
+    copyTofsHelper(data<WeightedEvent>() + first, count, tofs);
+    break;
+  case API::WEIGHTED_NOTIME:
+    copyTofsHelper(data<WeightedEventNoTime>() + first, count, tofs);
+    break;
+  }
+}
+
+/** Copy the weights and squared errors of a range of events. Events without
+ * weights have a weight and squared error of 1.
+ * @param first :: index of the first event
+ * @param count :: number of events
+ * @param weights :: receives count weights
+ * @param errorSquareds :: receives count squared errors
+ */
+void MappedEvents::copyWeights(const size_t first, const size_t count,
+                               float *weights, float *errorSquareds) const {
+  switch (m_eventType) {
+  case API::TOF:
+    copyWeightsHelper(data<TofEvent>() + first, count, weights,
+                      errorSquareds);
+    break;
+  case API::WEIGHTED:
+    copyWeightsHelper(data<WeightedEvent>() + first, count, weights,
+                      errorSquareds);
+    break;
+  case API::WEIGHTED_NOTIME:
+    copyWeightsHelper(data<WeightedEventNoTime>() + first, count, weights,
+                      errorSquareds);
+    break;
+  }
+}
+
+/** Copy the events into memory. Any existing content is replaced.
+ * @param events :: receives the events, which must be TofEvent
+ */
+void MappedEvents::copyTo(std::vector<TofEvent> &events) const {
+  if (m_eventType != API::TOF)
+    throw std::runtime_error("MappedEvents::copyTo: events are not TofEvent");
+  events.assign(data<TofEvent>(), data<TofEvent>() + m_size);
+}
+
+/** Copy the events into memory. Any existing content is replaced.
+ * @param events :: receives the events, which must be WeightedEvent
+ */
+void MappedEvents::copyTo(std::vector<WeightedEvent> &events) const {
+  if (m_eventType != API::WEIGHTED)
+    throw std::runtime_error(
+        "MappedEvents::copyTo: events are not WeightedEvent");
+  events.assign(data<WeightedEvent>(), data<WeightedEvent>() + m_size);
+}
+
+/** Copy the events into memory. Any existing content is replaced.
+ * @param events :: receives the events, which must be WeightedEventNoTime
+ */
+void MappedEvents::copyTo(std::vector<WeightedEventNoTime> &events) const {
+  if (m_eventType != API::WEIGHTED_NOTIME)
+    throw std::runtime_error(
+        "MappedEvents::copyTo: events are not WeightedEventNoTime");
+  events.assign(data<WeightedEventNoTime>(),
+                data<WeightedEventNoTime>() + m_size);
+}
+
+/// Drop the view, releasing the file if this was its last view
+void MappedEvents::clear() {
+  m_file.reset();
+  m_data = nullptr;
+  m_size = 0;
+}
+
+} // namespace DataObjects
+} // namespace Mantid
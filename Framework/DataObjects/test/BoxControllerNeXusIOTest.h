@@ -226,6 +226,40 @@ public:
 
   void test_WriteFloatReadDouble() { this->WriteReadRead<float, double>(); }
 
+  void test_compressed_blocks_are_read_back_after_rewriting() {
+    using Mantid::DataObjects::BoxControllerNeXusIO;
+
+    std::unique_ptr<BoxControllerNeXusIO> pSaver(createTestBoxController());
+    pSaver->setDataType(sizeof(float), "MDEvent");
+    pSaver->setCompression(true);
+    TS_ASSERT(pSaver->getCompression());
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    const std::string FullPathFile = pSaver->getFileName();
+
+    const size_t nEvents = 30;
+    const size_t nColumns = pSaver->getNDataColums();
+    std::vector<float> toWrite(nColumns * nEvents);
+    for (size_t i = 0; i < toWrite.size(); i++)
+      toWrite[i] = static_cast<float>(i % 7);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(toWrite, 0));
+    // Rewrite part of the block in place, as the disk buffer does
+    std::vector<float> rewritten(nColumns * 10, 42.f);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(rewritten, 5));
+    std::copy(rewritten.begin(), rewritten.end(),
+              toWrite.begin() + 5 * nColumns);
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(FullPathFile, "r"));
+    std::vector<float> toRead;
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead, 0, nEvents));
+    TS_ASSERT_EQUALS(toRead, toWrite);
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    pSaver.reset();
+    if (Poco::File(FullPathFile).exists())
+      Poco::File(FullPathFile).remove();
+  }
+
 private:
   /// Create a test box controller. Ownership is passed to the caller
   Mantid::DataObjects::BoxControllerNeXusIO *createTestBoxController() {
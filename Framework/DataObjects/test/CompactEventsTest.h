@@ -0,0 +1,206 @@
+#ifndef MANTID_DATAOBJECTS_COMPACTEVENTSTEST_H_
+#define MANTID_DATAOBJECTS_COMPACTEVENTSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/CompactEvents.h"
+
+#include <cmath>
+
+using Mantid::DataObjects::CompactEvent;
+using Mantid::DataObjects::CompactEvents;
+using Mantid::DataObjects::WeightedEvent;
+using Mantid::DataObjects::WeightedEventNoTime;
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+
+class CompactEventsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompactEventsTest *createSuite() { return new CompactEventsTest(); }
+  static void destroySuite(CompactEventsTest *suite) { delete suite; }
+
+  void test_event_is_8_bytes() { TS_ASSERT_EQUALS(sizeof(CompactEvent), 8); }
+
+  void test_default_is_empty() {
+    CompactEvents compact;
+    TS_ASSERT(compact.empty());
+    TS_ASSERT_EQUALS(compact.size(), 0);
+    TS_ASSERT(!compact.hasPulseTimes());
+    TS_ASSERT(!compact.hasWeights());
+  }
+
+  void test_TofEvent_round_trip() {
+    const std::vector<TofEvent> events{TofEvent(3.5, DateAndTime(int64_t(7))),
+                                       TofEvent(1.5, DateAndTime(int64_t(9))),
+                                       TofEvent(2.5, DateAndTime(int64_t(7)))};
+    CompactEvents compact;
+    compact.assign(events);
+    TS_ASSERT_EQUALS(compact.size(), 3);
+    TS_ASSERT(compact.hasPulseTimes());
+    TS_ASSERT(!compact.hasWeights());
+    // Repeated pulse times are stored once
+    TS_ASSERT_EQUALS(compact.pulseTimes(), std::vector<int64_t>({7, 9}));
+
+    std::vector<TofEvent> copied;
+    compact.copyTo(copied);
+    TS_ASSERT_EQUALS(copied, events);
+  }
+
+  void test_WeightedEvent_round_trip() {
+    const std::vector<WeightedEvent> events{
+        WeightedEvent(3.5, DateAndTime(int64_t(7)), 2.0, 4.0),
+        WeightedEvent(1.5, DateAndTime(int64_t(9)), 0.5, 0.25)};
+    CompactEvents compact;
+    compact.assign(events);
+    TS_ASSERT(compact.hasPulseTimes());
+    TS_ASSERT(compact.hasWeights());
+
+    std::vector<WeightedEvent> copied;
+    compact.copyTo(copied);
+    TS_ASSERT_EQUALS(copied, events);
+  }
+
+  void test_WeightedEventNoTime_round_trip() {
+    const std::vector<WeightedEventNoTime> events{
+        WeightedEventNoTime(3.5, 2.0, 4.0),
+        WeightedEventNoTime(1.5, 0.5, 0.25)};
+    CompactEvents compact;
+    compact.assign(events);
+    TS_ASSERT(!compact.hasPulseTimes());
+    TS_ASSERT(compact.hasWeights());
+
+    std::vector<WeightedEventNoTime> copied;
+    compact.copyTo(copied);
+    TS_ASSERT_EQUALS(copied, events);
+  }
+
+  void test_tof_is_rounded_to_single_precision() {
+    CompactEvents compact;
+    compact.push_back(TofEvent(0.1, DateAndTime(int64_t(0))));
+    std::vector<TofEvent> copied;
+    compact.copyTo(copied);
+    TS_ASSERT_EQUALS(copied[0].tof(), static_cast<double>(0.1f));
+
+    // Converting again is lossless
+    CompactEvents again;
+    again.assign(copied);
+    std::vector<TofEvent> copiedAgain;
+    again.copyTo(copiedAgain);
+    TS_ASSERT_EQUALS(copiedAgain, copied);
+  }
+
+  void test_tof_rounding_error_is_bounded() {
+    // Single precision keeps 24 significant bits
+    const double bound = std::ldexp(1.0, -24);
+    std::vector<WeightedEvent> events;
+    double tof = 1e-3;
+    for (int i = 0; i < 1000; ++i, tof *= 1.0173)
+      events.emplace_back(tof, DateAndTime(int64_t(i)), tof / 3., tof / 7.);
+    CompactEvents compact;
+    compact.assign(events);
+    std::vector<WeightedEvent> copied;
+    compact.copyTo(copied);
+
+    TS_ASSERT_EQUALS(copied.size(), events.size());
+    for (size_t i = 0; i < events.size(); ++i) {
+      const auto &event = events[i];
+      TS_ASSERT_LESS_THAN_EQUALS(std::abs(copied[i].tof() - event.tof()),
+                                 event.tof() * bound);
+      // Weights are single precision in WeightedEvent too
+      TS_ASSERT_EQUALS(copied[i].weight(), event.weight());
+      TS_ASSERT_EQUALS(copied[i].errorSquared(), event.errorSquared());
+      TS_ASSERT_EQUALS(copied[i].pulseTime(), event.pulseTime());
+    }
+  }
+
+  void test_push_back_out_of_order_pulses() {
+    CompactEvents compact;
+    for (int64_t pulse : {30, 10, 20, 10, 30})
+      compact.push_back(TofEvent(double(pulse), DateAndTime(pulse)));
+    TS_ASSERT_EQUALS(compact.size(), 5);
+    // Each pulse time is held once
+    TS_ASSERT_EQUALS(compact.pulseTimes().size(), 3);
+
+    std::vector<TofEvent> copied;
+    compact.copyTo(copied);
+    for (const auto &event : copied)
+      TS_ASSERT_EQUALS(event.pulseTime().totalNanoseconds(),
+                       static_cast<int64_t>(event.tof()));
+  }
+
+  void test_interleaved_pulses_do_not_grow_the_table() {
+    CompactEvents compact;
+    for (int i = 0; i < 1000; ++i) {
+      const int64_t pulse = 100 * (i % 7) + 5 * (i % 3);
+      compact.push_back(TofEvent(double(pulse), DateAndTime(pulse)));
+    }
+    TS_ASSERT_EQUALS(compact.pulseTimes().size(), 21);
+    std::vector<TofEvent> copied;
+    compact.copyTo(copied);
+    for (const auto &event : copied)
+      TS_ASSERT_EQUALS(event.pulseTime().totalNanoseconds(),
+                       static_cast<int64_t>(event.tof()));
+  }
+
+  void test_sortTof_keeps_weights_together() {
+    CompactEvents compact;
+    compact.push_back(WeightedEvent(3.0, DateAndTime(int64_t(30)), 3.0, 9.0));
+    compact.push_back(WeightedEvent(1.0, DateAndTime(int64_t(10)), 1.0, 1.0));
+    compact.push_back(WeightedEvent(2.0, DateAndTime(int64_t(20)), 2.0, 4.0));
+    compact.sortTof();
+
+    std::vector<WeightedEvent> copied;
+    compact.copyTo(copied);
+    TS_ASSERT_EQUALS(copied[0],
+                     WeightedEvent(1.0, DateAndTime(int64_t(10)), 1.0, 1.0));
+    TS_ASSERT_EQUALS(copied[1],
+                     WeightedEvent(2.0, DateAndTime(int64_t(20)), 2.0, 4.0));
+    TS_ASSERT_EQUALS(copied[2],
+                     WeightedEvent(3.0, DateAndTime(int64_t(30)), 3.0, 9.0));
+  }
+
+  void test_sortPulseTimeTof() {
+    CompactEvents compact;
+    compact.push_back(TofEvent(2.0, DateAndTime(int64_t(20))));
+    compact.push_back(TofEvent(5.0, DateAndTime(int64_t(10))));
+    compact.push_back(TofEvent(1.0, DateAndTime(int64_t(20))));
+    compact.sortPulseTimeTof();
+
+    std::vector<TofEvent> copied;
+    compact.copyTo(copied);
+    TS_ASSERT_EQUALS(copied[0], TofEvent(5.0, DateAndTime(int64_t(10))));
+    TS_ASSERT_EQUALS(copied[1], TofEvent(1.0, DateAndTime(int64_t(20))));
+    TS_ASSERT_EQUALS(copied[2], TofEvent(2.0, DateAndTime(int64_t(20))));
+  }
+
+  void test_reverse_and_erase() {
+    CompactEvents compact;
+    for (int i = 0; i < 5; ++i)
+      compact.push_back(TofEvent(double(i), DateAndTime(int64_t(i))));
+    compact.reverse();
+    TS_ASSERT_EQUALS(compact.events().front().tof(), 4.0);
+
+    compact.erase(1, 3);
+    std::vector<double> tofs(compact.size());
+    compact.copyTofs(0, compact.size(), tofs.data());
+    TS_ASSERT_EQUALS(tofs, std::vector<double>({4.0, 1.0, 0.0}));
+  }
+
+  void test_memory_is_half_of_TofEvent() {
+    std::vector<TofEvent> events;
+    for (int i = 0; i < 1000; ++i)
+      events.emplace_back(double(i), DateAndTime(int64_t(i / 100)));
+    CompactEvents compact;
+    compact.assign(events);
+    TS_ASSERT_EQUALS(compact.getMemorySize(),
+                     1000 * sizeof(CompactEvent) + 10 * sizeof(int64_t));
+
+    compact.clear();
+    TS_ASSERT(compact.empty());
+    TS_ASSERT_EQUALS(compact.getMemorySize(), 0);
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_COMPACTEVENTSTEST_H_ */
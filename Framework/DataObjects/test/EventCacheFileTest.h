@@ -0,0 +1,197 @@
+#ifndef MANTID_DATAOBJECTS_EVENTCACHEFILETEST_H_
+#define MANTID_DATAOBJECTS_EVENTCACHEFILETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/EventCacheFile.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <Poco/File.h>
+
+#include <fstream>
+
+using namespace Mantid::DataObjects;
+using Mantid::Kernel::ConfigService;
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+
+class EventCacheFileTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventCacheFileTest *createSuite() { return new EventCacheFileTest(); }
+  static void destroySuite(EventCacheFileTest *suite) { delete suite; }
+
+  EventCacheFileTest()
+      : m_filename(
+            ConfigService::Instance().getString("defaultsave.directory") +
+            "EventCacheFileTest.evc") {}
+
+  void tearDown() override {
+    for (const auto &filename : EventCacheFile::existingNames(m_filename))
+      Poco::File(filename).remove();
+  }
+
+  void test_write_and_map_round_trip() {
+    auto ws = createWorkspace();
+    EventCacheFile::write(m_filename, *ws, "source=test");
+    auto file = EventCacheFile::open(m_filename);
+    TS_ASSERT_EQUALS(file->signature(), "source=test");
+    TS_ASSERT_EQUALS(file->getNumberHistograms(), ws->getNumberHistograms());
+    TS_ASSERT_EQUALS(file->getNumberEvents(), ws->getNumberEvents());
+    TS_ASSERT_EQUALS(file->getTofMin(), 0.5);
+    TS_ASSERT_EQUALS(file->getTofMax(), 99.5);
+
+    auto mapped = ws->clone();
+    file->mapInto(*mapped);
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+      const auto &original = ws->getSpectrum(i);
+      const auto &spectrum = mapped->getSpectrum(i);
+      TS_ASSERT_EQUALS(spectrum.getStorageMode(), MAPPED_STORAGE);
+      TS_ASSERT_EQUALS(spectrum.getEventType(), original.getEventType());
+      TS_ASSERT_EQUALS(spectrum.getNumberEvents(), original.getNumberEvents());
+      TS_ASSERT_EQUALS(spectrum.getSortType(), TOF_SORT);
+    }
+    // The workspace the file was written from is untouched
+    TS_ASSERT_EQUALS(ws->getSpectrum(0).getStorageMode(), ROW_STORAGE);
+  }
+
+  void test_mapped_histogram_and_integral_match_events_in_memory() {
+    auto ws = createWorkspace();
+    EventCacheFile::write(m_filename, *ws, "");
+    auto mapped = ws->clone();
+    EventCacheFile::open(m_filename)->mapInto(*mapped);
+
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+      TS_ASSERT_EQUALS(mapped->y(i).rawData(), ws->y(i).rawData());
+      TS_ASSERT_EQUALS(mapped->e(i).rawData(), ws->e(i).rawData());
+      const auto &original = ws->getSpectrum(i);
+      const auto &spectrum = mapped->getSpectrum(i);
+      TS_ASSERT_EQUALS(spectrum.integrate(10.2, 40.7, false),
+                       original.integrate(10.2, 40.7, false));
+      TS_ASSERT_EQUALS(spectrum.integrate(0, 0, true),
+                       original.integrate(0, 0, true));
+      TS_ASSERT_EQUALS(spectrum.getTofMin(), original.getTofMin());
+      TS_ASSERT_EQUALS(spectrum.getTofMax(), original.getTofMax());
+      // Reading does not copy the events
+      TS_ASSERT_EQUALS(spectrum.getStorageMode(), MAPPED_STORAGE);
+    }
+  }
+
+  void test_modifying_a_mapped_list_copies_its_events() {
+    auto ws = createWorkspace();
+    EventCacheFile::write(m_filename, *ws, "");
+    auto mapped = ws->clone();
+    EventCacheFile::open(m_filename)->mapInto(*mapped);
+
+    auto &spectrum = mapped->getSpectrum(0);
+    const size_t numEvents = spectrum.getNumberEvents();
+    spectrum.addEventQuickly(TofEvent(1000.0, DateAndTime(int64_t(0))));
+    TS_ASSERT_EQUALS(spectrum.getStorageMode(), ROW_STORAGE);
+    TS_ASSERT_EQUALS(spectrum.getNumberEvents(), numEvents + 1);
+
+    auto &other = mapped->getSpectrum(1);
+    other.convertTof(2.0, 1.0);
+    TS_ASSERT_EQUALS(other.getStorageMode(), ROW_STORAGE);
+    TS_ASSERT_EQUALS(other.getTofMin(),
+                     2.0 * ws->getSpectrum(1).getTofMin() + 1.0);
+    // The other spectra still share the file
+    TS_ASSERT_EQUALS(mapped->getSpectrum(2).getStorageMode(), MAPPED_STORAGE);
+  }
+
+  void test_rewriting_a_mapped_file_leaves_its_mapping_valid() {
+    auto ws = createWorkspace();
+    TS_ASSERT_EQUALS(EventCacheFile::write(m_filename, *ws, "first"),
+                     m_filename);
+    auto mapped = ws->clone();
+    EventCacheFile::open(m_filename)->mapInto(*mapped);
+    const auto expected = ws->y(3).rawData();
+
+    // Where the mapped file cannot be replaced the new one gets a fresh name
+    auto other = WorkspaceCreationHelper::createEventWorkspace2(5, 100);
+    const std::string written =
+        EventCacheFile::write(m_filename, *other, "second");
+    TS_ASSERT_EQUALS(EventCacheFile::open(written)->signature(), "second");
+    TS_ASSERT_EQUALS(mapped->y(3).rawData(), expected);
+    if (written != m_filename) {
+      mapped.reset();
+      Poco::File(written).remove();
+    }
+  }
+
+  void test_mapped_storage_cannot_be_set_directly() {
+    EventList list;
+    TS_ASSERT_THROWS(list.setStorageMode(MAPPED_STORAGE),
+                     std::invalid_argument);
+  }
+
+  void test_mapInto_requires_matching_number_of_spectra() {
+    auto ws = createWorkspace();
+    EventCacheFile::write(m_filename, *ws, "");
+    auto other = WorkspaceCreationHelper::createEventWorkspace2(3, 10);
+    TS_ASSERT_THROWS(EventCacheFile::open(m_filename)->mapInto(*other),
+                     std::invalid_argument);
+  }
+
+  void test_open_rejects_other_files() {
+    {
+      std::ofstream out(m_filename);
+      out << "not an event cache, but long enough to hold a header......";
+    }
+    TS_ASSERT_THROWS(EventCacheFile::open(m_filename), std::runtime_error);
+  }
+
+  void test_existingNames_lists_the_numbered_files() {
+    TS_ASSERT(EventCacheFile::existingNames(m_filename).empty());
+    auto ws = createWorkspace();
+    const std::string first = numberedName(1);
+    const std::string second = numberedName(2);
+    EventCacheFile::write(first, *ws, "");
+    // Without filename itself the numbered files are still found
+    TS_ASSERT_EQUALS(EventCacheFile::existingNames(m_filename),
+                     std::vector<std::string>({first}));
+    EventCacheFile::write(m_filename, *ws, "");
+    EventCacheFile::write(second, *ws, "");
+    TS_ASSERT_EQUALS(EventCacheFile::existingNames(m_filename),
+                     std::vector<std::string>({m_filename, first, second}));
+  }
+
+  void test_writing_while_mapped_keeps_the_number_of_files() {
+    auto ws = createWorkspace();
+    EventCacheFile::write(m_filename, *ws, "first");
+    auto mapped = ws->clone();
+    EventCacheFile::open(m_filename)->mapInto(*mapped);
+
+    // Each file is replaced, or the first unmapped numbered one is, so
+    // writing again and again while one file is mapped needs two at most
+    for (int i = 0; i < 3; ++i)
+      EventCacheFile::write(m_filename, *ws, "again");
+    const auto names = EventCacheFile::existingNames(m_filename);
+    TS_ASSERT_LESS_THAN_EQUALS(names.size(), 2);
+    TS_ASSERT_EQUALS(EventCacheFile::open(names.back())->signature(),
+                     "again");
+    mapped.reset();
+  }
+
+private:
+  /// @return m_filename with "-number" added to its base name
+  std::string numberedName(const int number) const {
+    return m_filename.substr(0, m_filename.size() - 4) + "-" +
+           std::to_string(number) + ".evc";
+  }
+
+  /// 5 spectra of TofEvents, one converted to weighted events
+  EventWorkspace_sptr createWorkspace() {
+    auto ws = WorkspaceCreationHelper::createEventWorkspace2(5, 100);
+    ws->getSpectrum(3).switchTo(Mantid::API::WEIGHTED);
+    ws->getSpectrum(3) *= 2.5;
+    ws->getSpectrum(4).switchTo(Mantid::API::WEIGHTED_NOTIME);
+    return ws;
+  }
+
+  const std::string m_filename;
+};
+
+#endif /* MANTID_DATAOBJECTS_EVENTCACHEFILETEST_H_ */
@@ -0,0 +1,120 @@
+#ifndef MANTID_DATAOBJECTS_EVENTCOLUMNSTEST_H_
+#define MANTID_DATAOBJECTS_EVENTCOLUMNSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/EventColumns.h"
+
+using Mantid::DataObjects::EventColumns;
+using Mantid::DataObjects::WeightedEvent;
+using Mantid::DataObjects::WeightedEventNoTime;
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+
+class EventColumnsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventColumnsTest *createSuite() { return new EventColumnsTest(); }
+  static void destroySuite(EventColumnsTest *suite) { delete suite; }
+
+  void test_default_is_empty() {
+    EventColumns columns;
+    TS_ASSERT(columns.empty());
+    TS_ASSERT_EQUALS(columns.size(), 0);
+    TS_ASSERT(!columns.hasPulseTimes());
+    TS_ASSERT(!columns.hasWeights());
+  }
+
+  void test_TofEvent_round_trip() {
+    const std::vector<TofEvent> events{TofEvent(3.5, DateAndTime(int64_t(7))),
+                                       TofEvent(1.5, DateAndTime(int64_t(9)))};
+    EventColumns columns;
+    columns.assign(events);
+    TS_ASSERT_EQUALS(columns.size(), 2);
+    TS_ASSERT(columns.hasPulseTimes());
+    TS_ASSERT(!columns.hasWeights());
+
+    std::vector<TofEvent> copied;
+    columns.copyTo(copied);
+    TS_ASSERT_EQUALS(copied, events);
+  }
+
+  void test_WeightedEvent_round_trip() {
+    const std::vector<WeightedEvent> events{
+        WeightedEvent(3.5, DateAndTime(int64_t(7)), 2.0, 4.0),
+        WeightedEvent(1.5, DateAndTime(int64_t(9)), 0.5, 0.25)};
+    EventColumns columns;
+    columns.assign(events);
+    TS_ASSERT(columns.hasPulseTimes());
+    TS_ASSERT(columns.hasWeights());
+
+    std::vector<WeightedEvent> copied;
+    columns.copyTo(copied);
+    TS_ASSERT_EQUALS(copied, events);
+  }
+
+  void test_WeightedEventNoTime_round_trip() {
+    const std::vector<WeightedEventNoTime> events{
+        WeightedEventNoTime(3.5, 2.0, 4.0),
+        WeightedEventNoTime(1.5, 0.5, 0.25)};
+    EventColumns columns;
+    columns.assign(events);
+    TS_ASSERT(!columns.hasPulseTimes());
+    TS_ASSERT(columns.hasWeights());
+
+    std::vector<WeightedEventNoTime> copied;
+    columns.copyTo(copied);
+    TS_ASSERT_EQUALS(copied, events);
+  }
+
+  void test_TofEvent_copied_as_unit_weight() {
+    EventColumns columns;
+    columns.push_back(TofEvent(3.5, DateAndTime(int64_t(7))));
+    std::vector<WeightedEvent> copied;
+    columns.copyTo(copied);
+    TS_ASSERT_EQUALS(copied.size(), 1);
+    TS_ASSERT_EQUALS(copied[0].weight(), 1.0);
+    TS_ASSERT_EQUALS(copied[0].errorSquared(), 1.0);
+    TS_ASSERT_EQUALS(copied[0].pulseTime(), DateAndTime(int64_t(7)));
+  }
+
+  void test_sortTof_keeps_columns_together() {
+    EventColumns columns;
+    columns.push_back(WeightedEvent(3.0, DateAndTime(int64_t(30)), 3.0, 9.0));
+    columns.push_back(WeightedEvent(1.0, DateAndTime(int64_t(10)), 1.0, 1.0));
+    columns.push_back(WeightedEvent(2.0, DateAndTime(int64_t(20)), 2.0, 4.0));
+    columns.sortTof();
+
+    TS_ASSERT_EQUALS(columns.tofs(), std::vector<double>({1.0, 2.0, 3.0}));
+    TS_ASSERT_EQUALS(columns.pulseTimes(), std::vector<int64_t>({10, 20, 30}));
+    TS_ASSERT_EQUALS(columns.weights(), std::vector<float>({1.f, 2.f, 3.f}));
+    TS_ASSERT_EQUALS(columns.errorSquareds(),
+                     std::vector<float>({1.f, 4.f, 9.f}));
+  }
+
+  void test_reverse_and_erase() {
+    EventColumns columns;
+    for (int i = 0; i < 5; ++i)
+      columns.push_back(TofEvent(double(i), DateAndTime(int64_t(i))));
+    columns.reverse();
+    TS_ASSERT_EQUALS(columns.tofs().front(), 4.0);
+    TS_ASSERT_EQUALS(columns.pulseTimes().front(), 4);
+
+    columns.erase(1, 3);
+    TS_ASSERT_EQUALS(columns.tofs(), std::vector<double>({4.0, 1.0, 0.0}));
+    TS_ASSERT_EQUALS(columns.pulseTimes(), std::vector<int64_t>({4, 1, 0}));
+  }
+
+  void test_clear_releases_memory() {
+    EventColumns columns;
+    columns.reserve(100);
+    TS_ASSERT_LESS_THAN_EQUALS(100 * (sizeof(double) + sizeof(int64_t)),
+                               columns.getMemorySize());
+    columns.clear();
+    TS_ASSERT(columns.empty());
+    TS_ASSERT_EQUALS(columns.getMemorySize(), 0);
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_EVENTCOLUMNSTEST_H_ */
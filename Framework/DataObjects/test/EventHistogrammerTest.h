@@ -0,0 +1,276 @@
+#ifndef MANTID_DATAOBJECTS_EVENTHISTOGRAMMERTEST_H_
+#define MANTID_DATAOBJECTS_EVENTHISTOGRAMMERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/EventHistogrammer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+
+using Mantid::DataObjects::EventHistogrammer;
+using Mantid::DataObjects::WeightedEvent;
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+using Mantid::MantidVec;
+using Binning = EventHistogrammer::Binning;
+
+namespace {
+MantidVec linearBins(const double start, const double step, const double end) {
+  MantidVec X;
+  for (double x = start; x < end; x += step)
+    X.push_back(x);
+  X.push_back(end);
+  return X;
+}
+
+MantidVec logBins(const double start, const double step, const double end) {
+  MantidVec X;
+  for (double x = start; x < end; x *= (1. + step))
+    X.push_back(x);
+  X.push_back(end);
+  return X;
+}
+
+/// Reference bin search
+size_t searchBin(const MantidVec &X, const double tof) {
+  if (!(tof >= X.front() && tof < X.back()))
+    return X.size() - 1;
+  return static_cast<size_t>(std::upper_bound(X.begin(), X.end(), tof) -
+                             X.begin()) -
+         1;
+}
+
+std::vector<double> randomTofs(const size_t num, const double min,
+                               const double max) {
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<double> distribution(min, max);
+  std::vector<double> tofs(num);
+  for (auto &tof : tofs)
+    tof = distribution(generator);
+  return tofs;
+}
+} // namespace
+
+class EventHistogrammerTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventHistogrammerTest *createSuite() {
+    return new EventHistogrammerTest();
+  }
+  static void destroySuite(EventHistogrammerTest *suite) { delete suite; }
+
+  void test_classifies_linear_bins() {
+    const auto X = linearBins(0., 0.1, 100.);
+    EventHistogrammer histogrammer(X);
+    TS_ASSERT_EQUALS(histogrammer.binning(), Binning::Linear);
+    TS_ASSERT_EQUALS(histogrammer.numberOfBins(), X.size() - 1);
+  }
+
+  void test_classifies_linear_bins_with_short_last_bin() {
+    const auto X = linearBins(0., 3., 10.);
+    TS_ASSERT_EQUALS(X.back() - X[X.size() - 2], 1.);
+    TS_ASSERT_EQUALS(EventHistogrammer(X).binning(), Binning::Linear);
+  }
+
+  void test_classifies_logarithmic_bins() {
+    const auto X = logBins(10., 0.01, 20000.);
+    TS_ASSERT_EQUALS(EventHistogrammer(X).binning(), Binning::Logarithmic);
+  }
+
+  void test_classifies_arbitrary_bins() {
+    const MantidVec X{0., 1., 3., 4., 10.};
+    TS_ASSERT_EQUALS(EventHistogrammer(X).binning(), Binning::Arbitrary);
+  }
+
+  void test_findBin_linear() { checkFindBin(linearBins(-5., 0.37, 1000.)); }
+
+  void test_findBin_logarithmic() { checkFindBin(logBins(1., 0.004, 500.)); }
+
+  void test_findBin_arbitrary() {
+    checkFindBin({0., 0.5, 7., 7.25, 100., 101., 1000.});
+  }
+
+  void test_findBin_on_boundaries() {
+    const auto X = linearBins(0., 0.1, 10.);
+    EventHistogrammer histogrammer(X);
+    for (size_t i = 0; i < X.size() - 1; ++i)
+      TS_ASSERT_EQUALS(histogrammer.findBin(X[i]), i);
+    TS_ASSERT_EQUALS(histogrammer.findBin(X.back()), X.size() - 1);
+  }
+
+  void test_out_of_range_and_nan_are_ignored() {
+    const auto X = linearBins(0., 1., 10.);
+    EventHistogrammer histogrammer(X);
+    const std::vector<double> tofs{-1., 10., 11.,
+                                   std::numeric_limits<double>::quiet_NaN(),
+                                   std::numeric_limits<double>::infinity()};
+    MantidVec Y(X.size() - 1, 0.);
+    histogrammer.addCounts(tofs.data(), tofs.size(), Y.data());
+    TS_ASSERT_EQUALS(std::accumulate(Y.begin(), Y.end(), 0.), 0.);
+  }
+
+  void test_empty_bins() {
+    const MantidVec X{1.};
+    EventHistogrammer histogrammer(X);
+    TS_ASSERT_EQUALS(histogrammer.numberOfBins(), 0);
+    TS_ASSERT_EQUALS(histogrammer.findBin(1.), 0);
+  }
+
+  void test_vectorised_matches_scalar() {
+    const auto X = linearBins(0., 0.5, 1000.);
+    const auto tofs = randomTofs(10001, -10., 1010.);
+    MantidVec vectorY(X.size() - 1, 0.), scalarY(X.size() - 1, 0.);
+    EventHistogrammer(X, true).addCounts(tofs.data(), tofs.size(),
+                                         vectorY.data());
+    EventHistogrammer(X, false).addCounts(tofs.data(), tofs.size(),
+                                          scalarY.data());
+    TS_ASSERT_EQUALS(vectorY, scalarY);
+  }
+
+  void test_addCounts_unsorted_events() {
+    const auto X = logBins(1., 0.1, 100.);
+    const auto tofs = randomTofs(1000, 0., 120.);
+    MantidVec Y(X.size() - 1, 0.), expected(X.size() - 1, 0.);
+    for (const auto tof : tofs)
+      if (searchBin(X, tof) < expected.size())
+        expected[searchBin(X, tof)] += 1.;
+    std::vector<TofEvent> events;
+    for (const auto tof : tofs)
+      events.emplace_back(tof, DateAndTime(int64_t(0)));
+    EventHistogrammer(X).addCounts(events, Y);
+    TS_ASSERT_EQUALS(Y, expected);
+  }
+
+  void test_addWeights() {
+    const MantidVec X{0., 1., 2., 4.};
+    const std::vector<WeightedEvent> events{
+        WeightedEvent(0.5, DateAndTime(int64_t(0)), 2., 4.),
+        WeightedEvent(3.0, DateAndTime(int64_t(0)), 1.5, 2.25),
+        WeightedEvent(0.7, DateAndTime(int64_t(0)), 1., 1.),
+        WeightedEvent(5.0, DateAndTime(int64_t(0)), 1., 1.)};
+    MantidVec Y(3, 0.), E(3, 0.);
+    EventHistogrammer(X).addWeights(events, Y, E);
+    TS_ASSERT_EQUALS(Y, MantidVec({3., 0., 1.5}));
+    TS_ASSERT_EQUALS(E, MantidVec({5., 0., 2.25}));
+  }
+
+  void test_sorted_matches_unsorted() {
+    const MantidVec X{0., 0.5, 7., 7.25, 100., 101., 1000.};
+    auto tofs = randomTofs(10000, -10., 1010.);
+    std::sort(tofs.begin(), tofs.end());
+    std::vector<float> weights(tofs.size()), errorSquareds(tofs.size());
+    for (size_t i = 0; i < tofs.size(); ++i) {
+      weights[i] = static_cast<float>(i % 7);
+      errorSquareds[i] = static_cast<float>(i % 3);
+    }
+    EventHistogrammer histogrammer(X);
+    MantidVec sortedY(X.size() - 1, 0.), sortedE(X.size() - 1, 0.);
+    MantidVec unsortedY(X.size() - 1, 0.), unsortedE(X.size() - 1, 0.);
+    histogrammer.addWeights(tofs.data(), weights.data(), errorSquareds.data(),
+                            tofs.size(), sortedY.data(), sortedE.data(), true);
+    histogrammer.addWeights(tofs.data(), weights.data(), errorSquareds.data(),
+                            tofs.size(), unsortedY.data(), unsortedE.data(),
+                            false);
+    TS_ASSERT_EQUALS(sortedY, unsortedY);
+    TS_ASSERT_EQUALS(sortedE, unsortedE);
+
+    std::fill(sortedY.begin(), sortedY.end(), 0.);
+    std::fill(unsortedY.begin(), unsortedY.end(), 0.);
+    histogrammer.addCounts(tofs.data(), tofs.size(), sortedY.data(), true);
+    histogrammer.addCounts(tofs.data(), tofs.size(), unsortedY.data(), false);
+    TS_ASSERT_EQUALS(sortedY, unsortedY);
+    TS_ASSERT_EQUALS(std::accumulate(sortedY.begin(), sortedY.end(), 0.),
+                     static_cast<double>(
+                         std::lower_bound(tofs.begin(), tofs.end(), 1000.) -
+                         std::lower_bound(tofs.begin(), tofs.end(), 0.)));
+  }
+
+  void test_instructionSet() {
+    const auto name = EventHistogrammer::instructionSet();
+    TS_ASSERT(name == "AVX" || name == "SSE2" || name == "scalar");
+  }
+
+private:
+  void checkFindBin(const MantidVec &X) {
+    const auto tofs = randomTofs(5000, X.front() - 1., X.back() + 1.);
+    for (const bool vectorise : {true, false}) {
+      EventHistogrammer histogrammer(X, vectorise);
+      for (const auto tof : tofs)
+        TS_ASSERT_EQUALS(histogrammer.findBin(tof), searchBin(X, tof));
+      for (const auto edge : X)
+        TS_ASSERT_EQUALS(histogrammer.findBin(edge), searchBin(X, edge));
+    }
+  }
+};
+
+//=============================================================================
+/** Compares the histogrammer against the sequential walk over sorted events
+ * that EventList used before, for linear, logarithmic and arbitrary bins.
+ */
+class EventHistogrammerTestPerformance : public CxxTest::TestSuite {
+public:
+  static EventHistogrammerTestPerformance *createSuite() {
+    return new EventHistogrammerTestPerformance();
+  }
+  static void destroySuite(EventHistogrammerTestPerformance *suite) {
+    delete suite;
+  }
+
+  EventHistogrammerTestPerformance()
+      : tofs(randomTofs(10000000, 0., 100000.)),
+        linearX(linearBins(0., 1., 100000.)),
+        logX(logBins(1., 0.0001, 100000.)) {
+    std::sort(tofs.begin(), tofs.end());
+    // Arbitrary bins: the logarithmic ones with every other edge moved
+    arbitraryX = logX;
+    for (size_t i = 1; i < arbitraryX.size() - 1; i += 2)
+      arbitraryX[i] = 0.5 * (arbitraryX[i - 1] + arbitraryX[i + 1]) + 1e-3;
+    Y.resize(linearX.size());
+  }
+
+  void test_linear_sequential_walk() { sequentialWalk(linearX); }
+  void test_linear_sorted() { histogram(linearX, true, true); }
+  void test_linear_scalar() { histogram(linearX, false, false); }
+  void test_linear_vectorised() { histogram(linearX, true, false); }
+
+  void test_logarithmic_sequential_walk() { sequentialWalk(logX); }
+  void test_logarithmic_sorted() { histogram(logX, true, true); }
+  void test_logarithmic() { histogram(logX, true, false); }
+
+  void test_arbitrary_sequential_walk() { sequentialWalk(arbitraryX); }
+  void test_arbitrary_sorted() { histogram(arbitraryX, true, true); }
+  void test_arbitrary() { histogram(arbitraryX, true, false); }
+
+private:
+  void histogram(const MantidVec &X, const bool vectorise, const bool sorted) {
+    Y.assign(X.size() - 1, 0.);
+    EventHistogrammer(X, vectorise)
+        .addCounts(tofs.data(), tofs.size(), Y.data(), sorted);
+  }
+
+  /// The bin walk previously used by EventList::generateCountsHistogram
+  void sequentialWalk(const MantidVec &X) {
+    Y.assign(X.size() - 1, 0.);
+    size_t bin = 0;
+    auto itev = std::lower_bound(tofs.cbegin(), tofs.cend(), X.front());
+    for (; itev != tofs.cend() && bin < X.size() - 1; ++itev) {
+      while (bin < X.size() - 1 && *itev >= X[bin + 1])
+        ++bin;
+      if (bin < X.size() - 1)
+        Y[bin]++;
+    }
+  }
+
+  std::vector<double> tofs;
+  MantidVec linearX;
+  MantidVec logX;
+  MantidVec arbitraryX;
+  MantidVec Y;
+};
+
+#endif /* MANTID_DATAOBJECTS_EVENTHISTOGRAMMERTEST_H_ */
@@ -2393,6 +2393,333 @@ public:
     return;
   }
 
+  //-----------------------------------------------------------------------------------------------
+  void test_histogram_without_sort_allTypes() {
+    const MantidVec linearX = makeX(1e5, 90);
+    const MantidVec arbitraryX{0., 1e5, 3e5, 3.5e5, 7e6, 1e7};
+    for (int this_type = 0; this_type < 3; this_type++) {
+      for (int columns = 0; columns < 2; columns++) {
+        EventList sorted = this->fake_data();
+        sorted.switchTo(static_cast<EventType>(this_type));
+        if (columns)
+          sorted.setStorageMode(COLUMN_STORAGE);
+        EventList unsorted(sorted);
+        TS_ASSERT(unsorted.getSortBeforeHistogram());
+        unsorted.setSortBeforeHistogram(false);
+        TS_ASSERT(!unsorted.getSortBeforeHistogram());
+
+        MantidVec Y, E, unsortedY, unsortedE;
+        sorted.generateHistogram(linearX, Y, E);
+        unsorted.generateHistogram(linearX, unsortedY, unsortedE);
+        TS_ASSERT(sorted.isSortedByTof());
+        TSM_ASSERT("Linear bins must not sort the events",
+                   !unsorted.isSortedByTof());
+        TS_ASSERT_EQUALS(unsortedY, Y);
+        TS_ASSERT_EQUALS(unsortedE.size(), E.size());
+        for (size_t i = 0; i < E.size(); ++i)
+          TS_ASSERT_DELTA(unsortedE[i], E[i], 1e-10);
+
+        sorted.generateHistogram(arbitraryX, Y, E);
+        unsorted.generateHistogram(arbitraryX, unsortedY, unsortedE);
+        TSM_ASSERT("Arbitrary bins still sort the events",
+                   unsorted.isSortedByTof());
+        TS_ASSERT_EQUALS(unsortedY, Y);
+      }
+    }
+  }
+
+  void test_sortBeforeHistogram_is_copied() {
+    EventList original;
+    original.setSortBeforeHistogram(false);
+    const EventList copy(original);
+    TS_ASSERT(!copy.getSortBeforeHistogram());
+  }
+
+  void test_columnStorage_roundTrip_allTypes() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      const EventList original(el);
+
+      el.setStorageMode(COLUMN_STORAGE);
+      TS_ASSERT_EQUALS(el.getStorageMode(), COLUMN_STORAGE);
+      TS_ASSERT_EQUALS(el.getNumberEvents(), original.getNumberEvents());
+      TS_ASSERT_EQUALS(el.getEventType(), original.getEventType());
+
+      el.setStorageMode(ROW_STORAGE);
+      TS_ASSERT_EQUALS(el.getStorageMode(), ROW_STORAGE);
+      TSM_ASSERT(this_type, el == original);
+    }
+  }
+
+  void test_columnStorage_histogram_matches_rows_allTypes() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      this->test_setX();
+      EventList columns(el);
+      columns.setStorageMode(COLUMN_STORAGE);
+
+      MantidVec rowY, rowE, colY, colE;
+      el.generateHistogram(el.readX(), rowY, rowE);
+      columns.generateHistogram(el.readX(), colY, colE);
+      TS_ASSERT_EQUALS(columns.getStorageMode(), COLUMN_STORAGE);
+      TS_ASSERT_EQUALS(rowY.size(), colY.size());
+      for (size_t i = 0; i < rowY.size(); ++i) {
+        TS_ASSERT_DELTA(rowY[i], colY[i], 1e-10);
+        TS_ASSERT_DELTA(rowE[i], colE[i], 1e-10);
+      }
+    }
+  }
+
+  void test_columnStorage_histogram_weights() {
+    this->fake_uniform_data_weights();
+    this->test_setX();
+    EventList columns(el);
+    columns.setStorageMode(COLUMN_STORAGE);
+    MantidVec rowY, rowE, colY, colE;
+    el.generateHistogram(el.readX(), rowY, rowE);
+    columns.generateHistogram(el.readX(), colY, colE);
+    TS_ASSERT_EQUALS(rowY, colY);
+    TS_ASSERT_EQUALS(rowE, colE);
+  }
+
+  void test_columnStorage_convertTof_maskTof_integrate() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      EventList rows(el);
+      el.setStorageMode(COLUMN_STORAGE);
+
+      rows.convertTof(2.5, 1.);
+      el.convertTof(2.5, 1.);
+      rows.maskTof(MAX_TOF * 0.5, MAX_TOF);
+      el.maskTof(MAX_TOF * 0.5, MAX_TOF);
+      TS_ASSERT_EQUALS(el.getStorageMode(), COLUMN_STORAGE);
+      TS_ASSERT_EQUALS(el.getNumberEvents(), rows.getNumberEvents());
+      TS_ASSERT_EQUALS(el.getTofMin(), rows.getTofMin());
+      TS_ASSERT_EQUALS(el.getTofMax(), rows.getTofMax());
+      TS_ASSERT_EQUALS(el.integrate(0, MAX_TOF, false),
+                       rows.integrate(0, MAX_TOF, false));
+      TS_ASSERT_EQUALS(el.getTofs(), rows.getTofs());
+      TS_ASSERT_EQUALS(el.getStorageMode(), COLUMN_STORAGE);
+    }
+  }
+
+  void test_columnStorage_falls_back_to_rows_when_needed() {
+    this->fake_uniform_time_data();
+    const auto times = el.getPulseTimes();
+    el.setStorageMode(COLUMN_STORAGE);
+    el.sortPulseTime();
+    TS_ASSERT_EQUALS(el.getStorageMode(), ROW_STORAGE);
+    TS_ASSERT_EQUALS(el.getPulseTimes(), times);
+  }
+
+  void test_columnStorage_addEventQuickly() {
+    EventList columns;
+    columns.setStorageMode(COLUMN_STORAGE);
+    columns.addEventQuickly(TofEvent(3.0, 30));
+    columns.addEventQuickly(TofEvent(1.0, 10));
+    TS_ASSERT_EQUALS(columns.getNumberEvents(), 2);
+    columns.sortTof();
+    TS_ASSERT_EQUALS(columns.getTofMin(), 1.0);
+    const auto &events = columns.getEvents();
+    TS_ASSERT_EQUALS(columns.getStorageMode(), ROW_STORAGE);
+    TS_ASSERT_EQUALS(events[0].pulseTime(), DateAndTime(int64_t(10)));
+    TS_ASSERT_EQUALS(events[1].tof(), 3.0);
+  }
+
+  void test_columnStorage_addEventQuickly_switches_to_weights() {
+    EventList columns;
+    columns.setStorageMode(COLUMN_STORAGE);
+    columns.addEventQuickly(TofEvent(3.0, 30));
+    columns.addEventQuickly(
+        WeightedEvent(1.0, DateAndTime(int64_t(10)), 2.0, 4.0));
+    TS_ASSERT_EQUALS(columns.getEventType(), WEIGHTED);
+    columns.addEventQuickly(TofEvent(2.0, 20));
+    TS_ASSERT_EQUALS(columns.getNumberEvents(), 3);
+    const auto &events = columns.getWeightedEvents();
+    TS_ASSERT_EQUALS(events[0].weight(), 1.0);
+    TS_ASSERT_EQUALS(events[0].pulseTime(), DateAndTime(int64_t(30)));
+    TS_ASSERT_EQUALS(events[1].weight(), 2.0);
+    TS_ASSERT_EQUALS(events[1].errorSquared(), 4.0);
+    TS_ASSERT_EQUALS(events[2].tof(), 2.0);
+    TS_ASSERT_EQUALS(events[2].weight(), 1.0);
+
+    columns.setStorageMode(COLUMN_STORAGE);
+    columns.addEventQuickly(WeightedEventNoTime(5.0, 3.0, 9.0));
+    TS_ASSERT_EQUALS(columns.getEventType(), WEIGHTED_NOTIME);
+    const auto &noTime = columns.getWeightedEventsNoTime();
+    TS_ASSERT_EQUALS(noTime.size(), 4);
+    TS_ASSERT_EQUALS(noTime[1].weight(), 2.0);
+    TS_ASSERT_EQUALS(noTime[3].tof(), 5.0);
+    TS_ASSERT_EQUALS(noTime[3].errorSquared(), 9.0);
+  }
+
+  /// Round the times-of-flight of el to single precision, as compact storage
+  /// does, so that results can be compared exactly with row storage
+  void roundTofsToFloat() {
+    el.setStorageMode(COMPACT_STORAGE);
+    el.setStorageMode(ROW_STORAGE);
+  }
+
+  void test_compactStorage_roundTrip_allTypes() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      roundTofsToFloat();
+      const EventList original(el);
+
+      el.setStorageMode(COMPACT_STORAGE);
+      TS_ASSERT_EQUALS(el.getStorageMode(), COMPACT_STORAGE);
+      TS_ASSERT_EQUALS(el.getNumberEvents(), original.getNumberEvents());
+      TS_ASSERT_EQUALS(el.getEventType(), original.getEventType());
+      // A WeightedEventNoTime has no pulse time to move to a table, and
+      // takes 16 bytes either way
+      if (this_type == WEIGHTED_NOTIME) {
+        TS_ASSERT_LESS_THAN_EQUALS(el.getMemorySize(),
+                                   original.getMemorySize());
+      } else {
+        TS_ASSERT_LESS_THAN(el.getMemorySize(), original.getMemorySize());
+      }
+
+      el.setStorageMode(ROW_STORAGE);
+      TSM_ASSERT(this_type, el == original);
+    }
+  }
+
+  void test_compactStorage_histogram_matches_rows_allTypes() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      roundTofsToFloat();
+      this->test_setX();
+      EventList compact(el);
+      compact.setStorageMode(COMPACT_STORAGE);
+
+      MantidVec rowY, rowE, compactY, compactE;
+      el.generateHistogram(el.readX(), rowY, rowE);
+      compact.generateHistogram(el.readX(), compactY, compactE);
+      TS_ASSERT_EQUALS(compact.getStorageMode(), COMPACT_STORAGE);
+      TS_ASSERT_EQUALS(rowY.size(), compactY.size());
+      for (size_t i = 0; i < rowY.size(); ++i) {
+        TS_ASSERT_DELTA(rowY[i], compactY[i], 1e-10);
+        TS_ASSERT_DELTA(rowE[i], compactE[i], 1e-10);
+      }
+    }
+  }
+
+  void test_compactStorage_sort_stays_compact() {
+    this->fake_data();
+    roundTofsToFloat();
+    EventList rows(el);
+    el.setStorageMode(COMPACT_STORAGE);
+
+    rows.sortPulseTimeTOF();
+    el.sortPulseTimeTOF();
+    TS_ASSERT_EQUALS(el.getStorageMode(), COMPACT_STORAGE);
+    // getPulseTimes() goes back to row storage, so ask a copy
+    TS_ASSERT_EQUALS(EventList(el).getPulseTimes(), rows.getPulseTimes());
+    TS_ASSERT_EQUALS(el.getTofs(), rows.getTofs());
+
+    rows.sortTof();
+    el.sortTof();
+    TS_ASSERT_EQUALS(el.getStorageMode(), COMPACT_STORAGE);
+    TS_ASSERT(el.isSortedByTof());
+    TS_ASSERT_EQUALS(el.getTofs(), rows.getTofs());
+  }
+
+  void test_compactStorage_convertTof_maskTof_integrate() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      roundTofsToFloat();
+      EventList rows(el);
+      el.setStorageMode(COMPACT_STORAGE);
+
+      rows.convertTof(2.5, 1.);
+      el.convertTof(2.5, 1.);
+      rows.maskTof(MAX_TOF * 0.5, MAX_TOF);
+      el.maskTof(MAX_TOF * 0.5, MAX_TOF);
+      TS_ASSERT_EQUALS(el.getStorageMode(), COMPACT_STORAGE);
+      TS_ASSERT_EQUALS(el.getNumberEvents(), rows.getNumberEvents());
+      TS_ASSERT_DELTA(el.getTofMin(), rows.getTofMin(),
+                      rows.getTofMin() * 1e-6);
+      TS_ASSERT_DELTA(el.getTofMax(), rows.getTofMax(),
+                      rows.getTofMax() * 1e-6);
+      TS_ASSERT_EQUALS(el.integrate(0, MAX_TOF, false),
+                       rows.integrate(0, MAX_TOF, false));
+      TS_ASSERT_EQUALS(el.getStorageMode(), COMPACT_STORAGE);
+    }
+  }
+
+  void test_compactStorage_compressEvents_keeps_storage() {
+    this->fake_uniform_data();
+    el.setStorageMode(COMPACT_STORAGE);
+    EventList compressed;
+    el.compressEvents(10., &compressed);
+    TS_ASSERT_EQUALS(el.getStorageMode(), COMPACT_STORAGE);
+    TS_ASSERT_EQUALS(compressed.getStorageMode(), COMPACT_STORAGE);
+    TS_ASSERT_EQUALS(compressed.getEventType(), WEIGHTED_NOTIME);
+    TS_ASSERT_DELTA(compressed.integrate(0, MAX_TOF, true),
+                    el.integrate(0, MAX_TOF, true), 1e-6);
+  }
+
+  void test_compactStorage_addEventQuickly() {
+    EventList compact;
+    compact.setStorageMode(COMPACT_STORAGE);
+    compact.addEventQuickly(TofEvent(3.0, 30));
+    compact.addEventQuickly(TofEvent(1.0, 10));
+    TS_ASSERT_EQUALS(compact.getNumberEvents(), 2);
+    compact.sortTof();
+    TS_ASSERT_EQUALS(compact.getTofMin(), 1.0);
+    const auto &events = compact.getEvents();
+    TS_ASSERT_EQUALS(compact.getStorageMode(), ROW_STORAGE);
+    TS_ASSERT_EQUALS(events[0].pulseTime(), DateAndTime(int64_t(10)));
+    TS_ASSERT_EQUALS(events[1].tof(), 3.0);
+  }
+
+  void test_compactStorage_addEventQuickly_switches_to_weights() {
+    EventList compact;
+    compact.setStorageMode(COMPACT_STORAGE);
+    compact.addEventQuickly(TofEvent(1.5, 30));
+    compact.addEventQuickly(
+        WeightedEvent(2.5, DateAndTime(int64_t(10)), 2.0, 4.0));
+    TS_ASSERT_EQUALS(compact.getEventType(), WEIGHTED);
+    compact.addEventQuickly(TofEvent(3.5, 20));
+    TS_ASSERT_EQUALS(compact.getNumberEvents(), 3);
+
+    const MantidVec X{1., 2., 3., 4.};
+    MantidVec Y, E;
+    compact.generateHistogram(X, Y, E);
+    TS_ASSERT_EQUALS(compact.getStorageMode(), COMPACT_STORAGE);
+    const MantidVec weightedY{1., 2., 1.};
+    const MantidVec weightedE{1., 2., 1.};
+    TS_ASSERT_EQUALS(Y, weightedY);
+    TS_ASSERT_EQUALS(E, weightedE);
+
+    compact.addEventQuickly(WeightedEventNoTime(1.25, 3.0, 9.0));
+    TS_ASSERT_EQUALS(compact.getEventType(), WEIGHTED_NOTIME);
+    compact.addEventQuickly(TofEvent(2.25, 40));
+    compact.generateHistogram(X, Y, E);
+    TS_ASSERT_EQUALS(compact.getStorageMode(), COMPACT_STORAGE);
+    const MantidVec noTimeY{4., 3., 1.};
+    const MantidVec noTimeE{std::sqrt(10.), std::sqrt(5.), 1.};
+    TS_ASSERT_EQUALS(Y.size(), noTimeY.size());
+    for (size_t i = 0; i < Y.size(); ++i) {
+      TS_ASSERT_DELTA(Y[i], noTimeY[i], 1e-12);
+      TS_ASSERT_DELTA(E[i], noTimeE[i], 1e-12);
+    }
+
+    // Histogramming sorted the events by tof
+    const auto &events = compact.getWeightedEventsNoTime();
+    TS_ASSERT_EQUALS(events.size(), 5);
+    TS_ASSERT_EQUALS(events[0].weight(), 3.0);
+    TS_ASSERT_EQUALS(events[2].tof(), 2.25);
+    TS_ASSERT_EQUALS(events[2].errorSquared(), 1.0);
+    TS_ASSERT_EQUALS(events[3].weight(), 2.0);
+  }
+
   //==================================================================================
   // Mocking functions
   //==================================================================================
@@ -2825,6 +3152,34 @@ public:
     el_sorted_weighted.generateHistogram(coarseX, Y, E);
   }
 
+  void test_histogram_fine_columns() {
+    el_sorted.setStorageMode(COLUMN_STORAGE);
+    el_sorted_weighted.setStorageMode(COLUMN_STORAGE);
+    MantidVec Y, E;
+    el_sorted.generateHistogram(fineX, Y, E);
+    el_sorted_weighted.generateHistogram(fineX, Y, E);
+    el_sorted.setStorageMode(ROW_STORAGE);
+    el_sorted_weighted.setStorageMode(ROW_STORAGE);
+  }
+
+  void test_histogram_fine_without_sort() {
+    el_random.setSortBeforeHistogram(false);
+    MantidVec Y, E;
+    el_random.generateHistogram(fineX, Y, E);
+  }
+
+  void test_histogram_fine_with_sort() {
+    MantidVec Y, E;
+    el_random.generateHistogram(fineX, Y, E);
+  }
+
+  void test_convertTof_columns() {
+    // A copy, so that the shared fixture stays in row storage
+    EventList columns(el_random);
+    columns.setStorageMode(COLUMN_STORAGE);
+    columns.convertTof(2.5, 6.78);
+  }
+
   void test_maskTof() {
     TS_ASSERT_EQUALS(el_sorted.getNumberEvents(), 10000000);
     el_sorted.maskTof(25e3, 75e3);
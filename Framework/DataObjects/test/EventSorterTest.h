@@ -0,0 +1,211 @@
+#ifndef MANTID_DATAOBJECTS_EVENTSORTERTEST_H_
+#define MANTID_DATAOBJECTS_EVENTSORTERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/EventSorter.h"
+
+#include <algorithm>
+#include <random>
+
+using Mantid::DataObjects::CompactEvent;
+using Mantid::DataObjects::EventSorter;
+using Mantid::DataObjects::WeightedEvent;
+using Mantid::DataObjects::WeightedEventNoTime;
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+
+namespace {
+/** Events with random times-of-flight, some negative, and pulse times taken
+ * from a few hundred pulses so that many events share one.
+ */
+std::vector<TofEvent> randomEvents(const size_t numEvents) {
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<double> tof(-1000., 100000.);
+  std::uniform_int_distribution<int64_t> pulse(0, 300);
+  std::vector<TofEvent> events;
+  events.reserve(numEvents);
+  for (size_t i = 0; i < numEvents; ++i)
+    events.emplace_back(tof(generator),
+                        DateAndTime(1000000000000000000 +
+                                    pulse(generator) * 16666667));
+  return events;
+}
+
+std::vector<WeightedEvent> randomWeightedEvents(const size_t numEvents) {
+  std::vector<WeightedEvent> weighted;
+  size_t i = 0;
+  for (const auto &event : randomEvents(numEvents)) {
+    const auto weight = static_cast<float>(i++ % 7);
+    weighted.emplace_back(event.tof(), event.pulseTime(), weight, weight);
+  }
+  return weighted;
+}
+
+template <class T> bool lessTof(const T &lhs, const T &rhs) {
+  return lhs.tof() < rhs.tof();
+}
+
+template <class T> bool lessPulseTime(const T &lhs, const T &rhs) {
+  return lhs.pulseTime() < rhs.pulseTime();
+}
+
+template <class T> bool lessPulseTimeTof(const T &lhs, const T &rhs) {
+  if (lhs.pulseTime() != rhs.pulseTime())
+    return lhs.pulseTime() < rhs.pulseTime();
+  return lhs.tof() < rhs.tof();
+}
+} // namespace
+
+class EventSorterTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventSorterTest *createSuite() { return new EventSorterTest(); }
+  static void destroySuite(EventSorterTest *suite) { delete suite; }
+
+  void test_sortTof_short_list() { checkSortTof(100); }
+
+  void test_sortTof_radix() { checkSortTof(100000); }
+
+  void test_sortTof_parallel() {
+    checkSortTof(EventSorter::PARALLEL_THRESHOLD + 12345);
+  }
+
+  void test_sortTof_single_precision() {
+    // Values read from NeXus files, whose low bytes are all zero
+    auto events = randomEvents(10000);
+    for (auto &event : events)
+      event = TofEvent(static_cast<float>(event.tof()), event.pulseTime());
+    auto expected = events;
+    std::sort(expected.begin(), expected.end(), lessTof<TofEvent>);
+    EventSorter::sortTof(events);
+    TS_ASSERT_EQUALS(events, expected);
+  }
+
+  void test_sortTof_WeightedEventNoTime() {
+    std::vector<WeightedEventNoTime> events;
+    for (const auto &event : randomWeightedEvents(10000))
+      events.emplace_back(event);
+    auto expected = events;
+    std::sort(expected.begin(), expected.end(),
+              lessTof<WeightedEventNoTime>);
+    EventSorter::sortTof(events);
+    TS_ASSERT_EQUALS(events, expected);
+  }
+
+  void test_sortTof_CompactEvent() {
+    std::vector<CompactEvent> events;
+    uint32_t index = 0;
+    for (const auto &event : randomEvents(10000))
+      events.push_back(CompactEvent{static_cast<float>(event.tof()), index++});
+    EventSorter::sortTof(events);
+    TS_ASSERT(std::is_sorted(events.begin(), events.end(),
+                             lessTof<CompactEvent>));
+    // Each event is moved whole
+    for (const auto &event : events)
+      TS_ASSERT_LESS_THAN(event.m_pulseIndex, 10000);
+  }
+
+  void test_sortPulseTime_is_stable() {
+    auto events = randomEvents(100000);
+    auto expected = events;
+    std::stable_sort(expected.begin(), expected.end(),
+                     lessPulseTime<TofEvent>);
+    EventSorter::sortPulseTime(events);
+    TS_ASSERT_EQUALS(events, expected);
+  }
+
+  void test_sortPulseTime_WeightedEvent() {
+    auto events = randomWeightedEvents(100000);
+    auto expected = events;
+    std::stable_sort(expected.begin(), expected.end(),
+                     lessPulseTime<WeightedEvent>);
+    EventSorter::sortPulseTime(events);
+    TS_ASSERT_EQUALS(events, expected);
+  }
+
+  void test_sortPulseTimeTof() {
+    for (const size_t numEvents :
+         {size_t(100), size_t(100000), EventSorter::PARALLEL_THRESHOLD}) {
+      auto events = randomEvents(numEvents);
+      auto expected = events;
+      std::sort(expected.begin(), expected.end(), lessPulseTimeTof<TofEvent>);
+      EventSorter::sortPulseTimeTof(events);
+      TSM_ASSERT(numEvents, events == expected);
+    }
+  }
+
+  void test_sortPulseTimeTof_WeightedEvent() {
+    auto events = randomWeightedEvents(100000);
+    auto expected = events;
+    std::sort(expected.begin(), expected.end(),
+              lessPulseTimeTof<WeightedEvent>);
+    EventSorter::sortPulseTimeTof(events);
+    TS_ASSERT_EQUALS(events, expected);
+  }
+
+  void test_sorted_and_empty_lists() {
+    std::vector<TofEvent> empty;
+    TS_ASSERT_THROWS_NOTHING(EventSorter::sortTof(empty));
+    TS_ASSERT_THROWS_NOTHING(EventSorter::sortPulseTimeTof(empty));
+
+    auto events = randomEvents(10000);
+    std::sort(events.begin(), events.end(), lessTof<TofEvent>);
+    const auto sorted = events;
+    EventSorter::sortTof(events);
+    TS_ASSERT_EQUALS(events, sorted);
+  }
+
+private:
+  void checkSortTof(const size_t numEvents) {
+    auto events = randomEvents(numEvents);
+    auto expected = events;
+    std::sort(expected.begin(), expected.end(), lessTof<TofEvent>);
+    EventSorter::sortTof(events);
+    TS_ASSERT(events == expected);
+
+    auto weighted = randomWeightedEvents(numEvents);
+    auto expectedWeighted = weighted;
+    std::sort(expectedWeighted.begin(), expectedWeighted.end(),
+              lessTof<WeightedEvent>);
+    EventSorter::sortTof(weighted);
+    TS_ASSERT(weighted == expectedWeighted);
+  }
+};
+
+//=============================================================================
+/** Compares the radix sort with std::sort, which EventList used before, for
+ * one very long list of events.
+ */
+class EventSorterTestPerformance : public CxxTest::TestSuite {
+public:
+  static EventSorterTestPerformance *createSuite() {
+    return new EventSorterTestPerformance();
+  }
+  static void destroySuite(EventSorterTestPerformance *suite) {
+    delete suite;
+  }
+
+  EventSorterTestPerformance() : events(randomEvents(20000000)) {}
+
+  void setUp() override { toSort = events; }
+
+  void test_sortTof_std_sort() {
+    std::sort(toSort.begin(), toSort.end(), lessTof<TofEvent>);
+  }
+
+  void test_sortTof() { EventSorter::sortTof(toSort); }
+
+  void test_sortPulseTimeTof_std_sort() {
+    std::sort(toSort.begin(), toSort.end(), lessPulseTimeTof<TofEvent>);
+  }
+
+  void test_sortPulseTimeTof() { EventSorter::sortPulseTimeTof(toSort); }
+
+private:
+  const std::vector<TofEvent> events;
+  std::vector<TofEvent> toSort;
+};
+
+#endif /* MANTID_DATAOBJECTS_EVENTSORTERTEST_H_ */
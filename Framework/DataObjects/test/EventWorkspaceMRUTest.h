@@ -2,12 +2,20 @@
 #define MANTID_DATAOBJECTS_EVENTWORKSPACEMRUTEST_H_
 
 #include <cxxtest/TestSuite.h>
+#include "MantidKernel/make_cow.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/System.h"
 
+#include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
 
+#include <thread>
+
 using namespace Mantid::DataObjects;
+using Mantid::HistogramData::HistogramE;
+using Mantid::HistogramData::HistogramY;
+using Mantid::Kernel::make_cow;
 
 class EventWorkspaceMRUTest : public CxxTest::TestSuite {
 public:
@@ -16,6 +24,150 @@ public:
     TS_ASSERT_THROWS_NOTHING(mru.MRUSize());
     TS_ASSERT_EQUALS(mru.MRUSize(), 0);
   }
+
+  void test_find_and_insert() {
+    EventWorkspaceMRU mru;
+    EventList list;
+    TS_ASSERT(!mru.findY(&list));
+    auto y = make_cow<HistogramY>(10, 1.);
+    auto e = make_cow<HistogramE>(10, 2.);
+    mru.insertY(y, &list);
+    mru.insertE(e, &list);
+    TS_ASSERT_EQUALS(mru.MRUSize(), 1);
+    TS_ASSERT_EQUALS(&mru.findY(&list)->rawData(), &y->rawData());
+    TS_ASSERT_EQUALS(&mru.findE(&list)->rawData(), &e->rawData());
+
+    const auto stats = mru.statistics();
+    TS_ASSERT_EQUALS(stats.hits, 2);
+    TS_ASSERT_EQUALS(stats.misses, 1);
+    TS_ASSERT_EQUALS(stats.evictions, 0);
+    TS_ASSERT_EQUALS(stats.entries, 1);
+    TS_ASSERT_EQUALS(stats.memory, 20 * sizeof(double));
+
+    mru.resetStatistics();
+    TS_ASSERT_EQUALS(mru.statistics().hits, 0);
+    TS_ASSERT_EQUALS(mru.statistics().misses, 0);
+  }
+
+  void test_insert_replaces() {
+    EventWorkspaceMRU mru;
+    EventList list;
+    mru.insertY(make_cow<HistogramY>(10, 1.), &list);
+    mru.insertY(make_cow<HistogramY>(5, 3.), &list);
+    TS_ASSERT_EQUALS(mru.MRUSize(), 1);
+    TS_ASSERT_EQUALS(mru.findY(&list)->size(), 5);
+    TS_ASSERT_EQUALS(mru.statistics().memory, 5 * sizeof(double));
+  }
+
+  void test_deleteIndex_and_clear() {
+    EventWorkspaceMRU mru;
+    std::vector<EventList> lists(10);
+    for (auto &list : lists)
+      mru.insertY(make_cow<HistogramY>(10, 1.), &list);
+    TS_ASSERT_EQUALS(mru.MRUSize(), 10);
+
+    mru.deleteIndex(&lists[3]);
+    TS_ASSERT_EQUALS(mru.MRUSize(), 9);
+    TS_ASSERT(!mru.findY(&lists[3]));
+    TS_ASSERT(mru.findY(&lists[4]));
+    TS_ASSERT_EQUALS(mru.statistics().memory, 90 * sizeof(double));
+
+    mru.clear();
+    TS_ASSERT_EQUALS(mru.MRUSize(), 0);
+    TS_ASSERT_EQUALS(mru.statistics().memory, 0);
+  }
+
+  void test_memory_budget_evicts() {
+    EventWorkspaceMRU mru(0);
+    std::vector<EventList> lists(1000);
+    for (auto &list : lists)
+      mru.insertY(make_cow<HistogramY>(10, 1.), &list);
+
+    // The most recent entry is always kept
+    TS_ASSERT(mru.findY(&lists.back()));
+    const auto stats = mru.statistics();
+    TS_ASSERT_EQUALS(stats.budget, 0);
+    TS_ASSERT_LESS_THAN(stats.entries, lists.size());
+    TS_ASSERT_EQUALS(stats.entries + stats.evictions, lists.size());
+    TS_ASSERT_EQUALS(stats.memory, stats.entries * 10 * sizeof(double));
+  }
+
+  void test_held_histogram_outlives_eviction() {
+    EventWorkspaceMRU mru(0);
+    EventList list;
+    mru.insertY(make_cow<HistogramY>(10, 7.), &list);
+    const HistogramY &held = mru.holdY(mru.findY(&list));
+
+    std::vector<EventList> others(10000);
+    for (auto &other : others)
+      mru.insertY(make_cow<HistogramY>(10, 1.), &other);
+    TS_ASSERT(!mru.findY(&list));
+    TS_ASSERT_EQUALS(held.size(), 10);
+    TS_ASSERT_EQUALS(held.front(), 7.);
+  }
+
+  void test_held_histograms_are_counted() {
+    EventWorkspaceMRU mru;
+    mru.holdY(make_cow<HistogramY>(10, 1.));
+    mru.holdE(make_cow<HistogramE>(5, 1.));
+    TS_ASSERT_EQUALS(mru.statistics().heldMemory, 15 * sizeof(double));
+    // Only the last 50 histograms of each kind are held
+    for (int i = 0; i < 100; ++i)
+      mru.holdY(make_cow<HistogramY>(10, 1.));
+    TS_ASSERT_EQUALS(mru.statistics().heldMemory,
+                     (50 * 10 + 5) * sizeof(double));
+    mru.clear();
+    TS_ASSERT_EQUALS(mru.statistics().heldMemory, 0);
+  }
+
+  void test_held_histograms_take_from_the_budget() {
+    const size_t budget = 50 * 1000 * sizeof(double);
+    EventWorkspaceMRU withHeld(budget);
+    EventWorkspaceMRU withoutHeld(budget);
+    for (int i = 0; i < 50; ++i)
+      withHeld.holdY(make_cow<HistogramY>(1000, 1.));
+    std::vector<EventList> lists(10000);
+    for (auto &list : lists) {
+      withHeld.insertY(make_cow<HistogramY>(10, 1.), &list);
+      withoutHeld.insertY(make_cow<HistogramY>(10, 1.), &list);
+    }
+    TS_ASSERT_LESS_THAN(withHeld.MRUSize(), withoutHeld.MRUSize());
+  }
+
+  void test_held_histograms_of_exited_threads_are_reused() {
+    EventWorkspaceMRU mru;
+    // Each thread gives its worker slot back when it exits, so the next one
+    // takes over its held histograms instead of adding its own
+    for (int i = 0; i < 100; ++i) {
+      std::thread worker([&mru]() { mru.holdY(make_cow<HistogramY>(10, 1.)); });
+      worker.join();
+    }
+    TS_ASSERT_LESS_THAN_EQUALS(mru.statistics().heldMemory,
+                               50 * 10 * sizeof(double));
+  }
+
+  void test_large_budget_keeps_everything() {
+    EventWorkspaceMRU mru(1024 * 1024 * 1024);
+    std::vector<EventList> lists(1000);
+    for (auto &list : lists)
+      mru.insertY(make_cow<HistogramY>(10, 1.), &list);
+    TS_ASSERT_EQUALS(mru.MRUSize(), lists.size());
+    TS_ASSERT_EQUALS(mru.statistics().evictions, 0);
+  }
+
+  void test_concurrent_access() {
+    EventWorkspaceMRU mru;
+    std::vector<EventList> lists(1000);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < static_cast<int>(lists.size()); ++i) {
+      const EventList *list = &lists[i];
+      if (!mru.findY(list))
+        mru.insertY(make_cow<HistogramY>(10, double(i)), list);
+    }
+    TS_ASSERT_EQUALS(mru.MRUSize(), lists.size());
+    for (size_t i = 0; i < lists.size(); ++i)
+      TS_ASSERT_EQUALS(mru.findY(&lists[i])->front(), double(i));
+  }
 };
 
 #endif /* MANTID_DATAOBJECTS_EVENTWORKSPACEMRUTEST_H_ */
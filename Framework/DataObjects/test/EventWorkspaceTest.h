@@ -20,8 +20,10 @@
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/EventWorkspaceMRU.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 #include "MantidTestHelpers/ComponentCreationHelper.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Memory.h"
 #include "MantidKernel/Timer.h"
 #include "PropertyManagerHelper.h"
@@ -342,27 +344,33 @@ public:
     data1 = ew2->dataY(0);
     TS_ASSERT_DELTA(ew2->dataY(0)[1], 2.0, 1e-6);
     TS_ASSERT_DELTA(data1[1], 2.0, 1e-6);
-    // Cache should now be full
-    TS_ASSERT_EQUALS(ew2->MRUSize(), 50);
+    // All are cached: they are well within the default memory budget
+    TS_ASSERT_EQUALS(ew2->MRUSize(), 100);
 
     int last = 100;
     // Read more;
     for (int i = last; i < last + 100; i++)
       data1 = ew2->dataY(i);
-
-    // Cache should now be full still
-    TS_ASSERT_EQUALS(ew2->MRUSize(), 50);
+    TS_ASSERT_EQUALS(ew2->MRUSize(), 200);
 
     // Do it some more
     last = 200;
     for (int i = last; i < last + 100; i++)
       data1 = ew2->dataY(i);
 
+    // Reading cached spectra again only hits the cache
+    const auto before = ew2->getHistogramCacheStatistics();
+    for (int i = 0; i < 300; i++)
+      data1 = ew2->dataY(i);
+    const auto after = ew2->getHistogramCacheStatistics();
+    TS_ASSERT_EQUALS(after.hits - before.hits, 300);
+    TS_ASSERT_EQUALS(after.misses, before.misses);
+    TS_ASSERT_EQUALS(after.evictions, 0);
+
     //----- Now we test that setAllX clears the memory ----
 
-    // Yes, our eventworkspace MRU is full
-    TS_ASSERT_EQUALS(ew->MRUSize(), 50);
-    TS_ASSERT_EQUALS(ew2->MRUSize(), 50);
+    TS_ASSERT_EQUALS(ew->MRUSize(), 300);
+    TS_ASSERT_EQUALS(ew2->MRUSize(), 300);
     ew->setAllX(BinEdges(10, LinearGenerator(0.0, BIN_DELTA)));
 
     // MRU should have been cleared now
@@ -522,29 +530,89 @@ public:
     */
   }
 
+  void test_readY_reference_survives_eviction() {
+    // With no memory budget every part of the cache is always over budget
+    auto &config = ConfigService::Instance();
+    const std::string budgetKey("EventWorkspace.HistogramCache.MaxMemoryMB");
+    const std::string oldBudget = config.getString(budgetKey);
+    config.setString(budgetKey, "0");
+    EventWorkspace_const_sptr ew2 = createEventWorkspace(true, true);
+    config.setString(budgetKey, oldBudget);
+
+    const MantidVec &data0 = ew2->readY(0);
+    const MantidVec &errors0 = ew2->readE(0);
+    // The events of spectrum i start in bin i, so only spectrum 0 has counts
+    // in the first bin
+    TS_ASSERT_EQUALS(data0.front(), 2.0);
+    for (int i = 1; i < 40; i++) {
+      TS_ASSERT_EQUALS(ew2->readY(i).front(), 0.0);
+      TS_ASSERT_EQUALS(ew2->readE(i).front(), 0.0);
+    }
+    TS_ASSERT_LESS_THAN(0, ew2->getHistogramCacheStatistics().evictions);
+    TS_ASSERT_EQUALS(data0.size(), NUMBINS - 1);
+    TS_ASSERT_EQUALS(data0.front(), 2.0);
+    TS_ASSERT_DELTA(errors0.front(), M_SQRT2, 1e-6);
+  }
+
   void test_droppingOffMRU() {
-    // Try caching and most-recently-used MRU list.
-    EventWorkspace_const_sptr ew2 =
-        boost::dynamic_pointer_cast<const EventWorkspace>(ew);
+    // With no memory budget each part of the cache only keeps its most
+    // recently used histograms
+    auto &config = ConfigService::Instance();
+    const std::string budgetKey("EventWorkspace.HistogramCache.MaxMemoryMB");
+    const std::string oldBudget = config.getString(budgetKey);
+    config.setString(budgetKey, "0");
+    EventWorkspace_const_sptr ew2 = createEventWorkspace(true, true);
+    config.setString(budgetKey, oldBudget);
 
-    // OK, we grab data0 from the MRU.
     const auto &inSpec = ew2->getSpectrum(0);
-    const auto &inSpec300 = ew2->getSpectrum(300);
-
-    const MantidVec &data0 = inSpec.readY();
-    const MantidVec &e300 = inSpec300.readE();
-    TS_ASSERT_EQUALS(data0.size(), NUMBINS - 1);
+    TS_ASSERT_EQUALS(inSpec.readY().size(), NUMBINS - 1);
 
-    // Fill up the MRU to make data0 drop off
-    for (size_t i = 0; i < 200; i++)
+    // Fill up the MRU to make histograms drop off
+    for (int i = 0; i < NUMPIXELS; i++)
       MantidVec otherData = ew2->readY(i);
 
-    // data0 and e300 are now invalid references!
-    TS_ASSERT_DIFFERS(&data0, &inSpec.readY());
-    TS_ASSERT_DIFFERS(&e300, &inSpec.readE());
+    const auto stats = ew2->getHistogramCacheStatistics();
+    TS_ASSERT_EQUALS(stats.budget, 0);
+    TS_ASSERT_LESS_THAN(ew2->MRUSize(), NUMPIXELS);
+    TS_ASSERT_EQUALS(stats.entries, ew2->MRUSize());
+    // Every spectrum was cached once, and then either kept or dropped
+    TS_ASSERT_EQUALS(stats.entries + stats.evictions, NUMPIXELS);
+
+    // Dropped histograms are regenerated
+    TS_ASSERT_DELTA(ew2->readY(0)[1], 2.0, 1e-6);
+  }
+
+  void test_setEventStorageMode() {
+    EventWorkspace_sptr ws =
+        WorkspaceCreationHelper::createRandomEventWorkspace(NUMBINS, NUMPIXELS);
+    const auto expectedY = ws->y(0).rawData();
+
+    ws->setEventStorageMode(COLUMN_STORAGE);
+    for (int wi = 0; wi < NUMPIXELS; wi++)
+      TS_ASSERT_EQUALS(ws->getSpectrum(wi).getStorageMode(), COLUMN_STORAGE);
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), NUMBINS * NUMPIXELS);
+    TS_ASSERT_EQUALS(ws->y(0).rawData(), expectedY);
 
-    // MRU is full
-    TS_ASSERT_EQUALS(ew2->MRUSize(), 50);
+    ws->setEventStorageMode(ROW_STORAGE);
+    TS_ASSERT_EQUALS(ws->getSpectrum(0).getStorageMode(), ROW_STORAGE);
+    TS_ASSERT_EQUALS(ws->getSpectrum(0).getEvents().size(), NUMBINS);
+  }
+
+  void test_setSortBeforeHistogram() {
+    EventWorkspace_sptr ws =
+        WorkspaceCreationHelper::createRandomEventWorkspace(NUMBINS, NUMPIXELS);
+    TS_ASSERT(ws->getSortBeforeHistogram());
+    ws->setSortBeforeHistogram(false);
+    TS_ASSERT(!ws->getSortBeforeHistogram());
+    for (int wi = 0; wi < NUMPIXELS; wi++)
+      TS_ASSERT(!ws->getSpectrum(wi).getSortBeforeHistogram());
+
+    ws->y(0);
+    TS_ASSERT(!ws->getSpectrum(0).isSortedByTof());
+
+    auto copy = ws->clone();
+    TS_ASSERT(!copy->getSortBeforeHistogram());
+    TS_ASSERT(!copy->getSpectrum(0).getSortBeforeHistogram());
   }
 
   void test_sortAll_TOF() {
@@ -611,6 +679,32 @@ public:
     }
   }
 
+  /** Lists of very different sizes are all sorted, whatever chunk they are
+   * scheduled in.
+   */
+  void test_sortAll_uneven_lists() {
+    EventWorkspace_sptr test_in =
+        WorkspaceCreationHelper::createRandomEventWorkspace(2, NUMPIXELS);
+    for (int wi = 0; wi < NUMPIXELS; wi += 10) {
+      auto &el = test_in->getSpectrum(wi);
+      for (int i = 0; i < 10 * wi; i++)
+        el += TofEvent(double((i * 7919) % 10007), int64_t(i % 13));
+    }
+
+    test_in->sortAll(PULSETIMETOF_SORT, nullptr);
+
+    for (int wi = 0; wi < NUMPIXELS; wi++) {
+      const auto &el = test_in->getSpectrum(wi);
+      TS_ASSERT_EQUALS(el.getSortType(), PULSETIMETOF_SORT);
+      const auto &ve = el.getEvents();
+      for (size_t i = 0; i + 1 < ve.size(); i++) {
+        TS_ASSERT_LESS_THAN_EQUALS(ve[i].pulseTime(), ve[i + 1].pulseTime());
+        if (ve[i].pulseTime() == ve[i + 1].pulseTime())
+          TS_ASSERT_LESS_THAN_EQUALS(ve[i].tof(), ve[i + 1].tof());
+      }
+    }
+  }
+
   /** Nov 29 2010, ticket #1974
    * SegFault on data access through MRU list.
    * Test that parallelization is thread-safe
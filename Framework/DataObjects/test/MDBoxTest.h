@@ -636,6 +636,28 @@ public:
     b.reserveMemoryForLoad(3);
     TS_ASSERT_EQUALS(b.getEvents().capacity(), 3);
   }
+
+  void test_sortObjByFilePosition() {
+    BoxController_sptr sc(new BoxController(2));
+    std::vector<std::unique_ptr<MDBox<MDLeanEvent<2>, 2>>> boxes;
+    for (size_t i = 0; i < 4; i++) {
+      boxes.emplace_back(new MDBox<MDLeanEvent<2>, 2>(sc.get()));
+      boxes.back()->setID(i);
+    }
+    // Box 2 is only in memory, box 3 has no place on file yet
+    boxes[0]->setFileBacked(200, 10, true);
+    boxes[1]->setFileBacked(100, 10, true);
+    boxes[3]->setFileBacked();
+
+    std::vector<IMDNode *> nodes;
+    for (size_t i = 4; i > 0; i--)
+      nodes.push_back(boxes[i - 1].get());
+    IMDNode::sortObjByFilePosition(nodes);
+    TS_ASSERT_EQUALS(nodes[0]->getID(), 1);
+    TS_ASSERT_EQUALS(nodes[1]->getID(), 0);
+    TS_ASSERT_EQUALS(nodes[2]->getID(), 2);
+    TS_ASSERT_EQUALS(nodes[3]->getID(), 3);
+  }
 };
 
 #endif
@@ -405,6 +405,76 @@ public:
     TS_ASSERT_DELTA(mid_points_vect[10], 1.75, 1e-4);
   }
 
+  //-------------------------------------------------------------------------------------
+  /** Adding in bulk splits the boxes while adding and gives the same boxes,
+   * with the events in the same order, as adding and then splitting */
+  void test_addEventsInBulk_matches_addEvents_and_splitting() {
+    // Clusters of events, so that the boxes are split to different depths
+    boost::mt19937 rng(1234);
+    boost::uniform_real<coord_t> unit(0.f, 1.f);
+    boost::variate_generator<boost::mt19937 &, boost::uniform_real<coord_t>>
+        gen(rng, unit);
+    std::vector<MDLeanEvent<3>> events;
+    for (size_t i = 0; i < 6000; ++i) {
+      const coord_t width = i % 3 == 0 ? 10.f : (i % 3 == 1 ? 2.f : 0.2f);
+      coord_t centers[3];
+      for (auto &center : centers)
+        center = 3.f + width * (gen() - 0.5f) * 0.5f;
+      events.emplace_back(static_cast<float>(i), 1.f, centers);
+    }
+
+    std::vector<MDEventWorkspace3Lean::sptr> workspaces;
+    for (size_t i = 0; i < 2; ++i) {
+      workspaces.push_back(MDEventsTestHelper::makeMDEW<3>(4, 0.0, 10.0, 0));
+      workspaces.back()->getBoxController()->setSplitThreshold(20);
+      workspaces.back()->getBoxController()->setMaxDepth(4);
+    }
+    MDEventWorkspace3Lean::sptr added = workspaces[0];
+    added->addEvents(events);
+    added->splitBox();
+    added->splitAllIfNeeded(nullptr);
+    added->refreshCache();
+
+    // In two batches, the second one extends the boxes of the first one
+    MDEventWorkspace3Lean::sptr bulk = workspaces[1];
+    const std::vector<MDLeanEvent<3>> firstBatch(events.begin(),
+                                                 events.begin() + 1000);
+    const std::vector<MDLeanEvent<3>> secondBatch(events.begin() + 1000,
+                                                  events.end());
+    TS_ASSERT_EQUALS(bulk->addEventsInBulk(firstBatch), firstBatch.size());
+    TS_ASSERT(bulk->isGridBox());
+    TS_ASSERT_EQUALS(bulk->addEventsInBulk(secondBatch), secondBatch.size());
+    bulk->refreshCache();
+
+    TS_ASSERT_EQUALS(bulk->getNPoints(), events.size());
+    TS_ASSERT_EQUALS(bulk->getBoxController()->getTotalNumMDBoxes(),
+                     added->getBoxController()->getTotalNumMDBoxes());
+    std::vector<IMDNode *> addedBoxes;
+    std::vector<IMDNode *> bulkBoxes;
+    added->getBoxes(addedBoxes, 1000, true);
+    bulk->getBoxes(bulkBoxes, 1000, true);
+    TS_ASSERT_LESS_THAN(64, bulkBoxes.size());
+    TS_ASSERT_EQUALS(bulkBoxes.size(), addedBoxes.size());
+    for (size_t i = 0; i < std::min(bulkBoxes.size(), addedBoxes.size()); ++i) {
+      auto addedBox = dynamic_cast<MDBox<MDLeanEvent<3>, 3> *>(addedBoxes[i]);
+      auto bulkBox = dynamic_cast<MDBox<MDLeanEvent<3>, 3> *>(bulkBoxes[i]);
+      TS_ASSERT(addedBox && bulkBox);
+      if (!addedBox || !bulkBox)
+        return;
+      TS_ASSERT_EQUALS(bulkBox->getDepth(), addedBox->getDepth());
+      TS_ASSERT_EQUALS(bulkBox->getExtents(0).getMin(),
+                       addedBox->getExtents(0).getMin());
+      const auto &addedEvents = addedBox->getConstEvents();
+      const auto &bulkEvents = bulkBox->getConstEvents();
+      TS_ASSERT_EQUALS(bulkEvents.size(), addedEvents.size());
+      for (size_t j = 0; j < std::min(bulkEvents.size(), addedEvents.size());
+           ++j)
+        TS_ASSERT_EQUALS(bulkEvents[j].getSignal(), addedEvents[j].getSignal());
+      addedBox->releaseEvents();
+      bulkBox->releaseEvents();
+    }
+  }
+
   //-------------------------------------------------------------------------------------
   /** Get the signal at a given coord or 0 if masked */
   void test_getSignalWithMaskAtCoord() {
@@ -1,6 +1,7 @@
 #ifndef MANTID_DATAOBJECTS_MDHISTOWORKSPACETEST_H_
 #define MANTID_DATAOBJECTS_MDHISTOWORKSPACETEST_H_
 
+#include "MantidAPI/DualNumber.h"
 #include "MantidAPI/IMDIterator.h"
 #include "MantidAPI/IMDWorkspace.h"
 #include "MantidAPI/Sample.h"
@@ -914,6 +915,71 @@ public:
     checkWorkspace(a, 4.0, 16 * 4 * 3. / 4., 1.0);
   }
 
+  //--------------------------------------------------------------------------------------
+  void test_operations_on_a_workspace_split_between_threads() {
+    // 50^3 bins is enough to run on several threads
+    MDHistoWorkspace_sptr a =
+        MDEventsTestHelper::makeFakeMDHistoWorkspace(0.0, 3, 50, 10.0);
+    MDHistoWorkspace_sptr b =
+        MDEventsTestHelper::makeFakeMDHistoWorkspace(0.0, 3, 50, 10.0);
+    const size_t length = a->getNPoints();
+    for (size_t i = 0; i < length; ++i) {
+      a->setSignalAt(i, double(i % 7) + 1.);
+      a->setErrorSquaredAt(i, double(i % 5));
+      b->setSignalAt(i, double(i % 3) + 2.);
+      b->setErrorSquaredAt(i, 1.);
+    }
+    *a /= *b;
+    a->add(1.0, 0.0);
+    for (size_t i = 0; i < length; ++i) {
+      const double num = double(i % 7) + 1.;
+      const double den = double(i % 3) + 2.;
+      const double f = num / den;
+      TS_ASSERT_DELTA(a->getSignalAt(i), f + 1., 1e-12);
+      TS_ASSERT_DELTA(a->getErrorAt(i) * a->getErrorAt(i),
+                      double(i % 5) / (den * den) + f * f / (den * den), 1e-12);
+    }
+    a->lessThan(*b);
+    for (size_t i = 0; i < length; ++i) {
+      const double f = (double(i % 7) + 1.) / (double(i % 3) + 2.) + 1.;
+      TS_ASSERT_EQUALS(a->getSignalAt(i), f < double(i % 3) + 2. ? 1.0 : 0.0);
+    }
+  }
+
+  //--------------------------------------------------------------------------------------
+  void test_setToExpression_matches_the_operations_one_by_one() {
+    MDHistoWorkspace_sptr a = MDEventsTestHelper::makeFakeMDHistoWorkspace(
+        7.0, 2, 5, 10.0, 3.0 /*errorSquared*/);
+    MDHistoWorkspace_sptr b = MDEventsTestHelper::makeFakeMDHistoWorkspace(
+        2.0, 2, 5, 10.0, 2.0 /*errorSquared*/);
+    MDHistoWorkspace_sptr c = MDEventsTestHelper::makeFakeMDHistoWorkspace(
+        4.0, 2, 5, 10.0, 0.5 /*errorSquared*/);
+    MDHistoWorkspace_sptr expected(a->clone());
+    *expected -= *b;
+    *expected /= *c;
+
+    MDHistoWorkspace_sptr out = MDEventsTestHelper::makeFakeMDHistoWorkspace(
+        0.0, 2, 5, 10.0, 0.0 /*errorSquared*/);
+    out->setToExpression<3>({{a.get(), b.get(), c.get()}},
+                            [](const std::array<DualNumber<3>, 3> &x) {
+                              return (x[0] - x[1]) / x[2];
+                            });
+    for (size_t i = 0; i < out->getNPoints(); ++i) {
+      TS_ASSERT_DELTA(out->getSignalAt(i), expected->getSignalAt(i), 1e-14);
+      TS_ASSERT_DELTA(out->getErrorAt(i), expected->getErrorAt(i), 1e-14);
+    }
+  }
+
+  void test_setToExpression_in_place() {
+    MDHistoWorkspace_sptr a = MDEventsTestHelper::makeFakeMDHistoWorkspace(
+        2.0, 2, 5, 10.0, 3.0 /*errorSquared*/);
+    // a * a is exactly correlated, unlike a multiplication by a copy of a
+    a->setToExpression<1>(
+        {{a.get()}},
+        [](const std::array<DualNumber<1>, 1> &x) { return x[0] * x[0]; });
+    checkWorkspace(a, 4.0, 4 * 4 * 3.0, 1.0);
+  }
+
   //--------------------------------------------------------------------------------------
   void test_boolean_and() {
     MDHistoWorkspace_sptr a =
@@ -84,6 +84,9 @@ public:
   const BoundingBox &getBoundingBox() const override {
     return m_shape->getBoundingBox();
   }
+  bool boundingBoxEnclosesObject() const override {
+    return m_shape->boundingBoxEnclosesObject();
+  }
   void getBoundingBox(double &xmax, double &ymax, double &zmax, double &xmin,
                       double &ymin, double &zmin) const override {
     m_shape->getBoundingBox(xmax, ymax, zmax, xmin, ymin, zmin);
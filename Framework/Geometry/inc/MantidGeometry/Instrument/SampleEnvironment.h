@@ -6,6 +6,7 @@
 //------------------------------------------------------------------------------
 #include "MantidGeometry/DllConfig.h"
 #include "MantidGeometry/Instrument/Container.h"
+#include "MantidGeometry/Objects/BoundingVolumeHierarchy.h"
 
 namespace Mantid {
 namespace Kernel {
@@ -69,9 +70,18 @@ public:
   void add(const IObject_const_sptr &component);
 
 private:
+  void buildHierarchy();
+
   std::string m_name;
   // Element zero is always assumed to be the can
   std::vector<IObject_const_sptr> m_components;
+  /// Bounding boxes of the components whose box encloses them, to find
+  /// those a track can hit
+  BoundingVolumeHierarchy m_hierarchy;
+  /// The component index of each item of m_hierarchy
+  std::vector<size_t> m_hierarchyComponents;
+  /// Components whose box is not known to enclose them, tested by every track
+  std::vector<size_t> m_alwaysTested;
 };
 
 // Typedef a unique_ptr
@@ -134,6 +134,9 @@ public:
   /// Does a line intersect the bounding box
   bool doesLineIntersect(const Kernel::V3D &startPoint,
                          const Kernel::V3D &lineDir) const;
+  /// Does a ray starting anywhere intersect the bounding box
+  bool doesRayIntersect(const Kernel::V3D &startPoint,
+                        const Kernel::V3D &direction) const;
   /// Calculate the angular half width from the given point
   double angularWidth(const Kernel::V3D &observer) const;
   /// Check if it is normal axis aligned bounding box or not.
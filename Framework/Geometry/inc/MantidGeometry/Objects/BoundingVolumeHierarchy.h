@@ -0,0 +1,92 @@
+#ifndef MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHY_H_
+#define MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHY_H_
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidGeometry/Objects/BoundingBox.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+class V3D;
+}
+namespace Geometry {
+
+/** BoundingVolumeHierarchy : A binary tree of axis-aligned bounding boxes
+  over a fixed set of items, used to find the few items a ray can hit without
+  testing all of them.
+
+  The items are given by their bounding boxes and are referred to by their
+  index in the vector passed to the constructor. The tree is built once by
+  splitting the items at the median of their centres along the longest axis
+  of the enclosing box, until no more than a given number remain in a node.
+  Items with a null bounding box have an unknown extent: they are reported as
+  candidates for every ray.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_GEOMETRY_DLL BoundingVolumeHierarchy {
+public:
+  BoundingVolumeHierarchy() = default;
+  explicit BoundingVolumeHierarchy(const std::vector<BoundingBox> &boxes,
+                                   const size_t maxItemsPerLeaf = 4);
+
+  /// @return the number of items in the hierarchy
+  size_t size() const { return m_numberOfItems; }
+  /// @return true if the hierarchy holds no items
+  bool empty() const { return m_numberOfItems == 0; }
+  /// @return the number of nodes of the tree
+  size_t numberOfNodes() const { return m_nodes.size(); }
+
+  void intersectingItems(const Kernel::V3D &startPoint,
+                         const Kernel::V3D &direction,
+                         std::vector<size_t> &items) const;
+
+private:
+  /// A node of the tree, either a leaf holding items or a pair of children
+  struct Node {
+    BoundingBox box;
+    /// Index of the first item in m_items (leaves) or of the first child
+    size_t first;
+    /// Number of items; 0 for an inner node
+    size_t count;
+  };
+
+  void build(const size_t node, const std::vector<BoundingBox> &boxes,
+             const size_t begin, const size_t end,
+             const size_t maxItemsPerLeaf);
+
+  size_t m_numberOfItems = 0;
+  /// The nodes, the root first; the children of a node are adjacent
+  std::vector<Node> m_nodes;
+  /// Item indices ordered so that the items of each leaf are contiguous
+  std::vector<size_t> m_items;
+  /// The bounding boxes of the items, in the order of m_items
+  std::vector<BoundingBox> m_boxes;
+  /// Items with an unknown extent
+  std::vector<size_t> m_unbounded;
+};
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHY_H_ */
@@ -156,6 +156,7 @@ public:
 
   /// Return cached value of axis-aligned bounding box
   const BoundingBox &getBoundingBox() const override;
+  bool boundingBoxEnclosesObject() const override;
   /// Define axis-aligned bounding box
   void defineBoundingBox(const double &xMax, const double &yMax,
                          const double &zMax, const double &xMin,
@@ -235,6 +236,9 @@ private:
   std::unique_ptr<Rule> TopRule;
   /// Object's bounding box
   BoundingBox m_boundingBox;
+  /// True if the bounding box is known to enclose the whole object, so that
+  /// tracks missing it can skip the surfaces
+  bool m_boundingBoxEnclosesObject;
   // -- DEPRECATED --
   mutable double AABBxMax,  ///< xmax of Axis aligned bounding box cache
       AABByMax,             ///< ymax of Axis aligned bounding box cache
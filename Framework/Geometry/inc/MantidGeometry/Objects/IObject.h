@@ -73,6 +73,8 @@ public:
                             const Kernel::V3D &scaleFactor) const = 0;
   /// Return cached value of axis-aligned bounding box
   virtual const BoundingBox &getBoundingBox() const = 0;
+  /// Whether a track missing the bounding box is known to miss the object
+  virtual bool boundingBoxEnclosesObject() const = 0;
   /// Calculate (or return cached value of) Axis Aligned Bounding box
   /// (DEPRECATED)
   virtual void getBoundingBox(double &xmax, double &ymax, double &zmax,
@@ -5,6 +5,7 @@
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidGeometry/Objects/BoundingBox.h"
+#include "MantidGeometry/Objects/BoundingVolumeHierarchy.h"
 #include <boost/unordered_map.hpp>
 #include <deque>
 #include <list>
@@ -16,6 +17,7 @@ class V3D;
 }
 namespace Geometry {
 class IComponent;
+class IObjComponent;
 struct Link;
 class Track;
 /// Typedef for object intersections
@@ -69,6 +71,19 @@ private:
   InstrumentRayTracer();
   /// Fire the given track at the instrument
   void fireRay(Track &testRay) const;
+  /// Fire the given track at the components below an assembly
+  void fireRayAtAssembly(const IComponent_const_sptr &assembly,
+                         Track &testRay) const;
+  /// Build the hierarchy of the bounding boxes of the components
+  void buildHierarchy() const;
+
+  /// A component of the instrument that can be traced on its own
+  struct TraceItem {
+    /// The component, kept alive while it is traced
+    IComponent_const_sptr component;
+    /// The component as a physical object; null for an assembly
+    const IObjComponent *object;
+  };
 
   /// Pointer to the instrument
   Instrument_const_sptr m_instrument;
@@ -79,6 +94,12 @@ private:
   mutable boost::unordered_map<IComponent *, BoundingBox> m_boxCache;
   /// Mutex to lock box cache
   mutable std::mutex m_mutex;
+  /// The components looked up through the hierarchy
+  mutable std::vector<TraceItem> m_items;
+  /// Bounding boxes of m_items
+  mutable BoundingVolumeHierarchy m_hierarchy;
+  /// Ensures the hierarchy is built once
+  mutable std::once_flag m_hierarchyBuilt;
 };
 }
 }
@@ -24,7 +24,9 @@ using Kernel::V3D;
  */
 SampleEnvironment::SampleEnvironment(std::string name,
                                      Container_const_sptr container)
-    : m_name(std::move(name)), m_components(1, container) {}
+    : m_name(std::move(name)), m_components(1, container) {
+  buildHierarchy();
+}
 
 /**
  * @return An axis-aligned BoundingBox object that encompasses the whole kit.
@@ -93,8 +95,15 @@ bool SampleEnvironment::isValid(const V3D &point) const {
  */
 int SampleEnvironment::interceptSurfaces(Track &track) const {
   int nsegments(0);
-  for (const auto &component : m_components) {
-    nsegments += component->interceptSurface(track);
+  std::vector<size_t> candidates;
+  m_hierarchy.intersectingItems(track.startPoint(), track.direction(),
+                                candidates);
+  for (const auto item : candidates) {
+    nsegments +=
+        m_components[m_hierarchyComponents[item]]->interceptSurface(track);
+  }
+  for (const auto index : m_alwaysTested) {
+    nsegments += m_components[index]->interceptSurface(track);
   }
   return nsegments;
 }
@@ -104,6 +113,32 @@ int SampleEnvironment::interceptSurfaces(Track &track) const {
  */
 void SampleEnvironment::add(const IObject_const_sptr &component) {
   m_components.emplace_back(component);
+  buildHierarchy();
+}
+
+//------------------------------------------------------------------------------
+// Private methods
+//------------------------------------------------------------------------------
+
+/**
+ * Rebuild the hierarchy of the component bounding boxes. Only components
+ * whose box is known to enclose them go in the hierarchy: a user defined box
+ * may be smaller than the shape, so the other components are tested by every
+ * track.
+ */
+void SampleEnvironment::buildHierarchy() {
+  std::vector<BoundingBox> boxes;
+  m_hierarchyComponents.clear();
+  m_alwaysTested.clear();
+  for (size_t i = 0; i < m_components.size(); ++i) {
+    if (m_components[i]->boundingBoxEnclosesObject()) {
+      boxes.push_back(m_components[i]->getBoundingBox());
+      m_hierarchyComponents.push_back(i);
+    } else {
+      m_alwaysTested.push_back(i);
+    }
+  }
+  m_hierarchy = BoundingVolumeHierarchy(boxes);
 }
 }
 }
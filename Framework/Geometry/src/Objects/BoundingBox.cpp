@@ -5,6 +5,7 @@
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidKernel/Exception.h"
 
+#include <algorithm>
 #include <cfloat>
 
 namespace Mantid {
@@ -125,6 +126,43 @@ bool BoundingBox::doesLineIntersect(const V3D &startPoint,
   return this->isPointInside(startPoint);
 }
 
+/**
+* Does a ray intersect the bounding box. Unlike doesLineIntersect the start
+* point may be anywhere, and the faces of the box are included within the
+* tolerance defined by Mantid::Geometry::Tolerance, so that the test can be
+* used to safely skip objects enclosed by the box.
+* @param startPoint :: The starting point of the ray
+* @param direction :: The direction of the ray
+* @returns True if the ray intersects this bounding box, false otherwise.
+*/
+bool BoundingBox::doesRayIntersect(const V3D &startPoint,
+                                   const V3D &direction) const {
+  if (!this->isAxisAligned()) {
+    throw(Kernel::Exception::NotImplementedError(
+        "this function has not been modified properly"));
+  }
+  // Clip the ray to the slab between each pair of faces in turn
+  double tMin(0.0), tMax(DBL_MAX);
+  for (size_t i = 0; i < 3; ++i) {
+    const double lower = m_minPoint[i] - Kernel::Tolerance;
+    const double upper = m_maxPoint[i] + Kernel::Tolerance;
+    if (direction[i] == 0.0) {
+      if (startPoint[i] < lower || startPoint[i] > upper)
+        return false;
+      continue;
+    }
+    double t1 = (lower - startPoint[i]) / direction[i];
+    double t2 = (upper - startPoint[i]) / direction[i];
+    if (t1 > t2)
+      std::swap(t1, t2);
+    tMin = std::max(tMin, t1);
+    tMax = std::min(tMax, t2);
+    if (tMin > tMax)
+      return false;
+  }
+  return true;
+}
+
 /**
  * Find maximum angular half width of the bounding box from the observer, that
  * is
@@ -0,0 +1,107 @@
+#include "MantidGeometry/Objects/BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace Geometry {
+
+using Kernel::V3D;
+
+/** Build the hierarchy
+ * @param boxes :: the bounding boxes of the items
+ * @param maxItemsPerLeaf :: nodes with more items than this are split
+ */
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(
+    const std::vector<BoundingBox> &boxes, const size_t maxItemsPerLeaf)
+    : m_numberOfItems(boxes.size()) {
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    if (boxes[i].isNull())
+      m_unbounded.push_back(i);
+    else
+      m_items.push_back(i);
+  }
+  if (m_items.empty())
+    return;
+  m_nodes.reserve(2 * m_items.size());
+  m_nodes.push_back(Node());
+  build(0, boxes, 0, m_items.size(), std::max(maxItemsPerLeaf, size_t(1)));
+  m_boxes.reserve(m_items.size());
+  for (const auto item : m_items)
+    m_boxes.push_back(boxes[item]);
+}
+
+/** Fill in a node and, if it holds too many items, its descendants
+ * @param node :: index of the node in m_nodes
+ * @param boxes :: the bounding boxes of the items
+ * @param begin :: first position in m_items of the node's items
+ * @param end :: one past the last position in m_items of the node's items
+ * @param maxItemsPerLeaf :: nodes with more items than this are split
+ */
+void BoundingVolumeHierarchy::build(const size_t node,
+                                    const std::vector<BoundingBox> &boxes,
+                                    const size_t begin, const size_t end,
+                                    const size_t maxItemsPerLeaf) {
+  BoundingBox box = boxes[m_items[begin]];
+  for (size_t i = begin + 1; i < end; ++i)
+    box.grow(boxes[m_items[i]]);
+  m_nodes[node].box = box;
+  if (end - begin <= maxItemsPerLeaf) {
+    m_nodes[node].first = begin;
+    m_nodes[node].count = end - begin;
+    return;
+  }
+
+  // Split at the median centre along the longest axis of the node
+  const V3D width = box.width();
+  size_t axis = width.X() >= width.Y() ? 0 : 1;
+  if (width.Z() > width[axis])
+    axis = 2;
+  const size_t middle = begin + (end - begin) / 2;
+  std::nth_element(m_items.begin() + begin, m_items.begin() + middle,
+                   m_items.begin() + end,
+                   [&boxes, axis](const size_t a, const size_t b) {
+                     return boxes[a].centrePoint()[axis] <
+                            boxes[b].centrePoint()[axis];
+                   });
+  const size_t left = m_nodes.size();
+  m_nodes[node].first = left;
+  m_nodes[node].count = 0;
+  m_nodes.push_back(Node());
+  m_nodes.push_back(Node());
+  build(left, boxes, begin, middle, maxItemsPerLeaf);
+  build(left + 1, boxes, middle, end, maxItemsPerLeaf);
+}
+
+/** Find the items whose bounding boxes a ray may intersect. Items without a
+ * bounding box are always included.
+ * @param startPoint :: the starting point of the ray
+ * @param direction :: the direction of the ray
+ * @param items :: on exit the indices of the items, in increasing order
+ */
+void BoundingVolumeHierarchy::intersectingItems(
+    const V3D &startPoint, const V3D &direction,
+    std::vector<size_t> &items) const {
+  items = m_unbounded;
+  if (m_nodes.empty())
+    return;
+  std::vector<size_t> stack(1, 0);
+  while (!stack.empty()) {
+    const Node &node = m_nodes[stack.back()];
+    stack.pop_back();
+    if (!node.box.doesRayIntersect(startPoint, direction))
+      continue;
+    if (node.count > 0) {
+      for (size_t i = node.first; i < node.first + node.count; ++i) {
+        if (m_boxes[i].doesRayIntersect(startPoint, direction))
+          items.push_back(m_items[i]);
+      }
+    } else {
+      stack.push_back(node.first);
+      stack.push_back(node.first + 1);
+    }
+  }
+  std::sort(items.begin(), items.end());
+}
+
+} // namespace Geometry
+} // namespace Mantid
@@ -53,9 +53,10 @@ CSGObject::CSGObject() : CSGObject("") {}
 *  @param shapeXML : string with original shape xml.
 */
 CSGObject::CSGObject(const std::string &shapeXML)
-    : TopRule(nullptr), m_boundingBox(), AABBxMax(0), AABByMax(0), AABBzMax(0),
-      AABBxMin(0), AABByMin(0), AABBzMin(0), boolBounded(false), ObjNum(0),
-      m_handler(), bGeometryCaching(false),
+    : TopRule(nullptr), m_boundingBox(), m_boundingBoxEnclosesObject(false),
+      AABBxMax(0), AABByMax(0), AABBzMax(0), AABBxMin(0), AABByMin(0),
+      AABBzMin(0), boolBounded(false), ObjNum(0), m_handler(),
+      bGeometryCaching(false),
       vtkCacheReader(boost::shared_ptr<vtkGeometryCacheReader>()),
       vtkCacheWriter(boost::shared_ptr<vtkGeometryCacheWriter>()),
       m_shapeXML(shapeXML), m_id(), m_material() // empty by default
@@ -754,6 +755,11 @@ int CSGObject::procString(const std::string &Line) {
 * @return Number of segments added
 */
 int CSGObject::interceptSurface(Geometry::Track &UT) const {
+  // A track that misses a box known to enclose the object cannot intercept
+  // any of its surfaces
+  if (boundingBoxEnclosesObject() &&
+      !m_boundingBox.doesRayIntersect(UT.startPoint(), UT.direction()))
+    return 0;
   int cnt = UT.count(); // Number of intersections original track
   // Loop over all the surfaces.
   LineIntersectVisit LI(UT.startPoint(), UT.direction());
@@ -1632,6 +1638,15 @@ double CSGObject::singleShotMonteCarloVolume(const int shotSize,
   return ratio * boundingVolume;
 }
 
+/**
+ * A box defined by the user or the fallback box may be smaller than the
+ * shape. Only boxes derived from the rules or the exact geometry enclose it.
+ * @return true if the bounding box is known to enclose the whole object
+ */
+bool CSGObject::boundingBoxEnclosesObject() const {
+  return getBoundingBox().isNonNull() && m_boundingBoxEnclosesObject;
+}
+
 /**
 * Returns an axis-aligned bounding box that will fit the shape
 * @returns A reference to a bounding box for this shape.
@@ -1704,6 +1719,8 @@ void CSGObject::calcBoundingBoxByRule() {
       maxZ < big && minX <= maxX && minY <= maxY && minZ <= maxZ) {
     // Values make sense, cache and return bounding box
     defineBoundingBox(maxX, maxY, maxZ, minX, minY, minZ);
+    // The rules only ever overestimate the extent of the shape
+    m_boundingBoxEnclosesObject = true;
   }
 }
 
@@ -1872,6 +1889,7 @@ void CSGObject::calcBoundingBoxByGeometry() {
 
   // Store bounding box in cache
   defineBoundingBox(maxX, maxY, maxZ, minX, minY, minZ);
+  m_boundingBoxEnclosesObject = true;
 }
 
 /**
@@ -1934,6 +1952,8 @@ void CSGObject::defineBoundingBox(const double &xMax, const double &yMax,
                                   const double &yMin, const double &zMin) {
   BoundingBox::checkValid(xMax, yMax, zMax, xMin, yMin, zMin);
 
+  // Nothing is known about how a user defined box relates to the shape
+  m_boundingBoxEnclosesObject = false;
   AABBxMax = xMax;
   AABByMax = yMax;
   AABBzMax = zMax;
@@ -1950,7 +1970,10 @@ void CSGObject::defineBoundingBox(const double &xMax, const double &yMax,
 /**
 * Set the bounding box to a null box
 */
-void CSGObject::setNullBoundingBox() { m_boundingBox = BoundingBox(); }
+void CSGObject::setNullBoundingBox() {
+  m_boundingBox = BoundingBox();
+  m_boundingBoxEnclosesObject = false;
+}
 
 /**
 Try to find a point that lies within (or on) the object
@@ -5,10 +5,13 @@
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidGeometry/Instrument/InstrumentVisitor.h"
 #include "MantidGeometry/IComponent.h"
+#include "MantidGeometry/IObjComponent.h"
+#include "MantidGeometry/Instrument/CompAssembly.h"
 #include "MantidKernel/V3D.h"
 #include "MantidKernel/Exception.h"
 #include <deque>
 #include <iterator>
+#include <typeinfo>
 
 namespace Mantid {
 namespace Geometry {
@@ -111,20 +114,43 @@ IDetector_const_sptr InstrumentRayTracer::getDetectorResult() const {
 // Private member functions
 //-------------------------------------------------------------
 /**
- * Fire the test ray at the instrument and perform a bread-first search of the
- * object tree to find the objects that were intersected.
+ * Fire the test ray at the instrument. The bounding volume hierarchy gives the
+ * physical objects and specialised assemblies the ray may hit, which are then
+ * tested properly.
  * @param testRay :: An input/output parameter that defines the track and
  * accumulates the
  *        intersection results
  */
 void InstrumentRayTracer::fireRay(Track &testRay) const {
+  std::call_once(m_hierarchyBuilt, [this]() { buildHierarchy(); });
+  std::vector<size_t> candidates;
+  m_hierarchy.intersectingItems(testRay.startPoint(), testRay.direction(),
+                                candidates);
+  for (const auto index : candidates) {
+    const auto &item = m_items[index];
+    if (item.object)
+      item.object->interceptSurface(testRay);
+    else
+      fireRayAtAssembly(item.component, testRay);
+  }
+}
+
+/**
+ * Fire the test ray at an assembly and perform a bread-first search of the
+ * object tree below it to find the objects that were intersected.
+ * @param assembly :: The root of the search
+ * @param testRay :: An input/output parameter that defines the track and
+ * accumulates the intersection results
+ */
+void InstrumentRayTracer::fireRayAtAssembly(
+    const IComponent_const_sptr &assembly, Track &testRay) const {
   // Go through the instrument tree and see if we get any hits by
   // (a) first testing the bounding box and if we're inside that then
   // (b) test the lower components.
   std::deque<IComponent_const_sptr> nodeQueue;
 
   // Start at the root of the tree
-  nodeQueue.push_back(m_instrument);
+  nodeQueue.push_back(assembly);
 
   IComponent_const_sptr node;
   while (!nodeQueue.empty()) {
@@ -153,6 +179,40 @@ void InstrumentRayTracer::fireRay(Track &testRay) const {
   }
 }
 
+/**
+ * Flatten the instrument tree into the components that are traced on their
+ * own and build the hierarchy of their bounding boxes. Plain assemblies are
+ * replaced by their children. Assemblies with their own intersection test,
+ * such as rectangular detectors, are kept whole and searched with
+ * fireRayAtAssembly.
+ */
+void InstrumentRayTracer::buildHierarchy() const {
+  std::vector<BoundingBox> boxes;
+  std::deque<IComponent_const_sptr> nodeQueue(1, m_instrument);
+  while (!nodeQueue.empty()) {
+    const auto node = nodeQueue.front();
+    nodeQueue.pop_front();
+    if (auto assembly =
+            boost::dynamic_pointer_cast<const ICompAssembly>(node)) {
+      const auto &type = typeid(*assembly);
+      if (type == typeid(CompAssembly) || type == typeid(Instrument)) {
+        for (int i = 0; i < assembly->nelements(); ++i)
+          nodeQueue.push_back(assembly->getChild(i));
+        continue;
+      }
+      m_items.push_back(TraceItem{node, nullptr});
+    } else if (auto object = dynamic_cast<const IObjComponent *>(node.get())) {
+      m_items.push_back(TraceItem{node, object});
+    } else {
+      continue;
+    }
+    BoundingBox box;
+    node->getBoundingBox(box);
+    boxes.push_back(box);
+  }
+  m_hierarchy = BoundingVolumeHierarchy(boxes);
+}
+
 ///**
 // * Perform a quick check as to whether the ray passes through the component
 // * @param component :: The test component
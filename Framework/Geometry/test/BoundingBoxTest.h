@@ -156,6 +156,22 @@ public:
                      false);
   }
 
+  void test_That_A_Ray_Hits_Faces_And_Misses_Behind_Its_Start() {
+    BoundingBox bbox(4.1, 4.1, 4.1, -4.1, -4.1, -4.1);
+    // Starting inside
+    TS_ASSERT(bbox.doesRayIntersect(V3D(1.0, 0.0, 0.0), V3D(0.0, 1.0, 0.0)));
+    // Pointing towards and away from the box
+    TS_ASSERT(bbox.doesRayIntersect(V3D(-6.0, 0.0, 0.0), V3D(1.0, 0.0, 0.0)));
+    TS_ASSERT(!bbox.doesRayIntersect(V3D(-6.0, 0.0, 0.0), V3D(-1.0, 0.0, 0.0)));
+    // Grazing a face counts as a hit
+    TS_ASSERT(bbox.doesRayIntersect(V3D(-6.0, 4.1, 0.0), V3D(1.0, 0.0, 0.0)));
+    TS_ASSERT(!bbox.doesRayIntersect(V3D(-6.0, 4.2, 0.0), V3D(1.0, 0.0, 0.0)));
+    // Diagonals
+    const V3D corner(10.0, 10.0, 0.0);
+    TS_ASSERT(bbox.doesRayIntersect(corner, V3D(-1.0, -0.8, 0.0)));
+    TS_ASSERT(!bbox.doesRayIntersect(corner, V3D(-1.0, -0.4, 0.0)));
+  }
+
   void test_That_Angular_Width_From_Point_Outside_Bounding_Box_Is_Valid() {
     BoundingBox bbox(4.1, 4.1, 4.1, -4.1, -4.1, -4.1);
 
@@ -0,0 +1,246 @@
+#ifndef MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHYTEST_H_
+#define MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHYTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Instrument/Container.h"
+#include "MantidGeometry/Instrument/SampleEnvironment.h"
+#include "MantidGeometry/Objects/BoundingVolumeHierarchy.h"
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/ShapeFactory.h"
+#include "MantidGeometry/Objects/Track.h"
+#include "MantidKernel/MersenneTwister.h"
+#include "MantidKernel/Timer.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+
+#include <boost/make_shared.hpp>
+
+#include <iostream>
+#include <sstream>
+
+using Mantid::Geometry::BoundingBox;
+using Mantid::Geometry::BoundingVolumeHierarchy;
+using Mantid::Kernel::V3D;
+
+namespace {
+/// A cube of unit boxes with gaps between them
+std::vector<BoundingBox> makeGridOfBoxes(const size_t n) {
+  std::vector<BoundingBox> boxes;
+  for (size_t i = 0; i < n; ++i)
+    for (size_t j = 0; j < n; ++j)
+      for (size_t k = 0; k < n; ++k)
+        boxes.emplace_back(2. * i + 1., 2. * j + 1., 2. * k + 1., 2. * i,
+                           2. * j, 2. * k);
+  return boxes;
+}
+
+/// @return a random unit vector
+V3D randomDirection(Mantid::Kernel::MersenneTwister &rng) {
+  V3D direction;
+  do {
+    direction = V3D(rng.nextValue(), rng.nextValue(), rng.nextValue());
+  } while (direction.norm2() > 1. || direction.norm2() < 1e-6);
+  direction.normalize();
+  return direction;
+}
+
+/// XML for a vertical cylindrical shell centred on the origin
+std::string annulusXML(const double innerRadius, const double outerRadius,
+                       const double height, const std::string &id) {
+  std::ostringstream xml;
+  for (const auto &part : {std::make_pair(std::string("outer"), outerRadius),
+                           std::make_pair(std::string("inner"), innerRadius)}) {
+    xml << "<cylinder id=\"" << id << "-" << part.first << "\">"
+        << "<centre-of-bottom-base x=\"0\" y=\"" << -0.5 * height
+        << "\" z=\"0\"/><axis x=\"0\" y=\"1\" z=\"0\"/>"
+        << "<radius val=\"" << part.second << "\"/>"
+        << "<height val=\"" << height << "\"/></cylinder>";
+  }
+  xml << "<algebra val=\"" << id << "-outer (# " << id << "-inner)\"/>";
+  return xml.str();
+}
+} // namespace
+
+class BoundingVolumeHierarchyTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BoundingVolumeHierarchyTest *createSuite() {
+    return new BoundingVolumeHierarchyTest();
+  }
+  static void destroySuite(BoundingVolumeHierarchyTest *suite) {
+    delete suite;
+  }
+
+  void test_empty_hierarchy_has_no_items() {
+    BoundingVolumeHierarchy hierarchy;
+    TS_ASSERT(hierarchy.empty());
+    std::vector<size_t> items(1, 3);
+    hierarchy.intersectingItems(V3D(), V3D(1, 0, 0), items);
+    TS_ASSERT(items.empty());
+  }
+
+  void test_items_without_a_box_are_always_candidates() {
+    std::vector<BoundingBox> boxes(2);
+    boxes.emplace_back(1., 1., 1., 0., 0., 0.);
+    BoundingVolumeHierarchy hierarchy(boxes);
+    TS_ASSERT_EQUALS(hierarchy.size(), 3);
+    std::vector<size_t> items;
+    hierarchy.intersectingItems(V3D(5, 5, 5), V3D(1, 0, 0), items);
+    TS_ASSERT_EQUALS(items, std::vector<size_t>({0, 1}));
+    hierarchy.intersectingItems(V3D(-1, 0.5, 0.5), V3D(1, 0, 0), items);
+    TS_ASSERT_EQUALS(items, std::vector<size_t>({0, 1, 2}));
+  }
+
+  void test_ray_along_a_row_finds_the_row_in_order() {
+    const size_t n = 10;
+    BoundingVolumeHierarchy hierarchy(makeGridOfBoxes(n), 2);
+    TS_ASSERT_EQUALS(hierarchy.size(), n * n * n);
+    TS_ASSERT_LESS_THAN(1, hierarchy.numberOfNodes());
+    std::vector<size_t> items;
+    // The row with j = 3, k = 4, starting inside the third box
+    hierarchy.intersectingItems(V3D(4.5, 6.5, 8.5), V3D(1, 0, 0), items);
+    std::vector<size_t> expected;
+    for (size_t i = 2; i < n; ++i)
+      expected.push_back(i * n * n + 3 * n + 4);
+    TS_ASSERT_EQUALS(items, expected);
+    // Through the gaps
+    hierarchy.intersectingItems(V3D(-1, 1.5, 1.5), V3D(1, 0, 0), items);
+    TS_ASSERT(items.empty());
+  }
+
+  void test_matches_testing_every_box() {
+    const auto boxes = makeGridOfBoxes(8);
+    BoundingVolumeHierarchy hierarchy(boxes);
+    Mantid::Kernel::MersenneTwister rng(12345, -1., 1.);
+    std::vector<size_t> items;
+    for (int i = 0; i < 200; ++i) {
+      const V3D start(10. + 12. * rng.nextValue(), 10. + 12. * rng.nextValue(),
+                      10. + 12. * rng.nextValue());
+      const V3D direction = randomDirection(rng);
+      std::vector<size_t> expected;
+      for (size_t j = 0; j < boxes.size(); ++j) {
+        if (boxes[j].doesRayIntersect(start, direction))
+          expected.push_back(j);
+      }
+      hierarchy.intersectingItems(start, direction, items);
+      TS_ASSERT_EQUALS(items, expected);
+    }
+  }
+
+  void test_SampleEnvironment_only_skips_components_a_track_misses() {
+    using namespace Mantid::Geometry;
+    ShapeFactory factory;
+    auto can = boost::make_shared<Container>(
+        factory.createShape(annulusXML(0.004, 0.0045, 0.04, "can")));
+    SampleEnvironment kit("TestKit", can);
+    kit.add(ComponentCreationHelper::createSphere(0.001, V3D(0.05, 0, 0)));
+    kit.add(ComponentCreationHelper::createSphere(0.001, V3D(-0.05, 0, 0)));
+
+    Track ray(V3D(0., 0., 0.), V3D(1., 0., 0.));
+    TS_ASSERT_EQUALS(kit.interceptSurfaces(ray), 2);
+    Track missed(V3D(0., 0.03, 0.), V3D(1., 0., 0.));
+    TS_ASSERT_EQUALS(kit.interceptSurfaces(missed), 0);
+  }
+
+  void test_SampleEnvironment_tests_components_with_a_user_defined_box() {
+    using namespace Mantid::Geometry;
+    ShapeFactory factory;
+    auto can = boost::make_shared<Container>(
+        factory.createShape(annulusXML(0.004, 0.0045, 0.04, "can")));
+    SampleEnvironment kit("TestKit", can);
+    // A box that does not hold the sphere says nothing about where it is
+    auto sphere = boost::dynamic_pointer_cast<CSGObject>(
+        ComponentCreationHelper::createSphere(0.001, V3D(0.05, 0, 0)));
+    sphere->defineBoundingBox(0.061, 0.011, 0.001, 0.06, 0.01, 0.);
+    TS_ASSERT(!sphere->boundingBoxEnclosesObject());
+    kit.add(sphere);
+
+    Track ray(V3D(0., 0., 0.), V3D(1., 0., 0.));
+    TS_ASSERT_EQUALS(kit.interceptSurfaces(ray), 2);
+  }
+};
+
+/** Reports the number of tracks traced per second through a sample in a
+ * cylinder, a can in a can and a sample environment with heat shields and
+ * supports, for tracks scattered from within the sample.
+ */
+class BoundingVolumeHierarchyTestPerformance : public CxxTest::TestSuite {
+public:
+  static BoundingVolumeHierarchyTestPerformance *createSuite() {
+    return new BoundingVolumeHierarchyTestPerformance();
+  }
+  static void destroySuite(BoundingVolumeHierarchyTestPerformance *suite) {
+    delete suite;
+  }
+
+  void test_cylinder() {
+    const auto cylinder = ComponentCreationHelper::createCappedCylinder(
+        0.004, 0.04, V3D(0., -0.02, 0.), V3D(0., 1., 0.), "cyl");
+    run("Cylinder", [&cylinder](Mantid::Geometry::Track &track) {
+      return cylinder->interceptSurface(track);
+    });
+  }
+
+  void test_can_in_can() {
+    auto kit = makeEnvironment(false);
+    run("Can in can", [&kit](Mantid::Geometry::Track &track) {
+      return kit->interceptSurfaces(track);
+    });
+  }
+
+  void test_sample_environment() {
+    auto kit = makeEnvironment(true);
+    run("Sample environment", [&kit](Mantid::Geometry::Track &track) {
+      return kit->interceptSurfaces(track);
+    });
+  }
+
+private:
+  template <typename Tracer>
+  void run(const std::string &name, const Tracer &tracer) {
+    const int numberOfTracks = 200000;
+    Mantid::Kernel::MersenneTwister rng(54321, -1., 1.);
+    int segments(0);
+    Mantid::Kernel::Timer timer;
+    for (int i = 0; i < numberOfTracks; ++i) {
+      const V3D start(0.003 * rng.nextValue(), 0.015 * rng.nextValue(), 0.);
+      Mantid::Geometry::Track track(start, randomDirection(rng));
+      segments += tracer(track);
+    }
+    const double elapsed = timer.elapsed();
+    TS_ASSERT_LESS_THAN(0, segments);
+    std::cout << '\n' << name << ": " << numberOfTracks / elapsed
+              << " tracks/s\n";
+  }
+
+  /// Sample can inside an outer can, optionally within shields and supports
+  boost::shared_ptr<Mantid::Geometry::SampleEnvironment>
+  makeEnvironment(const bool full) {
+    using namespace Mantid::Geometry;
+    ShapeFactory factory;
+    auto can = boost::make_shared<Container>(
+        factory.createShape(annulusXML(0.004, 0.0045, 0.04, "can")));
+    auto kit = boost::make_shared<SampleEnvironment>("TestKit", can);
+    kit->add(factory.createShape(annulusXML(0.006, 0.0065, 0.05, "outer")));
+    if (!full)
+      return kit;
+    for (int i = 0; i < 6; ++i) {
+      const double radius = 0.02 + 0.015 * i;
+      const double height = 0.1 + 0.02 * i;
+      kit->add(factory.createShape(annulusXML(radius, radius + 0.001, height,
+                                              "shield" + std::to_string(i))));
+    }
+    // Supports beneath the sample, off the beam axis
+    for (int i = 0; i < 8; ++i) {
+      const double x = 0.01 * (i % 4) - 0.015;
+      const double z = i < 4 ? -0.012 : 0.012;
+      kit->add(ComponentCreationHelper::createCappedCylinder(
+          0.001, 0.02, V3D(x, -0.05, z), V3D(0., 1., 0.),
+          "support" + std::to_string(i)));
+    }
+    return kit;
+  }
+};
+
+#endif /* MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHYTEST_H_ */
@@ -10,11 +10,14 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #endif
+#include <condition_variable>
 #include <cstdint>
+#include <exception>
 #include <limits>
 #include <list>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace Mantid {
@@ -30,7 +33,28 @@ class ISaveable;
   store boxes (lists of events) before writing them out.
 
   It also stores a list of "free" blocks in the output file,
-  to allow new blocks to fill them later.
+  to allow new blocks to fill them later. The free blocks are segregated by
+  size class (see FreeBlock::sizeClass), with a bit set for each class that
+  holds blocks, so that allocating space takes a fixed number of steps
+  however many free blocks there are. Freed blocks are merged with their
+  neighbours straight away, which keeps the file compact.
+
+  The objects are written without holding the lock on the to-write buffer,
+  so that other threads can keep adding objects meanwhile. Only one thread
+  writes at a time: a thread that fills the buffer while another one is
+  writing leaves the objects to that thread, unless the buffer has grown to
+  twice its size.
+
+  With setWriteBehind(true) the buffer is written out by a thread of its own,
+  started when it is first needed, and the thread that fills the buffer goes
+  on without waiting for the I/O. The buffer stays bounded: a thread that
+  finds it at twice its size writes it out itself, after the write-behind
+  thread is done. An error of the write-behind thread is thrown by the next
+  flushCache().
+
+  Algorithms that load many boxes sort them by file position
+  (IMDNode::sortObjByFilePosition) so that the reads are sequential and the
+  read-ahead of the operating system takes effect.
 
   @date 2011-12-30
 
@@ -59,7 +83,7 @@ class DLLExport DiskBuffer {
 public:
   /** A map for the list of free space blocks in the file.
    * Index 1: Position in the file.
-   * Index 2: Size of the free block
+   * Index 2: Size class of the free block
    */
   typedef boost::multi_index::multi_index_container<
       FreeBlock,
@@ -67,23 +91,31 @@ public:
           boost::multi_index::ordered_non_unique<
               BOOST_MULTI_INDEX_CONST_MEM_FUN(FreeBlock, uint64_t,
                                               getFilePosition)>,
-          boost::multi_index::ordered_non_unique<
-              BOOST_MULTI_INDEX_CONST_MEM_FUN(FreeBlock, uint64_t, getSize)>>>
+          boost::multi_index::hashed_non_unique<
+              BOOST_MULTI_INDEX_CONST_MEM_FUN(FreeBlock, size_t,
+                                              getSizeClass)>>>
       freeSpace_t;
 
-  /// A way to index the free space by their size
-  typedef freeSpace_t::nth_index<1>::type freeSpace_bySize_t;
+  /// A way to index the free space by their size class
+  typedef freeSpace_t::nth_index<1>::type freeSpace_bySizeClass_t;
 
   DiskBuffer();
   DiskBuffer(uint64_t m_writeBufferSize);
   DiskBuffer(const DiskBuffer &) = delete;
   DiskBuffer &operator=(const DiskBuffer &) = delete;
-  virtual ~DiskBuffer() = default;
+  virtual ~DiskBuffer();
 
   void toWrite(ISaveable *item);
   void flushCache();
   void objectDeleted(ISaveable *item);
 
+  void setWriteBehind(const bool writeBehind);
+  /// @return true if the to-write buffer is written out on a thread of its own
+  bool getWriteBehind() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_writeBehind;
+  }
+
   // Free space map methods
   void freeBlock(uint64_t const pos, uint64_t const size);
   void defragFreeBlocks();
@@ -114,7 +146,22 @@ public:
   uint64_t getWriteBufferSize() const { return m_writeBufferSize; }
 
   ///@return the memory used in the "toWrite" buffer, in number of events
-  uint64_t getWriteBufferUsed() const { return m_writeBufferUsed; }
+  uint64_t getWriteBufferUsed() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_writeBufferUsed;
+  }
+
+  ///@return the total size of the free blocks in the file
+  uint64_t getFreeSpaceSize() const {
+    std::lock_guard<std::mutex> lock(m_freeMutex);
+    return m_freeSpaceSize;
+  }
+
+  ///@return the number of free blocks in the file
+  size_t getNumFreeBlocks() const {
+    std::lock_guard<std::mutex> lock(m_freeMutex);
+    return m_free.size();
+  }
 
   //-------------------------------------------------------------------------------------------
   ///@return reference to the free space map (for testing only!)
@@ -123,17 +170,34 @@ public:
   //-------------------------------------------------------------------------------------------
   ///@return the position of the last allocated point in the file (for testing
   /// only!)
-  uint64_t getFileLength() const { return m_fileLength; }
+  uint64_t getFileLength() const {
+    std::lock_guard<std::mutex> lock(m_freeMutex);
+    return m_fileLength;
+  }
 
   /** Set the length of the file that this MRU writes to.
    * @param length :: length in the same units as the cache, etc. (not
    * necessarily bytes)  */
-  void setFileLength(const uint64_t length) const { m_fileLength = length; }
+  void setFileLength(const uint64_t length) const {
+    std::lock_guard<std::mutex> lock(m_freeMutex);
+    m_fileLength = length;
+  }
 
   //-------------------------------------------------------------------------------------------
 
 protected:
-  inline void writeOldObjects();
+  void writeOldObjects();
+  void writeObject(ISaveable *obj);
+  void writeBehindLoop();
+  void stopWriteBehind();
+
+  // Free space map changes, which keep the size classes up to date.
+  // m_freeMutex must be held.
+  freeSpace_t::iterator insertFreeBlock(const FreeBlock &block);
+  void eraseFreeBlock(freeSpace_t::iterator it);
+  void replaceFreeBlock(freeSpace_t::iterator it, const FreeBlock &block);
+  void countFreeBlock(const FreeBlock &block, const bool added);
+  size_t findSizeClass(const size_t sizeClass) const;
 
   // ----------------------- To-write buffer
   // --------------------------------------
@@ -151,18 +215,48 @@ protected:
   std::list<ISaveable *> m_toWriteBuffer;
 
   /// Mutex for modifying the the toWrite buffer.
-  std::mutex m_mutex;
+  mutable std::mutex m_mutex;
+  /// Mutex held while writing out the toWrite buffer.
+  std::mutex m_writeMutex;
+  /// The object being written (or flushed) without holding m_mutex.
+  ISaveable *m_writing;
+  /// Notified when m_writing changes.
+  std::condition_variable m_writingChanged;
+
+  // ----------------------- Write-behind thread
+  // --------------------------------------
+  /// Write the to-write buffer out on m_writer rather than the adding thread
+  bool m_writeBehind;
+  /// The write-behind thread, started when first needed
+  std::thread m_writer;
+  /// Set to make m_writer write out the to-write buffer
+  bool m_writeRequested;
+  /// Set to make m_writer exit
+  bool m_stopWriter;
+  /// Notified when m_writeRequested or m_stopWriter is set
+  std::condition_variable m_writeRequest;
+  /// The first error of m_writer not yet thrown by flushCache()
+  std::exception_ptr m_writerError;
 
   // ----------------------- Free space map
   // --------------------------------------
   /// Map of the free blocks in the file
   freeSpace_t m_free;
 
-  /// Index into m_free, but indexed by block size.
-  freeSpace_bySize_t &m_free_bySize;
+  /// Index into m_free, but indexed by block size class.
+  freeSpace_bySizeClass_t &m_free_bySizeClass;
+
+  /// Number of free blocks in each size class
+  std::vector<size_t> m_sizeClassCount;
+
+  /// One bit per size class, set if the class has free blocks
+  std::vector<uint64_t> m_sizeClassUsed;
+
+  /// Total size of the free blocks
+  uint64_t m_freeSpaceSize;
 
-  /// Mutex for modifying the free space list
-  std::mutex m_freeMutex;
+  /// Mutex for the free space list and the file length
+  mutable std::mutex m_freeMutex;
 
   // ----------------------- File object --------------------------------------
   /// Length of the file. This is where new blocks that don't fit get placed.
@@ -3,13 +3,17 @@
 
 #include "MantidKernel/System.h"
 
+#include <cstddef>
+#include <cstdint>
+
 namespace Mantid {
 namespace Kernel {
 
 /** FreeBlock: a simple class that holds the position
   and size of block of free space in a file.
 
-  This is used by the DiskBuffer class to track and defrag free space.
+  This is used by the DiskBuffer class to track and defrag free space,
+  and to find free space of a given size through the size classes.
 
   @author Janik Zikovsky, SNS
   @date 2011-08-04
@@ -51,6 +55,37 @@ public:
   /// @return the size of the free block in the file
   inline uint64_t getSize() const { return m_size; }
 
+  /// @return the size class of the free block in the file
+  inline size_t getSizeClass() const { return sizeClass(m_size); }
+
+  //----------------------------------------------------------------
+  /** Size classes segregate free blocks by size so that a block large enough
+   * for a request is found without searching. Sizes below 16 have a class
+   * each; above, each power of two is split into 8 classes of equal width.
+   *
+   * @param size :: size of a block
+   * @return the size class, which grows with the size
+   */
+  static size_t sizeClass(const uint64_t size) {
+    if (size < 2 * SubClassesPerPowerOfTwo)
+      return static_cast<size_t>(size);
+    size_t powerOfTwo = 0;
+    for (uint64_t rest = size; rest > 1; rest >>= 1)
+      ++powerOfTwo;
+    const size_t subClass = static_cast<size_t>(
+        size >> (powerOfTwo - SubClassBits)) - SubClassesPerPowerOfTwo;
+    return (powerOfTwo - SubClassBits + 1) * SubClassesPerPowerOfTwo +
+           subClass;
+  }
+
+  /// Number of bits of the size selecting a class within a power of two
+  static const size_t SubClassBits = 3;
+  /// Number of classes within a power of two
+  static const size_t SubClassesPerPowerOfTwo = size_t(1) << SubClassBits;
+  /// Number of size classes, enough for any 64-bit size
+  static const size_t NumSizeClasses =
+      (64 - SubClassBits + 1) * SubClassesPerPowerOfTwo;
+
   //----------------------------------------------------------------
   /** Attempt to merge an adjacent block into this one.
    * If the blocks are contiguous, they get merged into one larger block.
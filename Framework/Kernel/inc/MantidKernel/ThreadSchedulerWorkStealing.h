@@ -0,0 +1,95 @@
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/ThreadScheduler.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ThreadSchedulerWorkStealing : A Thread Scheduler with one queue per thread.
+
+  Each thread of the ThreadPool takes its tasks from its own queue, newest
+  first. When its queue is empty it steals the oldest task of another thread's
+  queue. Each queue has its own lock, so threads only contend when stealing,
+  rather than on every push and pop as with the single queue of
+  ThreadSchedulerFIFO.
+
+  Tasks pushed by a task that is running on one of the scheduler's threads go
+  to the queue of that thread: this is how a task spawns children locally.
+  Recursive work, such as splitting MD boxes, is then done depth first by the
+  thread that created it while idle threads steal the large subtrees near the
+  root. Tasks pushed from any other thread are dealt out to the queues in
+  turn.
+
+  The total cost of the queued tasks (totalCost()) is not tracked, as that
+  would need a lock shared by all threads.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL ThreadSchedulerWorkStealing : public ThreadScheduler {
+public:
+  explicit ThreadSchedulerWorkStealing(size_t numQueues);
+  ~ThreadSchedulerWorkStealing() override;
+
+  void push(Task *newTask) override;
+  void pushLocal(Task *newTask, size_t threadnum);
+  Task *pop(size_t threadnum) override;
+  void finished(Task *task, size_t threadnum) override;
+
+  size_t size() override;
+  bool empty() override;
+  void clear() override;
+
+  /// @return the number of queues, one per thread
+  size_t numberOfQueues() const { return m_queues.size(); }
+  /// @return the number of tasks taken from another thread's queue
+  size_t numberOfSteals() const { return m_steals; }
+
+private:
+  /// The tasks of one thread
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<Task *> tasks;
+  };
+
+  size_t queueIndex(size_t threadnum) const;
+  Task *steal(size_t thief);
+
+  /// One queue per thread
+  std::vector<std::unique_ptr<WorkQueue>> m_queues;
+  /// Queue the next task pushed from outside the pool goes to
+  std::atomic<size_t> m_nextQueue;
+  /// Number of tasks stolen
+  std::atomic<size_t> m_steals;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_ */
@@ -1,5 +1,6 @@
 #include "MantidKernel/DiskBuffer.h"
 #include "MantidKernel/ISaveable.h"
+#include <algorithm>
 #include <sstream>
 #include <utility>
 
@@ -13,7 +14,11 @@ namespace Kernel {
  */
 DiskBuffer::DiskBuffer()
     : m_writeBufferSize(50), m_writeBufferUsed(0), m_nObjectsToWrite(0),
-      m_free(), m_free_bySize(m_free.get<1>()), m_fileLength(0) {
+      m_writing(nullptr), m_writeBehind(false), m_writeRequested(false),
+      m_stopWriter(false), m_free(), m_free_bySizeClass(m_free.get<1>()),
+      m_sizeClassCount(FreeBlock::NumSizeClasses, 0),
+      m_sizeClassUsed((FreeBlock::NumSizeClasses + 63) / 64, 0),
+      m_freeSpaceSize(0), m_fileLength(0) {
   m_free.clear();
 }
 
@@ -26,17 +31,29 @@ DiskBuffer::DiskBuffer()
  */
 DiskBuffer::DiskBuffer(uint64_t m_writeBufferSize)
     : m_writeBufferSize(m_writeBufferSize), m_writeBufferUsed(0),
-      m_nObjectsToWrite(0), m_free(), m_free_bySize(m_free.get<1>()),
-      m_fileLength(0) {
+      m_nObjectsToWrite(0), m_writing(nullptr), m_writeBehind(false),
+      m_writeRequested(false), m_stopWriter(false), m_free(),
+      m_free_bySizeClass(m_free.get<1>()),
+      m_sizeClassCount(FreeBlock::NumSizeClasses, 0),
+      m_sizeClassUsed((FreeBlock::NumSizeClasses + 63) / 64, 0),
+      m_freeSpaceSize(0), m_fileLength(0) {
   m_free.clear();
 }
 
+//----------------------------------------------------------------------------------------------
+/** Destructor. Stops the write-behind thread; the objects still in the
+ * to-write buffer are not written.
+ */
+DiskBuffer::~DiskBuffer() { stopWriteBehind(); }
+
 //---------------------------------------------------------------------------------------------
 /** Call this method when an object is ready to be written
  * out to disk.
  *
  * When the to-write buffer is full, all of it gets written
- * out to disk using writeOldObjects()
+ * out to disk using writeOldObjects(), unless another thread
+ * is already doing so. With write-behind, the write-behind thread
+ * is asked to do it unless the buffer has grown to twice its size.
  *
  * @param item :: item that can be written to disk.
  */
@@ -45,27 +62,45 @@ void DiskBuffer::toWrite(ISaveable *item) {
     return;
   //    if (!m_useWriteBuffer) return;
 
+  std::unique_lock<std::mutex> uniqueLock(m_mutex);
+  // The object may be being written right now
+  m_writingChanged.wait(uniqueLock, [this, item] { return m_writing != item; });
   if (item->getBufPostion()) // already in the buffer and probably have changed
                              // its size in memory
   {
     // forget old memory size
-    std::unique_lock<std::mutex> uniqueLock(m_mutex);
     m_writeBufferUsed -= item->getBufferSize();
     // add new size
     size_t newMemorySize = item->getDataMemorySize();
     m_writeBufferUsed += newMemorySize;
-    uniqueLock.unlock();
     item->setBufferSize(newMemorySize);
   } else {
-    std::lock_guard<std::mutex> lock(m_mutex);
     m_toWriteBuffer.push_front(item);
     m_writeBufferUsed += item->setBufferPosition(m_toWriteBuffer.begin());
     m_nObjectsToWrite++;
   }
+  const size_t used = m_writeBufferUsed;
 
   // Should we now write out the old data?
-  if (m_writeBufferUsed > m_writeBufferSize)
-    writeOldObjects();
+  if (used <= m_writeBufferSize)
+    return;
+  if (m_writeBehind && !m_stopWriter && used / 2 <= m_writeBufferSize) {
+    if (!m_writer.joinable())
+      m_writer = std::thread(&DiskBuffer::writeBehindLoop, this);
+    m_writeRequested = true;
+    m_writeRequest.notify_one();
+    return;
+  }
+  uniqueLock.unlock();
+  std::unique_lock<std::mutex> writeLock(m_writeMutex, std::try_to_lock);
+  if (!writeLock.owns_lock()) {
+    // Another thread is writing. Leave the data to it, but do not let the
+    // buffer grow without bounds.
+    if (used / 2 <= m_writeBufferSize)
+      return;
+    writeLock.lock();
+  }
+  writeOldObjects();
 }
 
 //---------------------------------------------------------------------------------------------
@@ -81,10 +116,13 @@ void DiskBuffer::objectDeleted(ISaveable *item) {
     return;
   // have it ever been in the buffer?
   std::unique_lock<std::mutex> uniqueLock(m_mutex);
+  // The object must not be deleted while it is being written
+  m_writingChanged.wait(uniqueLock, [this, item] { return m_writing != item; });
   auto opt2it = item->getBufPostion();
   if (opt2it) {
     m_writeBufferUsed -= item->getBufferSize();
     m_toWriteBuffer.erase(*opt2it);
+    m_nObjectsToWrite--;
   } else {
     return;
   }
@@ -100,96 +138,198 @@ void DiskBuffer::objectDeleted(ISaveable *item) {
 
 //---------------------------------------------------------------------------------------------
 /** Method to write out the old objects that have been
- * stored in the "toWrite" buffer.
+ * stored in the "toWrite" buffer. m_writeMutex must be held.
+ *
+ * Each object is written without holding m_mutex; toWrite() and
+ * objectDeleted() wait for the object being written.
  */
 void DiskBuffer::writeOldObjects() {
+  std::unique_lock<std::mutex> uniqueLock(m_mutex);
+  auto setWriting = [this](ISaveable *obj) {
+    m_writing = obj;
+    m_writingChanged.notify_all();
+  };
 
-  std::lock_guard<std::mutex> _lock(m_mutex);
-  // Holder for any objects that you were NOT able to write.
-  std::list<ISaveable *> couldNotWrite;
-  size_t objectsNotWritten(0);
-  size_t memoryNotWritten(0);
-
-  // Iterate through the list
+  // Iterate through the list. Objects added meanwhile go to its front and
+  // are left for the next time.
   auto it = m_toWriteBuffer.begin();
-  auto it_end = m_toWriteBuffer.end();
-
-  ISaveable *obj = nullptr;
-
-  for (; it != it_end; ++it) {
-    obj = *it;
-    if (!obj->isBusy()) {
-      uint64_t NumObjEvents = obj->getTotalDataSize();
-      uint64_t fileIndexStart;
-      if (!obj->wasSaved()) {
-        fileIndexStart = this->allocate(NumObjEvents);
-        // Write to the disk; this will call the object specific save function;
-        // Prevent simultaneous file access (e.g. write while loading)
-        obj->saveAt(fileIndexStart, NumObjEvents);
-      } else {
-        uint64_t NumFileEvents = obj->getFileSize();
-        if (NumObjEvents != NumFileEvents) {
-          // Event list changed size. The MRU can tell us where it best fits
-          // now.
-          fileIndexStart = this->relocate(obj->getFilePosition(), NumFileEvents,
-                                          NumObjEvents);
-          // Write to the disk; this will call the object specific save
-          // function;
-          obj->saveAt(fileIndexStart, NumObjEvents);
-        } else // despite object size have not been changed, it can be modified
-               // other way. In this case, the method which changed the data
-               // should set dataChanged ID
-        {
-          if (obj->isDataChanged()) {
-            fileIndexStart = obj->getFilePosition();
-            // Write to the disk; this will call the object specific save
-            // function;
-            obj->saveAt(fileIndexStart, NumObjEvents);
-            // this is questionable operation, which adjust file size in case
-            // when the file postions were allocated externaly
-            if (fileIndexStart + NumObjEvents > m_fileLength)
-              m_fileLength = fileIndexStart + NumObjEvents;
-          } else // just clean the object up -- it just occupies memory
-            obj->clearDataFromMemory();
-        }
-      }
-      // tell the object that it has been removed from the buffer
-      obj->clearBufferState();
-    } else // object busy
-    {
-      // The object is busy, can't write. Save it for later
-      couldNotWrite.push_back(obj);
-      // When a prefix or postfix operator is applied to a function argument,
-      // the value of the argument is
-      // NOT GUARANTEED to be incremented or decremented before it is passed to
-      // the function.
-      auto it = --couldNotWrite.end();
-      memoryNotWritten += obj->setBufferPosition(it);
-      objectsNotWritten++;
+  while (it != m_toWriteBuffer.end()) {
+    ISaveable *obj = *it;
+    if (obj->isBusy()) {
+      // The object is busy, can't write. Leave it for later
+      m_writeBufferUsed -= obj->getBufferSize();
+      m_writeBufferUsed += obj->setBufferPosition(it);
+      ++it;
+      continue;
+    }
+    // The previous object stays in m_writing until now, so that the last one
+    // can be used to flush the data below
+    setWriting(obj);
+    uniqueLock.unlock();
+    try {
+      writeObject(obj);
+    } catch (...) {
+      uniqueLock.lock();
+      setWriting(nullptr);
+      throw;
     }
+    uniqueLock.lock();
+    m_writeBufferUsed -= obj->getBufferSize();
+    m_nObjectsToWrite--;
+    it = m_toWriteBuffer.erase(it);
+    // tell the object that it has been removed from the buffer
+    obj->clearBufferState();
   }
 
   // use last object to clear NeXus buffer and actually write data to HDD
-  if (obj) {
+  if (m_writing) {
     // NXS needs to flush the writes to file by closing and re-opening the data
     // block.
     // For speed, it is best to do this only once per write dump, using last
     // object saved
-    obj->flushData();
+    ISaveable *last = m_writing;
+    uniqueLock.unlock();
+    try {
+      last->flushData();
+    } catch (...) {
+      uniqueLock.lock();
+      setWriting(nullptr);
+      throw;
+    }
+    uniqueLock.lock();
+    setWriting(nullptr);
   }
+}
 
-  // Exchange with the new map you built out of the not-written blocks.
-  m_toWriteBuffer.swap(couldNotWrite);
-  m_writeBufferUsed = memoryNotWritten;
-  m_nObjectsToWrite = objectsNotWritten;
+//---------------------------------------------------------------------------------------------
+/** Write a single object of the "toWrite" buffer to disk, allocating space in
+ * the file for it if its size changed.
+ *
+ * @param obj :: the object to write; it must not be busy
+ */
+void DiskBuffer::writeObject(ISaveable *obj) {
+  uint64_t NumObjEvents = obj->getTotalDataSize();
+  uint64_t fileIndexStart;
+  if (!obj->wasSaved()) {
+    fileIndexStart = this->allocate(NumObjEvents);
+    // Write to the disk; this will call the object specific save function;
+    // Prevent simultaneous file access (e.g. write while loading)
+    obj->saveAt(fileIndexStart, NumObjEvents);
+  } else {
+    uint64_t NumFileEvents = obj->getFileSize();
+    if (NumObjEvents != NumFileEvents) {
+      // Event list changed size. The MRU can tell us where it best fits
+      // now.
+      fileIndexStart =
+          this->relocate(obj->getFilePosition(), NumFileEvents, NumObjEvents);
+      // Write to the disk; this will call the object specific save
+      // function;
+      obj->saveAt(fileIndexStart, NumObjEvents);
+    } else // despite object size have not been changed, it can be modified
+           // other way. In this case, the method which changed the data
+           // should set dataChanged ID
+    {
+      if (obj->isDataChanged()) {
+        fileIndexStart = obj->getFilePosition();
+        // Write to the disk; this will call the object specific save
+        // function;
+        obj->saveAt(fileIndexStart, NumObjEvents);
+        // this is questionable operation, which adjust file size in case
+        // when the file postions were allocated externaly
+        std::lock_guard<std::mutex> lock(m_freeMutex);
+        if (fileIndexStart + NumObjEvents > m_fileLength)
+          m_fileLength = fileIndexStart + NumObjEvents;
+      } else // just clean the object up -- it just occupies memory
+        obj->clearDataFromMemory();
+    }
+  }
 }
 
 //---------------------------------------------------------------------------------------------
 /** Flush out all the data in the memory; and writes out everything in the
  * to-write cache. */
 void DiskBuffer::flushCache() {
-  // Now write everything out.
-  writeOldObjects();
+  {
+    // Now write everything out, after any other thread that is writing
+    std::lock_guard<std::mutex> writeLock(m_writeMutex);
+    writeOldObjects();
+  }
+  // Report what went wrong on the write-behind thread
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::swap(error, m_writerError);
+  }
+  if (error)
+    std::rethrow_exception(error);
+}
+
+//---------------------------------------------------------------------------------------------
+/** Choose whether the to-write buffer is written out on a thread of its own.
+ * Switching it off waits for the write in progress, if any; the objects
+ * left in the buffer are written by the next thread to overflow it or by
+ * flushCache().
+ *
+ * @param writeBehind :: true to write on a thread of its own
+ */
+void DiskBuffer::setWriteBehind(const bool writeBehind) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_writeBehind = writeBehind;
+  }
+  if (!writeBehind)
+    stopWriteBehind();
+}
+
+//---------------------------------------------------------------------------------------------
+/** Body of the write-behind thread: write out the to-write buffer each time
+ * it is asked to, until it is stopped.
+ */
+void DiskBuffer::writeBehindLoop() {
+  std::unique_lock<std::mutex> uniqueLock(m_mutex);
+  while (true) {
+    m_writeRequest.wait(uniqueLock,
+                        [this] { return m_writeRequested || m_stopWriter; });
+    if (m_stopWriter)
+      return;
+    m_writeRequested = false;
+    uniqueLock.unlock();
+    {
+      std::lock_guard<std::mutex> writeLock(m_writeMutex);
+      try {
+        writeOldObjects();
+      } catch (...) {
+        // Recorded before m_writeMutex is released, so that a flushCache()
+        // waiting for this write sees it
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_writerError)
+          m_writerError = std::current_exception();
+      }
+    }
+    uniqueLock.lock();
+  }
+}
+
+//---------------------------------------------------------------------------------------------
+/** Stop the write-behind thread, if it runs, once it is done with the write
+ * in progress. It is started again when it is next needed, if write-behind
+ * is still on. Classes writing through the ISaveable objects must call this
+ * before the file is closed.
+ */
+void DiskBuffer::stopWriteBehind() {
+  std::thread writer;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_writer.joinable())
+      return;
+    m_stopWriter = true;
+    writer = std::move(m_writer);
+  }
+  m_writeRequest.notify_one();
+  writer.join();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_stopWriter = false;
+  m_writeRequested = false;
 }
 
 //---------------------------------------------------------------------------------------------
@@ -208,17 +348,15 @@ void DiskBuffer::freeBlock(uint64_t const pos, uint64_t const size) {
   // Make the block
   FreeBlock newBlock(pos, size);
   // Insert it
-  std::pair<freeSpace_t::iterator, bool> p = m_free.insert(newBlock);
+  freeSpace_t::iterator it = this->insertFreeBlock(newBlock);
 
-  // Failed insert? Should not happen since the map is NOT unique
-  // Or, if the map has only 1 item then it cannot do any merging. This solves a
+  // If the map has only 1 item then it cannot do any merging. This solves a
   // hanging bug in MacOS. Refs #3652
-  if (!p.second || m_free.size() <= 1) {
+  if (m_free.size() <= 1) {
     return;
   }
 
   // This is where we inserted
-  freeSpace_t::iterator it = p.first;
   if (it != m_free.begin()) {
     freeSpace_t::iterator it_before = it;
     --it_before;
@@ -227,9 +365,9 @@ void DiskBuffer::freeBlock(uint64_t const pos, uint64_t const size) {
     if (FreeBlock::merge(block_before, newBlock)) {
       // Change the map by replacing the old "before" block with the new merged
       // one
-      m_free.replace(it_before, block_before);
+      this->replaceFreeBlock(it_before, block_before);
       // Remove the block we just inserted
-      m_free.erase(it);
+      this->eraseFreeBlock(it);
       // For cases where the new block was between two blocks.
       newBlock = block_before;
       it = it_before;
@@ -243,9 +381,9 @@ void DiskBuffer::freeBlock(uint64_t const pos, uint64_t const size) {
     FreeBlock block_after = *it_after;
     if (FreeBlock::merge(newBlock, block_after)) {
       // Change the map by replacing the old "new" block with the new merged one
-      m_free.replace(it, newBlock);
+      this->replaceFreeBlock(it, newBlock);
       // Remove the block that was after this one
-      m_free.erase(it_after);
+      this->eraseFreeBlock(it_after);
     }
   }
 }
@@ -257,26 +395,27 @@ void DiskBuffer::freeBlock(uint64_t const pos, uint64_t const size) {
  */
 void DiskBuffer::defragFreeBlocks() {
   std::lock_guard<std::mutex> lock(m_freeMutex);
+  if (m_free.empty())
+    return;
 
   freeSpace_t::iterator it = m_free.begin();
-  FreeBlock thisBlock;
-  thisBlock = *it;
-
-  while (it != m_free.end()) {
-    // Get iterator to the block after "it".
-    freeSpace_t::iterator it_after = it;
-    ++it_after;
+  FreeBlock thisBlock = *it;
+  // Get iterator to the block after "it".
+  freeSpace_t::iterator it_after = it;
+  ++it_after;
 
+  while (it_after != m_free.end()) {
     if (FreeBlock::merge(thisBlock, *it_after)) {
       // Change the map by replacing the old "before" block with the new merged
       // one
-      m_free.replace(it, thisBlock);
-      // Remove the block that was merged out
-      m_free.erase(it_after);
-      // And stay at this iterator to
+      this->replaceFreeBlock(it, thisBlock);
+      // Remove the block that was merged out, and stay at this iterator
+      freeSpace_t::iterator it_merged = it_after++;
+      this->eraseFreeBlock(it_merged);
     } else {
       // Move on to the next block
-      ++it;
+      it = it_after;
+      ++it_after;
       thisBlock = *it;
     }
   }
@@ -286,22 +425,34 @@ void DiskBuffer::defragFreeBlocks() {
 /** Allocate a block of the given size in a free spot in the file,
  * or at the end of the file if there is no space.
  *
+ * The free blocks of the size class of the request may be smaller than the
+ * request, so only one of them is tried; otherwise any block of the next
+ * size class that has blocks is large enough. This takes a fixed number of
+ * steps and leaves the large blocks for large requests.
+ *
  * @param newSize :: new size of the data
  * @return a new position at which the data can be saved.
  */
 uint64_t DiskBuffer::allocate(uint64_t const newSize) {
   std::unique_lock<std::mutex> uniqueLock(m_freeMutex);
 
-  // Now, find the first available block of sufficient size.
-  freeSpace_bySize_t::iterator it;
-  bool putAtFileEnd = true;
+  // Now, find an available block of sufficient size.
+  freeSpace_t::iterator it = m_free.end();
   if (m_free.size() > 0) {
     // Unless there is nothing in the free space map
-    it = m_free_bySize.lower_bound(newSize);
-    putAtFileEnd = (it == m_free_bySize.end());
+    size_t sizeClass = FreeBlock::sizeClass(newSize);
+    auto candidate = m_free_bySizeClass.find(sizeClass);
+    if (candidate != m_free_bySizeClass.end() &&
+        candidate->getSize() >= newSize) {
+      it = m_free.project<0>(candidate);
+    } else {
+      sizeClass = this->findSizeClass(sizeClass + 1);
+      if (sizeClass < FreeBlock::NumSizeClasses)
+        it = m_free.project<0>(m_free_bySizeClass.find(sizeClass));
+    }
   }
 
-  if (putAtFileEnd) {
+  if (it == m_free.end()) {
     // No block found
     // Go to the end of the file.
     uint64_t retVal = m_fileLength;
@@ -314,7 +465,7 @@ uint64_t DiskBuffer::allocate(uint64_t const newSize) {
     uint64_t foundPos = it->getFilePosition();
     uint64_t foundSize = it->getSize();
     // Remove the free block you found - it is no longer free
-    m_free_bySize.erase(it);
+    this->eraseFreeBlock(it);
     uniqueLock.unlock();
     // Block was too large - free the bit of space after it.
     if (foundSize > newSize) {
@@ -324,6 +475,76 @@ uint64_t DiskBuffer::allocate(uint64_t const newSize) {
   }
 }
 
+//---------------------------------------------------------------------------------------------
+/** Add a block to the free space map.
+ * @param block :: the free block
+ * @return the position of the block in the map */
+DiskBuffer::freeSpace_t::iterator
+DiskBuffer::insertFreeBlock(const FreeBlock &block) {
+  freeSpace_t::iterator it = m_free.insert(block).first;
+  this->countFreeBlock(block, true);
+  return it;
+}
+
+/** Remove a block from the free space map.
+ * @param it :: the position of the block in the map */
+void DiskBuffer::eraseFreeBlock(freeSpace_t::iterator it) {
+  this->countFreeBlock(*it, false);
+  m_free.erase(it);
+}
+
+/** Change a block of the free space map, which stays at the same place.
+ * @param it :: the position of the block in the map
+ * @param block :: the new block */
+void DiskBuffer::replaceFreeBlock(freeSpace_t::iterator it,
+                                  const FreeBlock &block) {
+  this->countFreeBlock(*it, false);
+  m_free.replace(it, block);
+  this->countFreeBlock(block, true);
+}
+
+/** Update the size class counts and the total free space for a block that
+ * was added to or removed from the map.
+ * @param block :: the free block
+ * @param added :: true if the block was added, false if it was removed */
+void DiskBuffer::countFreeBlock(const FreeBlock &block, const bool added) {
+  const size_t sizeClass = block.getSizeClass();
+  const uint64_t bit = uint64_t(1) << (sizeClass % 64);
+  if (added) {
+    m_freeSpaceSize += block.getSize();
+    if (m_sizeClassCount[sizeClass]++ == 0)
+      m_sizeClassUsed[sizeClass / 64] |= bit;
+  } else {
+    m_freeSpaceSize -= block.getSize();
+    if (--m_sizeClassCount[sizeClass] == 0)
+      m_sizeClassUsed[sizeClass / 64] &= ~bit;
+  }
+}
+
+/** Find the smallest size class that has free blocks, starting from a given
+ * one.
+ * @param sizeClass :: the smallest size class to look at
+ * @return the size class found, or FreeBlock::NumSizeClasses if none */
+size_t DiskBuffer::findSizeClass(const size_t sizeClass) const {
+  for (size_t word = sizeClass / 64; word < m_sizeClassUsed.size(); ++word) {
+    uint64_t bits = m_sizeClassUsed[word];
+    size_t found = word * 64;
+    if (word == sizeClass / 64) {
+      // Skip the classes below the one asked for
+      bits >>= sizeClass % 64;
+      found = sizeClass;
+    }
+    if (bits == 0)
+      continue;
+    while ((bits & 1) == 0) {
+      bits >>= 1;
+      ++found;
+    }
+    return found;
+  }
+  return FreeBlock::NumSizeClasses;
+}
+
 //---------------------------------------------------------------------------------------------
 /** This method is called by an ISaveable object that has outgrown
  * its space allocated on file and needs to relocate.
@@ -346,26 +567,30 @@ uint64_t DiskBuffer::relocate(uint64_t const oldPos, uint64_t const oldSize,
 }
 
 //---------------------------------------------------------------------------------------------
-/** Returns a vector with two entries per free block: position and size.
+/** Returns a vector with two entries per free block: position and size,
+ * in the order of the blocks in the file.
  * @param[out] free :: vector to fill */
 void DiskBuffer::getFreeSpaceVector(std::vector<uint64_t> &free) const {
+  std::lock_guard<std::mutex> lock(m_freeMutex);
   free.reserve(m_free.size() * 2);
-  freeSpace_bySize_t::const_iterator it = m_free_bySize.begin();
-  freeSpace_bySize_t::const_iterator it_end = m_free_bySize.end();
-  for (; it != it_end; ++it) {
-    free.push_back(it->getFilePosition());
-    free.push_back(it->getSize());
+  for (const auto &block : m_free) {
+    free.push_back(block.getFilePosition());
+    free.push_back(block.getSize());
   }
 }
 
 /** Sets the free space map. Should only be used when loading a file.
  * @param[in] free :: vector containing free space index to set */
 void DiskBuffer::setFreeSpaceVector(std::vector<uint64_t> &free) {
-  m_free.clear();
-
   if (free.size() % 2 != 0)
     throw std::length_error("Free vector size is not a factor of 2.");
 
+  std::lock_guard<std::mutex> lock(m_freeMutex);
+  m_free.clear();
+  std::fill(m_sizeClassCount.begin(), m_sizeClassCount.end(), 0);
+  std::fill(m_sizeClassUsed.begin(), m_sizeClassUsed.end(), 0);
+  m_freeSpaceSize = 0;
+
   for (auto it = free.begin(); it != free.end(); it += 2) {
     auto it_next = std::next(it);
 
@@ -374,7 +599,7 @@ void DiskBuffer::setFreeSpaceVector(std::vector<uint64_t> &free) {
     }
 
     FreeBlock newBlock(*it, *it_next);
-    m_free.insert(newBlock);
+    this->insertFreeBlock(newBlock);
   }
 }
 
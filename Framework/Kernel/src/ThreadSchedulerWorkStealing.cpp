@@ -0,0 +1,148 @@
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidKernel/make_unique.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// The scheduler whose task the calling thread is running, if any
+thread_local const ThreadSchedulerWorkStealing *t_scheduler = nullptr;
+/// The queue of the calling thread in t_scheduler
+thread_local size_t t_queue = 0;
+} // namespace
+
+/** Constructor
+ * @param numQueues :: number of queues, normally the number of threads of the
+ * ThreadPool. Thread numbers beyond it share the queues. At least 1.
+ */
+ThreadSchedulerWorkStealing::ThreadSchedulerWorkStealing(
+    const size_t numQueues)
+    : ThreadScheduler(), m_nextQueue(0), m_steals(0) {
+  m_queues.resize(std::max(numQueues, size_t(1)));
+  for (auto &queue : m_queues)
+    queue = Kernel::make_unique<WorkQueue>();
+}
+
+/// Destructor. Deletes the tasks left in the queues.
+ThreadSchedulerWorkStealing::~ThreadSchedulerWorkStealing() { clear(); }
+
+/** Add a Task. From a task running on one of this scheduler's threads it goes
+ * to the queue of that thread, otherwise to the queues in turn.
+ * @param newTask :: Task to add
+ */
+void ThreadSchedulerWorkStealing::push(Task *newTask) {
+  if (t_scheduler == this) {
+    pushLocal(newTask, t_queue);
+    return;
+  }
+  pushLocal(newTask, m_nextQueue++);
+}
+
+/** Add a Task to the queue of a thread
+ * @param newTask :: Task to add
+ * @param threadnum :: ID of the thread whose queue it goes to
+ */
+void ThreadSchedulerWorkStealing::pushLocal(Task *newTask,
+                                            const size_t threadnum) {
+  auto &queue = *m_queues[queueIndex(threadnum)];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  queue.tasks.push_back(newTask);
+}
+
+/** Retrieve the next Task for a thread: the newest of its own queue, or else
+ * the oldest of another queue.
+ * @param threadnum :: ID of the calling thread
+ * @return the Task; nullptr if all queues are empty
+ */
+Task *ThreadSchedulerWorkStealing::pop(const size_t threadnum) {
+  const size_t index = queueIndex(threadnum);
+  Task *task = nullptr;
+  {
+    auto &queue = *m_queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      task = queue.tasks.back();
+      queue.tasks.pop_back();
+    }
+  }
+  if (!task)
+    task = steal(index);
+  if (task) {
+    // Tasks pushed while this one runs go to this thread's queue
+    t_scheduler = this;
+    t_queue = index;
+  }
+  return task;
+}
+
+/** Take the oldest task of the first non-empty queue after the thief's
+ * @param thief :: index of the queue of the stealing thread
+ * @return the Task; nullptr if all other queues are empty
+ */
+Task *ThreadSchedulerWorkStealing::steal(const size_t thief) {
+  for (size_t i = 1; i < m_queues.size(); ++i) {
+    auto &queue = *m_queues[(thief + i) % m_queues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      Task *task = queue.tasks.front();
+      queue.tasks.pop_front();
+      ++m_steals;
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+/** Signal that a task popped by a thread is complete
+ * @param task :: the Task that was completed
+ * @param threadnum :: Thread ID that ran the task
+ */
+void ThreadSchedulerWorkStealing::finished(Task *task, size_t threadnum) {
+  UNUSED_ARG(task);
+  UNUSED_ARG(threadnum);
+  t_scheduler = nullptr;
+}
+
+/// @return the number of tasks in all queues
+size_t ThreadSchedulerWorkStealing::size() {
+  size_t total = 0;
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    total += queue->tasks.size();
+  }
+  return total;
+}
+
+/// @return true if all queues are empty
+bool ThreadSchedulerWorkStealing::empty() {
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (!queue->tasks.empty())
+      return false;
+  }
+  return true;
+}
+
+/// Empty out the queues, deleting the tasks
+void ThreadSchedulerWorkStealing::clear() {
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    for (auto &task : queue->tasks)
+      delete task;
+    queue->tasks.clear();
+  }
+  m_cost = 0;
+  m_costExecuted = 0;
+}
+
+/** @param threadnum :: ID of a thread
+ * @return the index of its queue
+ */
+size_t ThreadSchedulerWorkStealing::queueIndex(const size_t threadnum) const {
+  return threadnum % m_queues.size();
+}
+
+} // namespace Kernel
+} // namespace Mantid
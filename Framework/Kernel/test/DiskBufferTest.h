@@ -14,6 +14,10 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <cxxtest/TestSuite.h>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 using namespace Mantid;
 using namespace Mantid::Kernel;
 using Mantid::Kernel::CPUTimer;
@@ -64,6 +68,8 @@ public:
 
   char m_ch;
   void save() const override {
+    while (holdSaves)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
     // Fake writing to a file
     streamMutex.lock();
     uint64_t mPos = this->getFilePosition();
@@ -73,6 +79,7 @@ public:
 
     for (size_t i = mPos; i < mPos + mMem; i++)
       fakeFile[i] = m_ch;
+    m_savedBy = std::this_thread::get_id();
 
     streamMutex.unlock();
     // this is important function call which has to be implemented by any save
@@ -90,13 +97,34 @@ public:
   }
   void flushData() const override {}
 
+  /// The thread that last saved the object
+  mutable std::thread::id m_savedBy;
+
   static std::string fakeFile;
   static std::mutex streamMutex;
+  /// Saving waits while this is set
+  static std::atomic<bool> holdSaves;
 };
 
 // Declare the static members here.
 std::string SaveableTesterWithFile::fakeFile;
 std::mutex SaveableTesterWithFile::streamMutex;
+std::atomic<bool> SaveableTesterWithFile::holdSaves(false);
+
+/** A SaveableTesterWithFile whose first save fails */
+class SaveableTesterFailingOnce : public SaveableTesterWithFile {
+public:
+  SaveableTesterFailingOnce(uint64_t pos, uint64_t size, char ch)
+      : SaveableTesterWithFile(pos, size, ch), m_failed(false) {}
+
+  void save() const override {
+    if (!m_failed.exchange(true))
+      throw std::runtime_error("Fake disk error");
+    SaveableTesterWithFile::save();
+  }
+
+  mutable std::atomic<bool> m_failed;
+};
 
 //====================================================================================
 class DiskBufferTest : public CxxTest::TestSuite {
@@ -266,6 +294,118 @@ public:
     for (size_t i = 0; i < size_t(bigNum); i++)
       delete bigData[i];
   }
+
+  //--------------------------------------------------------------------------------
+  /** Objects added by other threads while one thread writes are all written
+   * by the end, and objects can be deleted while others are written */
+  void test_adding_and_deleting_while_writing() {
+    DiskBuffer dbuf(20);
+    const int bigNum = 2000;
+    std::vector<SaveableTesterWithFile *> bigData;
+    bigData.reserve(bigNum);
+    for (int i = 0; i < bigNum; i++)
+      bigData.push_back(new SaveableTesterWithFile(0, 2, char(i % 26 + 0x41),
+                                                   false));
+
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < bigNum; i++) {
+      dbuf.toWrite(bigData[i]);
+      if (i % 10 == 4)
+        dbuf.objectDeleted(bigData[i]);
+    }
+    dbuf.flushCache();
+    TS_ASSERT_EQUALS(dbuf.getWriteBufferUsed(), 0);
+
+    // Everything that was not deleted was written, each to its own place
+    for (int i = 0; i < bigNum; i++) {
+      if (i % 10 != 4) {
+        TS_ASSERT(bigData[i]->wasSaved());
+        TS_ASSERT_EQUALS(
+            SaveableTesterWithFile::fakeFile.substr(
+                static_cast<size_t>(bigData[i]->getFilePosition()), 2),
+            std::string(2, bigData[i]->m_ch));
+      }
+      delete bigData[i];
+    }
+  }
+  //--------------------------------------------------------------------------------
+  /** With write-behind, the buffer is written out by another thread */
+  void test_writeBehind_writes_on_another_thread() {
+    DiskBuffer dbuf(4);
+    dbuf.setWriteBehind(true);
+    TS_ASSERT(dbuf.getWriteBehind());
+    for (size_t i = 0; i < 3; i++) {
+      data[i]->setDataChanged();
+      dbuf.toWrite(data[i]);
+    }
+    // The adding thread did not wait for the write. Wait for it here.
+    for (int i = 0; i < 10000 && dbuf.getWriteBufferUsed() > 0; ++i)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    dbuf.flushCache();
+    TS_ASSERT_EQUALS(SaveableTesterWithFile::fakeFile, "AABBCC");
+    for (size_t i = 0; i < 3; i++)
+      TS_ASSERT_DIFFERS(data[i]->m_savedBy, std::this_thread::get_id());
+
+    dbuf.setWriteBehind(false);
+    TS_ASSERT(!dbuf.getWriteBehind());
+    for (size_t i = 3; i < 6; i++) {
+      data[i]->setDataChanged();
+      dbuf.toWrite(data[i]);
+    }
+    TS_ASSERT_EQUALS(data[3]->m_savedBy, std::this_thread::get_id());
+  }
+
+  /** With write-behind, adding does not wait for the writer until the buffer
+   * is at twice its size */
+  void test_writeBehind_buffer_is_bounded() {
+    DiskBuffer dbuf(4);
+    dbuf.setWriteBehind(true);
+    for (size_t i = 0; i < 5; i++)
+      data[i]->setDataChanged();
+
+    // Hold up the writes
+    SaveableTesterWithFile::holdSaves = true;
+    for (size_t i = 0; i < 4; i++)
+      dbuf.toWrite(data[i]);
+    TS_ASSERT_EQUALS(dbuf.getWriteBufferUsed(), 8);
+
+    std::atomic<bool> added(false);
+    std::thread adder([&dbuf, &added, this] {
+      dbuf.toWrite(data[4]);
+      added = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    TSM_ASSERT("Adding beyond twice the buffer size waits for the writes",
+               !added);
+    SaveableTesterWithFile::holdSaves = false;
+    adder.join();
+    TS_ASSERT(added);
+
+    dbuf.flushCache();
+    TS_ASSERT_EQUALS(dbuf.getWriteBufferUsed(), 0);
+    TS_ASSERT_EQUALS(SaveableTesterWithFile::fakeFile, "AABBCCDDEE");
+  }
+
+  /** An error on the write-behind thread is thrown by flushCache() */
+  void test_writeBehind_error_is_thrown_by_flushCache() {
+    DiskBuffer dbuf(2);
+    dbuf.setWriteBehind(true);
+    SaveableTesterFailingOnce failing(0, 2, 'X');
+    failing.setDataChanged();
+    dbuf.toWrite(&failing);
+    data[1]->setDataChanged();
+    dbuf.toWrite(data[1]);
+    for (int i = 0; i < 10000 && !failing.m_failed; ++i)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    TS_ASSERT(failing.m_failed);
+
+    TS_ASSERT_THROWS(dbuf.flushCache(), std::runtime_error);
+    // The objects left behind were written by flushCache()
+    TS_ASSERT_EQUALS(dbuf.getWriteBufferUsed(), 0);
+    TS_ASSERT_EQUALS(SaveableTesterWithFile::fakeFile, "XXBB");
+    TS_ASSERT_THROWS_NOTHING(dbuf.flushCache());
+  }
+
   ////--------------------------------------------------------------------------------
   ////--------------------------------------------------------------------------------
   ////----------TESTS FOR FREE SPACE MAPS
@@ -366,6 +506,44 @@ public:
     TS_ASSERT_EQUALS(dbuf.getFreeSpaceMap().size(), 6667);
   }
 
+  /** Blocks of the size class of a request may be too small, larger classes
+   * are used then, and the free space is tracked */
+  void test_allocate_uses_size_classes() {
+    DiskBuffer dbuf(3);
+    dbuf.setFileLength(10000);
+    dbuf.freeBlock(100, 1000);
+    dbuf.freeBlock(3000, 2000);
+    TS_ASSERT_EQUALS(FreeBlock::sizeClass(1000), FreeBlock::sizeClass(1001));
+    TS_ASSERT_EQUALS(dbuf.getNumFreeBlocks(), 2);
+    TS_ASSERT_EQUALS(dbuf.getFreeSpaceSize(), 3000);
+
+    // The only block of the class is too small: take a larger class
+    TS_ASSERT_EQUALS(dbuf.allocate(1001), 3000);
+    TS_ASSERT_EQUALS(dbuf.getNumFreeBlocks(), 2);
+    TS_ASSERT_EQUALS(dbuf.getFreeSpaceSize(), 1999);
+    TS_ASSERT_EQUALS(dbuf.allocate(5000), 10000);
+    TS_ASSERT_EQUALS(dbuf.getFileLength(), 15000);
+
+    // Giving back the space merges it all into one block
+    dbuf.freeBlock(1100, 1900);
+    dbuf.freeBlock(3000, 1001);
+    TS_ASSERT_EQUALS(dbuf.getNumFreeBlocks(), 1);
+    TS_ASSERT_EQUALS(dbuf.getFreeSpaceSize(), 4900);
+    TS_ASSERT_EQUALS(dbuf.allocate(4900), 100);
+    TS_ASSERT_EQUALS(dbuf.getNumFreeBlocks(), 0);
+    TS_ASSERT_EQUALS(dbuf.getFreeSpaceSize(), 0);
+  }
+
+  void test_sizeClass_grows_with_size() {
+    for (uint64_t size = 0; size < 100000; size++)
+      TS_ASSERT_LESS_THAN_EQUALS(FreeBlock::sizeClass(size),
+                                 FreeBlock::sizeClass(size + 1));
+    TS_ASSERT_EQUALS(FreeBlock::sizeClass(5), 5);
+    TS_ASSERT_LESS_THAN(
+        FreeBlock::sizeClass(std::numeric_limits<uint64_t>::max()),
+        FreeBlock::NumSizeClasses);
+  }
+
   ///** Disabled because it is not necessary to defrag since that happens on the
   /// fly */
   // void xtest_defragFreeBlocks()
@@ -0,0 +1,212 @@
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadScheduler.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+
+#include <atomic>
+
+using namespace Mantid::Kernel;
+
+namespace {
+/// Counts its destruction
+class CountedTask : public Task {
+public:
+  explicit CountedTask(std::atomic<int> &destructed)
+      : m_destructed(destructed) {}
+  ~CountedTask() override { ++m_destructed; }
+  void run() override {}
+
+private:
+  std::atomic<int> &m_destructed;
+};
+
+/** Spawns a binary tree of tiny tasks, as MD box splitting does: each task
+ * does a little work then pushes its two children to the scheduler.
+ */
+class TreeTask : public Task {
+public:
+  TreeTask(ThreadScheduler &scheduler, std::atomic<size_t> &count,
+           const int depth)
+      : m_scheduler(scheduler), m_count(count), m_depth(depth) {}
+  void run() override {
+    double x = 1.0;
+    for (int i = 0; i < 200; ++i)
+      x = x * 1.0000001 + 1e-9;
+    if (x > 0)
+      ++m_count;
+    if (m_depth > 0) {
+      m_scheduler.push(new TreeTask(m_scheduler, m_count, m_depth - 1));
+      m_scheduler.push(new TreeTask(m_scheduler, m_count, m_depth - 1));
+    }
+  }
+
+private:
+  ThreadScheduler &m_scheduler;
+  std::atomic<size_t> &m_count;
+  const int m_depth;
+};
+
+/** Run a tree of tasks through a thread pool
+ * @return the number of tasks run
+ */
+size_t runTree(ThreadScheduler *scheduler, const size_t numThreads,
+               const int depth, const int numRoots) {
+  std::atomic<size_t> count(0);
+  ThreadPool pool(scheduler, numThreads);
+  for (int i = 0; i < numRoots; ++i)
+    scheduler->push(new TreeTask(*scheduler, count, depth));
+  pool.joinAll();
+  return count;
+}
+
+void throwingFunction() { throw std::runtime_error("failed task"); }
+
+/// @return the number of tasks in a tree of a given depth
+size_t treeSize(const int depth) { return (size_t(1) << (depth + 1)) - 1; }
+} // namespace
+
+class ThreadSchedulerWorkStealingTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ThreadSchedulerWorkStealingTest *createSuite() {
+    return new ThreadSchedulerWorkStealingTest();
+  }
+  static void destroySuite(ThreadSchedulerWorkStealingTest *suite) {
+    delete suite;
+  }
+
+  void test_push_size_and_clear() {
+    std::atomic<int> destructed(0);
+    ThreadSchedulerWorkStealing scheduler(3);
+    TS_ASSERT_EQUALS(scheduler.numberOfQueues(), 3);
+    TS_ASSERT(scheduler.empty());
+    for (int i = 0; i < 5; ++i)
+      scheduler.push(new CountedTask(destructed));
+    TS_ASSERT_EQUALS(scheduler.size(), 5);
+    TS_ASSERT(!scheduler.empty());
+    scheduler.clear();
+    TS_ASSERT_EQUALS(scheduler.size(), 0);
+    TS_ASSERT_EQUALS(destructed.load(), 5);
+  }
+
+  void test_at_least_one_queue() {
+    ThreadSchedulerWorkStealing scheduler(0);
+    TS_ASSERT_EQUALS(scheduler.numberOfQueues(), 1);
+  }
+
+  void test_own_queue_newest_first_then_steal_oldest() {
+    std::atomic<int> destructed(0);
+    ThreadSchedulerWorkStealing scheduler(2);
+    Task *own1 = new CountedTask(destructed);
+    Task *own2 = new CountedTask(destructed);
+    Task *other1 = new CountedTask(destructed);
+    Task *other2 = new CountedTask(destructed);
+    scheduler.pushLocal(own1, 0);
+    scheduler.pushLocal(own2, 0);
+    scheduler.pushLocal(other1, 1);
+    scheduler.pushLocal(other2, 1);
+
+    std::vector<Task *> popped;
+    while (Task *task = scheduler.pop(0)) {
+      popped.push_back(task);
+      scheduler.finished(task, 0);
+    }
+    TS_ASSERT_EQUALS(popped, std::vector<Task *>({own2, own1, other1, other2}));
+    TS_ASSERT_EQUALS(scheduler.numberOfSteals(), 2);
+    for (auto task : popped)
+      delete task;
+  }
+
+  void test_tasks_pushed_by_a_running_task_stay_on_its_thread() {
+    std::atomic<int> destructed(0);
+    ThreadSchedulerWorkStealing scheduler(4);
+    scheduler.pushLocal(new CountedTask(destructed), 2);
+    Task *running = scheduler.pop(2);
+    // While the task runs, its children go to queue 2
+    for (int i = 0; i < 3; ++i)
+      scheduler.push(new CountedTask(destructed));
+    scheduler.finished(running, 2);
+    delete running;
+    for (int i = 0; i < 3; ++i) {
+      Task *child = scheduler.pop(2);
+      scheduler.finished(child, 2);
+      delete child;
+    }
+    TS_ASSERT_EQUALS(scheduler.numberOfSteals(), 0);
+    TS_ASSERT(scheduler.empty());
+  }
+
+  void test_tasks_pushed_from_outside_are_dealt_to_all_queues() {
+    std::atomic<int> destructed(0);
+    ThreadSchedulerWorkStealing scheduler(4);
+    for (int i = 0; i < 4; ++i)
+      scheduler.push(new CountedTask(destructed));
+    for (size_t thread = 0; thread < 4; ++thread) {
+      Task *task = scheduler.pop(thread);
+      TS_ASSERT(task);
+      scheduler.finished(task, thread);
+      delete task;
+    }
+    TS_ASSERT_EQUALS(scheduler.numberOfSteals(), 0);
+  }
+
+  void test_ThreadPool_runs_all_spawned_tasks() {
+    const int depth = 10;
+    TS_ASSERT_EQUALS(runTree(new ThreadSchedulerWorkStealing(4), 4, depth, 3),
+                     3 * treeSize(depth));
+  }
+
+  void test_ThreadPool_rethrows_exceptions() {
+    auto scheduler = new ThreadSchedulerWorkStealing(2);
+    ThreadPool pool(scheduler, 2);
+    for (int i = 0; i < 10; ++i)
+      scheduler->push(new FunctionTask(throwingFunction));
+    TS_ASSERT_THROWS(pool.joinAll(), std::runtime_error);
+  }
+};
+
+/** Compares the schedulers on a large number of tiny tasks that spawn further
+ * tasks, the pattern of MDGridBox::splitAllIfNeeded.
+ */
+class ThreadSchedulerWorkStealingTestPerformance : public CxxTest::TestSuite {
+public:
+  static ThreadSchedulerWorkStealingTestPerformance *createSuite() {
+    return new ThreadSchedulerWorkStealingTestPerformance();
+  }
+  static void destroySuite(ThreadSchedulerWorkStealingTestPerformance *suite) {
+    delete suite;
+  }
+
+  ThreadSchedulerWorkStealingTestPerformance()
+      : m_numThreads(ThreadPool::getNumPhysicalCores()) {}
+
+  void test_FIFO() {
+    run(new ThreadSchedulerFIFO());
+  }
+
+  void test_LIFO() {
+    run(new ThreadSchedulerLIFO());
+  }
+
+  void test_WorkStealing() {
+    run(new ThreadSchedulerWorkStealing(m_numThreads));
+  }
+
+private:
+  void run(ThreadScheduler *scheduler) {
+    const int depth = 17;
+    const int numRoots = 8;
+    TS_ASSERT_EQUALS(runTree(scheduler, m_numThreads, depth, numRoots),
+                     numRoots * treeSize(depth));
+  }
+
+  const size_t m_numThreads;
+};
+
+#endif /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_ */
@@ -21,6 +21,13 @@ namespace LiveData {
   A call to capture() starts the process of capturing the stream on a separate
   thread.
 
+  Large event messages are decoded by several threads, each adding the events
+  of its own share of the spectra, so no locking is needed between them. The
+  events are grouped by thread before the buffers are locked, so the lock is
+  only held while the events are added. The buffers are double-buffered:
+  extractData() swaps in a spare set and prepares the next spare after
+  capturing has resumed.
+
   Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
   National Laboratory & European Spallation Source
 
@@ -51,7 +58,8 @@ public:
                           const std::string &eventTopic,
                           const std::string &runInfoTopic,
                           const std::string &spDetTopic,
-                          const std::string &sampleEnvTopic);
+                          const std::string &sampleEnvTopic,
+                          const size_t nshards = 0);
   ~KafkaEventStreamDecoder();
   KafkaEventStreamDecoder(const KafkaEventStreamDecoder &) = delete;
   KafkaEventStreamDecoder &operator=(const KafkaEventStreamDecoder &) = delete;
@@ -69,6 +77,8 @@ public:
   bool hasData() const noexcept;
   int runNumber() const noexcept { return m_runNumber; }
   bool hasReachedEndOfRun() noexcept;
+  /// Number of threads that decode a large event message
+  size_t numberOfShards() const noexcept { return m_nshards; }
   ///@}
 
   ///@name Callbacks
@@ -96,6 +106,8 @@ private:
   void captureImplExcept();
 
   void initLocalCaches();
+  void initSpectrumIndexTable();
+  size_t workspaceIndex(const int32_t spectrumNumber) const;
   DataObjects::EventWorkspace_sptr createBufferWorkspace(const size_t nspectra,
                                                          const int32_t *spec,
                                                          const int32_t *udet,
@@ -110,7 +122,9 @@ private:
   void eventDataFromMessage(const std::string &buffer);
   void sampleDataFromMessage(const std::string &buffer);
 
-  API::Workspace_sptr extractDataImpl();
+  std::vector<DataObjects::EventWorkspace_sptr> extractDataImpl();
+  void prepareSpareBuffers(
+      const std::vector<DataObjects::EventWorkspace_sptr> &extracted);
 
   /// Broker to use to subscribe to topics
   std::shared_ptr<IKafkaBroker> m_broker;
@@ -123,10 +137,29 @@ private:
   std::atomic<bool> m_interrupt;
   /// Subscriber for the event stream
   std::unique_ptr<IKafkaStreamSubscriber> m_eventStream;
+  /// Number of threads decoding a large event message
+  const size_t m_nshards;
   /// Local event workspace buffers
   std::vector<DataObjects::EventWorkspace_sptr> m_localEvents;
+  /// Buffers swapped in by the next extraction, guarded by m_extractMutex
+  std::vector<DataObjects::EventWorkspace_sptr> m_spareEvents;
   /// Mapping of spectrum number to workspace index.
   spec2index_map m_specToIdx;
+  /// Workspace index of each spectrum number from m_minSpectrumNumber, if
+  /// the spectrum numbers are dense enough
+  std::vector<size_t> m_specToIdxTable;
+  /// Spectrum number of the first entry of m_specToIdxTable
+  int32_t m_minSpectrumNumber;
+  /// Workspace index of each event of the message being decoded
+  std::vector<size_t> m_eventIndices;
+  /// Where the next event of each block of the message goes in
+  /// m_sortedEvents, for each shard
+  std::vector<size_t> m_shardPositions;
+  /// Start of the events of each shard in m_sortedEvents, and their end
+  std::vector<size_t> m_shardStart;
+  /// The events of the message being decoded with their workspace index,
+  /// grouped by shard
+  std::vector<std::pair<size_t, Types::Event::TofEvent>> m_sortedEvents;
   /// Start time of the run
   Types::Core::DateAndTime m_runStart;
   /// Subscriber for the run info stream
@@ -140,6 +173,8 @@ private:
   std::thread m_thread;
   /// Mutex protecting event buffers
   mutable std::mutex m_mutex;
+  /// Mutex serializing extractions and protecting the spare buffers
+  std::mutex m_extractMutex;
   /// Mutex protecting the wait flag
   mutable std::mutex m_waitMutex;
   /// Mutex protecting the runStatusSeen flag
@@ -6,6 +6,8 @@
 #include "MantidKernel/DateAndTime.h"
 #include "MantidAPI/ILiveListener.h"
 
+#include <set>
+
 namespace Mantid {
 namespace LiveData {
 
@@ -58,6 +60,9 @@ protected:
   Mantid::API::IAlgorithm_sptr makeAlgorithm(bool postProcessing);
 
   bool hasPostProcessing() const;
+  bool hasIncrementalPostProcessing() const;
+  bool hasExplicitBinBoundaries(const std::string &properties) const;
+  static const std::set<std::string> &incrementalPostProcessingAlgorithms();
 
   /// Live listener
   Mantid::API::ILiveListener_sptr m_listener;
@@ -53,12 +53,14 @@ private:
   void init() override;
 
   Mantid::API::Workspace_sptr runProcessing(Mantid::API::Workspace_sptr inputWS,
-                                            bool PostProcess);
+                                            bool PostProcess, bool ChunkOnly);
   Mantid::API::Workspace_sptr processChunk(Mantid::API::Workspace_sptr chunkWS);
   void runPostProcessing();
+  void runIncrementalPostProcessing(Mantid::API::Workspace_sptr chunkWS);
 
   void replaceChunk(Mantid::API::Workspace_sptr chunkWS);
-  void addChunk(Mantid::API::Workspace_sptr chunkWS);
+  void addChunk(Mantid::API::Workspace_sptr accumWS,
+                Mantid::API::Workspace_sptr chunkWS);
   void addMatrixWSChunk(const std::string &algoName,
                         API::Workspace_sptr accumWS,
                         API::Workspace_sptr chunkWS);
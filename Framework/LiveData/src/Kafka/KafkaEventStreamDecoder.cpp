@@ -6,6 +6,7 @@
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidKernel/DateAndTimeHelpers.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/OptionalBool.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/UnitFactory.h"
@@ -22,6 +23,9 @@ GCC_DIAG_OFF(conversion)
 #include "private/Schema/f142_logdata_generated.h"
 GCC_DIAG_ON(conversion)
 
+#include <algorithm>
+#include <limits>
+
 using namespace Mantid::Types;
 
 namespace {
@@ -39,6 +43,12 @@ const std::string SAMPLE_MESSAGE_ID = "f142";
 
 const std::chrono::seconds MAX_LATENCY(1);
 
+/// Smallest number of events of a message worth giving to another thread
+const size_t MIN_EVENTS_PER_SHARD = 8192;
+
+/// Workspace index of events whose spectrum number is not in the mapping
+const size_t INVALID_INDEX = std::numeric_limits<size_t>::max();
+
 /**
  * Append sample log data to existing log or create a new log if one with
  * specified name does not already exist
@@ -77,15 +87,22 @@ using Types::Core::DateAndTime;
  * @param eventTopic The name of the topic streaming the event data
  * @param spDetTopic The name of the topic streaming the spectrum-detector
  * run mapping
+ * @param nshards The number of threads decoding a large event message, each
+ * filling its own range of spectra. 0 uses one per OpenMP thread.
  */
 KafkaEventStreamDecoder::KafkaEventStreamDecoder(
     std::shared_ptr<IKafkaBroker> broker, const std::string &eventTopic,
     const std::string &runInfoTopic, const std::string &spDetTopic,
-    const std::string &sampleEnvTopic)
+    const std::string &sampleEnvTopic, const size_t nshards)
     : m_broker(broker), m_eventTopic(eventTopic), m_runInfoTopic(runInfoTopic),
       m_spDetTopic(spDetTopic), m_sampleEnvTopic(sampleEnvTopic),
-      m_interrupt(false), m_localEvents(), m_specToIdx(), m_runStart(),
-      m_runNumber(-1), m_thread(), m_capturing(false), m_exception(),
+      m_interrupt(false),
+      m_nshards(nshards > 0 ? nshards
+                            : static_cast<size_t>(PARALLEL_GET_MAX_THREADS)),
+      m_localEvents(), m_spareEvents(), m_specToIdx(), m_specToIdxTable(),
+      m_minSpectrumNumber(0), m_eventIndices(), m_shardPositions(),
+      m_shardStart(), m_sortedEvents(), m_runStart(), m_runNumber(-1),
+      m_thread(), m_capturing(false), m_exception(),
       m_extractWaiting(false), m_cbIterationEnd([] {}), m_cbError([] {}) {}
 
 /**
@@ -177,7 +194,8 @@ bool KafkaEventStreamDecoder::hasReachedEndOfRun() noexcept {
 /**
  * Check for an exception thrown by the background thread and rethrow
  * it if necessary. If no error occurred swap the current internal buffer
- * for a fresh one and return the old buffer.
+ * for a fresh one and return the old buffer. Capturing only waits for the
+ * swap; the buffer for the next extraction is prepared afterwards.
  * @return A pointer to the data collected since the last call to this
  * method
  */
@@ -186,39 +204,66 @@ API::Workspace_sptr KafkaEventStreamDecoder::extractData() {
     throw * m_exception;
   }
 
+  std::lock_guard<std::mutex> extractLock(m_extractMutex);
   m_extractWaiting = true;
   m_cv.notify_one();
 
-  auto workspace_ptr = extractDataImpl();
+  auto buffers = extractDataImpl();
 
   m_extractWaiting = false;
   m_cv.notify_one();
 
-  return workspace_ptr;
+  prepareSpareBuffers(buffers);
+  if (buffers.size() == 1)
+    return buffers.front();
+  auto group = boost::make_shared<API::WorkspaceGroup>();
+  for (auto &filledBuffer : buffers)
+    group->addWorkspace(filledBuffer);
+  return group;
 }
 
 // -----------------------------------------------------------------------------
 // Private members
 // -----------------------------------------------------------------------------
 
-API::Workspace_sptr KafkaEventStreamDecoder::extractDataImpl() {
+/**
+ * Swap the filled buffers for the spare ones, bringing the logs of the spare
+ * buffers up to date. Must be called with m_extractMutex held.
+ * @return The filled buffers, one per period
+ */
+std::vector<DataObjects::EventWorkspace_sptr>
+KafkaEventStreamDecoder::extractDataImpl() {
   std::lock_guard<std::mutex> lock(m_mutex);
-  if (m_localEvents.size() == 1) {
-    auto temp = createBufferWorkspace(m_localEvents.front());
-    std::swap(m_localEvents.front(), temp);
-    return temp;
-  } else if (m_localEvents.size() > 1) {
-    auto group = boost::make_shared<API::WorkspaceGroup>();
-    size_t index(0);
-    for (auto &filledBuffer : m_localEvents) {
-      auto temp = createBufferWorkspace(filledBuffer);
-      std::swap(m_localEvents[index++], temp);
-      group->addWorkspace(temp);
-    }
-    return group;
-  } else {
+  if (m_localEvents.empty()) {
     throw Exception::NotYet("Local buffers not initialized.");
   }
+  if (m_spareEvents.size() != m_localEvents.size()) {
+    m_spareEvents.clear();
+    for (auto &filledBuffer : m_localEvents)
+      m_spareEvents.push_back(createBufferWorkspace(filledBuffer));
+  } else {
+    for (size_t i = 0; i < m_localEvents.size(); ++i) {
+      auto &run = m_spareEvents[i]->mutableRun();
+      run = m_localEvents[i]->run();
+      run.clearOutdatedTimeSeriesLogValues();
+    }
+  }
+  std::swap(m_localEvents, m_spareEvents);
+  std::vector<DataObjects::EventWorkspace_sptr> filled;
+  std::swap(filled, m_spareEvents);
+  return filled;
+}
+
+/**
+ * Create the buffers swapped in by the next extraction. Must be called with
+ * m_extractMutex held.
+ * @param extracted The buffers that have just been extracted
+ */
+void KafkaEventStreamDecoder::prepareSpareBuffers(
+    const std::vector<DataObjects::EventWorkspace_sptr> &extracted) {
+  m_spareEvents.clear();
+  for (auto &filledBuffer : extracted)
+    m_spareEvents.push_back(createBufferWorkspace(filledBuffer));
 }
 
 /**
@@ -505,7 +550,7 @@ void KafkaEventStreamDecoder::eventDataFromMessage(const std::string &buffer) {
   DateAndTime pulseTime = static_cast<int64_t>(eventMsg->pulse_time());
   const auto &tofData = *(eventMsg->time_of_flight());
   const auto &detData = *(eventMsg->detector_id());
-  auto nEvents = tofData.size();
+  const size_t nEvents = tofData.size();
 
   if (eventMsg->facility_specific_data_type() != FacilityData_ISISData) {
     throw std::runtime_error("KafkaEventStreamDecoder only knows how to "
@@ -514,19 +559,117 @@ void KafkaEventStreamDecoder::eventDataFromMessage(const std::string &buffer) {
   auto ISISMsg =
       static_cast<const ISISData *>(eventMsg->facility_specific_data());
 
+  // Large messages are split by workspace index, index modulo the number of
+  // shards, one shard per thread, so that every spectrum is only ever touched
+  // by one thread. The events are first bucketed by shard with a counting
+  // sort over contiguous blocks of the message, which keeps the order of the
+  // events of each spectrum. The buffer is only locked to add the events.
+  const auto nshards =
+      std::max(std::min(m_nshards, nEvents / MIN_EVENTS_PER_SHARD), size_t(1));
+  const auto blockSize = (nEvents + nshards - 1) / nshards;
+  m_eventIndices.resize(nEvents);
+  // Number of events of each block for each shard, later their positions
+  m_shardPositions.assign(nshards * nshards, 0);
+  PARALLEL_FOR_IF(nshards > 1)
+  for (int b = 0; b < static_cast<int>(nshards); ++b) {
+    const auto block = static_cast<size_t>(b);
+    auto *positions = &m_shardPositions[block * nshards];
+    const auto end = std::min(nEvents, (block + 1) * blockSize);
+    for (auto i = block * blockSize; i < end; ++i) {
+      const auto detector =
+          static_cast<int32_t>(detData[static_cast<uint32_t>(i)]);
+      const auto index = workspaceIndex(detector);
+      m_eventIndices[i] = index;
+      if (index != INVALID_INDEX)
+        ++positions[index % nshards];
+    }
+  }
+  m_shardStart.resize(nshards + 1);
+  size_t position = 0;
+  for (size_t shard = 0; shard < nshards; ++shard) {
+    m_shardStart[shard] = position;
+    for (size_t block = 0; block < nshards; ++block) {
+      auto &count = m_shardPositions[block * nshards + shard];
+      const auto blockCount = count;
+      count = position;
+      position += blockCount;
+    }
+  }
+  m_shardStart[nshards] = position;
+  m_sortedEvents.resize(position);
+  PARALLEL_FOR_IF(nshards > 1)
+  for (int b = 0; b < static_cast<int>(nshards); ++b) {
+    const auto block = static_cast<size_t>(b);
+    auto *positions = &m_shardPositions[block * nshards];
+    const auto end = std::min(nEvents, (block + 1) * blockSize);
+    for (auto i = block * blockSize; i < end; ++i) {
+      const auto index = m_eventIndices[i];
+      if (index == INVALID_INDEX)
+        continue;
+      // nanoseconds to microseconds
+      const double tof =
+          static_cast<double>(tofData[static_cast<uint32_t>(i)]) * 1e-3;
+      m_sortedEvents[positions[index % nshards]++] =
+          std::make_pair(index, TofEvent(tof, pulseTime));
+    }
+  }
+
   std::lock_guard<std::mutex> lock(m_mutex);
   auto &periodBuffer =
       *m_localEvents[static_cast<size_t>(ISISMsg->period_number())];
   auto &mutableRunInfo = periodBuffer.mutableRun();
   mutableRunInfo.getTimeSeriesProperty<double>(PROTON_CHARGE_PROPERTY)
       ->addValue(pulseTime, ISISMsg->proton_charge());
-  for (decltype(nEvents) i = 0; i < nEvents; ++i) {
-    auto &spectrum =
-        periodBuffer.getSpectrum(m_specToIdx[static_cast<int32_t>(detData[i])]);
-    spectrum.addEventQuickly(TofEvent(static_cast<double>(tofData[i]) *
-                                          1e-3, // nanoseconds to microseconds
-                                      pulseTime));
+  PARALLEL_FOR_IF(nshards > 1)
+  for (int shard = 0; shard < static_cast<int>(nshards); ++shard) {
+    const auto end = m_shardStart[static_cast<size_t>(shard) + 1];
+    for (auto i = m_shardStart[static_cast<size_t>(shard)]; i < end; ++i) {
+      const auto &event = m_sortedEvents[i];
+      periodBuffer.getSpectrum(event.first).addEventQuickly(event.second);
+    }
+  }
+}
+
+/**
+ * Build a lookup table from spectrum number to workspace index if the
+ * spectrum numbers are dense enough, otherwise m_specToIdx is used
+ */
+void KafkaEventStreamDecoder::initSpectrumIndexTable() {
+  m_specToIdxTable.clear();
+  if (m_specToIdx.empty())
+    return;
+  auto range = std::minmax_element(
+      m_specToIdx.cbegin(), m_specToIdx.cend(),
+      [](const spec2index_map::value_type &a,
+         const spec2index_map::value_type &b) { return a.first < b.first; });
+  m_minSpectrumNumber = range.first->first;
+  const auto tableSize =
+      static_cast<size_t>(range.second->first - m_minSpectrumNumber) + 1;
+  if (tableSize > 4 * m_specToIdx.size())
+    return;
+  m_specToIdxTable.assign(tableSize, INVALID_INDEX);
+  for (const auto &specIndex : m_specToIdx)
+    m_specToIdxTable[static_cast<size_t>(specIndex.first -
+                                         m_minSpectrumNumber)] =
+        specIndex.second;
+}
+
+/**
+ * @param spectrumNumber A spectrum number from an event message
+ * @return The workspace index of the spectrum, or INVALID_INDEX if it is not
+ * in the spectrum-detector mapping
+ */
+size_t
+KafkaEventStreamDecoder::workspaceIndex(const int32_t spectrumNumber) const {
+  if (!m_specToIdxTable.empty()) {
+    const auto offset = static_cast<int64_t>(spectrumNumber) -
+                        static_cast<int64_t>(m_minSpectrumNumber);
+    if (offset < 0 || offset >= static_cast<int64_t>(m_specToIdxTable.size()))
+      return INVALID_INDEX;
+    return m_specToIdxTable[static_cast<size_t>(offset)];
   }
+  auto search = m_specToIdx.find(spectrumNumber);
+  return search != m_specToIdx.end() ? search->second : INVALID_INDEX;
 }
 
 KafkaEventStreamDecoder::RunStartStruct
@@ -615,6 +758,7 @@ void KafkaEventStreamDecoder::initLocalCaches() {
 
   // Cache spec->index mapping. We assume it is the same across all periods
   m_specToIdx = eventBuffer->getSpectrumToWorkspaceIndexMap();
+  initSpectrumIndexTable();
 
   // Buffers for each period
   const size_t nperiods = runStartData.nPeriods;
@@ -623,7 +767,9 @@ void KafkaEventStreamDecoder::initLocalCaches() {
         "KafkaEventStreamDecoder - Message has n_periods==0. This is "
         "an error by the data producer");
   }
+  std::lock_guard<std::mutex> extractLock(m_extractMutex);
   std::lock_guard<std::mutex> lock(m_mutex);
+  m_spareEvents.clear();
   m_localEvents.resize(nperiods);
   m_localEvents[0] = eventBuffer;
   for (size_t i = 1; i < nperiods; ++i) {
@@ -135,6 +135,17 @@ void LiveDataAlgorithm::initProps() {
                                 FileProperty::OptionalLoad, "py"),
       " Python script that will be run to process the accumulated data.");
 
+  declareProperty(
+      "IncrementalPostProcessing", false,
+      "Post-process only each new chunk and add it to the previous output, "
+      "instead of post-processing the whole accumulation workspace on every "
+      "update.\n"
+      "Only used with the Add AccumulationMethod and a "
+      "PostProcessingAlgorithm that is linear in the data: " +
+          Strings::join(incrementalPostProcessingAlgorithms().begin(),
+                        incrementalPostProcessingAlgorithms().end(), ", ") +
+          ". Rebin needs explicit bin boundaries.");
+
   std::vector<std::string> runOptions{"Restart", "Stop", "Rename"};
   declareProperty("RunTransitionBehavior", "Restart",
                   boost::make_shared<StringListValidator>(runOptions),
@@ -185,6 +196,50 @@ bool LiveDataAlgorithm::hasPostProcessing() const {
           !this->getPropertyValue("PostProcessingScriptFilename").empty());
 }
 
+//----------------------------------------------------------------------------------------------
+/** @return the post-processing algorithms that can be applied to each chunk
+ * and summed, giving the same result as post-processing the sum of the
+ * chunks. ConvertToMatrixWorkspace is not one: it keeps the X of each chunk,
+ * which need not match that of the previous output.
+ */
+const std::set<std::string> &
+LiveDataAlgorithm::incrementalPostProcessingAlgorithms() {
+  static const std::set<std::string> algorithms{
+      "ConvertUnits", "CropWorkspace", "ExtractSpectra", "GroupDetectors",
+      "Rebin", "SumSpectra"};
+  return algorithms;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Check that Rebin properties give the boundaries of the bins. A bin width
+ * alone bins each chunk from its own data range, which changes from chunk to
+ * chunk.
+ * @param properties :: the Rebin properties, as a single string
+ * @return true if Params holds a start, a step and an end
+ */
+bool LiveDataAlgorithm::hasExplicitBinBoundaries(
+    const std::string &properties) const {
+  auto rebin = AlgorithmManager::Instance().createUnmanaged("Rebin");
+  rebin->initialize();
+  try {
+    rebin->setPropertiesWithString(properties,
+                                   {"InputWorkspace", "OutputWorkspace"});
+  } catch (std::exception &) {
+    return false;
+  }
+  const std::vector<double> params = rebin->getProperty("Params");
+  return params.size() >= 3;
+}
+
+//----------------------------------------------------------------------------------------------
+/** @return true if the post-processing step is to be applied to each new
+ * chunk only, its result being added to the previous output
+ */
+bool LiveDataAlgorithm::hasIncrementalPostProcessing() const {
+  const bool incremental = this->getProperty("IncrementalPostProcessing");
+  return incremental && this->hasPostProcessing();
+}
+
 //----------------------------------------------------------------------------------------------
 /**
  * Return or create the ILiveListener for this algorithm.
@@ -397,6 +452,25 @@ std::map<std::string, std::string> LiveDataAlgorithm::validateInputs() {
       out["PostProcessingScript"] = msg;
       out["PostProcessingScriptFilename"] = msg;
     }
+
+    if (this->hasIncrementalPostProcessing()) {
+      const auto &algorithms = incrementalPostProcessingAlgorithms();
+      if (algorithms.count(getPropertyValue("PostProcessingAlgorithm")) == 0)
+        out["IncrementalPostProcessing"] =
+            "Incremental post-processing needs one of the "
+            "PostProcessingAlgorithms " +
+            Strings::join(algorithms.begin(), algorithms.end(), ", ") + ".";
+      else if (getPropertyValue("AccumulationMethod") != "Add")
+        out["IncrementalPostProcessing"] =
+            "Incremental post-processing needs the Add AccumulationMethod.";
+      else if (getPropertyValue("PostProcessingAlgorithm") == "Rebin" &&
+               !hasExplicitBinBoundaries(
+                   getPropertyValue("PostProcessingProperties")))
+        out["IncrementalPostProcessing"] =
+            "Incremental post-processing with Rebin needs Params giving "
+            "the bin boundaries (start, step, end), so that every chunk is "
+            "binned the same way.";
+    }
   }
 
   // For StartLiveData and MonitorLiveData, make sure another thread is not
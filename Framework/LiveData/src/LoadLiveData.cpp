@@ -5,6 +5,7 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidKernel/CPUTimer.h"
 #include "MantidKernel/ReadLock.h"
+#include "MantidKernel/Timer.h"
 #include "MantidKernel/WriteLock.h"
 #include "MantidLiveData/Exception.h"
 
@@ -79,12 +80,14 @@ void LoadLiveData::init() { this->initProps(); }
  *
  * @param inputWS :: workspace being processed
  * @param PostProcess :: flag, TRUE if doing the post-processing
+ * @param ChunkOnly :: flag, TRUE if inputWS is a chunk rather than the
+ *accumulation workspace. A chunk is processed in-place under an anonymous name.
  * @return the processed workspace. Will point to inputWS if no processing is to
  *do
  */
 Mantid::API::Workspace_sptr
 LoadLiveData::runProcessing(Mantid::API::Workspace_sptr inputWS,
-                            bool PostProcess) {
+                            bool PostProcess, bool ChunkOnly) {
   if (!inputWS)
     throw std::runtime_error(
         "LoadLiveData::runProcessing() called for an empty input workspace.");
@@ -109,7 +112,7 @@ LoadLiveData::runProcessing(Mantid::API::Workspace_sptr inputWS,
     std::string outputName = inputName;
 
     // Except, no need for anonymous names with the post-processing
-    if (PostProcess) {
+    if (PostProcess && !ChunkOnly) {
       inputName = this->getPropertyValue("AccumulationWorkspace");
       outputName = this->getPropertyValue("OutputWorkspace");
     }
@@ -160,7 +163,7 @@ LoadLiveData::runProcessing(Mantid::API::Workspace_sptr inputWS,
           " Algorithm's OutputWorkspace property is not a WorkspaceProperty!");
     Workspace_sptr temp = wsProp->getWorkspace();
 
-    if (!PostProcess) {
+    if (ChunkOnly) {
       if (!temp) {
         // a group workspace cannot be returned by wsProp
         temp = AnalysisDataService::Instance().retrieve(inputName);
@@ -189,7 +192,7 @@ LoadLiveData::runProcessing(Mantid::API::Workspace_sptr inputWS,
 Mantid::API::Workspace_sptr
 LoadLiveData::processChunk(Mantid::API::Workspace_sptr chunkWS) {
   try {
-    return runProcessing(chunkWS, false);
+    return runProcessing(chunkWS, false, true);
   } catch (...) {
     g_log.error("While processing chunk:");
     throw;
@@ -203,23 +206,44 @@ LoadLiveData::processChunk(Mantid::API::Workspace_sptr chunkWS) {
  */
 void LoadLiveData::runPostProcessing() {
   try {
-    m_outputWS = runProcessing(m_accumWS, true);
+    m_outputWS = runProcessing(m_accumWS, true, false);
   } catch (...) {
     g_log.error("While post processing:");
     throw;
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Perform the PostProcessing steps on a new chunk only and add the result to
+ * the previous output. Only valid for post-processing that is linear in the
+ * data, see LiveDataAlgorithm::incrementalPostProcessingAlgorithms().
+ * Updates the m_outputWS member.
+ *
+ * @param chunkWS :: processed live data chunk workspace, already added to
+ *m_accumWS. It may be modified.
+ */
+void LoadLiveData::runIncrementalPostProcessing(
+    Mantid::API::Workspace_sptr chunkWS) {
+  try {
+    auto processed = runProcessing(chunkWS, true, true);
+    addChunk(m_outputWS, processed);
+  } catch (...) {
+    g_log.error("While post processing the chunk:");
+    throw;
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Accumulate the data by adding (summing) to the output workspace.
  * Calls the Plus algorithm
- * Sets m_accumWS.
  *
+ * @param accumWS :: workspace the chunk is added to, normally m_accumWS
  * @param chunkWS :: processed live data chunk workspace
  */
-void LoadLiveData::addChunk(Mantid::API::Workspace_sptr chunkWS) {
+void LoadLiveData::addChunk(Mantid::API::Workspace_sptr accumWS,
+                            Mantid::API::Workspace_sptr chunkWS) {
   // Acquire locks on the workspaces we use
-  WriteLock _lock1(*m_accumWS);
+  WriteLock _lock1(*accumWS);
   ReadLock _lock2(*chunkWS);
 
   // Choose the appropriate algorithm to add chunks
@@ -234,7 +258,7 @@ void LoadLiveData::addChunk(Mantid::API::Workspace_sptr chunkWS) {
 
   if (gws) {
     WorkspaceGroup_sptr accum_gws =
-        boost::dynamic_pointer_cast<WorkspaceGroup>(m_accumWS);
+        boost::dynamic_pointer_cast<WorkspaceGroup>(accumWS);
     if (!accum_gws) {
       throw std::runtime_error("Two workspace groups are expected.");
     }
@@ -250,7 +274,7 @@ void LoadLiveData::addChunk(Mantid::API::Workspace_sptr chunkWS) {
     }
   } else {
     // just add the chunk
-    addMatrixWSChunk(algoName, m_accumWS, chunkWS);
+    addMatrixWSChunk(algoName, accumWS, chunkWS);
   }
 }
 
@@ -411,6 +435,10 @@ void LoadLiveData::exec() {
     m_accumWS = m_outputWS;
   }
 
+  // Time each stage of the update
+  Timer timer;
+  double processingTime(0.0), accumulationTime(0.0), postProcessingTime(0.0);
+
   // Get or create the live listener
   ILiveListener_sptr listener = this->getLiveListener();
 
@@ -442,6 +470,7 @@ void LoadLiveData::exec() {
   this->setPropertyValue("LastTimeStamp", lastTimeStamp.toISO8601String());
 
   // Now we process the chunk
+  timer.reset();
   Workspace_sptr processed = this->processChunk(chunkWS);
 
   bool PreserveEvents = this->getProperty("PreserveEvents");
@@ -490,6 +519,13 @@ void LoadLiveData::exec() {
     accum = "Replace";
 
   g_log.notice() << "Performing the " << accum << " operation.\n";
+  processingTime = timer.elapsed();
+
+  // Only the new chunk needs post-processing if the previous output is the
+  // post-processed sum of the previous chunks
+  const bool incremental = accum == "Add" && m_outputWS &&
+                           m_outputWS != m_accumWS &&
+                           this->hasIncrementalPostProcessing();
 
   // Perform the accumulation and set the AccumulationWorkspace workspace
   if (accum == "Replace")
@@ -498,13 +534,18 @@ void LoadLiveData::exec() {
     this->appendChunk(processed);
   else
     // Default to Add.
-    this->addChunk(processed);
+    this->addChunk(m_accumWS, processed);
+  accumulationTime = timer.elapsed();
 
   // At this point, m_accumWS is set.
 
   if (this->hasPostProcessing()) {
     // ----------- Run post-processing -------------
-    this->runPostProcessing();
+    if (incremental)
+      this->runIncrementalPostProcessing(processed);
+    else
+      this->runPostProcessing();
+    postProcessingTime = timer.elapsed();
     // Set both output workspaces
     this->setProperty("AccumulationWorkspace", m_accumWS);
     this->setProperty("OutputWorkspace", m_outputWS);
@@ -515,6 +556,14 @@ void LoadLiveData::exec() {
     this->setProperty("OutputWorkspace", m_outputWS);
   }
 
+  g_log.notice() << "Live data update took " << processingTime
+                 << " s for chunk processing, " << accumulationTime
+                 << " s for accumulation";
+  if (this->hasPostProcessing())
+    g_log.notice() << " and " << postProcessingTime << " s for "
+                   << (incremental ? "incremental " : "") << "post-processing";
+  g_log.notice() << ".\n";
+
   // Output group requires some additional handling
   WorkspaceGroup_sptr out_gws =
       boost::dynamic_pointer_cast<WorkspaceGroup>(m_outputWS);
@@ -132,6 +132,57 @@ public:
     }
   }
 
+  void test_Large_Messages_Are_Decoded_By_Several_Threads() {
+    using namespace ISISKafkaTesting;
+    using Mantid::API::Workspace_sptr;
+    using Mantid::DataObjects::EventWorkspace;
+
+    const uint32_t nspectra(100), neventsPerMessage(50000);
+    auto broker =
+        std::make_shared<FakeKafkaBroker>(nspectra, neventsPerMessage);
+    auto decoder = createTestDecoder(broker, 4);
+    TS_ASSERT_EQUALS(4, decoder->numberOfShards());
+    startCapturing(*decoder, 3);
+
+    Workspace_sptr workspace;
+    TS_ASSERT_THROWS_NOTHING(workspace = decoder->extractData());
+    TS_ASSERT_THROWS_NOTHING(decoder->stopCapture());
+    auto eventWksp = boost::dynamic_pointer_cast<EventWorkspace>(workspace);
+    TS_ASSERT(eventWksp);
+    if (!eventWksp)
+      return;
+    TS_ASSERT_EQUALS(nspectra, eventWksp->getNumberHistograms());
+    const size_t nevents = eventWksp->getNumberEvents();
+    TS_ASSERT(nevents != 0);
+    TS_ASSERT_EQUALS(0, nevents % neventsPerMessage);
+    // Each message holds the same number of events for every spectrum
+    for (size_t i = 0; i < nspectra; ++i) {
+      TS_ASSERT_EQUALS(nevents / nspectra,
+                       eventWksp->getSpectrum(i).getNumberEvents());
+    }
+  }
+
+  void test_Extracting_Twice_Returns_New_Buffers() {
+    using namespace ISISKafkaTesting;
+    using Mantid::API::Workspace_sptr;
+
+    auto broker = std::make_shared<FakeKafkaBroker>(10, 100);
+    auto decoder = createTestDecoder(broker);
+    startCapturing(*decoder, 2);
+
+    Workspace_sptr first, second;
+    TS_ASSERT_THROWS_NOTHING(first = decoder->extractData());
+    TS_ASSERT_THROWS_NOTHING(second = decoder->extractData());
+    TS_ASSERT_THROWS_NOTHING(decoder->stopCapture());
+    TS_ASSERT(first);
+    TS_ASSERT(second);
+    TS_ASSERT_DIFFERS(first, second);
+    // The logs carry over to the swapped-in buffer
+    TS_ASSERT(boost::dynamic_pointer_cast<Mantid::API::MatrixWorkspace>(second)
+                  ->run()
+                  .hasProperty("proton_charge"));
+  }
+
   void test_End_Of_Run_Reported_After_Run_Stop_Reached() {
     using namespace ::testing;
     using namespace ISISKafkaTesting;
@@ -344,10 +395,11 @@ private:
   }
 
   std::unique_ptr<Mantid::LiveData::KafkaEventStreamDecoder>
-  createTestDecoder(std::shared_ptr<Mantid::LiveData::IKafkaBroker> broker) {
+  createTestDecoder(std::shared_ptr<Mantid::LiveData::IKafkaBroker> broker,
+                    const size_t nshards = 0) {
     using namespace Mantid::LiveData;
-    return Mantid::Kernel::make_unique<KafkaEventStreamDecoder>(broker, "", "",
-                                                                "", "");
+    return Mantid::Kernel::make_unique<KafkaEventStreamDecoder>(
+        broker, "", "", "", "", nshards);
   }
 
   void
@@ -395,4 +447,48 @@ private:
   uint8_t m_niterations = 0;
 };
 
+/** Measures the rate at which the decoder ingests large event messages served
+ * by a local fake broker, with one decoding thread and with one per core.
+ */
+class KafkaEventStreamDecoderTestPerformance : public CxxTest::TestSuite {
+public:
+  static KafkaEventStreamDecoderTestPerformance *createSuite() {
+    return new KafkaEventStreamDecoderTestPerformance();
+  }
+  static void destroySuite(KafkaEventStreamDecoderTestPerformance *suite) {
+    delete suite;
+  }
+
+  void test_single_thread_throughput() { measureThroughput(1); }
+
+  void test_sharded_throughput() { measureThroughput(0); }
+
+private:
+  void measureThroughput(const size_t nshards) {
+    using namespace Mantid::LiveData;
+    const uint32_t nspectra(100000), neventsPerMessage(500000);
+    const int nmessages(20);
+
+    auto broker = std::make_shared<ISISKafkaTesting::FakeKafkaBroker>(
+        nspectra, neventsPerMessage);
+    KafkaEventStreamDecoder decoder(broker, "", "", "", "", nshards);
+    std::mutex mutex;
+    std::condition_variable condition;
+    int niterations(0);
+    decoder.registerIterationEndCb([&]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (++niterations == nmessages)
+        condition.notify_one();
+    });
+
+    decoder.startCapture();
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      condition.wait(lock, [&]() { return niterations >= nmessages; });
+    }
+    decoder.stopCapture();
+    TS_ASSERT(decoder.extractData());
+  }
+};
+
 #endif /* MANTID_LIVEDATA_KAFKAEVENTSTREAMDECODERTEST_H_ */
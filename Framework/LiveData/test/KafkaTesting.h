@@ -3,6 +3,7 @@
 
 #include "MantidKernel/DateAndTimeHelpers.h"
 #include "MantidKernel/WarningSuppressions.h"
+#include "MantidKernel/make_unique.h"
 #include "MantidLiveData/Kafka/IKafkaBroker.h"
 #include "MantidLiveData/Kafka/IKafkaStreamSubscriber.h"
 #include "MantidTypes/Core/DateAndTime.h"
@@ -441,6 +442,152 @@ private:
   // These match the detector numbers in HRPDTEST_Definition.xml
   std::vector<int32_t> m_detid = {1001, 1002, 1100, 901000, 10100};
 };
+
+// -----------------------------------------------------------------------------
+// Fake ISIS event stream of large messages. Event i of a message is in
+// spectrum (i % nspectra) + 1.
+// -----------------------------------------------------------------------------
+class FakeLargeISISEventSubscriber
+    : public Mantid::LiveData::IKafkaStreamSubscriber {
+public:
+  FakeLargeISISEventSubscriber(uint32_t nspectra, uint32_t neventsPerMessage) {
+    flatbuffers::FlatBufferBuilder builder;
+    std::vector<uint32_t> spec(neventsPerMessage);
+    std::vector<uint32_t> tof(neventsPerMessage);
+    for (uint32_t i = 0; i < neventsPerMessage; ++i) {
+      spec[i] = (i % nspectra) + 1;
+      tof[i] = 1000 + (i * 7919) % 20000;
+    }
+    auto messageFlatbuf = CreateEventMessage(
+        builder, builder.CreateString("KafkaTesting"), 0, 1,
+        builder.CreateVector(tof), builder.CreateVector(spec),
+        FacilityData_ISISData,
+        CreateISISData(builder, 0, RunState_RUNNING, 0.5f).Union());
+    FinishEventMessageBuffer(builder, messageFlatbuf);
+    m_message.assign(reinterpret_cast<const char *>(builder.GetBufferPointer()),
+                     builder.GetSize());
+  }
+  void subscribe() override {}
+  void subscribe(int64_t offset) override { UNUSED_ARG(offset) }
+  void consumeMessage(std::string *message, int64_t &offset, int32_t &partition,
+                      std::string &topic) override {
+    assert(message);
+    *message = m_message;
+    UNUSED_ARG(offset);
+    UNUSED_ARG(partition);
+    UNUSED_ARG(topic);
+  }
+  std::unordered_map<std::string, std::vector<int64_t>>
+  getOffsetsForTimestamp(int64_t timestamp) override {
+    UNUSED_ARG(timestamp);
+    return {
+        std::pair<std::string, std::vector<int64_t>>("topic_name", {1, 2, 3})};
+  }
+  std::unordered_map<std::string, std::vector<int64_t>>
+  getCurrentOffsets() override {
+    std::unordered_map<std::string, std::vector<int64_t>> offsets;
+    return offsets;
+  }
+  void seek(const std::string &topic, uint32_t partition,
+            int64_t offset) override {
+    UNUSED_ARG(topic);
+    UNUSED_ARG(partition);
+    UNUSED_ARG(offset);
+  }
+
+private:
+  std::string m_message;
+};
+
+// -----------------------------------------------------------------------------
+// Fake spectra-detector stream mapping spectrum n to detector n
+// -----------------------------------------------------------------------------
+class FakeLargeSpDetStreamSubscriber
+    : public Mantid::LiveData::IKafkaStreamSubscriber {
+public:
+  explicit FakeLargeSpDetStreamSubscriber(uint32_t nspectra)
+      : m_nspectra(nspectra) {}
+  void subscribe() override {}
+  void subscribe(int64_t offset) override { UNUSED_ARG(offset) }
+  void consumeMessage(std::string *buffer, int64_t &offset, int32_t &partition,
+                      std::string &topic) override {
+    assert(buffer);
+    std::vector<int32_t> spec(m_nspectra);
+    for (uint32_t i = 0; i < m_nspectra; ++i)
+      spec[i] = static_cast<int32_t>(i + 1);
+    flatbuffers::FlatBufferBuilder builder;
+    auto specVector = builder.CreateVector(spec);
+    auto detIdsVector = builder.CreateVector(spec);
+    auto spdet = CreateSpectraDetectorMapping(
+        builder, specVector, detIdsVector, static_cast<int32_t>(m_nspectra));
+    FinishSpectraDetectorMappingBuffer(builder, spdet);
+    buffer->assign(reinterpret_cast<const char *>(builder.GetBufferPointer()),
+                   builder.GetSize());
+    UNUSED_ARG(offset);
+    UNUSED_ARG(partition);
+    UNUSED_ARG(topic);
+  }
+  std::unordered_map<std::string, std::vector<int64_t>>
+  getOffsetsForTimestamp(int64_t timestamp) override {
+    UNUSED_ARG(timestamp);
+    return {
+        std::pair<std::string, std::vector<int64_t>>("topic_name", {1, 2, 3})};
+  }
+  std::unordered_map<std::string, std::vector<int64_t>>
+  getCurrentOffsets() override {
+    std::unordered_map<std::string, std::vector<int64_t>> offsets;
+    return offsets;
+  }
+  void seek(const std::string &topic, uint32_t partition,
+            int64_t offset) override {
+    UNUSED_ARG(topic);
+    UNUSED_ARG(partition);
+    UNUSED_ARG(offset);
+  }
+
+private:
+  const uint32_t m_nspectra;
+};
+
+// -----------------------------------------------------------------------------
+// Local broker serving an endless stream of large event messages, for
+// measuring the throughput of the decoder without a Kafka server
+// -----------------------------------------------------------------------------
+class FakeKafkaBroker : public Mantid::LiveData::IKafkaBroker {
+public:
+  using IKafkaStreamSubscriber_uptr =
+      std::unique_ptr<Mantid::LiveData::IKafkaStreamSubscriber>;
+
+  FakeKafkaBroker(uint32_t nspectra, uint32_t neventsPerMessage)
+      : m_nspectra(nspectra), m_neventsPerMessage(neventsPerMessage) {}
+
+  IKafkaStreamSubscriber_uptr
+  subscribe(std::vector<std::string> topics,
+            Mantid::LiveData::SubscribeAtOption option) const override {
+    UNUSED_ARG(topics);
+    using Mantid::LiveData::SubscribeAtOption;
+    switch (option) {
+    case SubscribeAtOption::LASTONE:
+      return Mantid::Kernel::make_unique<FakeLargeSpDetStreamSubscriber>(
+          m_nspectra);
+    case SubscribeAtOption::LASTTWO:
+      return Mantid::Kernel::make_unique<FakeRunInfoStreamSubscriber>(1);
+    default:
+      return Mantid::Kernel::make_unique<FakeLargeISISEventSubscriber>(
+          m_nspectra, m_neventsPerMessage);
+    }
+  }
+  IKafkaStreamSubscriber_uptr
+  subscribe(std::vector<std::string> topics, int64_t offset,
+            Mantid::LiveData::SubscribeAtOption option) const override {
+    UNUSED_ARG(offset);
+    return subscribe(std::move(topics), option);
+  }
+
+private:
+  const uint32_t m_nspectra;
+  const uint32_t m_neventsPerMessage;
+};
 } // namespace ISISKafkaTesting
 
 #endif // MANTID_LIVEDATA_ISISKAFKAEVENTSTREAMDECODERTESTMOCKS_H_
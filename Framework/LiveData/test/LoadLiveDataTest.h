@@ -53,7 +53,7 @@ public:
          std::string PostProcessingAlgorithm = "",
          std::string PostProcessingProperties = "", bool PreserveEvents = true,
          ILiveListener_sptr listener = ILiveListener_sptr(),
-         bool makeThrow = false) {
+         bool makeThrow = false, bool IncrementalPostProcessing = false) {
     FacilityHelper::ScopedFacilities loadTESTFacility(
         "IDFs_for_UNIT_TESTING/UnitTestFacilities.xml", "TEST");
 
@@ -73,6 +73,8 @@ public:
     TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("PostProcessingProperties",
                                                   PostProcessingProperties));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("PreserveEvents", PreserveEvents));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("IncrementalPostProcessing",
+                                             IncrementalPostProcessing));
     if (!PostProcessingAlgorithm.empty())
       TS_ASSERT_THROWS_NOTHING(
           alg.setPropertyValue("AccumulationWorkspace", "fake_accum"));
@@ -283,6 +285,92 @@ public:
     TS_ASSERT_EQUALS(AnalysisDataService::Instance().size(), 2);
   }
 
+  //--------------------------------------------------------------------------------------------
+  /** Post-process each chunk and add it to the previous output */
+  void test_Add_and_Incremental_PostProcessing() {
+    EventWorkspace_sptr ws1 =
+        doExec<EventWorkspace>("Add", "", "", "Rebin", "Params=40e3, 1e3, 60e3",
+                               true, ILiveListener_sptr(), false, true);
+    TS_ASSERT_EQUALS(ws1->getNumberEvents(), 200);
+    EventWorkspace_sptr ws2 =
+        doExec<EventWorkspace>("Add", "", "", "Rebin", "Params=40e3, 1e3, 60e3",
+                               true, ILiveListener_sptr(), false, true);
+    EventWorkspace_sptr ws_accum =
+        AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+            "fake_accum");
+    TS_ASSERT(ws_accum);
+
+    // The accumulated workspace: it was NOT rebinned.
+    TS_ASSERT_EQUALS(ws_accum->getNumberEvents(), 400);
+    TS_ASSERT_EQUALS(ws_accum->blocksize(), 1);
+
+    // The previous output was updated with the rebinned chunk
+    TSM_ASSERT("Output workspace being added stayed the same pointer",
+               ws1 == ws2);
+    TS_ASSERT_EQUALS(ws2->getNumberHistograms(), 2);
+    TS_ASSERT_EQUALS(ws2->getNumberEvents(), 400);
+    TS_ASSERT_EQUALS(ws2->blocksize(), 20);
+    TS_ASSERT_DELTA(ws2->x(0)[0], 40e3, 1e-4);
+    TS_ASSERT_EQUALS(AnalysisDataService::Instance().size(), 2);
+  }
+
+  void test_Incremental_PostProcessing_needs_linear_algorithm() {
+    FacilityHelper::ScopedFacilities loadTESTFacility(
+        "IDFs_for_UNIT_TESTING/UnitTestFacilities.xml", "TEST");
+    LoadLiveData alg;
+    alg.initialize();
+    alg.setPropertyValue("Instrument", "TestDataListener");
+    alg.setPropertyValue("AccumulationMethod", "Add");
+    alg.setPropertyValue("PostProcessingAlgorithm", "NormaliseByCurrent");
+    alg.setProperty("IncrementalPostProcessing", true);
+    alg.setPropertyValue("AccumulationWorkspace", "fake_accum");
+    alg.setPropertyValue("OutputWorkspace", "fake");
+    auto errors = alg.validateInputs();
+    TS_ASSERT_EQUALS(errors.count("IncrementalPostProcessing"), 1);
+
+    alg.setPropertyValue("PostProcessingAlgorithm", "Rebin");
+    alg.setPropertyValue("AccumulationMethod", "Replace");
+    errors = alg.validateInputs();
+    TS_ASSERT_EQUALS(errors.count("IncrementalPostProcessing"), 1);
+
+    alg.setPropertyValue("AccumulationMethod", "Add");
+    alg.setPropertyValue("PostProcessingProperties", "Params=40e3, 1e3, 60e3");
+    errors = alg.validateInputs();
+    TS_ASSERT_EQUALS(errors.count("IncrementalPostProcessing"), 0);
+
+    alg.setPropertyValue("PostProcessingAlgorithm", "ConvertToMatrixWorkspace");
+    alg.setPropertyValue("PostProcessingProperties", "");
+    errors = alg.validateInputs();
+    TS_ASSERT_EQUALS(errors.count("IncrementalPostProcessing"), 1);
+  }
+
+  void test_Incremental_PostProcessing_needs_Rebin_boundaries() {
+    FacilityHelper::ScopedFacilities loadTESTFacility(
+        "IDFs_for_UNIT_TESTING/UnitTestFacilities.xml", "TEST");
+    LoadLiveData alg;
+    alg.initialize();
+    alg.setPropertyValue("Instrument", "TestDataListener");
+    alg.setPropertyValue("AccumulationMethod", "Add");
+    alg.setPropertyValue("PostProcessingAlgorithm", "Rebin");
+    alg.setProperty("IncrementalPostProcessing", true);
+    alg.setPropertyValue("AccumulationWorkspace", "fake_accum");
+    alg.setPropertyValue("OutputWorkspace", "fake");
+
+    // Each chunk would be binned over its own range
+    alg.setPropertyValue("PostProcessingProperties", "Params=1e3");
+    auto errors = alg.validateInputs();
+    TS_ASSERT_EQUALS(errors.count("IncrementalPostProcessing"), 1);
+
+    alg.setPropertyValue("PostProcessingProperties", "");
+    errors = alg.validateInputs();
+    TS_ASSERT_EQUALS(errors.count("IncrementalPostProcessing"), 1);
+
+    alg.setPropertyValue("PostProcessingProperties",
+                         "Params=40e3, 1e3, 60e3; PreserveEvents=0");
+    errors = alg.validateInputs();
+    TS_ASSERT_EQUALS(errors.count("IncrementalPostProcessing"), 0);
+  }
+
   //--------------------------------------------------------------------------------------------
   /** Do some processing that converts to a different type of workspace */
   void test_ProcessToMDWorkspace_and_Add() {
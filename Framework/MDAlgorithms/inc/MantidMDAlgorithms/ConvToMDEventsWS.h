@@ -67,9 +67,22 @@ private:
   // the public Matrix WS interface
   DataObjects::EventWorkspace_const_sptr m_EventWS;
 
-  /**function converts particular type of events into MD space and add these
-   * events to the workspace itself    */
+  /**function converts particular type of events into MD space and appends
+   * them to the buffers below    */
   template <class T> size_t convertEventList(size_t workspaceIndex);
+  /// adds the buffered events to the workspace in one go and clears buffers
+  void addBufferedEvents();
+
+  // buffers for the events converted from several spectra, which are added to
+  // the workspace together
+  /// MD events coordinates buffer
+  std::vector<coord_t> m_allCoord;
+  /// signal and error squared of the events
+  std::vector<float> m_sigErr;
+  /// run index of the events
+  std::vector<uint16_t> m_runIndex;
+  /// detector id-s of the events
+  std::vector<uint32_t> m_detIDs;
 };
 
 } // endNamespace DataObjects
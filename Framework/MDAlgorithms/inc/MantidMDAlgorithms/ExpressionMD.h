@@ -0,0 +1,54 @@
+#ifndef MANTID_MDALGORITHMS_EXPRESSIONMD_H_
+#define MANTID_MDALGORITHMS_EXPRESSIONMD_H_
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidKernel/System.h"
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+/** ExpressionMD : evaluate an arithmetic expression of up to four
+  MDHistoWorkspaces, element-by-element, in a single pass over the bins.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport ExpressionMD : public API::Algorithm {
+public:
+  const std::string name() const override;
+  /// Summary of algorithms purpose
+  const std::string summary() const override {
+    return "Evaluate an arithmetic expression of MDHistoWorkspaces, "
+           "e.g. (a - b) / c, in a single pass.";
+  }
+
+  int version() const override;
+  const std::string category() const override;
+
+private:
+  void init() override;
+  void exec() override;
+};
+
+} // namespace MDAlgorithms
+} // namespace Mantid
+
+#endif /* MANTID_MDALGORITHMS_EXPRESSIONMD_H_ */
@@ -314,10 +314,10 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       // Leaf-only; no depth limit; with the implicit function passed to it.
       ws->getBox()->getBoxes(boxes, 1000, true, function);
 
-      // Sort boxes by file position IF file backed. This reduces seeking time,
-      // hopefully.
+      // Sort boxes by file position IF file backed, so that they are read
+      // sequentially.
       if (bc->isFileBacked())
-        API::IMDNode::sortObjByID(boxes);
+        API::IMDNode::sortObjByFilePosition(boxes);
 
       // For progress reporting, the # of boxes
       if (prog) {
@@ -1,5 +1,6 @@
 #include "MantidMDAlgorithms/ConvToMDEventsWS.h"
 
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 #include "MantidMDAlgorithms/UnitsConversionHelper.h"
 
 namespace Mantid {
@@ -27,18 +28,6 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
   if (!m_QConverter->calcYDepCoordinates(locCoord, workspaceIndex))
     return 0; // skip if any y outsize of the range of interest;
   localUnitConv.updateConversion(workspaceIndex);
-  //
-  // allocate temporary buffers for MD Events data
-  // MD events coordinates buffer
-  std::vector<coord_t> allCoord;
-  std::vector<float> sig_err;      // array for signal and error.
-  std::vector<uint16_t> run_index; // Buffer for run index for each event
-  std::vector<uint32_t> det_ids;   // Buffer of det Id-s for each event
-
-  allCoord.reserve(this->m_NDims * numEvents);
-  sig_err.reserve(2 * numEvents);
-  run_index.reserve(numEvents);
-  det_ids.reserve(numEvents);
 
   // This little dance makes the getting vector of events more general (since
   // you can't overload by return type).
@@ -47,6 +36,7 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
   const typename std::vector<T> &events = *events_ptr;
 
   // Iterators to start/end
+  size_t n_added_events = 0;
   for (auto it = events.cbegin(); it != events.cend(); it++) {
     double val = localUnitConv.convertUnits(it->tof());
     double signal = it->weight();
@@ -54,20 +44,28 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
     if (!m_QConverter->calcMatrixCoord(val, locCoord, signal, errorSq))
       continue; // skip ND outside the range
 
-    sig_err.push_back(static_cast<float>(signal));
-    sig_err.push_back(static_cast<float>(errorSq));
-    run_index.push_back(runIndexLoc);
-    det_ids.push_back(detID);
-    allCoord.insert(allCoord.end(), locCoord.begin(), locCoord.end());
+    m_sigErr.push_back(static_cast<float>(signal));
+    m_sigErr.push_back(static_cast<float>(errorSq));
+    m_runIndex.push_back(runIndexLoc);
+    m_detIDs.push_back(detID);
+    m_allCoord.insert(m_allCoord.end(), locCoord.begin(), locCoord.end());
+    ++n_added_events;
   }
-
-  // Add them to the MDEW
-  size_t n_added_events = run_index.size();
-  m_OutWSWrapper->addMDData(sig_err, run_index, det_ids, allCoord,
-                            n_added_events);
+  // The events are added to the MDEW by addBufferedEvents
   return n_added_events;
 }
 
+/** Add the events buffered by convertEventList to the workspace as one batch,
+ * which splits the boxes as it goes, and clear the buffers */
+void ConvToMDEventsWS::addBufferedEvents() {
+  m_OutWSWrapper->addMDDataInBulk(m_sigErr, m_runIndex, m_detIDs, m_allCoord,
+                                  m_runIndex.size());
+  m_allCoord.clear();
+  m_sigErr.clear();
+  m_runIndex.clear();
+  m_detIDs.clear();
+}
+
 /** The method runs conversion for a single event list, corresponding to a
  * particular workspace index */
 size_t ConvToMDEventsWS::conversionChunk(size_t workspaceIndex) {
@@ -125,7 +123,7 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   size_t nValidSpectra = m_NSpectra;
 
   //--->>> Thread control stuff
-  Kernel::ThreadSchedulerFIFO *ts(nullptr);
+  Kernel::ThreadScheduler *ts(nullptr);
 
   int nThreads(m_NumThreads);
   if (nThreads < 0)
@@ -135,8 +133,11 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   if (m_NumThreads != 0) {
     runMultithreaded = true;
     // Create the thread pool that will run all of these. It will be deleted by
-    // the threadpool
-    ts = new Kernel::ThreadSchedulerFIFO();
+    // the threadpool. Box splitting tasks spawn their children locally, so
+    // each thread keeps its own queue and steals only when that is empty
+    ts = new Kernel::ThreadSchedulerWorkStealing(
+        nThreads > 0 ? static_cast<size_t>(nThreads)
+                     : Kernel::ThreadPool::getNumPhysicalCores());
     // it will initiate thread pool with number threads or machine's cores (0 in
     // tp constructor)
     pProgress->resetNumSteps(nValidSpectra, 0, 1);
@@ -149,14 +150,20 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   if (!m_QConverter->calcGenericVariables(m_Coord, m_NDims))
     return;
 
+  // The events of many spectra are sorted into the boxes together, which
+  // splits the boxes as it goes and fills them on several threads
+  const size_t eventsPerBatch = 1000000;
   size_t eventsAdded = 0;
   for (size_t wi = 0; wi < nValidSpectra; wi++) {
 
     size_t nConverted = this->conversionChunk(wi);
     eventsAdded += nConverted;
     nEventsInWS += nConverted;
+    if (m_runIndex.size() >= eventsPerBatch)
+      addBufferedEvents();
     // Keep a running total of how many events we've added
     if (bc->shouldSplitBoxes(nEventsInWS, eventsAdded, lastNumBoxes)) {
+      addBufferedEvents();
       if (runMultithreaded) {
         // Now do all the splitting tasks
         m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(ts);
@@ -176,6 +183,11 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
       pProgress->report(wi);
     }
   }
+  addBufferedEvents();
+  m_allCoord.shrink_to_fit();
+  m_sigErr.shrink_to_fit();
+  m_runIndex.shrink_to_fit();
+  m_detIDs.shrink_to_fit();
   // Do a final splitting of everything
   if (runMultithreaded) {
     m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(ts);
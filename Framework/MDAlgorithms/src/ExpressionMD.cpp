@@ -0,0 +1,315 @@
+#include "MantidMDAlgorithms/ExpressionMD.h"
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/DualNumber.h"
+#include "MantidAPI/WorkspaceProperty.h"
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/MandatoryValidator.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <memory>
+
+using namespace Mantid::Kernel;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+// Register the algorithm into the AlgorithmFactory
+DECLARE_ALGORITHM(ExpressionMD)
+
+namespace {
+/// The largest number of workspaces in an expression, named a, b, c and d
+const size_t maxOperands = 4;
+
+/// A node of the parsed expression
+struct Node {
+  enum class Type {
+    Constant,
+    Variable,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Negate,
+    Exp,
+    Log,
+    Sqrt
+  };
+  explicit Node(const Type type) : type(type) {}
+  Type type;
+  /// The value of a Constant
+  double value = 0.;
+  /// The index of a Variable
+  size_t variable = 0;
+  /// The operands. Unary operations and functions only use lhs.
+  std::unique_ptr<Node> lhs;
+  std::unique_ptr<Node> rhs;
+};
+
+/** Parse an expression into a tree of Nodes, by recursive descent:
+ *
+ * expression := term {('+' | '-') term}
+ * term := factor {('*' | '/') factor}
+ * factor := '-' factor | number | variable | function '(' expression ')'
+ *           | '(' expression ')'
+ */
+class Parser {
+public:
+  Parser(const std::string &text, const size_t numVariables)
+      : m_text(text), m_numVariables(numVariables) {}
+
+  std::unique_ptr<Node> parse() {
+    auto tree = expression();
+    skipSpaces();
+    if (m_position != m_text.size())
+      fail("unexpected '" + m_text.substr(m_position, 1) + "'");
+    return tree;
+  }
+
+private:
+  std::unique_ptr<Node> expression() {
+    auto tree = term();
+    while (accept('+') || accept('-')) {
+      const auto type = m_text[m_position - 1] == '+' ? Node::Type::Add
+                                                      : Node::Type::Subtract;
+      tree = binary(type, std::move(tree), term());
+    }
+    return tree;
+  }
+
+  std::unique_ptr<Node> term() {
+    auto tree = factor();
+    while (accept('*') || accept('/')) {
+      const auto type = m_text[m_position - 1] == '*' ? Node::Type::Multiply
+                                                      : Node::Type::Divide;
+      tree = binary(type, std::move(tree), factor());
+    }
+    return tree;
+  }
+
+  std::unique_ptr<Node> factor() {
+    if (accept('-')) {
+      auto node = Kernel::make_unique<Node>(Node::Type::Negate);
+      node->lhs = factor();
+      return node;
+    }
+    if (accept('(')) {
+      auto tree = expression();
+      expect(')');
+      return tree;
+    }
+    skipSpaces();
+    if (m_position == m_text.size())
+      fail("unexpected end of the expression");
+    const char next = m_text[m_position];
+    if (std::isdigit(next) || next == '.')
+      return number();
+    if (std::isalpha(next))
+      return name();
+    fail("unexpected '" + std::string(1, next) + "'");
+    return nullptr;
+  }
+
+  std::unique_ptr<Node> number() {
+    const char *begin = m_text.c_str() + m_position;
+    char *end = nullptr;
+    const double value = std::strtod(begin, &end);
+    if (end == begin)
+      fail("invalid number");
+    m_position += static_cast<size_t>(end - begin);
+    auto node = Kernel::make_unique<Node>(Node::Type::Constant);
+    node->value = value;
+    return node;
+  }
+
+  std::unique_ptr<Node> name() {
+    const size_t begin = m_position;
+    while (m_position < m_text.size() && std::isalpha(m_text[m_position]))
+      ++m_position;
+    const std::string word = m_text.substr(begin, m_position - begin);
+    if (word.size() == 1) {
+      const auto index = static_cast<size_t>(word[0] - 'a');
+      if (index >= m_numVariables)
+        fail("unknown workspace '" + word + "', there are only " +
+             std::to_string(m_numVariables) + " InputWorkspaces");
+      auto node = Kernel::make_unique<Node>(Node::Type::Variable);
+      node->variable = index;
+      return node;
+    }
+    Node::Type type;
+    if (word == "exp")
+      type = Node::Type::Exp;
+    else if (word == "log")
+      type = Node::Type::Log;
+    else if (word == "sqrt")
+      type = Node::Type::Sqrt;
+    else
+      fail("unknown function '" + word + "'");
+    expect('(');
+    auto node = Kernel::make_unique<Node>(type);
+    node->lhs = expression();
+    expect(')');
+    return node;
+  }
+
+  static std::unique_ptr<Node> binary(const Node::Type type,
+                                      std::unique_ptr<Node> lhs,
+                                      std::unique_ptr<Node> rhs) {
+    auto node = Kernel::make_unique<Node>(type);
+    node->lhs = std::move(lhs);
+    node->rhs = std::move(rhs);
+    return node;
+  }
+
+  void skipSpaces() {
+    while (m_position < m_text.size() && std::isspace(m_text[m_position]))
+      ++m_position;
+  }
+
+  bool accept(const char c) {
+    skipSpaces();
+    if (m_position < m_text.size() && m_text[m_position] == c) {
+      ++m_position;
+      return true;
+    }
+    return false;
+  }
+
+  void expect(const char c) {
+    if (!accept(c))
+      fail("expected '" + std::string(1, c) + "'");
+  }
+
+  void fail(const std::string &message) const {
+    throw std::invalid_argument("Invalid Expression \"" + m_text +
+                                "\" at character " +
+                                std::to_string(m_position + 1) + ": " +
+                                message + ".");
+  }
+
+  const std::string &m_text;
+  const size_t m_numVariables;
+  size_t m_position = 0;
+};
+
+/// @return the value of the expression tree for the given arguments
+template <size_t N>
+DualNumber<N> evaluate(const Node &node,
+                       const std::array<DualNumber<N>, N> &arguments) {
+  switch (node.type) {
+  case Node::Type::Constant:
+    return DualNumber<N>(node.value);
+  case Node::Type::Variable:
+    return arguments[node.variable];
+  case Node::Type::Add:
+    return evaluate(*node.lhs, arguments) + evaluate(*node.rhs, arguments);
+  case Node::Type::Subtract:
+    return evaluate(*node.lhs, arguments) - evaluate(*node.rhs, arguments);
+  case Node::Type::Multiply:
+    return evaluate(*node.lhs, arguments) * evaluate(*node.rhs, arguments);
+  case Node::Type::Divide:
+    return evaluate(*node.lhs, arguments) / evaluate(*node.rhs, arguments);
+  case Node::Type::Negate:
+    return -evaluate(*node.lhs, arguments);
+  case Node::Type::Exp:
+    return exp(evaluate(*node.lhs, arguments));
+  case Node::Type::Log:
+    return log(evaluate(*node.lhs, arguments));
+  case Node::Type::Sqrt:
+    return sqrt(evaluate(*node.lhs, arguments));
+  }
+  throw std::logic_error("ExpressionMD: unknown node type");
+}
+
+/// Set the output to the expression of the N inputs
+template <size_t N>
+void setToExpression(MDHistoWorkspace &output,
+                     const std::vector<MDHistoWorkspace_sptr> &inputs,
+                     const Node &tree) {
+  std::array<const MDHistoWorkspace *, N> operands;
+  for (size_t k = 0; k < N; ++k)
+    operands[k] = inputs[k].get();
+  output.setToExpression<N>(
+      operands, [&tree](const std::array<DualNumber<N>, N> &arguments) {
+        return evaluate(tree, arguments);
+      });
+}
+} // namespace
+
+/// Algorithm's name for identification. @see Algorithm::name
+const std::string ExpressionMD::name() const { return "ExpressionMD"; }
+
+/// Algorithm's version for identification. @see Algorithm::version
+int ExpressionMD::version() const { return 1; }
+
+/// Algorithm's category for identification. @see Algorithm::category
+const std::string ExpressionMD::category() const {
+  return "MDAlgorithms\\MDArithmetic";
+}
+
+//----------------------------------------------------------------------------------------------
+/** Initialize the algorithm's properties.
+ */
+void ExpressionMD::init() {
+  declareProperty(
+      Kernel::make_unique<ArrayProperty<std::string>>(
+          "InputWorkspaces",
+          boost::make_shared<MandatoryValidator<std::vector<std::string>>>()),
+      "The names of one to four MDHistoWorkspaces, referred to as a, b, c "
+      "and d in the Expression.");
+  declareProperty("Expression", "",
+                  boost::make_shared<MandatoryValidator<std::string>>(),
+                  "The expression to evaluate, e.g. (a - b) / c. It may use "
+                  "+, -, *, /, parentheses, numbers and the functions exp, "
+                  "log and sqrt.");
+  declareProperty(make_unique<WorkspaceProperty<IMDHistoWorkspace>>(
+                      "OutputWorkspace", "", Direction::Output),
+                  "Name of the output MDHistoWorkspace.");
+}
+
+//----------------------------------------------------------------------------------------------
+/** Execute the algorithm.
+ */
+void ExpressionMD::exec() {
+  const std::vector<std::string> names = getProperty("InputWorkspaces");
+  if (names.size() > maxOperands)
+    throw std::invalid_argument("At most " + std::to_string(maxOperands) +
+                                " InputWorkspaces can be given.");
+  std::vector<MDHistoWorkspace_sptr> inputs;
+  for (const auto &name : names) {
+    auto ws = boost::dynamic_pointer_cast<MDHistoWorkspace>(
+        AnalysisDataService::Instance().retrieve(name));
+    if (!ws)
+      throw std::invalid_argument("Workspace " + name +
+                                  " is not a MDHistoWorkspace.");
+    inputs.push_back(ws);
+  }
+
+  const std::string expression = getProperty("Expression");
+  const auto tree = Parser(expression, inputs.size()).parse();
+
+  // The output takes the geometry and number of events of a
+  MDHistoWorkspace_sptr output(inputs.front()->clone());
+  switch (inputs.size()) {
+  case 1:
+    setToExpression<1>(*output, inputs, *tree);
+    break;
+  case 2:
+    setToExpression<2>(*output, inputs, *tree);
+    break;
+  case 3:
+    setToExpression<3>(*output, inputs, *tree);
+    break;
+  case 4:
+    setToExpression<4>(*output, inputs, *tree);
+    break;
+  }
+  setProperty("OutputWorkspace",
+              boost::static_pointer_cast<IMDHistoWorkspace>(output));
+}
+
+} // namespace MDAlgorithms
+} // namespace Mantid
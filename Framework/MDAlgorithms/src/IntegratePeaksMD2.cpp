@@ -21,13 +21,17 @@
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidHistogramData/LinearGenerator.h"
 #include "MantidKernel/ListValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/Utils.h"
 #include "MantidMDAlgorithms/GSLFunctions.h"
 
+#include <algorithm>
 #include <cmath>
 #include <gsl/gsl_integration.h>
 #include <fstream>
+#include <limits>
+#include <numeric>
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -42,6 +46,59 @@ using namespace Mantid::DataObjects;
 using namespace Mantid::DataObjects;
 using namespace Mantid::Geometry;
 
+namespace {
+/// @return the position of a peak in the given coordinates
+V3D peakPosition(const IPeak &p,
+                 const Mantid::Kernel::SpecialCoordinateSystem coordinates) {
+  if (coordinates == Mantid::Kernel::QLab) //"Q (lab frame)"
+    return p.getQLabFrame();
+  else if (coordinates == Mantid::Kernel::QSample) //"Q (sample frame)"
+    return p.getQSampleFrame();
+  else if (coordinates == Mantid::Kernel::HKL) //"HKL"
+    return p.getHKL();
+  return V3D();
+}
+
+/**
+ * Order the peaks by the position on disk of the box containing their centre,
+ * so that the boxes of a file backed workspace are loaded once for all the
+ * peaks around them rather than again for each peak.
+ * @param root :: The top box of the workspace
+ * @param peakWS :: The peaks
+ * @param coordinates :: The coordinates of the workspace
+ * @return The indices of the peaks in the order to integrate them
+ */
+std::vector<int>
+orderByBoxLocality(API::IMDNode &root, const PeaksWorkspace &peakWS,
+                   const Mantid::Kernel::SpecialCoordinateSystem coordinates) {
+  const int nPeaks = peakWS.getNumberPeaks();
+  using Key = std::pair<uint64_t, size_t>;
+  std::vector<Key> keys(nPeaks, Key(std::numeric_limits<uint64_t>::max(),
+                                    std::numeric_limits<size_t>::max()));
+  for (int i = 0; i < nPeaks; ++i) {
+    const V3D pos = peakPosition(peakWS.getPeak(i), coordinates);
+    coord_t center[3];
+    for (size_t d = 0; d < 3; ++d) {
+      center[d] = static_cast<coord_t>(pos[d]);
+    }
+    const API::IMDNode *box = root.getBoxAtCoord(center);
+    if (!box)
+      continue;
+    const Kernel::ISaveable *saveable = box->getISaveable();
+    if (saveable && saveable->wasSaved())
+      keys[i].first = saveable->getFilePosition();
+    keys[i].second = box->getID();
+  }
+  std::vector<int> order(nPeaks);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&keys](const int a, const int b) {
+                     return keys[a] < keys[b];
+                   });
+  return order;
+}
+} // namespace
+
 /** Initialize the algorithm's properties.
  */
 void IntegratePeaksMD2::init() {
@@ -276,35 +333,34 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
                                          std::pow(BackgroundOuterRadius, 3));
   // volume of PeakRadius sphere
   double volumeRadius = 4.0 / 3.0 * M_PI * std::pow(PeakRadius, 3);
-  //
-  // If the following OMP pragma is included, this algorithm seg faults
-  // sporadically when processing multiple TOPAZ runs in a script, on
-  // Scientific Linux 6.2.  Typically, it seg faults after 2 to 6 runs are
-  // processed, though occasionally it will process all 8 requested in the
-  // script without crashing.  Since the lower level codes already use OpenMP,
-  // parallelizing at this level is only marginally useful, giving about a
-  // 5-10% speedup.  Perhaps is should just be removed permanantly, but for
-  // now it is commented out to avoid the seg faults.  Refs #5533
-  // PRAGMA_OMP(parallel for schedule(dynamic, 10) )
   // Initialize progress reporting
   int nPeaks = peakWS->getNumberPeaks();
   Progress progress(this, 0., 1., nPeaks);
-  for (int i = 0; i < nPeaks; ++i) {
-    if (this->getCancel())
-      break; // User cancellation
+  // The peaks are independent, and integrating a sphere only reads the box
+  // tree, so spheres are integrated on several threads unless the boxes have
+  // to be loaded from disk. The cylinder integration runs child algorithms
+  // and writes the profiles file in order, so it stays serial. (The
+  // segmentation faults of #5533 came from file backed workspaces.)
+  const bool fileBacked = ws->isFileBacked();
+  std::vector<int> order(nPeaks);
+  if (fileBacked && !cylinderBool) {
+    order = orderByBoxLocality(*ws->getBox(), *peakWS, CoordinatesToUse);
+  } else {
+    std::iota(order.begin(), order.end(), 0);
+  }
+  // Peaks whose integration spheres are checked for overlaps afterwards
+  std::vector<char> checkOverlaps(nPeaks, false);
+  PARALLEL_FOR_IF(!cylinderBool && !fileBacked)
+  for (int iOrder = 0; iOrder < nPeaks; ++iOrder) {
+    PARALLEL_START_INTERUPT_REGION
     progress.report();
+    const int i = order[iOrder];
 
     // Get a direct ref to that peak.
     IPeak &p = peakWS->getPeak(i);
 
     // Get the peak center as a position in the dimensions of the workspace
-    V3D pos;
-    if (CoordinatesToUse == Mantid::Kernel::QLab) //"Q (lab frame)"
-      pos = p.getQLabFrame();
-    else if (CoordinatesToUse == Mantid::Kernel::QSample) //"Q (sample frame)"
-      pos = p.getQSampleFrame();
-    else if (CoordinatesToUse == Mantid::Kernel::HKL) //"HKL"
-      pos = p.getHKL();
+    const V3D pos = peakPosition(p, CoordinatesToUse);
 
     // Do not integrate if sphere is off edge of detector
 
@@ -601,9 +657,7 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
         }
       }
     }
-    checkOverlap(
-        i, peakWS, CoordinatesToUse,
-        2.0 * std::max(PeakRadiusVector[i], BackgroundOuterRadiusVector[i]));
+    checkOverlaps[i] = true;
     // Save it back in the peak object.
     if (signal != 0. || replaceIntensity) {
       double edgeMultiplier = 1.0;
@@ -641,6 +695,14 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
                         << bgErrorSquared +
                                ratio * ratio * std::fabs(background_total)
                         << ") subtracted.\n";
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+  for (int i = 0; i < nPeaks; ++i) {
+    if (checkOverlaps[i])
+      checkOverlap(i, peakWS, CoordinatesToUse,
+                   2.0 * std::max(PeakRadiusVector[i],
+                                  BackgroundOuterRadiusVector[i]));
   }
   // This flag is used by the PeaksWorkspace to evaluate whether it has been
   // integrated.
@@ -757,23 +819,11 @@ void IntegratePeaksMD2::checkOverlap(
     Mantid::Kernel::SpecialCoordinateSystem CoordinatesToUse, double radius) {
   // Get a direct ref to that peak.
   IPeak &p1 = peakWS->getPeak(i);
-  V3D pos1;
-  if (CoordinatesToUse == Kernel::QLab) //"Q (lab frame)"
-    pos1 = p1.getQLabFrame();
-  else if (CoordinatesToUse == Kernel::QSample) //"Q (sample frame)"
-    pos1 = p1.getQSampleFrame();
-  else if (CoordinatesToUse == Kernel::HKL) //"HKL"
-    pos1 = p1.getHKL();
+  const V3D pos1 = peakPosition(p1, CoordinatesToUse);
   for (int j = i + 1; j < peakWS->getNumberPeaks(); ++j) {
     // Get a direct ref to rest of peaks peak.
     IPeak &p2 = peakWS->getPeak(j);
-    V3D pos2;
-    if (CoordinatesToUse == Kernel::QLab) //"Q (lab frame)"
-      pos2 = p2.getQLabFrame();
-    else if (CoordinatesToUse == Kernel::QSample) //"Q (sample frame)"
-      pos2 = p2.getQSampleFrame();
-    else if (CoordinatesToUse == Kernel::HKL) //"HKL"
-      pos2 = p2.getHKL();
+    const V3D pos2 = peakPosition(p2, CoordinatesToUse);
     if (pos1.distance(pos2) < radius) {
       g_log.warning() << " Warning:  Peak integration spheres for peaks " << i
                       << " and " << j << " overlap.  Distance between peaks is "
@@ -120,6 +120,57 @@ void MDEventWSWrapper::addMDDataND<0>(float *, uint16_t *, uint32_t *,
                               "to 0-dimensional workspace"));
 }
 
+/** Function builds the MD events from the input data and adds them to the
+ * workspace as one batch, see MDEventWorkspace::addEventsInBulk. The
+ * arguments are those of addMDDataND.
+ */
+template <size_t nd>
+void MDEventWSWrapper::addMDDataNDInBulk(float *sigErr, uint16_t *runIndex,
+                                         uint32_t *detId, coord_t *Coord,
+                                         size_t dataSize) const {
+
+  DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *const pWs =
+      dynamic_cast<
+          DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *>(
+          m_Workspace.get());
+  if (pWs) {
+    std::vector<DataObjects::MDEvent<nd>> events;
+    events.reserve(dataSize);
+    for (size_t i = 0; i < dataSize; i++) {
+      events.emplace_back(*(sigErr + 2 * i), *(sigErr + 2 * i + 1),
+                          *(runIndex + i), *(detId + i), (Coord + i * nd));
+    }
+    pWs->addEventsInBulk(events);
+  } else {
+    DataObjects::MDEventWorkspace<DataObjects::MDLeanEvent<nd>, nd> *const
+        pLWs = dynamic_cast<
+            DataObjects::MDEventWorkspace<DataObjects::MDLeanEvent<nd>, nd> *>(
+            m_Workspace.get());
+
+    if (!pLWs)
+      throw std::runtime_error("Bad Cast: Target MD workspace to add events "
+                               "does not correspond to type of events you try "
+                               "to add to it");
+
+    std::vector<DataObjects::MDLeanEvent<nd>> events;
+    events.reserve(dataSize);
+    for (size_t i = 0; i < dataSize; i++) {
+      events.emplace_back(*(sigErr + 2 * i), *(sigErr + 2 * i + 1),
+                          (Coord + i * nd));
+    }
+    pLWs->addEventsInBulk(events);
+  }
+}
+
+/// the function used in template metaloop termination on 0 dimensions and to
+/// throw the error in attempt to add data to 0-dimension workspace
+template <>
+void MDEventWSWrapper::addMDDataNDInBulk<0>(float *, uint16_t *, uint32_t *,
+                                            coord_t *, size_t) const {
+  throw(std::invalid_argument(" class has not been initiated, can not add data "
+                              "to 0-dimensional workspace"));
+}
+
 /***/
 template <size_t nd> void MDEventWSWrapper::splitBoxList() {
   DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *const pWs =
@@ -226,6 +277,22 @@ void MDEventWSWrapper::addMDData(std::vector<float> &sigErr,
                                              &detId[0], &Coord[0], dataSize);
 }
 
+/** method adds a large batch of data to the workspace which was initiated
+ * before, splitting the boxes that get enough events while adding. The events
+ * are added in parallel. The arguments are those of addMDData.
+ */
+void MDEventWSWrapper::addMDDataInBulk(std::vector<float> &sigErr,
+                                       std::vector<uint16_t> &runIndex,
+                                       std::vector<uint32_t> &detId,
+                                       std::vector<coord_t> &Coord,
+                                       size_t dataSize) const {
+
+  if (dataSize == 0)
+    return;
+  (this->*(mdEvAddInBulk[m_NDimensions]))(&sigErr[0], &runIndex[0], &detId[0],
+                                          &Coord[0], dataSize);
+}
+
 /** method should be called at the end of the algorithm, to let the workspace
 manager know that it has whole responsibility for the workspace
 (As the algorithm is static, it will hold the pointer to the workspace
@@ -247,6 +314,7 @@ public:
     LOOP<i - 1>::EXEC(pH);
     pH->wsCreator[i] = &MDEventWSWrapper::createEmptyEventWS<i>;
     pH->mdEvAddAndForget[i] = &MDEventWSWrapper::addMDDataND<i>;
+    pH->mdEvAddInBulk[i] = &MDEventWSWrapper::addMDDataNDInBulk<i>;
     pH->mdCalCentroid[i] = &MDEventWSWrapper::calcCentroidND<i>;
     pH->mdBoxListSplitter[i] = &MDEventWSWrapper::splitBoxList<i>;
   }
@@ -258,6 +326,7 @@ public:
   static inline void EXEC(MDEventWSWrapper *pH) {
     pH->wsCreator[0] = &MDEventWSWrapper::createEmptyEventWS<0>;
     pH->mdEvAddAndForget[0] = &MDEventWSWrapper::addMDDataND<0>;
+    pH->mdEvAddInBulk[0] = &MDEventWSWrapper::addMDDataNDInBulk<0>;
     pH->mdCalCentroid[0] = &MDEventWSWrapper::calcCentroidND<0>;
     pH->mdBoxListSplitter[0] = &MDEventWSWrapper::splitBoxList<0>;
   }
@@ -268,6 +337,7 @@ MDEventWSWrapper::MDEventWSWrapper()
     : m_NDimensions(0), m_needSplitting(false) {
   wsCreator.resize(MAX_N_DIM + 1);
   mdEvAddAndForget.resize(MAX_N_DIM + 1);
+  mdEvAddInBulk.resize(MAX_N_DIM + 1);
   mdCalCentroid.resize(MAX_N_DIM + 1);
   mdBoxListSplitter.resize(MAX_N_DIM + 1);
   LOOP<MAX_N_DIM>::EXEC(this);
@@ -4,6 +4,7 @@
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidAPI/NumericAxis.h"
 #include "MantidAPI/Run.h"
+#include "MantidAPI/SpectrumGeometry.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidKernel/CompositeValidator.h"
@@ -244,6 +245,7 @@ void PreprocessDetectorsToMD::processDetectorsPositions(
   //// Loop over the spectra
   uint32_t liveDetectorsCount(0);
   const auto &spectrumInfo = inputWS->spectrumInfo();
+  const auto geometry = inputWS->spectrumGeometry();
   for (size_t i = 0; i < nHist; i++) {
     sp2detMap[i] = std::numeric_limits<uint64_t>::quiet_NaN();
     detId[i] = std::numeric_limits<int32_t>::quiet_NaN();
@@ -253,7 +255,7 @@ void PreprocessDetectorsToMD::processDetectorsPositions(
     Azimuthal[i] = std::numeric_limits<double>::quiet_NaN();
     //     detMask[i]  = true;
 
-    if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i))
+    if (!geometry->hasDetectors(i) || geometry->isMonitor(i))
       continue;
 
     // if masked detectors state is not used, masked detectors just ignored;
@@ -269,9 +271,9 @@ void PreprocessDetectorsToMD::processDetectorsPositions(
     sp2detMap[i] = liveDetectorsCount;
     detId[liveDetectorsCount] = int32_t(spDet.getID());
     detIDMap[liveDetectorsCount] = i;
-    L2[liveDetectorsCount] = spectrumInfo.l2(i);
+    L2[liveDetectorsCount] = geometry->l2(i);
 
-    double polar = spectrumInfo.twoTheta(i);
+    double polar = geometry->twoTheta(i);
     double azim = spDet.getPhi();
     TwoTheta[liveDetectorsCount] = polar;
     Azimuthal[liveDetectorsCount] = azim;
@@ -292,11 +294,16 @@ void PreprocessDetectorsToMD::processDetectorsPositions(
     // for indirect instrument but may be deployed on any code with Ei property
     // defined;
     if (pEfixedArray) {
-      try {
-        Geometry::Parameter_sptr par = pmap.getRecursive(&spDet, "eFixed");
-        if (par)
-          Efi = par->value<double>();
-      } catch (std::runtime_error &) {
+      if (geometry->hasEFixed(i)) {
+        Efi = geometry->eFixed(i);
+      } else if (!spectrumInfo.hasUniqueDetector(i)) {
+        // the geometry only holds the parameter of single detectors
+        try {
+          Geometry::Parameter_sptr par = pmap.getRecursive(&spDet, "eFixed");
+          if (par)
+            Efi = par->value<double>();
+        } catch (std::runtime_error &) {
+        }
       }
       // set efixed for each existing detector
       *(pEfixedArray + liveDetectorsCount) = static_cast<float>(Efi);
@@ -179,11 +179,11 @@ void SliceMD::slice(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   std::vector<API::IMDNode *> boxes;
   // Leaf-only; no depth limit; with the implicit function passed to it.
   ws->getBox()->getBoxes(boxes, 1000, true, function);
-  // Sort boxes by file position IF file backed. This reduces seeking time,
-  // hopefully.
+  // Sort boxes by file position IF file backed, so that they are read
+  // sequentially.
   bool fileBackedWS = bc->isFileBacked();
   if (fileBackedWS)
-    API::IMDNode::sortObjByID(boxes);
+    API::IMDNode::sortObjByFilePosition(boxes);
 
   auto prog = make_unique<Progress>(this, 0.0, 1.0, boxes.size());
 
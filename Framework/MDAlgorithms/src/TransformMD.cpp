@@ -72,7 +72,7 @@ void TransformMD::doTransform(
 
   // If file backed, sort them first.
   if (ws->isFileBacked())
-    API::IMDNode::sortObjByID(boxes);
+    API::IMDNode::sortObjByFilePosition(boxes);
 
   PARALLEL_FOR_IF(!ws->isFileBacked())
   for (int i = 0; i < static_cast<int>(boxes.size()); i++) { // NOLINT
@@ -0,0 +1,127 @@
+#ifndef MANTID_MDALGORITHMS_EXPRESSIONMDTEST_H_
+#define MANTID_MDALGORITHMS_EXPRESSIONMDTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/FrameworkManager.h"
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidMDAlgorithms/ExpressionMD.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+#include <cmath>
+
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+using namespace Mantid::MDAlgorithms;
+
+class ExpressionMDTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ExpressionMDTest *createSuite() { return new ExpressionMDTest(); }
+  static void destroySuite(ExpressionMDTest *suite) { delete suite; }
+
+  ExpressionMDTest() { FrameworkManager::Instance(); }
+
+  void setUp() override {
+    MDEventsTestHelper::makeFakeMDHistoWorkspace(7.0, 2, 5, 10.0, 3.0,
+                                                 "ExpressionMDTest_a");
+    MDEventsTestHelper::makeFakeMDHistoWorkspace(2.0, 2, 5, 10.0, 2.0,
+                                                 "ExpressionMDTest_b");
+    MDEventsTestHelper::makeFakeMDHistoWorkspace(4.0, 2, 5, 10.0, 0.5,
+                                                 "ExpressionMDTest_c");
+  }
+
+  void tearDown() override { AnalysisDataService::Instance().clear(); }
+
+  void test_Init() {
+    ExpressionMD alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT(alg.isInitialized())
+  }
+
+  void test_matches_MinusMD_then_DivideMD() {
+    FrameworkManager::Instance().exec(
+        "MinusMD", 6, "LHSWorkspace", "ExpressionMDTest_a", "RHSWorkspace",
+        "ExpressionMDTest_b", "OutputWorkspace", "ExpressionMDTest_chained");
+    FrameworkManager::Instance().exec(
+        "DivideMD", 6, "LHSWorkspace", "ExpressionMDTest_chained",
+        "RHSWorkspace", "ExpressionMDTest_c", "OutputWorkspace",
+        "ExpressionMDTest_chained");
+    auto expected = getWorkspace("ExpressionMDTest_chained");
+
+    auto out = doTest(
+        "(a - b) / c",
+        "ExpressionMDTest_a,ExpressionMDTest_b,ExpressionMDTest_c");
+    TS_ASSERT_EQUALS(out->getNPoints(), expected->getNPoints());
+    for (size_t i = 0; i < out->getNPoints(); ++i) {
+      TS_ASSERT_DELTA(out->getSignalAt(i), expected->getSignalAt(i), 1e-14);
+      TS_ASSERT_DELTA(out->getErrorAt(i), expected->getErrorAt(i), 1e-14);
+    }
+  }
+
+  void test_precedence_constants_and_functions() {
+    // 2 * a - b / 2 + exp(0) with a = 7 and b = 2
+    auto out = doTest("2*a - b/2 + -(-exp(0))",
+                      "ExpressionMDTest_a,ExpressionMDTest_b");
+    TS_ASSERT_DELTA(out->getSignalAt(0), 14.0, 1e-14);
+    // d/da = 2 and d/db = -0.5
+    TS_ASSERT_DELTA(out->getErrorAt(0), std::sqrt(4 * 3.0 + 0.25 * 2.0),
+                    1e-14);
+  }
+
+  void test_the_inputs_are_not_modified() {
+    doTest("sqrt(a) * log(a)", "ExpressionMDTest_a");
+    auto a = getWorkspace("ExpressionMDTest_a");
+    TS_ASSERT_DELTA(a->getSignalAt(0), 7.0, 1e-14);
+    TS_ASSERT_DELTA(a->getErrorAt(0), std::sqrt(3.0), 1e-14);
+  }
+
+  void test_invalid_expressions_throw() {
+    for (const auto expression : {"(a - b", "a -", "a $ b", "c + a", "foo(a)",
+                                  "a b"}) {
+      ExpressionMD alg;
+      alg.initialize();
+      alg.setRethrows(true);
+      alg.setPropertyValue("InputWorkspaces",
+                           "ExpressionMDTest_a,ExpressionMDTest_b");
+      alg.setPropertyValue("Expression", expression);
+      alg.setPropertyValue("OutputWorkspace", "ExpressionMDTest_out");
+      TS_ASSERT_THROWS(alg.execute(), std::invalid_argument);
+    }
+  }
+
+  void test_too_many_workspaces_throw() {
+    ExpressionMD alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    alg.setPropertyValue("InputWorkspaces",
+                         "ExpressionMDTest_a,ExpressionMDTest_b,"
+                         "ExpressionMDTest_c,ExpressionMDTest_a,"
+                         "ExpressionMDTest_b");
+    alg.setPropertyValue("Expression", "a");
+    alg.setPropertyValue("OutputWorkspace", "ExpressionMDTest_out");
+    TS_ASSERT_THROWS(alg.execute(), std::invalid_argument);
+  }
+
+private:
+  MDHistoWorkspace_sptr getWorkspace(const std::string &name) {
+    return AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(name);
+  }
+
+  MDHistoWorkspace_sptr doTest(const std::string &expression,
+                               const std::string &inputs) {
+    ExpressionMD alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("InputWorkspaces", inputs));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Expression", expression));
+    TS_ASSERT_THROWS_NOTHING(
+        alg.setPropertyValue("OutputWorkspace", "ExpressionMDTest_out"));
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+    return getWorkspace("ExpressionMDTest_out");
+  }
+};
+
+#endif /* MANTID_MDALGORITHMS_EXPRESSIONMDTEST_H_ */
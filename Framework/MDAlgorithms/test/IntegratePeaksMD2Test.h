@@ -15,6 +15,8 @@
 #include "MantidMDAlgorithms/FakeMDEventData.h"
 #include "MantidMDAlgorithms/IntegratePeaksMD2.h"
 #include "MantidTestHelpers/ComponentCreationHelper.h"
+#include "MantidTestHelpers/MDAlgorithmsTestHelper.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
 #include "MantidKernel/UnitLabelTypes.h"
 
 #include <boost/math/distributions/normal.hpp>
@@ -435,6 +437,91 @@ public:
     TS_ASSERT_EQUALS(backgroundInnerRadius,
                      sphericalShape->backgroundInnerRadius().get());
   }
+
+  //-------------------------------------------------------------------------------
+  /** Put a peaks workspace with peaks at the given HKLs in the ADS */
+  static PeaksWorkspace_sptr addPeaksWorkspace(const std::vector<V3D> &hkls) {
+    Instrument_sptr inst =
+        ComponentCreationHelper::createTestInstrumentCylindrical(5);
+    PeaksWorkspace_sptr peakWS(new PeaksWorkspace());
+    for (const auto &hkl : hkls)
+      peakWS->addPeak(Peak(inst, 15050, 1.0, hkl));
+    AnalysisDataService::Instance().addOrReplace("IntegratePeaksMD2Test_peaks",
+                                                 peakWS);
+    return peakWS;
+  }
+
+  /** Peaks are integrated concurrently: the result must not depend on which
+   * other peaks are integrated in the same run */
+  void test_integrating_many_peaks_matches_integrating_them_one_by_one() {
+    createMDEW();
+    std::vector<V3D> hkls;
+    for (int i = 0; i < 4; ++i)
+      for (int j = 0; j < 4; ++j)
+        for (int k = 0; k < 3; ++k)
+          hkls.emplace_back(-7.5 + 5. * i, -7.5 + 5. * j, -5. + 5. * k);
+    for (size_t i = 0; i < hkls.size(); ++i)
+      addPeak(200 + 10 * i, hkls[i].X(), hkls[i].Y(), hkls[i].Z(), 1.0);
+
+    addPeaksWorkspace(hkls);
+    doRun(1.0, 1.5, "IntegratePeaksMD2Test_all", 1.2);
+    auto allWS = AnalysisDataService::Instance().retrieveWS<PeaksWorkspace>(
+        "IntegratePeaksMD2Test_all");
+    TS_ASSERT_EQUALS(allWS->getNumberPeaks(), static_cast<int>(hkls.size()));
+
+    for (size_t i = 0; i < hkls.size(); ++i) {
+      addPeaksWorkspace(std::vector<V3D>(1, hkls[i]));
+      doRun(1.0, 1.5, "IntegratePeaksMD2Test_one", 1.2);
+      auto oneWS = AnalysisDataService::Instance().retrieveWS<PeaksWorkspace>(
+          "IntegratePeaksMD2Test_one");
+      const IPeak &peak = allWS->getPeak(static_cast<int>(i));
+      TS_ASSERT_LESS_THAN(0.0, peak.getIntensity());
+      TS_ASSERT_EQUALS(peak.getIntensity(), oneWS->getPeak(0).getIntensity());
+      TS_ASSERT_EQUALS(peak.getSigmaIntensity(),
+                       oneWS->getPeak(0).getSigmaIntensity());
+    }
+    AnalysisDataService::Instance().remove("IntegratePeaksMD2Test_all");
+    AnalysisDataService::Instance().remove("IntegratePeaksMD2Test_one");
+  }
+
+  /** File-backed workspaces are integrated in the order of the boxes on disk,
+   * the result must be that of the in-memory workspace */
+  void test_file_backed_workspace_gives_the_in_memory_result() {
+    std::vector<V3D> hkls;
+    for (int i = 0; i < 9; ++i)
+      hkls.emplace_back(9. - i, 1. + i, 1. + 0.5 * i);
+
+    MDAlgorithmsTestHelper::makeFileBackedMDEW("IntegratePeaksMD2Test_MDEWS",
+                                               false, 10000,
+                                               Mantid::Kernel::HKL);
+    addPeaksWorkspace(hkls);
+    doRun(1.0, 0.0, "IntegratePeaksMD2Test_memory");
+    auto memoryWS = AnalysisDataService::Instance().retrieveWS<PeaksWorkspace>(
+        "IntegratePeaksMD2Test_memory");
+
+    auto mdews = MDAlgorithmsTestHelper::makeFileBackedMDEW(
+        "IntegratePeaksMD2Test_MDEWS", true, 10000, Mantid::Kernel::HKL);
+    TS_ASSERT(mdews->isFileBacked());
+    addPeaksWorkspace(hkls);
+    doRun(1.0, 0.0, "IntegratePeaksMD2Test_file");
+    auto fileWS = AnalysisDataService::Instance().retrieveWS<PeaksWorkspace>(
+        "IntegratePeaksMD2Test_file");
+
+    for (int i = 0; i < memoryWS->getNumberPeaks(); ++i) {
+      const double intensity = memoryWS->getPeak(i).getIntensity();
+      TS_ASSERT_LESS_THAN(0.0, intensity);
+      TS_ASSERT_DELTA(fileWS->getPeak(i).getIntensity(), intensity,
+                      1e-10 * intensity);
+    }
+
+    const std::string filename =
+        mdews->getBoxController()->getFileIO()->getFileName();
+    mdews->clearFileBacked(false);
+    MDEventsTestHelper::checkAndDeleteFile(filename);
+    AnalysisDataService::Instance().remove("IntegratePeaksMD2Test_MDEWS");
+    AnalysisDataService::Instance().remove("IntegratePeaksMD2Test_memory");
+    AnalysisDataService::Instance().remove("IntegratePeaksMD2Test_file");
+  }
 };
 
 //=========================================================================================
@@ -37,5 +37,12 @@ void export_BoxController() {
            "Return  the full path to the file open as the file-based back or "
            "empty string if no file back-end is initiated")
       .def("useWriteBuffer", &BoxController::useWriteBuffer, arg("self"),
-           "Return true if the MRU should be used");
+           "Return true if the MRU should be used")
+      .def("getFileUtilisation", &BoxController::getFileUtilisation,
+           arg("self"),
+           "Return the fraction of the file back-end holding data, 1 if the "
+           "workspace is not file backed")
+      .def("getNumFreeFileBlocks", &BoxController::getNumFreeFileBlocks,
+           arg("self"),
+           "Return the number of blocks of free space in the file back-end");
 }
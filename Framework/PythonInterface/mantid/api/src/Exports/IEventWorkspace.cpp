@@ -45,7 +45,15 @@ void export_IEventWorkspace() {
            "the given :class:`~mantid.api.Workspace` "
            "index")
       .def("clearMRU", &IEventWorkspace::clearMRU, args("self"),
-           "Clear the most-recently-used lists");
+           "Clear the most-recently-used lists")
+      .def("setSortBeforeHistogram", &IEventWorkspace::setSortBeforeHistogram,
+           args("self", "sort"),
+           "If False, histogramming bins unsorted events directly when the "
+           "bins are linear or logarithmic, skipping the sort by TOF")
+      .def("getSortBeforeHistogram", &IEventWorkspace::getSortBeforeHistogram,
+           args("self"),
+           "Returns True if histogramming always sorts the events by TOF "
+           "first");
 
   RegisterWorkspacePtrToPython<IEventWorkspace>();
 }
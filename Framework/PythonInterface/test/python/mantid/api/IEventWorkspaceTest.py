@@ -34,6 +34,12 @@ class IEventWorkspaceTest(unittest.TestCase):
             error_raised = True
         self.assertFalse(error_raised)
 
+    def test_sort_before_histogram_can_be_toggled(self):
+        ws = WorkspaceCreationHelper.createEventWorkspace2(self._npixels, self._nbins)
+        self.assertTrue(ws.getSortBeforeHistogram())
+        ws.setSortBeforeHistogram(False)
+        self.assertFalse(ws.getSortBeforeHistogram())
+
     def test_event_list_is_return_as_correct_type(self):
         el = self._test_ws.getSpectrum(0)
         self.assertTrue(isinstance(el, IEventList))
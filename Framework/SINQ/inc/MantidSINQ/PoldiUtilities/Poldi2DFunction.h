@@ -59,6 +59,10 @@ public:
 
   void iterationFinished() override;
 
+protected:
+  /// function() also sets the fit weights from the total
+  bool membersAreSummed() const override { return false; }
+
 private:
   size_t m_iteration;
 };